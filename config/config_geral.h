@@ -18,22 +18,238 @@
 #define LED_B 12 // Azul: GPIO12
 #define PWM_STEP 0xFFFF // (1 << 16) - 1, para ciclo de trabalho máximo em PWM de 16 bits
 
+// Animação do LED RGB (drivers/rgb_led/rgb_led_animacao.h)
+#define ANIM_LED_MODO_DMA 1             // 1 = DMA nos registradores de comparação; 0 = apenas IRQ de wrap
+#define ANIM_LED_MAX_QUADROS_CHAVE 8    // Quadros-chave por sequência
+#define ANIM_LED_DMA_MAX_QUADROS 1024   // Quadros da tabela de DMA por slice (~2,1 s a 476 Hz)
+#define ANIM_LED_FADE_ACK_MS 300        // Transição para a nova cor após ACK do PING
+
 //Pinos I2C para OLED
 #define SDA_PIN 14 // SDA: GPIO14
 #define SCL_PIN 15 // SCL: GPIO15
 
+// Aquisição do ADC por DMA (drivers/adc/aquisicao_adc.h)
+// Entradas do round-robin: joystick (GPIO26/27), microfone (GPIO28) e sensor de temperatura (4)
+#define ADC_ENTRADAS ((1u << 0) | (1u << 1) | (1u << 2) | (1u << 4))
+#define ADC_TAXA_AMOSTRAS_HZ 8000     // Conversões por segundo, somando todas as entradas (máx. 500000)
+#define ADC_AMOSTRAS_BLOCO 512        // Amostras por bloco de DMA (potência de 2): um IRQ a cada 64 ms
+#define ADC_FILTRO_DESLOCAMENTO 2     // IIR por bloco: y += (x - y) / 2^N
+#define ADC_VREF_MV 3300              // Referência do ADC (ADC_AVDD) em mV
+
+// TLS com o broker (core1/transporte_tls.h), normalmente ligado pelo CMake (-DMQTT_TLS=ON).
+// O mbedTLS é configurado em config/mbedtls_config.h.
+#ifndef MQTT_TLS
+#define MQTT_TLS 0
+#endif
+#define TLS_HEAP_BYTES (40 * 1024)          // Heap estático do mbedTLS (handshake completo e buffers de registro)
+#define TLS_MAX_BROKERS 4                   // Sessões guardadas: os brokers seguintes de MQTT_BROKERS não retomam
+#define TLS_SESSAO_TAM_MAX 512              // Sessão serializada (com o ticket do broker) guardada na flash
+#ifndef TLS_SESSAO_FLASH
+#define TLS_SESSAO_FLASH 0                  // 1 = guarda a sessão no último setor da flash e a retoma após o reboot
+#endif
+
+// Publicação dos lotes sem o anel de saída do cliente MQTT (core1/mqtt_envio_direto.h):
+// o payload vai ao TCP por referência e o lote só é limitado por TCP_SND_BUF.
+// Com TLS o registro é cifrado numa cópia de qualquer forma, então o padrão é desligado.
+#ifndef PUBLICACAO_DIRETA
+#define PUBLICACAO_DIRETA (!MQTT_TLS)
+#endif
+#define ENVIO_DIRETO_MAX_EM_VOO 2           // Publicações diretas aguardando a confirmação do TCP
+#define ENVIO_DIRETO_TAM_TOPICO 48          // Maior tópico publicado pelo envio direto
+#define ENVIO_DIRETO_TAM_MAX (CONTROLE_LOTE_MAX * SENSORES_TAM_RESUMO + 1) // Lote cheio e o byte de cabeçalho
+
+// Controle adaptativo da publicação dos sensores (core0/controle_publicacao.h)
+#define SENSORES_TAM_RESUMO 256             // Bytes reservados por resumo de janela
+#ifndef SENSORES_FORMATO_CBOR
+#define SENSORES_FORMATO_CBOR 1             // 1 = resumos em CBOR (tools/decodificar_cbor.py); 0 = texto "chave=valor"
+#endif
+#define CONTROLE_JANELA_MIN_MS 1000         // Menor janela (maior resolução) com o enlace saudável
+#define CONTROLE_JANELA_MAX_MS 60000        // Maior janela com o enlace degradado
+#define CONTROLE_PASSO_JANELA_MS 500        // Redução aditiva da janela por ACK saudável
+#if PUBLICACAO_DIRETA
+#define CONTROLE_LOTE_MAX 16                // Resumos por mensagem no máximo (cada um com SENSORES_TAM_RESUMO)
+#else
+#define CONTROLE_LOTE_MAX 4                 // Limitado pelo anel de saída do cliente MQTT
+#endif
+#define CONTROLE_LATENCIA_ALVO_US 250000    // ACK médio acima disto indica congestionamento
+#define CONTROLE_OCUPACAO_MAX_PERMIL 500    // Buffer de saída do MQTT acima disto indica congestionamento
+
+// Compressão dos lotes publicados (shared/compressao_lzss.h, aplicada em core1/mqtt_client_core1.c)
+#ifndef COMPRESSAO_PAYLOAD
+#define COMPRESSAO_PAYLOAD 1                // 1 = comprime com LZSS quando economiza bytes; o cabeçalho indica
+#endif
+#define COMPRESSAO_MIN_BYTES 64             // Lotes menores saem sem tentar comprimir
+#define LZSS_BITS_JANELA 10                 // Janela de 1 KB; comprimentos de 3 a 66 bytes
+#define LZSS_PROFUNDIDADE_BUSCA 16          // Candidatos examinados por posição (velocidade x taxa)
+
+// Estatísticas de fluxo (shared/estatistica_fluxo.h)
+#define ESTATISTICA_NUM_FAIXAS 32       // Faixas do histograma dos quantis (erro de ~2 x alcance / N)
+
+// Velocidade do I2C do OLED (drivers/oled_ssd1306/oled_interface.c), igual em todos os perfis de clock
+#define OLED_I2C_FREQ_HZ (400 * 1000)       // Clock inicial, usado direto sem o autoajuste
+#ifndef OLED_I2C_AUTOAJUSTE
+#define OLED_I2C_AUTOAJUSTE 1               // 1 = testa velocidades crescentes no boot e fica com a mais rápida confiável
+#endif
+#ifndef OLED_I2C_FREQ_MAX_HZ
+#define OLED_I2C_FREQ_MAX_HZ (1000 * 1000)  // Teto do autoajuste (Fast-mode Plus)
+#endif
+#define OLED_I2C_PASSO_HZ (200 * 1000)      // Incremento entre as velocidades testadas
+#define OLED_I2C_QUADROS_TESTE 4            // Quadros completos enviados em cada velocidade
+
 // Tempos e tamanhos
 #define TEMPO_CONEXAO 2000      // ms para timeouts de conexão Wi-Fi
 #define TEMPO_MENSAGEM 2000     // ms para exibição de mensagens temporárias no OLED
 #define TAM_FILA 16             // Tamanho da fila circular para mensagens do Wi-Fi
-#define INTERVALO_PING_MS 5000  // Intervalo entre envios de "PING" MQTT
+#define INTERVALO_PING_MS 5000  // Janela inicial das publicações dos sensores (depois ajustada pelo controle adaptativo)
+
+// Energia do rádio (core1/energia_radio.h) e janelas de transmissão (core0/janela_transmissao.h)
+// Normalmente definido pelo CMake (-DMODO_ENERGIA=0|1|2)
+#define MODO_ENERGIA_PADRAO 0       // PM do SDK (CYW43_DEFAULT_PM), publicações saem assim que prontas
+#define MODO_ENERGIA_LATENCIA 1     // Rádio sempre acordado (CYW43_NONE_PM): menor latência, maior consumo
+#define MODO_ENERGIA_ECONOMIA 2     // PM2 com retorno curto ao sono e tráfego de saída só nas janelas
+#ifndef MODO_ENERGIA
+#define MODO_ENERGIA MODO_ENERGIA_PADRAO
+#endif
+#define RADIO_RETORNO_SONO_MS 20    // ECONOMIA: rádio acordado após o último quadro (múltiplo de 10)
+#define RADIO_INTERVALO_DTIM 3      // ECONOMIA: escuta 1 a cada N beacons DTIM (atraso máximo da descida)
+#define RADIO_ESCUTA_BEACON_US 2000 // Estimativa do tempo acordado para receber um beacon
+#ifndef JANELA_TX_PERIODO_MS
+#define JANELA_TX_PERIODO_MS INTERVALO_PING_MS // Uma janela de transmissão por período, alinhada ao boot
+#endif
+#define JANELA_TX_DURACAO_MS 250    // Parte aberta de cada período (alguns ciclos do loop do Núcleo 0)
+#define JANELA_TX_PERIODOS_KEEP_ALIVE 4 // ECONOMIA: keep-alive em períodos (PINGREQ só sem tráfego)
 
 // Configurações de Rede
 #define WIFI_SSID "@"                           // SSID da sua Rede Wi-Fi
 #define WIFI_PASS "internet"                    // Senha da sua Rede Wi-Fi
+#ifndef MQTT_BROKER_IP                          // Pode ser sobrescrito pelo build (ex.: alvo de rede nativo)
 #define MQTT_BROKER_IP "192.168.246.110"        // Endereço IP do seu broker Mosquitto
+#endif
+#if MQTT_TLS
+#define MQTT_BROKER_PORT 8883                   // Porta padrão do MQTT sobre TLS
+#else
 #define MQTT_BROKER_PORT 1883                   // Porta padrão do MQTT
-#define TOPICO "pico/PING"                      // Tópico MQTT para publicar o PING
+#endif
+#ifndef MQTT_BROKER_RESERVA_IP                  // Broker reserva (ex.: segunda instância do mosquitto)
+#define MQTT_BROKER_RESERVA_IP MQTT_BROKER_IP
+#endif
+#ifndef MQTT_BROKER_RESERVA_PORT
+#define MQTT_BROKER_RESERVA_PORT (MQTT_BROKER_PORT + 1)
+#endif
+#define TOPICO_PING "pico/PING"                 // Tópico da carga do cenário de rede nativo
+#define TOPICO_SENSORES "pico/sensores"         // Tópico das leituras periódicas do ADC
+#define TOPICO_ESTADO_WIFI "pico/estado/wifi"   // Status do enlace Wi-Fi, retido no broker
+#define TOPICO_COR_LED "pico/estado/cor"        // Cor atual do LED RGB, retida no broker
+#define TOPICO_TEMPERATURA "pico/sensores/temp_mc" // Temperatura interna, retida no broker
+
+// Failover entre brokers (core1/failover_broker.h): {IP, porta} em ordem de preferência
+#ifndef MQTT_BROKERS
+#define MQTT_BROKERS {{MQTT_BROKER_IP, MQTT_BROKER_PORT}, {MQTT_BROKER_RESERVA_IP, MQTT_BROKER_RESERVA_PORT}}
+#endif
+#if MODO_ENERGIA == MODO_ENERGIA_ECONOMIA
+// Com publicações a cada janela o PINGREQ não sai; sem tráfego ele não acorda o rádio a cada 10 s
+#define MQTT_KEEP_ALIVE_S (JANELA_TX_PERIODOS_KEEP_ALIVE * JANELA_TX_PERIODO_MS / 1000)
+#else
+#define MQTT_KEEP_ALIVE_S 10                    // PINGREQ ocioso; sem resposta em 1,5x o lwIP fecha a conexão
+#endif
+#if MQTT_TLS
+#define BROKER_TIMEOUT_CONEXAO_MS 10000         // Inclui um handshake TLS completo (ECDHE e ECDSA no M0+)
+#else
+#define BROKER_TIMEOUT_CONEXAO_MS 3000          // Tentativa sem CONNACK até aqui conta como falha
+#endif
+#ifndef MQTT_TLS_NOME_SERVIDOR                  // Nome conferido no certificado do broker e enviado no SNI
+#define MQTT_TLS_NOME_SERVIDOR NULL             // NULL = o IP do broker em MQTT_BROKERS
+#endif
+#define BROKER_PENALIDADE_FALHA_MS 5000         // Peso de cada falha recente na pontuação (ms de latência)
+#define BROKER_RETORNO_MS 60000                 // Tempo no reserva antes de voltar ao preferido (e meia-vida das falhas)
+#define BROKER_RETORNO_MAX_MS 480000            // Teto dessa espera, que dobra a cada volta malsucedida
+
+// Sonda de latência fim a fim (core0/sonda_rtt.h): publica em TOPICO_SONDA e mede a
+// volta por TOPICO_SONDA_ECO, respondido por um cliente de eco (tools/eco_sonda.sh).
+// Com TOPICO_SONDA_ECO igual a TOPICO_SONDA, o próprio broker devolve a sonda.
+#ifndef SONDA_RTT_HABILITADA
+#define SONDA_RTT_HABILITADA 1
+#endif
+#define TOPICO_SONDA "pico/sonda"
+#define TOPICO_SONDA_ECO "pico/sonda/eco"
+#define SONDA_INTERVALO_MS 2000                 // Uma sonda a cada intervalo
+#define SONDA_TIMEOUT_MS 5000                   // Sem resposta até aqui, a sonda conta como perdida
+#define SONDA_MAX_PENDENTES 8                   // Sondas aguardando resposta ao mesmo tempo
+#define SONDA_JANELA_MS 60000                   // Janela do histograma de RTT (p50/p99)
+
+// Caminho de entrada do MQTT (core1/entrada_mqtt.h): tópicos assinados e seus
+// manipuladores ficam na tabela de entrada_mqtt.c
+#define TOPICO_COMANDO "pico/comando/#"         // Comandos de um caractere aceitos remotamente (lista em main_core0_utils.c)
+#define ENTRADA_NUM_BUFFERS 16                  // Mensagens aguardando o Núcleo 0 (potência de 2): a maior rajada sem descarte
+#define ENTRADA_TAM_BUFFER 256                  // Maior payload aceito; maiores são descartados
+#define ENTRADA_TAM_TOPICO 48                   // Maior tópico recebido, com o terminador
+#define ENTRADA_TAM_HASH 16                     // Posições do índice dos tópicos exatos (potência de 2)
+
+// Arquitetura da rede (core1/saida_mqtt.h). Normalmente definido pelo CMake (-DREDE_POLL=ON):
+// 0 = lwIP em segundo plano (pico_cyw43_arch_lwip_threadsafe_background), com os callbacks em IRQ
+// 1 = polling (pico_cyw43_arch_lwip_poll): o laço do Núcleo 1 é o único a tocar no CYW43 e no lwIP
+#ifndef REDE_POLL
+#define REDE_POLL 0
+#endif
+#define REDE_POLL_OCIOSO_MAX_US 1000             // Maior sono do Núcleo 1 sem olhar o executor (REDE_POLL)
+#define SAIDA_NUM_BUFFERS 8                     // Publicações aguardando o Núcleo 1 (potência de 2)
+#define SAIDA_TAM_BUFFER METRICAS_TAM_RETRATO   // Maior payload copiado na fila (os lotes vão por referência)
+#if REDE_POLL && TLS_SESSAO_FLASH
+#error "TLS_SESSAO_FLASH pausa o Núcleo 1 pela FIFO; com REDE_POLL é ele quem conecta e não pode ser pausado"
+#endif
+
+// Publicação por exceção (tabela de tópicos em core1/mqtt_client_core1.c)
+#define ESTADO_INTERVALO_MIN_MS 1000            // Menor espaço entre duas mudanças de estado publicadas
+#define ESTADO_INTERVALO_MAX_MS 300000          // Republica o último valor mesmo sem mudança
+#define TEMPERATURA_INTERVALO_MIN_MS 10000      // Menor espaço entre duas temperaturas publicadas
+#define TEMPERATURA_ZONA_MORTA_MC 250           // Variação (m°C) que não justifica publicar
+
+// Rastreio de desempenho (shared/rastreio.h)
+// Normalmente definido pelo CMake (-DHABILITAR_RASTREIO=ON); com 0 todo o código é removido
+#ifndef HABILITAR_RASTREIO
+#define HABILITAR_RASTREIO 0
+#endif
+#define RASTREIO_TAM_BUFFER 512         // Eventos por núcleo (potência de 2, 8 bytes cada)
+#define COMANDO_DESPEJAR_RASTREIO 'd'   // Caractere recebido pela serial que exporta o rastreio
+
+// Perfil de clock do sistema (shared/perfil_clock.h)
+// Normalmente definido pelo CMake (-DPERFIL_CLOCK=1|2|3); 2 = 125 MHz, padrão do SDK
+#ifndef PERFIL_CLOCK
+#define PERFIL_CLOCK 2
+#endif
+#define COMANDO_BENCHMARK 'b'          // Caractere recebido pela serial que roda o benchmark do Núcleo 0
+
+// Funções do caminho crítico em SRAM (shared/secao_ram.h)
+// Normalmente definido pelo CMake (-DCODIGO_EM_RAM=0|1|2); 0 = tudo em flash (XIP)
+#ifndef CODIGO_EM_RAM
+#define CODIGO_EM_RAM 0
+#endif
+
+// Memória totalmente estática: nenhum malloc no firmware (o build falha se ele for ligado)
+// Normalmente definido pelo CMake (-DMEMORIA_ESTATICA=ON)
+#ifndef MEMORIA_ESTATICA
+#define MEMORIA_ESTATICA 0
+#endif
+
+// Métricas de recursos (shared/metricas.h), sempre coletadas
+#define TOPICO_METRICAS "pico/metricas"     // Tópico do retrato periódico das métricas
+#define METRICAS_INTERVALO_MS 60000         // Intervalo de publicação (0 = não publica)
+#define METRICAS_NUM_FAIXAS_LOOP 8          // Faixas do histograma de duração do loop do Núcleo 0
+#define METRICAS_TAM_RETRATO 512            // Bytes do retrato "chave=valor,..." (todas as chaves no dispositivo)
+#define COMANDO_IMPRIMIR_METRICAS 'm'       // Caractere recebido pela serial que imprime as métricas
+#define METRICAS_MAX_ATUALIZACOES 4         // Funções de metricas_registrar_atualizacao
+
+// Executor de trabalhos entre os núcleos (shared/executor.h)
+#define EXECUTOR_TAM_DEQUE 8                // Trabalhos por núcleo (potência de 2); com o deque cheio, roda na submissão
+
+// Agendador do trabalho periódico do Núcleo 0 (core0/temporizador.h)
+#define TEMPORIZADOR_NUM_POSICOES 32        // Posições da roda (potência de 2)
+#define TEMPORIZADOR_RESOLUCAO_MS 64        // Tempo de cada posição: uma volta da roda cobre 2048 ms
+#define TEMPORIZADOR_ESPERA_MAX_MS 1000     // Maior sono do loop sem prazos nem eventos
+#define TEMPORIZADOR_RETENTATIVA_MS 1000    // Nova tentativa de um tópico de estado recusado (sem conexão, anel cheio)
+#ifndef TEMPORIZADOR_PAUSA_FIXA_MS
+#define TEMPORIZADOR_PAUSA_FIXA_MS 0        // Diferente de 0: o loop volta à pausa fixa, para comparar o jitter
+#endif
 
 // Para evitar redefinição de oled_utils.h em outros lugares
 // Se oled_interface.h for incluído, estas funções estarão disponíveis.
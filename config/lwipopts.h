@@ -1,7 +1,12 @@
 /**
  * @file lwipopts.h
  * @brief Configurações personalizadas da pilha LWIP para o Raspberry Pi Pico W.
- * (Conteúdo original mantido)
+ *
+ * Os parâmetros de memória, buffers TCP e MQTT vêm de um perfil escolhido por
+ * LWIP_PERFIL (definido pelo CMake, -DLWIP_PERFIL=1|2|3). Cada parâmetro do
+ * perfil pode ser sobrescrito individualmente com -D, o que é usado pela
+ * varredura de tools/varredura_lwip.sh. O perfil equilibrado (padrão) mantém os
+ * valores originais do projeto.
  */
 #ifndef __LWIPOPTS_H__
 #define __LWIPOPTS_H__
@@ -17,33 +22,85 @@
 #ifndef LWIP_SOCKET
 #define LWIP_SOCKET                 0
 #endif
-#if PICO_CYW43_ARCH_POLL
+#if PICO_CYW43_ARCH_POLL && !MEMORIA_ESTATICA
 #define MEM_LIBC_MALLOC             1
 #else
 // MEM_LIBC_MALLOC is incompatible with non polling versions
+// (sem ele o heap do lwIP é o vetor estático ram_heap, de MEM_SIZE bytes)
 #define MEM_LIBC_MALLOC             0
 #endif
 #define MEM_ALIGNMENT               4
-#define MEM_SIZE                    4000
-#define MEMP_NUM_TCP_SEG            32
 #define MEMP_NUM_ARP_QUEUE          10
 #define MEMP_NUM_SYS_TIMEOUT        16 // Aumentado para MQTT (original era 10, outros exemplos usam 16)
-#define PBUF_POOL_SIZE              24
+
+// --- Perfis de memória ---
+#define LWIP_PERFIL_BAIXA_RAM       1  // Menor pegada de RAM; poucas publicações em voo
+#define LWIP_PERFIL_EQUILIBRADO     2  // Valores originais do projeto
+#define LWIP_PERFIL_ALTA_VAZAO      3  // Janelas e filas maiores para rajadas de publicação
+
+#ifndef LWIP_PERFIL
+#define LWIP_PERFIL                 LWIP_PERFIL_EQUILIBRADO
+#endif
+
+#if LWIP_PERFIL == LWIP_PERFIL_BAIXA_RAM
+#define PERFIL_MEM_SIZE             3072
+#define PERFIL_PBUF_POOL_SIZE       8
+#define PERFIL_TCP_WND_MSS          2        // Janelas em múltiplos de TCP_MSS (mínimo do lwIP: 2)
+#define PERFIL_TCP_SND_BUF_MSS      2
+#define PERFIL_MQTT_RINGBUF         256
+#define PERFIL_MQTT_EM_VOO          2
+#elif LWIP_PERFIL == LWIP_PERFIL_EQUILIBRADO
+#define PERFIL_MEM_SIZE             4000
+#define PERFIL_PBUF_POOL_SIZE       24
+#define PERFIL_TCP_WND_MSS          8
+#define PERFIL_TCP_SND_BUF_MSS      8
+#define PERFIL_MQTT_RINGBUF         1024
+#define PERFIL_MQTT_EM_VOO          5
+#elif LWIP_PERFIL == LWIP_PERFIL_ALTA_VAZAO
+#define PERFIL_MEM_SIZE             24000    // Comporta o TCP_SND_BUF inteiro copiado pelo cliente MQTT
+#define PERFIL_PBUF_POOL_SIZE       32
+#define PERFIL_TCP_WND_MSS          16
+#define PERFIL_TCP_SND_BUF_MSS      12
+#define PERFIL_MQTT_RINGBUF         4096
+#define PERFIL_MQTT_EM_VOO          16
+#else
+#error "LWIP_PERFIL inválido (use 1 = baixa RAM, 2 = equilibrado, 3 = alta vazão)"
+#endif
+
+#ifndef MEM_SIZE
+#define MEM_SIZE                    PERFIL_MEM_SIZE
+#endif
+#ifndef PBUF_POOL_SIZE
+#define PBUF_POOL_SIZE              PERFIL_PBUF_POOL_SIZE
+#endif
+// Cada segmento na fila de envio ocupa um MEMP_TCP_SEG (o lwIP exige >= TCP_SND_QUEUELEN)
+#ifndef MEMP_NUM_TCP_SEG
+#define MEMP_NUM_TCP_SEG            TCP_SND_QUEUELEN
+#endif
+
+// Estatísticas de uso e pico dos pools (publicadas por shared/metricas.c; só contadores)
+#ifndef LWIP_MEDIR_POOLS
+#define LWIP_MEDIR_POOLS            1
+#endif
 #define LWIP_ARP                    1
 #define LWIP_ETHERNET               1
 #define LWIP_ICMP                   1
 #define LWIP_RAW                    1
-#define TCP_WND                     (8 * TCP_MSS)
 #define TCP_MSS                     1460
-#define TCP_SND_BUF                 (8 * TCP_MSS)
+#ifndef TCP_WND
+#define TCP_WND                     (PERFIL_TCP_WND_MSS * TCP_MSS)
+#endif
+#ifndef TCP_SND_BUF
+#define TCP_SND_BUF                 (PERFIL_TCP_SND_BUF_MSS * TCP_MSS)
+#endif
 #define TCP_SND_QUEUELEN            ((4 * (TCP_SND_BUF) + (TCP_MSS - 1)) / (TCP_MSS))
 #define LWIP_NETIF_STATUS_CALLBACK  1
 #define LWIP_NETIF_LINK_CALLBACK    1
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETCONN                0
-#define MEM_STATS                   0
+#define MEM_STATS                   LWIP_MEDIR_POOLS
 #define SYS_STATS                   0
-#define MEMP_STATS                  0
+#define MEMP_STATS                  LWIP_MEDIR_POOLS
 #define LINK_STATS                  0
 // #define ETH_PAD_SIZE                2 // Comentado, pois pode não ser necessário para Wi-Fi
 #define LWIP_CHKSUM_ALGORITHM       3
@@ -61,6 +118,8 @@
 #define LWIP_DEBUG                  1
 #define LWIP_STATS                  1
 #define LWIP_STATS_DISPLAY          1
+#elif LWIP_MEDIR_POOLS
+#define LWIP_STATS                  1
 #endif
 
 #define ETHARP_DEBUG                LWIP_DBG_OFF
@@ -94,8 +153,18 @@
 
 // Configurações específicas para MQTT
 #define LWIP_ALTCP                  LWIP_TCP // Necessário para MQTT
+#if MQTT_TLS
+#define LWIP_ALTCP_TLS              1        // Cliente MQTT sobre TLS (core1/transporte_tls.h)
+#define LWIP_ALTCP_TLS_MBEDTLS      1
+#define ALTCP_MBEDTLS_PLATFORM_ALLOC 0       // O mbedTLS usa o heap estático próprio, não o heap do lwIP
+#else
 #define LWIP_ALTCP_TLS              0        // Desabilitar TLS se não for usado
-#define MQTT_OUTPUT_RINGBUF_SIZE    1024     // Ajustar conforme necessidade
-#define MQTT_REQ_MAX_IN_FLIGHT      5        // Número de requisições MQTT em trânsito
+#endif
+#ifndef MQTT_OUTPUT_RINGBUF_SIZE
+#define MQTT_OUTPUT_RINGBUF_SIZE    PERFIL_MQTT_RINGBUF  // Mensagens aguardando espaço no TCP
+#endif
+#ifndef MQTT_REQ_MAX_IN_FLIGHT
+#define MQTT_REQ_MAX_IN_FLIGHT      PERFIL_MQTT_EM_VOO   // Número de requisições MQTT em trânsito
+#endif
 
 #endif /* __LWIPOPTS_H__ */
\ No newline at end of file
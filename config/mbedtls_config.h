@@ -0,0 +1,84 @@
+/**
+ * @file mbedtls_config.h
+ * @brief Configuração do mbedTLS (3.x) para o cliente MQTT sobre TLS (MQTT_TLS).
+ *
+ * Só o necessário para um cliente TLS 1.2 com ECDHE-ECDSA sobre P-256: sem RSA,
+ * sem DHE e sem TLS 1.3, o que encolhe a flash e, principalmente, o pico de RAM
+ * do handshake. Toda alocação do mbedTLS vai para um heap estático de
+ * TLS_HEAP_BYTES (MBEDTLS_MEMORY_BUFFER_ALLOC_C), iniciado por
+ * core1/transporte_tls.c; o pico de uso desse heap é publicado nas métricas.
+ *
+ * O Pico SDK (pico_mbedtls) procura este arquivo pelo nome; o alvo de rede
+ * nativo (host/rede) compila o mbedTLS com ele também, para que o benchmark
+ * meça exatamente a configuração do firmware.
+ */
+#ifndef MBEDTLS_CONFIG_H
+#define MBEDTLS_CONFIG_H
+
+// --- Plataforma ---
+#define MBEDTLS_HAVE_TIME                   // Início da sessão, usado pela retomada
+#define MBEDTLS_PLATFORM_C
+#define MBEDTLS_PLATFORM_MEMORY             // calloc/free trocados pelo heap estático
+#define MBEDTLS_MEMORY_BUFFER_ALLOC_C
+#define MBEDTLS_MEMORY_DEBUG                // mbedtls_memory_buffer_alloc_max_get (pico de uso)
+#define MBEDTLS_NO_PLATFORM_ENTROPY         // Sem /dev/urandom no RP2040
+#define MBEDTLS_ENTROPY_HARDWARE_ALT        // mbedtls_hardware_poll do pico_mbedtls (ROSC)
+#define MBEDTLS_ENTROPY_C
+#define MBEDTLS_ENTROPY_FORCE_SHA256        // SHA-512 ficaria só para a entropia
+#define MBEDTLS_CTR_DRBG_C
+
+// --- Cifras: AES-128 em CCM e GCM ---
+#define MBEDTLS_AES_C
+#define MBEDTLS_AES_ROM_TABLES              // Tabelas constantes (flash) em vez de geradas na RAM
+#define MBEDTLS_AES_FEWER_TABLES            // 2 KB de tabelas em vez de 8 KB
+#define MBEDTLS_CIPHER_C
+#define MBEDTLS_CCM_C
+#define MBEDTLS_GCM_C
+#define MBEDTLS_MD_C
+#define MBEDTLS_SHA256_C
+
+// --- Curva elíptica: só P-256 ---
+#define MBEDTLS_BIGNUM_C
+#define MBEDTLS_ECP_C
+#define MBEDTLS_ECP_DP_SECP256R1_ENABLED
+#define MBEDTLS_ECP_NIST_OPTIM              // Redução modular rápida da P-256
+#define MBEDTLS_ECP_FIXED_POINT_OPTIM 1     // Tabela pré-calculada do gerador, constante em flash
+#define MBEDTLS_ECP_WINDOW_SIZE 4
+#define MBEDTLS_ECDH_C
+#define MBEDTLS_ECDSA_C
+
+// --- Certificados ---
+#define MBEDTLS_ASN1_PARSE_C
+#define MBEDTLS_ASN1_WRITE_C
+#define MBEDTLS_OID_C
+#define MBEDTLS_BASE64_C
+#define MBEDTLS_PEM_PARSE_C
+#define MBEDTLS_PK_C
+#define MBEDTLS_PK_PARSE_C
+#define MBEDTLS_X509_USE_C
+#define MBEDTLS_X509_CRT_PARSE_C
+
+// --- TLS ---
+#define MBEDTLS_SSL_TLS_C
+#define MBEDTLS_SSL_CLI_C
+#define MBEDTLS_SSL_PROTO_TLS1_2
+#define MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED
+#define MBEDTLS_SSL_SERVER_NAME_INDICATION
+#define MBEDTLS_SSL_SESSION_TICKETS         // Retomada sem estado no broker (RFC 5077)
+#define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH     // Extensão pedida ao broker; o altcp_tls limita cada escrita a um registro de saída
+
+// CCM antes de GCM: sem multiplicação sem vai-um no M0+, o GHASH custa mais que
+// o segundo AES do CBC-MAC. O broker escolhe entre as duas (mosquitto aceita ambas).
+#define MBEDTLS_SSL_CIPHERSUITES \
+    MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_CCM, \
+    MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256
+
+// Buffers de registro. A entrada não tem os 16 KB do padrão: cada conexão pede
+// ao broker registros de até 4 KB pela extensão max_fragment_length (RFC 6066,
+// core1/transporte_tls.c). O broker precisa aceitá-la (o OpenSSL aceita desde a
+// 1.1.1, e com ele o mosquitto); um que a ignore e envie um registro maior que
+// este buffer derruba a conexão. Os lotes publicados cabem na saída.
+#define MBEDTLS_SSL_IN_CONTENT_LEN 4096
+#define MBEDTLS_SSL_OUT_CONTENT_LEN 2048
+
+#endif /* MBEDTLS_CONFIG_H */
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+ * @file benchmark_core0.c
+ * @brief Benchmark embarcado do Núcleo 0, para comparar os perfis de clock.
+ *
+ * Mede desenho de glifos, operações na fila inter-core, correção gama do LED,
+ * atualizações e resumo das estatísticas de fluxo e renderização completa do OLED.
+ * Tudo menos a renderização escala com o clk_sys (as estatísticas saem em ciclos
+ * por valor, que devem ficar iguais entre os perfis); a renderização é dominada
+ * pelo I2C (velocidade escolhida no boot) e deve ficar igual em todos os perfis
+ * (é a verificação de que o I2C foi recalculado).
+ */
+
+#include "core0/benchmark_core0.h"
+#include "config/config_geral.h"
+#include "core0/fila_circular.h"
+#include "drivers/oled_ssd1306/oled_driver.h"
+#include "drivers/oled_ssd1306/oled_interface.h"
+#include "drivers/rgb_led/rgb_led_animacao.h"
+#include "drivers/rgb_led/rgb_led_pwm.h"
+#include "shared/estado_compartilhado.h"
+#include "shared/metricas.h"
+#include "shared/perfil_clock.h"
+#include "shared/estatistica_fluxo.h"
+#include "hardware/clocks.h"
+#include <stdio.h>
+
+#define BENCH_GLIFOS 4096
+#define BENCH_OPERACOES_FILA 4096
+#define BENCH_GAMA 16384
+#define BENCH_RENDERIZACOES 8
+#define BENCH_ESTATISTICA 8192
+
+// Evita que o compilador descarte os cálculos medidos
+static volatile uint32_t sumidouro_gama;
+
+/**
+ * @brief Converte uma contagem de operações em um intervalo para operações por segundo.
+ */
+static unsigned long por_segundo(uint32_t operacoes, uint32_t duracao_us) {
+    return duracao_us ? (unsigned long)((uint64_t)operacoes * 1000000u / duracao_us) : 0;
+}
+
+void benchmark_core0_executar(void) {
+    uint32_t inicio = time_us_32();
+    for (int i = 0; i < BENCH_GLIFOS; i++) {
+        ssd1306_draw_char(buffer_oled, (i % 16) * 8, ((i / 16) % 8) * 8, 'A' + i % 26);
+    }
+    uint32_t glifos_us = time_us_32() - inicio;
+
+    FilaCircularInterCore fila;
+    fila_intercore_inicializar(&fila);
+    MensagemInterCore msg = {0, 0};
+    inicio = time_us_32();
+    for (int i = 0; i < BENCH_OPERACOES_FILA / 2; i++) {
+        fila_intercore_inserir(&fila, msg);
+        fila_intercore_remover(&fila, &msg);
+    }
+    uint32_t fila_us = time_us_32() - inicio;
+
+    uint32_t soma = 0;
+    inicio = time_us_32();
+    for (int i = 0; i < BENCH_GAMA; i++) soma += anim_led_gama((uint16_t)(i * 4));
+    uint32_t gama_us = time_us_32() - inicio;
+    sumidouro_gama = soma;
+
+    static EstatisticaFluxo estatistica; // ~180 bytes: fora da pilha
+    ResumoEstatistica resumo;
+    estatistica_reiniciar(&estatistica);
+    uint32_t x = 1; // LCG de 32 bits: valores de 20 bits, como as médias Q8 do ADC
+    inicio = time_us_32();
+    for (int i = 0; i < BENCH_ESTATISTICA; i++) {
+        x = x * 1664525u + 1013904223u;
+        estatistica_adicionar(&estatistica, (int32_t)(x >> 12));
+    }
+    uint32_t estatistica_us = time_us_32() - inicio;
+    inicio = time_us_32();
+    estatistica_resumir(&estatistica, &resumo, true);
+    uint32_t resumo_us = time_us_32() - inicio;
+    // Sem o custo do gerador, medido à parte
+    inicio = time_us_32();
+    for (int i = 0; i < BENCH_ESTATISTICA; i++) {
+        x = x * 1664525u + 1013904223u;
+        soma += x >> 12;
+    }
+    uint32_t gerador_us = time_us_32() - inicio;
+    sumidouro_gama = soma;
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000u;
+    uint32_t estat_ciclos = estatistica_us > gerador_us
+        ? (uint32_t)((uint64_t)(estatistica_us - gerador_us) * mhz / BENCH_ESTATISTICA) : 0;
+
+    inicio = time_us_32();
+    for (int i = 0; i < BENCH_RENDERIZACOES; i++) ssd1306_render(buffer_oled, &area);
+    uint32_t render_us = (time_us_32() - inicio) / BENCH_RENDERIZACOES;
+
+    printf("#BENCH perfil=%s clk_sys_mhz=%lu pwm_wrap_hz=%.1f glifos_s=%lu fila_ops_s=%lu gama_s=%lu estat_ciclos=%lu estat_resumo_us=%lu render_us=%lu i2c_khz=%u i2c_bytes_s=%lu\n",
+           perfil_clock_nome(), (unsigned long)(clock_get_hz(clk_sys) / 1000000u), rgb_pwm_frequencia_wrap_hz(),
+           por_segundo(BENCH_GLIFOS, glifos_us), por_segundo(BENCH_OPERACOES_FILA, fila_us),
+           por_segundo(BENCH_GAMA, gama_us), (unsigned long)estat_ciclos, (unsigned long)resumo_us,
+           (unsigned long)render_us,
+           oled_i2c_frequencia_hz() / 1000, (unsigned long)oled_i2c_vazao_bytes_s());
+
+    static char retrato[METRICAS_TAM_RETRATO]; // Fora da pilha de 2 KB do Núcleo 0
+    metricas_formatar(retrato, sizeof(retrato));
+    printf("#METRICAS %s\n", retrato);
+
+    oled_clear_global_buffer();
+    oled_render_global_buffer();
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#ifndef BENCHMARK_CORE0_H
+#define BENCHMARK_CORE0_H
+
+/**
+ * @brief Mede, na placa, o custo das operações do Núcleo 0 que dependem do clk_sys
+ * e imprime uma linha "#BENCH chave=valor ..." seguida do retrato das métricas
+ * (histograma do loop). Disparado pelo comando serial COMANDO_BENCHMARK.
+ * Bloqueia o loop por cerca de meio segundo e deixa o OLED limpo ao final.
+ */
+void benchmark_core0_executar(void);
+
+#endif
\ No newline at end of file
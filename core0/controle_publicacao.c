@@ -0,0 +1,97 @@
+/**
+ * @file controle_publicacao.c
+ * @brief Controle AIMD da taxa de publicação dos sensores.
+ *
+ * O período entre mensagens é janela x lote. A cada resultado de publicação:
+ * - congestionamento (falha, ACK acima de CONTROLE_LATENCIA_ALVO_US, buffer de
+ *   saída acima de CONTROLE_OCUPACAO_MAX_PERMIL ou mensagem anterior ainda sem
+ *   ACK): o lote dobra até CONTROLE_LOTE_MAX, mantendo a resolução das janelas
+ *   em menos mensagens, maiores; com o lote no máximo, a janela dobra até
+ *   CONTROLE_JANELA_MAX_MS;
+ * - enlace saudável: o lote cai de um em um até 1 e depois a janela diminui
+ *   CONTROLE_PASSO_JANELA_MS por vez até CONTROLE_JANELA_MIN_MS.
+ * Quedas multiplicativas e recuperação aditiva, como no TCP.
+ */
+
+#include "core0/controle_publicacao.h"
+#include "config/config_geral.h"
+#include "pico/time.h"
+#include <stdio.h>
+
+static uint32_t janela_ms;
+static uint8_t lote;
+static uint32_t latencia_media_us;     // EWMA com peso 1/8
+static uint32_t instante_envio_us;
+static uint16_t ocupacao_no_envio;
+static bool aguardando_ack = false;
+static bool congestionado_no_envio = false;
+
+void controle_publicacao_inicializar(void) {
+    janela_ms = INTERVALO_PING_MS;
+    lote = 1;
+    latencia_media_us = 0;
+    aguardando_ack = false;
+}
+
+void controle_publicacao_registrar_envio(uint16_t ocupacao_permil) {
+    // Mensagem anterior sem resposta até o próximo envio também é congestionamento
+    congestionado_no_envio = aguardando_ack;
+    ocupacao_no_envio = ocupacao_permil;
+    instante_envio_us = time_us_32();
+    aguardando_ack = true;
+}
+
+/**
+ * @brief Reduz a taxa de mensagens: primeiro agrupa mais janelas, depois alonga as janelas.
+ */
+static void reduzir_taxa(void) {
+    if (lote < CONTROLE_LOTE_MAX) {
+        lote = lote * 2 > CONTROLE_LOTE_MAX ? CONTROLE_LOTE_MAX : lote * 2;
+    } else {
+        janela_ms = janela_ms * 2 > CONTROLE_JANELA_MAX_MS ? CONTROLE_JANELA_MAX_MS : janela_ms * 2;
+    }
+}
+
+/**
+ * @brief Aumenta a taxa de mensagens: primeiro desfaz o agrupamento, depois encurta as janelas.
+ */
+static void aumentar_taxa(void) {
+    if (lote > 1) {
+        lote--;
+    } else if (janela_ms > CONTROLE_JANELA_MIN_MS + CONTROLE_PASSO_JANELA_MS) {
+        janela_ms -= CONTROLE_PASSO_JANELA_MS;
+    } else {
+        janela_ms = CONTROLE_JANELA_MIN_MS;
+    }
+}
+
+void controle_publicacao_registrar_resultado(bool sucesso) {
+    if (!aguardando_ack) return; // Resultado de uma publicação anterior a um reinício
+    aguardando_ack = false;
+
+    uint32_t latencia_us = time_us_32() - instante_envio_us;
+    if (latencia_media_us == 0) latencia_media_us = latencia_us;
+    else latencia_media_us += ((int32_t)latencia_us - (int32_t)latencia_media_us) / 8;
+
+    bool congestionado = !sucesso || congestionado_no_envio ||
+                         latencia_media_us > CONTROLE_LATENCIA_ALVO_US ||
+                         ocupacao_no_envio > CONTROLE_OCUPACAO_MAX_PERMIL;
+    if (congestionado) reduzir_taxa();
+    else aumentar_taxa();
+
+    printf("[CONTROLE] %s: ack=%lu us (média %lu us), ocupação=%u/1000 -> janela=%lu ms, lote=%u\n",
+           congestionado ? "congestionado" : "saudável", (unsigned long)latencia_us,
+           (unsigned long)latencia_media_us, ocupacao_no_envio, (unsigned long)janela_ms, lote);
+}
+
+uint32_t controle_publicacao_janela_ms(void) {
+    return janela_ms;
+}
+
+uint8_t controle_publicacao_lote(void) {
+    return lote;
+}
+
+uint32_t controle_publicacao_latencia_us(void) {
+    return latencia_media_us;
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef CONTROLE_PUBLICACAO_H
+#define CONTROLE_PUBLICACAO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Reinicia o controle: janela de INTERVALO_PING_MS e um resumo por mensagem.
+ */
+void controle_publicacao_inicializar(void);
+
+/**
+ * @brief Registra o envio de uma mensagem de sensores.
+ *
+ * @param ocupacao_permil Ocupação do buffer de saída do MQTT no momento do envio.
+ */
+void controle_publicacao_registrar_envio(uint16_t ocupacao_permil);
+
+/**
+ * @brief Registra o resultado da última mensagem (ACK do callback de publicação,
+ * ou recusa local) e ajusta janela e lote.
+ */
+void controle_publicacao_registrar_resultado(bool sucesso);
+
+/**
+ * @brief Duração atual de cada janela de estatísticas (ms).
+ */
+uint32_t controle_publicacao_janela_ms(void);
+
+/**
+ * @brief Quantos resumos de janela vão em cada mensagem.
+ */
+uint8_t controle_publicacao_lote(void);
+
+/**
+ * @brief Latência média do ACK (us), suavizada.
+ */
+uint32_t controle_publicacao_latencia_us(void);
+
+#endif
\ No newline at end of file
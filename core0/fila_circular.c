@@ -4,15 +4,17 @@
  */
 
 #include "core0/fila_circular.h"
+#include "shared/secao_ram.h" // Para FUNC_RAM_NUCLEO0
 
 void fila_intercore_inicializar(FilaCircularInterCore *f) {
     f->frente = 0;
     f->tras = -1;
     f->tamanho = 0;
+    f->tamanho_max = 0;
     mutex_init(&f->mutex_fila);
 }
 
-bool fila_intercore_inserir(FilaCircularInterCore *f, MensagemInterCore m) {
+bool FUNC_RAM_NUCLEO0(fila_intercore_inserir)(FilaCircularInterCore *f, MensagemInterCore m) {
     bool sucesso = false;
     mutex_enter_blocking(&f->mutex_fila);
 
@@ -20,6 +22,7 @@ bool fila_intercore_inserir(FilaCircularInterCore *f, MensagemInterCore m) {
         f->tras = (f->tras + 1) % TAM_FILA;
         f->fila[f->tras] = m;
         f->tamanho++;
+        if (f->tamanho > f->tamanho_max) f->tamanho_max = f->tamanho;
         sucesso = true;
     }
 
@@ -27,7 +30,7 @@ bool fila_intercore_inserir(FilaCircularInterCore *f, MensagemInterCore m) {
     return sucesso;
 }
 
-bool fila_intercore_remover(FilaCircularInterCore *f, MensagemInterCore *saida) {
+bool FUNC_RAM_NUCLEO0(fila_intercore_remover)(FilaCircularInterCore *f, MensagemInterCore *saida) {
     bool sucesso = false;
     mutex_enter_blocking(&f->mutex_fila);
 
@@ -42,7 +45,7 @@ bool fila_intercore_remover(FilaCircularInterCore *f, MensagemInterCore *saida)
     return sucesso;
 }
 
-bool fila_intercore_vazia(FilaCircularInterCore *f) {
+bool FUNC_RAM_NUCLEO0(fila_intercore_vazia)(FilaCircularInterCore *f) {
     mutex_enter_blocking(&f->mutex_fila); // Proteger leitura do tamanho
     bool vazia = (f->tamanho == 0);
     mutex_exit(&f->mutex_fila);
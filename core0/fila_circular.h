@@ -18,6 +18,7 @@ typedef struct {
     int frente;
     int tras;
     int tamanho;
+    int tamanho_max;    // Maior profundidade já atingida (métricas)
     mutex_t mutex_fila; // Renomeado para evitar conflito com outros mutexes
 } FilaCircularInterCore;
 
@@ -0,0 +1,45 @@
+/**
+ * @file janela_transmissao.c
+ * @brief Janelas de transmissão alinhadas ao boot (ver janela_transmissao.h).
+ */
+
+#include "core0/janela_transmissao.h"
+#include "config/config_geral.h" // Para MODO_ENERGIA e JANELA_TX_*
+#include "shared/metricas.h"
+#include "pico/time.h"
+
+bool janela_tx_aberta(void) {
+#if MODO_ENERGIA == MODO_ENERGIA_ECONOMIA
+    return to_ms_since_boot(get_absolute_time()) % JANELA_TX_PERIODO_MS < JANELA_TX_DURACAO_MS;
+#else
+    return true;
+#endif
+}
+
+uint32_t janela_tx_espera_ms(void) {
+#if MODO_ENERGIA == MODO_ENERGIA_ECONOMIA
+    uint32_t fase_ms = to_ms_since_boot(get_absolute_time()) % JANELA_TX_PERIODO_MS;
+    return fase_ms < JANELA_TX_DURACAO_MS ? 0 : JANELA_TX_PERIODO_MS - fase_ms;
+#else
+    return 0;
+#endif
+}
+
+void janela_tx_registrar_envio(uint32_t pronto_ms) {
+#if MODO_ENERGIA == MODO_ENERGIA_ECONOMIA
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    // Pronta dentro desta mesma janela: saiu sem esperar
+    bool mesma_janela = pronto_ms / JANELA_TX_PERIODO_MS == agora_ms / JANELA_TX_PERIODO_MS &&
+                        pronto_ms % JANELA_TX_PERIODO_MS < JANELA_TX_DURACAO_MS;
+    if (mesma_janela || agora_ms < pronto_ms) return;
+    metricas_incrementar(METRICA_JANELA_ADIADAS);
+    metricas_somar(METRICA_JANELA_ATRASO_MS, agora_ms - pronto_ms);
+    metricas_maximo(METRICA_JANELA_ATRASO_MAX_MS, agora_ms - pronto_ms);
+#else
+    (void)pronto_ms; // Janela sempre aberta: nada espera
+#endif
+}
+
+void janela_tx_registrar_fora(void) {
+    metricas_incrementar(METRICA_JANELA_FORA);
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef JANELA_TRANSMISSAO_H
+#define JANELA_TRANSMISSAO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file janela_transmissao.h
+ * @brief Janelas de transmissão alinhadas para o tráfego de saída do Núcleo 0.
+ *
+ * Em MODO_ENERGIA_ECONOMIA as publicações dos lotes, dos tópicos de estado,
+ * das métricas e das sondas só saem nos primeiros JANELA_TX_DURACAO_MS de cada
+ * JANELA_TX_PERIODO_MS (contados desde o boot): juntas, acordam o rádio uma vez
+ * por período em vez de uma vez por fonte. O que fica pronto fora da janela
+ * espera a próxima; essa espera é a latência extra do modo, publicada em
+ * jd/ja/jx. Nos outros modos a janela está sempre aberta.
+ *
+ * Só o Núcleo 0 chama estas funções.
+ */
+
+/**
+ * @brief Informa se o tráfego de saída pode sair agora.
+ */
+bool janela_tx_aberta(void);
+
+/**
+ * @brief Tempo até a próxima abertura da janela, em ms (0 se ela está aberta).
+ */
+uint32_t janela_tx_espera_ms(void);
+
+/**
+ * @brief Registra a saída de uma publicação que ficou pronta em `pronto_ms`
+ * (to_ms_since_boot): se ela precisou esperar a janela, conta a espera.
+ */
+void janela_tx_registrar_envio(uint32_t pronto_ms);
+
+/**
+ * @brief Registra uma publicação que não pôde esperar a janela (buffer cheio).
+ */
+void janela_tx_registrar_fora(void);
+
+#endif
\ No newline at end of file
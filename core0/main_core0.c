@@ -8,7 +8,19 @@
  * - Receber mensagens do Núcleo 1 via FIFO (status Wi-Fi, IP, ACK MQTT).
  * - Processar e exibir essas mensagens no OLED e controlar LED RGB.
  * - Iniciar o cliente MQTT após receber um IP válido.
- * - Enviar periodicamente mensagens "PING" via MQTT.
+ * - Publicar periodicamente as leituras do ADC (aquisição por DMA) via MQTT, com
+ *   janela e lote ajustados pela latência do ACK e pela ocupação do buffer de saída.
+ * - Publicar por exceção o estado do Wi-Fi, a cor do LED e a temperatura.
+ * - Medir o RTT fim a fim pelo broker com a sonda de eco (p50/p99 no OLED).
+ * - Medir o próprio loop e publicar periodicamente as métricas de recursos.
+ * - Em MODO_ENERGIA_ECONOMIA, concentrar a saída nas janelas de transmissão.
+ * - Repassar ao executor a montagem dos lotes e, na pausa do loop, executar os
+ *   trabalhos do Núcleo 1.
+ *
+ * O trabalho periódico (janelas de sensores, lote na janela de transmissão,
+ * métricas, sonda, fim dos avisos no OLED) são temporizadores do agendador
+ * (core0/temporizador.h); o loop dorme até o prazo mais próximo ou até um
+ * evento: mensagem na FIFO ou na entrada MQTT, mudança na conexão, serial.
  */
 
 #include "config/config_geral.h"
@@ -16,22 +28,39 @@
 #include "core0/fila_circular.h"
 #include "core0/main_core0_utils.h" // Para util_tratar_mensagem_intercore, etc.
 #include "drivers/rgb_led/rgb_led_pwm.h"
+#include "drivers/rgb_led/rgb_led_animacao.h"
 #include "drivers/oled_ssd1306/oled_interface.h" // Para oled_setup_interface, etc.
 #include "drivers/oled_ssd1306/oled_driver.h" // para ssd1306_draw_utf8_string especificamente
 #include "core1/main_core1.h"           // Para declaração de main_core1_entry
-#include "core1/mqtt_client_core1.h"    // Para iniciar_cliente_mqtt, publicar_mensagem_mqtt
+#include "core1/mqtt_client_core1.h"    // Para iniciar_cliente_mqtt e a tabela de tópicos
 #include "pico/multicore.h"
 #include "lwip/ip_addr.h" // Para ip4_addr_t (usado em tratar_ip_recebido)
+#include "shared/rastreio.h" // Para instrumentação dos trechos críticos
+#include "shared/metricas.h" // Para o registro de métricas de recursos
+#include "shared/secao_ram.h" // Para FUNC_RAM_NUCLEO0 no caminho da FIFO
+#include "shared/perfil_clock.h" // Para perfil_clock_aplicar
+#include "drivers/adc/aquisicao_adc.h" // Para as leituras publicadas
+#include "core0/controle_publicacao.h" // Para a janela e o lote das publicações
+#include "core0/sonda_rtt.h" // Para a sonda de latência fim a fim
+#include "core1/entrada_mqtt.h" // Para o despacho das mensagens recebidas
+#include "core1/energia_radio.h" // Para a fração ativa do rádio nas métricas
+#include "core0/janela_transmissao.h" // Para as janelas de transmissão
+#include "shared/executor.h" // Para os trabalhos entre os núcleos
+#include "core0/temporizador.h" // Para o trabalho periódico e o sono do loop
+#include <string.h> // Para memcpy no lote de sensores
 
-// --- NOVAS INCLUSÕES ---
-#include <stdlib.h>      // Para rand() e srand()
-#include "pico/rand.h"   // Para get_rand_32(), uma boa semente no Pico
-// --- FIM DAS NOVAS INCLUSÕES ---
 
 
 // Fila para mensagens recebidas do núcleo 1
 static FilaCircularInterCore fila_mensagens_core1;
-static absolute_time_t proximo_envio_ping;
+
+// Resumos de janela aguardando envio, um por linha (controle_publicacao decide quantos)
+static char lote_sensores[CONTROLE_LOTE_MAX * SENSORES_TAM_RESUMO];
+static size_t tamanho_lote_sensores = 0;
+static uint8_t resumos_no_lote = 0;
+static bool lote_completo = false;  // Atingiu o tamanho do controle; sai na próxima janela de transmissão
+static uint32_t lote_pronto_ms = 0;
+static absolute_time_t proxima_publicacao_metricas; // Prazo nominal: a janela de transmissão pode atrasar o envio
 
 // Protótipos de funções locais
 static void inicializar_perifericos_core0();
@@ -39,20 +68,52 @@ static void iniciar_nucleo1();
 static void verificar_fifo_do_core1();
 static void processar_fila_mensagens();
 static void tentar_inicializar_mqtt();
-static void enviar_ping_mqtt_periodicamente();
+static void enviar_lote_sensores();
+static void lote_sensores_publicado(bool enfileirada);
+static void enviar_lote_na_janela();
+static void fechar_janela_sensores(Temporizador *t);
+static void disparar_lote_na_janela(Temporizador *t);
+static void publicar_metricas(Temporizador *t);
+static void executar_sonda(Temporizador *t);
+static void limpar_aviso_oled(Temporizador *t);
+static void acordar_loop(Temporizador *t);
+static void exibir_aviso_oled(const char *mensagem);
+static bool ha_evento_pendente(void);
+static void serial_disponivel(void *param);
+
+// Trabalho periódico do loop (core0/temporizador.h)
+static Temporizador temporizador_sensores = {.disparar = fechar_janela_sensores};
+static Temporizador temporizador_lote = {.disparar = disparar_lote_na_janela};
+static Temporizador temporizador_metricas = {.disparar = publicar_metricas};
+static Temporizador temporizador_sonda = {.disparar = executar_sonda};
+static Temporizador temporizador_aviso = {.disparar = limpar_aviso_oled};
+static uint32_t quadro_aviso = 0; // oled_quadros_enviados() logo após desenhar o aviso
+// Só acordam o loop, que chama loop_mqtt e publicar_topicos_pendentes a cada iteração
+static Temporizador temporizador_mqtt = {.disparar = acordar_loop};
+static Temporizador temporizador_topicos = {.disparar = acordar_loop};
 
 int main() {
+    metricas_inicializar(); // Antes de tudo: pinta as pilhas para a marca d'água
     inicializar_perifericos_core0();
     iniciar_nucleo1();
 
-    oled_exibir_mensagem_temporaria("Sistema Ativado!\nAguardando WiFi...", 0);
+    exibir_aviso_oled("Sistema Ativado!\nAguardando WiFi...");
 
     while (true) {
+        RASTREIO_INSTANTE(RASTREIO_ID_LOOP_CORE0);
+        uint32_t inicio_iteracao_us = time_us_32();
+        util_processar_comando_serial();
         verificar_fifo_do_core1();
+        entrada_mqtt_despachar(); // Mensagens assinadas já remontadas pelo lwIP
         processar_fila_mensagens();
         tentar_inicializar_mqtt();
-        enviar_ping_mqtt_periodicamente();
-        sleep_ms(50); // Pequena pausa para não sobrecarregar o loop
+        // Reconexão e failover entre brokers; o prazo devolvido só acorda o loop
+        if (mqtt_iniciado) temporizador_agendar(&temporizador_mqtt, loop_mqtt());
+        temporizador_processar(); // Sensores, lote, métricas, sonda e avisos vencidos
+        // Mudanças adiadas e batimentos dos tópicos de estado
+        if (mqtt_iniciado) temporizador_agendar(&temporizador_topicos, publicar_topicos_pendentes());
+        metricas_registrar_loop(time_us_32() - inicio_iteracao_us); // Só o trabalho, sem a pausa
+        temporizador_dormir(ha_evento_pendente); // Até o próximo prazo ou evento, ajudando o executor
     }
     return 0; // Nunca alcançado
 }
@@ -61,18 +122,25 @@ int main() {
  * @brief Inicializa os periféricos controlados pelo Núcleo 0.
  */
 static void inicializar_perifericos_core0() {
+    perfil_clock_aplicar(); // Antes dos periféricos, que calculam seus divisores a partir do clk_sys
     stdio_init_all(); // Inicializa stdio (USB e/ou UART)
     util_espera_usb_serial(); // Aguarda conexão serial USB
 
     oled_setup_interface(); // Configura I2C e OLED
     init_rgb_pwm();         // Configura PWM para o LED RGB
-    set_rgb_pwm(PWM_STEP, 0, PWM_STEP); // LED Roxo indicando inicialização
+    anim_led_inicializar(); // Canais de DMA e IRQ de wrap para as animações do LED
+    anim_led_cor(255, 0, 255); // LED Roxo indicando inicialização
+    aquisicao_adc_inicializar(); // ADC contínuo por DMA; a CPU só entra a cada bloco
 
     fila_intercore_inicializar(&fila_mensagens_core1);
-
-    // --- SEMEAR O GERADOR DE NÚMEROS ALEATÓRIOS ---
-    srand(get_rand_32()); // Usa o gerador de hardware do RP2040 como semente
-    // --- FIM DA SEMEADURA ---
+    metricas_registrar_fila(&fila_mensagens_core1);
+#if !REDE_POLL
+    metricas_registrar_atualizacao(energia_radio_atualizar_metricas); // Com REDE_POLL, o Núcleo 1 atualiza
+#endif
+    metricas_registrar_atualizacao(executor_atualizar_metricas);
+    metricas_registrar_atualizacao(temporizador_atualizar_metricas);
+    stdio_set_chars_available_callback(serial_disponivel, NULL); // Comandos acordam o loop
+    executor_inicializar(); // Antes do Núcleo 1, que já entra no executor
 
     printf("Núcleo 0: Periféricos inicializados.\n");
     oled_clear_global_buffer();
@@ -97,7 +165,8 @@ static void iniciar_nucleo1() {
 /**
  * @brief Verifica se há dados na FIFO enviados pelo Núcleo 1 e os processa.
  */
-static void verificar_fifo_do_core1() {
+static void FUNC_RAM_NUCLEO0(verificar_fifo_do_core1)() {
+    RASTREIO_INICIO(RASTREIO_ID_VERIFICAR_FIFO);
     if (multicore_fifo_rvalid()) { // Há dados para ler?
         uint32_t pacote_fifo = multicore_fifo_pop_blocking();
         
@@ -108,6 +177,8 @@ static void verificar_fifo_do_core1() {
             // Se é um IP, o próximo item na FIFO é o próprio IP
             uint32_t ip_bin = multicore_fifo_pop_blocking();
             util_tratar_ip_recebido(ip_bin);
+        } else if (tipo_ou_tentativa == FIFO_TIPO_TRABALHO) {
+            executor_campainha(); // Trabalhos deste núcleo executados pelo Núcleo 1
         } else {
             // Caso contrário, é uma mensagem de status (Wi-Fi ou MQTT ACK)
             MensagemInterCore msg;
@@ -116,19 +187,25 @@ static void verificar_fifo_do_core1() {
 
             if (!fila_intercore_inserir(&fila_mensagens_core1, msg)) {
                 printf("[CORE0] ERRO: Fila de mensagens do Core1 cheia! Mensagem descartada.\n");
-                oled_exibir_mensagem_temporaria("Core0: Fila FIFO cheia!", 0);
+                metricas_incrementar(METRICA_FILA_DESCARTES);
+                exibir_aviso_oled("Core0: Fila FIFO cheia!");
             }
         }
     }
+    RASTREIO_FIM(RASTREIO_ID_VERIFICAR_FIFO);
 }
 
 /**
  * @brief Processa mensagens da fila interna que foram recebidas do Núcleo 1.
  */
-static void processar_fila_mensagens() {
+static void FUNC_RAM_NUCLEO0(processar_fila_mensagens)() {
     MensagemInterCore msg_recebida;
     if (fila_intercore_remover(&fila_mensagens_core1, &msg_recebida)) {
         util_tratar_mensagem_intercore(msg_recebida);
+        if (msg_recebida.tentativa_ou_tipo != FIFO_TIPO_MQTT_PUB_ACK) {
+            // Status repetidos do Núcleo 1 são filtrados pela tabela de tópicos
+            publicar_valor_topico(TOPICO_ID_ESTADO_WIFI, msg_recebida.status_ou_dado);
+        }
     }
 }
 
@@ -141,34 +218,242 @@ static void tentar_inicializar_mqtt() {
         util_exibir_status_mqtt_oled("Iniciando..."); // Mostra no OLED
         iniciar_cliente_mqtt(); // Função do módulo mqtt_client_core1.c
         mqtt_iniciado = true;   // Marca como iniciado (variável de estado_compartilhado.c)
-        proximo_envio_ping = make_timeout_time_ms(INTERVALO_PING_MS); // Prepara para o primeiro PING
+        controle_publicacao_inicializar();
+        temporizador_agendar(&temporizador_sensores, controle_publicacao_janela_ms()); // Fecha a primeira janela
+        if (METRICAS_INTERVALO_MS != 0) {
+            proxima_publicacao_metricas = make_timeout_time_ms(METRICAS_INTERVALO_MS);
+            temporizador_agendar_em(&temporizador_metricas, to_us_since_boot(proxima_publicacao_metricas));
+        }
+#if SONDA_RTT_HABILITADA
+        sonda_rtt_inicializar();
+        temporizador_agendar(&temporizador_sonda, 0);
+#endif
     }
 }
 
 /**
- * @brief Envia uma mensagem "PING" via MQTT em intervalos regulares.
+ * @brief Envia o lote acumulado de resumos no TOPICO_SENSORES e atualiza o OLED
+ * com a temperatura atual. O ACK segue o mesmo caminho do antigo PING (LED e
+ * OLED) e alimenta o controle de publicação.
+ *
+ * A montagem do payload (cabeçalho e compressão) é um trabalho do executor: o
+ * lote só pode ser alterado depois de lote_sensores_publicado, por isso quem
+ * escreve nele chama publicacao_assincrona_aguardar antes.
  */
-static void enviar_ping_mqtt_periodicamente() {
-    if (mqtt_iniciado && absolute_time_diff_us(get_absolute_time(), proximo_envio_ping) <= 0) {
-        printf("[CORE0] Enviando PING MQTT...\n");
-        
-        oled_clear_global_buffer(); // Limpa para nova mensagem
-        // Re-exibe IP se já tivermos
-        if (ultimo_ip_bin != 0) {
-            char ip_str_temp[20];
-            char linha_oled_ip[30];
-            ip4addr_ntoa_r((const ip4_addr_t*)&ultimo_ip_bin, ip_str_temp, sizeof(ip_str_temp));
-            snprintf(linha_oled_ip, sizeof(linha_oled_ip), "%s", ip_str_temp);
-            ssd1306_draw_utf8_string(buffer_oled, 0, 16, linha_oled_ip);
-        }
-        // Exibe status do MQTT
-        char linha_oled_mqtt_status[40];
-        snprintf(linha_oled_mqtt_status, sizeof(linha_oled_mqtt_status), "\nMQTT: Ping...");
-        ssd1306_draw_utf8_string(buffer_oled, 0, 32, linha_oled_mqtt_status);
-        oled_render_global_buffer();
+static void enviar_lote_sensores() {
+#if SENSORES_FORMATO_CBOR
+    printf("[CORE0] Publicando %u resumo(s) de sensores em CBOR (%u bytes)\n",
+           resumos_no_lote, (unsigned)tamanho_lote_sensores);
+#else
+    printf("[CORE0] Publicando %u resumo(s) de sensores:\n%s\n", resumos_no_lote, lote_sensores);
+#endif
 
-        publicar_mensagem_mqtt("PING"); // Função do módulo mqtt_client_core1.c
-        
-        proximo_envio_ping = make_timeout_time_ms(INTERVALO_PING_MS); // Agenda o próximo PING
+    LeituraSensores leitura;
+    aquisicao_adc_ler(&leitura);
+    oled_clear_global_buffer(); // Limpa para nova mensagem
+    // Re-exibe IP se já tivermos
+    if (ultimo_ip_bin != 0) {
+        char ip_str_temp[20];
+        char linha_oled_ip[30];
+        ip4addr_ntoa_r((const ip4_addr_t*)&ultimo_ip_bin, ip_str_temp, sizeof(ip_str_temp));
+        snprintf(linha_oled_ip, sizeof(linha_oled_ip), "%s", ip_str_temp);
+        ssd1306_draw_utf8_string(buffer_oled, 0, 16, linha_oled_ip);
+    }
+    // Exibe status do MQTT
+    char linha_oled_mqtt_status[40];
+    int32_t graus_dec = leitura.temperatura_mc / 100; // Décimos de °C
+    int32_t modulo_dec = graus_dec < 0 ? -graus_dec : graus_dec;
+    snprintf(linha_oled_mqtt_status, sizeof(linha_oled_mqtt_status), "\nTemp: %s%ld.%ld C",
+             graus_dec < 0 ? "-" : "", (long)(modulo_dec / 10), (long)(modulo_dec % 10));
+    ssd1306_draw_utf8_string(buffer_oled, 0, 32, linha_oled_mqtt_status);
+#if SONDA_RTT_HABILITADA
+    uint32_t rtt_p50_us, rtt_p99_us;
+    char linha_oled_rtt[24];
+    if (sonda_rtt_quantis(&rtt_p50_us, &rtt_p99_us)) {
+        snprintf(linha_oled_rtt, sizeof(linha_oled_rtt), "RTT %lu/%lu ms",
+                 (unsigned long)(rtt_p50_us / 1000), (unsigned long)(rtt_p99_us / 1000));
+    } else {
+        snprintf(linha_oled_rtt, sizeof(linha_oled_rtt), "RTT --");
+    }
+    ssd1306_draw_utf8_string(buffer_oled, 0, 48, linha_oled_rtt);
+#endif
+    oled_render_global_buffer();
+
+    if (!janela_tx_aberta()) {
+        janela_tx_registrar_fora(); // O próximo resumo não caberia: não dá para esperar a janela
+    } else if (lote_completo) {
+        janela_tx_registrar_envio(lote_pronto_ms);
+    }
+    lote_completo = false;
+    temporizador_cancelar(&temporizador_lote);
+
+    controle_publicacao_registrar_envio(mqtt_ocupacao_saida_permil());
+    // Em texto o lote é a string, sem o terminador
+    if (publicar_topico_binario_assincrono(TOPICO_ID_SENSORES, lote_sensores, (uint16_t)tamanho_lote_sensores,
+                                           lote_sensores_publicado)) {
+        return;
+    }
+    // Outra publicação assíncrona em curso: espera por ela e tenta de novo; se
+    // ainda assim não der, o lote é tratado como recusado e esvaziado
+    publicacao_assincrona_aguardar();
+    if (!publicar_topico_binario_assincrono(TOPICO_ID_SENSORES, lote_sensores, (uint16_t)tamanho_lote_sensores,
+                                            lote_sensores_publicado)) {
+        lote_sensores_publicado(false);
+    }
+}
+
+/**
+ * @brief Conclusão da publicação do lote (neste núcleo): esvazia o lote.
+ */
+static void lote_sensores_publicado(bool enfileirada) {
+    if (!enfileirada) {
+        // Sem ACK a caminho: trata a falha localmente, como um ACK de falha
+        MensagemInterCore falha = {FIFO_TIPO_MQTT_PUB_ACK, 1};
+        util_tratar_mensagem_intercore(falha);
+    }
+    tamanho_lote_sensores = 0;
+    resumos_no_lote = 0;
+}
+
+/**
+ * @brief Envia o lote completo se a janela de transmissão estiver aberta; senão
+ * ele continua acumulando resumos e temporizador_lote o envia quando ela abrir.
+ */
+static void enviar_lote_na_janela() {
+    if (!lote_completo) return;
+    if (janela_tx_aberta()) enviar_lote_sensores();
+    else temporizador_agendar(&temporizador_lote, janela_tx_espera_ms());
+}
+
+static void disparar_lote_na_janela(Temporizador *t) {
+    (void)t;
+    enviar_lote_na_janela();
+}
+
+/**
+ * @brief Fecha a janela de estatísticas do ADC ao fim de cada janela do controle
+ * de publicação e acrescenta o resumo ao lote (em vez dos pontos individuais). O
+ * lote é enviado ao atingir o tamanho pedido pelo controle ou quando o próximo
+ * resumo não caberia no buffer de saída do MQTT. Completo, o lote espera a
+ * janela de transmissão (janela_transmissao.h).
+ *
+ * Em CBOR cada resumo é um item escrito direto no lote, que vira uma sequência
+ * de itens (RFC 8742); em texto, uma linha por janela.
+ *
+ * Disparo de temporizador_sensores, reagendado a cada janela.
+ */
+static void fechar_janela_sensores(Temporizador *t) {
+    publicacao_assincrona_aguardar(); // O lote anterior pode ainda estar sendo montado
+    uint32_t janela_ms = controle_publicacao_janela_ms();
+    static ResumoSensores resumo; // ~250 bytes: fora da pilha de 2 KB do Núcleo 0
+    aquisicao_adc_resumir_janela(&resumo);
+
+    size_t limite = mqtt_payload_maximo(TOPICO_ID_SENSORES);
+    if (limite > sizeof(lote_sensores) - 1) limite = sizeof(lote_sensores) - 1;
+#if SENSORES_FORMATO_CBOR
+    CodificadorCbor c;
+    cbor_iniciar(&c, (uint8_t *)lote_sensores + tamanho_lote_sensores, limite - tamanho_lote_sensores);
+    aquisicao_adc_codificar_resumo(&resumo, janela_ms, &c);
+    if (c.estouro && resumos_no_lote > 0) {
+        enviar_lote_sensores();
+        publicacao_assincrona_aguardar();
+        cbor_iniciar(&c, (uint8_t *)lote_sensores, limite);
+        aquisicao_adc_codificar_resumo(&resumo, janela_ms, &c);
+    }
+    if (!c.estouro) {
+        tamanho_lote_sensores += c.tamanho;
+        resumos_no_lote++;
+    }
+#else
+    char linha[SENSORES_TAM_RESUMO];
+    int n = snprintf(linha, sizeof(linha), "janela_ms=%lu,", (unsigned long)janela_ms);
+    aquisicao_adc_formatar_resumo(&resumo, linha + n, sizeof(linha) - n);
+
+    size_t tamanho_linha = strlen(linha);
+    if (resumos_no_lote > 0 && tamanho_lote_sensores + 1 + tamanho_linha > limite) {
+        enviar_lote_sensores();
+        publicacao_assincrona_aguardar();
+    }
+    if (resumos_no_lote > 0) lote_sensores[tamanho_lote_sensores++] = '\n';
+    memcpy(lote_sensores + tamanho_lote_sensores, linha, tamanho_linha + 1);
+    tamanho_lote_sensores += tamanho_linha;
+    resumos_no_lote++;
+#endif
+    if (resumos_no_lote >= controle_publicacao_lote() && !lote_completo) {
+        lote_completo = true;
+        lote_pronto_ms = to_ms_since_boot(get_absolute_time());
+    }
+    enviar_lote_na_janela();
+
+    // Temperatura filtrada, no seu tópico só quando sair da zona morta
+    LeituraSensores leitura;
+    aquisicao_adc_ler(&leitura);
+    publicar_valor_topico(TOPICO_ID_TEMPERATURA, leitura.temperatura_mc);
+
+    temporizador_repetir(t, controle_publicacao_janela_ms()); // Fecha a próxima janela
+}
+
+/**
+ * @brief Publica o retrato das métricas de recursos no TOPICO_METRICAS a cada
+ * METRICAS_INTERVALO_MS, na janela de transmissão. O resultado da publicação
+ * não altera LED nem OLED. Disparo de temporizador_metricas.
+ */
+static void publicar_metricas(Temporizador *t) {
+    if (!janela_tx_aberta()) {
+        temporizador_agendar(t, janela_tx_espera_ms());
+        return;
     }
+    janela_tx_registrar_envio(to_ms_since_boot(proxima_publicacao_metricas)); // Antes do retrato, que já inclui a espera
+    static char retrato[METRICAS_TAM_RETRATO]; // Fora da pilha de 2 KB do Núcleo 0
+    metricas_formatar(retrato, sizeof(retrato));
+    publicar_topico(TOPICO_ID_METRICAS, retrato);
+
+    // Período contado do prazo nominal, não do envio atrasado pela janela
+    proxima_publicacao_metricas = delayed_by_ms(proxima_publicacao_metricas, METRICAS_INTERVALO_MS);
+    if (time_reached(proxima_publicacao_metricas)) proxima_publicacao_metricas = make_timeout_time_ms(METRICAS_INTERVALO_MS);
+    temporizador_agendar_em(t, to_us_since_boot(proxima_publicacao_metricas));
+}
+
+static void executar_sonda(Temporizador *t) {
+    temporizador_agendar(t, sonda_rtt_executar());
+}
+
+/**
+ * @brief Exibe um aviso no OLED e agenda a limpeza para daqui a TEMPO_MENSAGEM,
+ * sem parar o loop.
+ */
+static void exibir_aviso_oled(const char *mensagem) {
+    oled_exibir_mensagem(mensagem, 0);
+    quadro_aviso = oled_quadros_enviados();
+    temporizador_agendar(&temporizador_aviso, TEMPO_MENSAGEM);
+}
+
+/**
+ * @brief Apaga o aviso, se ele ainda estiver na tela: uma tela desenhada depois
+ * dele (Wi-Fi, IP, temperatura...) cancela a limpeza.
+ */
+static void limpar_aviso_oled(Temporizador *t) {
+    (void)t;
+    if (oled_quadros_enviados() != quadro_aviso) return;
+    oled_clear_global_buffer();
+    oled_render_global_buffer();
+}
+
+static void acordar_loop(Temporizador *t) {
+    (void)t; // O disparo já acordou o loop, que faz o trabalho na iteração
+}
+
+/**
+ * @brief Há mensagens do Núcleo 1 ainda não tratadas: o loop não dorme.
+ */
+static bool ha_evento_pendente(void) {
+    return multicore_fifo_rvalid() || !fila_intercore_vazia(&fila_mensagens_core1);
+}
+
+/**
+ * @brief Caracteres na serial (no IRQ do USB): acorda o loop para os comandos.
+ */
+static void serial_disponivel(void *param) {
+    (void)param;
+    temporizador_sinalizar();
 }
\ No newline at end of file
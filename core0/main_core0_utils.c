@@ -8,11 +8,17 @@
 #include "config/config_geral.h"
 #include "shared/estado_compartilhado.h"
 #include "drivers/rgb_led/rgb_led_pwm.h"
+#include "drivers/rgb_led/rgb_led_animacao.h"
 #include "drivers/oled_ssd1306/oled_interface.h" 
 #include "drivers/oled_ssd1306/oled_driver.h"    
 #include <stdio.h> 
-#include <stdlib.h> // Para rand() 
+#include "pico/rand.h" // Para get_rand_32 (o rand() da newlib-nano aloca seu estado no heap)
 #include "lwip/ip_addr.h" // Para ip4addr_ntoa_r
+#include "shared/rastreio.h" // Para RASTREIO_* e rastreio_despejar
+#include "shared/metricas.h" // Para metricas_formatar
+#include "core0/benchmark_core0.h" // Para benchmark_core0_executar
+#include "core0/controle_publicacao.h" // Para o resultado das publicações de sensores
+#include "core1/mqtt_client_core1.h" // Para publicar a cor do LED por exceção
 
 /**
  * @brief Aguarda até que a conexão USB (console serial) esteja pronta.
@@ -28,11 +34,13 @@ void util_espera_usb_serial() {
  * @brief Trata uma mensagem recebida do núcleo 1.
  */
 void util_tratar_mensagem_intercore(MensagemInterCore msg) {
+    RASTREIO_INICIO(RASTREIO_ID_TRATAR_MENSAGEM);
     const char *descricao_status_wifi = "";
     char linha_oled[40]; 
 
     // Verifica se é uma confirmação de publicação MQTT (PING ACK)
     if (msg.tentativa_ou_tipo == FIFO_TIPO_MQTT_PUB_ACK) {
+        controle_publicacao_registrar_resultado(msg.status_ou_dado == 0);
         oled_clear_global_buffer(); 
         // Re-exibe IP se já tivermos, para não ser apagado pela msg de ACK PING
         if (ultimo_ip_bin != 0) {
@@ -46,20 +54,20 @@ void util_tratar_mensagem_intercore(MensagemInterCore msg) {
         }
         
         if (msg.status_ou_dado == 0) { // 0 = Sucesso
-            snprintf(linha_oled, sizeof(linha_oled), "ACK do PING: OK");
+            snprintf(linha_oled, sizeof(linha_oled), "ACK lwIP: OK"); // Só o envio ao TCP; o RTT real vem da sonda
             ssd1306_draw_utf8_string(buffer_oled, 0, 32, linha_oled); // Posição para status do PING
             
             // --- GERAR E APLICAR COR ALEATÓRIA ---
-            uint16_t r_aleatorio = rand() % (PWM_STEP + 1); // Gera valor entre 0 e PWM_STEP
-            uint16_t g_aleatorio = rand() % (PWM_STEP + 1);
-            uint16_t b_aleatorio = rand() % (PWM_STEP + 1);
+            uint16_t r_aleatorio = get_rand_32() % (PWM_STEP + 1); // Gera valor entre 0 e PWM_STEP
+            uint16_t g_aleatorio = get_rand_32() % (PWM_STEP + 1);
+            uint16_t b_aleatorio = get_rand_32() % (PWM_STEP + 1);
 
             // Opcional: garantir que a cor não seja muito escura/apagada
             if (r_aleatorio < (PWM_STEP / 4) && g_aleatorio < (PWM_STEP / 4) && b_aleatorio < (PWM_STEP / 4)) {
-                int canal_brilhante = rand() % 3;
-                if (canal_brilhante == 0) r_aleatorio = (PWM_STEP / 2) + (rand() % (PWM_STEP / 2));
-                else if (canal_brilhante == 1) g_aleatorio = (PWM_STEP / 2) + (rand() % (PWM_STEP / 2));
-                else b_aleatorio = (PWM_STEP / 2) + (rand() % (PWM_STEP / 2));
+                int canal_brilhante = get_rand_32() % 3;
+                if (canal_brilhante == 0) r_aleatorio = (PWM_STEP / 2) + (get_rand_32() % (PWM_STEP / 2));
+                else if (canal_brilhante == 1) g_aleatorio = (PWM_STEP / 2) + (get_rand_32() % (PWM_STEP / 2));
+                else b_aleatorio = (PWM_STEP / 2) + (get_rand_32() % (PWM_STEP / 2));
 
                 if (r_aleatorio > PWM_STEP) r_aleatorio = PWM_STEP;
                 if (g_aleatorio > PWM_STEP) g_aleatorio = PWM_STEP;
@@ -67,15 +75,19 @@ void util_tratar_mensagem_intercore(MensagemInterCore msg) {
             }
             
             printf("[CORE0] ACK PING OK. Nova cor RGB: R=%u, G=%u, B=%u\n", r_aleatorio, g_aleatorio, b_aleatorio);
-            set_rgb_pwm(r_aleatorio, g_aleatorio, b_aleatorio); 
+            // Transição suave feita pelo hardware (8 bits mais significativos, com correção gama)
+            anim_led_transicionar(r_aleatorio >> 8, g_aleatorio >> 8, b_aleatorio >> 8, ANIM_LED_FADE_ACK_MS);
+            publicar_valor_topico(TOPICO_ID_COR_LED,
+                                  ((int32_t)(r_aleatorio >> 8) << 16) | ((g_aleatorio >> 8) << 8) | (b_aleatorio >> 8));
             // --- FIM DA LÓGICA DE COR ALEATÓRIA ---
 
         } else { // Outro valor = Falha
-            snprintf(linha_oled, sizeof(linha_oled), "ACK do PING: FALHOU");
+            snprintf(linha_oled, sizeof(linha_oled), "ACK lwIP: FALHOU");
             ssd1306_draw_utf8_string(buffer_oled, 0, 32, linha_oled);
-            set_rgb_pwm(PWM_STEP, 0, 0); // LED Vermelho para ACK Falha
+            anim_led_cor(255, 0, 0); // LED Vermelho para ACK Falha
         }
         oled_render_global_buffer();
+        RASTREIO_FIM(RASTREIO_ID_TRATAR_MENSAGEM);
         return; // Importante para não sobrescrever a cor aleatória com a cor do status do WiFi
     }
 
@@ -83,23 +95,23 @@ void util_tratar_mensagem_intercore(MensagemInterCore msg) {
     switch (msg.status_ou_dado) {
         case 0: // CYW43_LINK_DOWN ou inicializando
             descricao_status_wifi = "WiFi: Tentando...";
-            set_rgb_pwm(PWM_STEP, PWM_STEP, 0); // LED Amarelo (Vermelho + Verde)
+            anim_led_executar(&ANIM_LED_WIFI_TENTANDO); // LED Amarelo piscando
             break;
         case 1: // CYW43_LINK_UP (Conectado)
             descricao_status_wifi = "WiFi: Conectado";
-            set_rgb_pwm(0, PWM_STEP, 0);      // LED Verde
+            anim_led_executar(&ANIM_LED_WIFI_CONECTADO); // LED Verde (acende suavemente)
             break;
         case 2: // CYW43_LINK_FAIL, CYW43_LINK_NONET, CYW43_LINK_BADAUTH
             descricao_status_wifi = "WiFi: Falha";
-            set_rgb_pwm(PWM_STEP, 0, 0);      // LED Vermelho
+            anim_led_executar(&ANIM_LED_WIFI_FALHA); // LED Vermelho piscando rápido
             break;
         case 3: // CYW43_LINK_CONNECTING (Status intermediário do cyw43)
             descricao_status_wifi = "WiFi: Conectando";
-            set_rgb_pwm(0, 0, PWM_STEP);      // LED Azul
+            anim_led_executar(&ANIM_LED_WIFI_CONECTANDO); // LED Azul "respirando"
             break;
         default:
             descricao_status_wifi = "WiFi: Desconhecido";
-            set_rgb_pwm(PWM_STEP, PWM_STEP, PWM_STEP); // LED Branco
+            anim_led_cor(255, 255, 255); // LED Branco
             break;
     }
 
@@ -123,6 +135,7 @@ void util_tratar_mensagem_intercore(MensagemInterCore msg) {
     oled_render_global_buffer();
     
     printf("[CORE0] Status Wi-Fi: %s (Tentativa: %u)\n", descricao_status_wifi, msg.tentativa_ou_tipo);
+    RASTREIO_FIM(RASTREIO_ID_TRATAR_MENSAGEM);
 }
 
 /**
@@ -167,4 +180,64 @@ void util_exibir_status_mqtt_oled(const char *texto) {
     oled_render_global_buffer();
 
     printf("[CORE0] Status MQTT: %s\n", texto);
+}
+
+/**
+ * @brief Lê (sem bloquear) um comando recebido pela serial USB e o executa.
+ */
+void util_processar_comando_serial() {
+    int comando;
+    // Todos os disponíveis: o aviso de caracteres na serial acorda o loop uma vez
+    while ((comando = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) util_executar_comando(comando);
+}
+
+// Comandos aceitos em TOPICO_COMANDO, que não tem autenticação: só os que apenas
+// leem o estado. O benchmark (troca o clock e prende o Núcleo 0) e o despejo do
+// rastreio ficam restritos à serial
+static const uint8_t comandos_mqtt_permitidos[] = {COMANDO_IMPRIMIR_METRICAS};
+
+static bool comando_mqtt_permitido(uint8_t comando) {
+    for (size_t i = 0; i < sizeof(comandos_mqtt_permitidos); i++) {
+        if (comandos_mqtt_permitidos[i] == comando) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Executa cada caractere do payload recebido em TOPICO_COMANDO que esteja
+ * em `comandos_mqtt_permitidos`; os demais são recusados.
+ */
+void util_tratar_comando_mqtt(const MensagemEntrada *mensagem) {
+    printf("[CORE0] Comando MQTT em '%s': %s\n", mensagem->topico, (const char *)mensagem->dados);
+    for (uint16_t i = 0; i < mensagem->tamanho; i++) {
+        if (comando_mqtt_permitido(mensagem->dados[i])) {
+            util_executar_comando(mensagem->dados[i]);
+        } else {
+            printf("[CORE0] Comando MQTT recusado: 0x%02X\n", mensagem->dados[i]);
+        }
+    }
+}
+
+/**
+ * @brief Executa um comando de um caractere, vindo da serial ou do MQTT.
+ */
+void util_executar_comando(int comando) {
+    switch (comando) {
+#if HABILITAR_RASTREIO
+        case COMANDO_DESPEJAR_RASTREIO:
+            rastreio_despejar();
+            break;
+#endif
+        case COMANDO_BENCHMARK:
+            benchmark_core0_executar();
+            break;
+        case COMANDO_IMPRIMIR_METRICAS: {
+            static char retrato[METRICAS_TAM_RETRATO]; // Fora da pilha de 2 KB do Núcleo 0
+            metricas_formatar(retrato, sizeof(retrato));
+            printf("#METRICAS %s\n", retrato);
+            break;
+        }
+        default:
+            break; // Comando desconhecido é ignorado
+    }
 }
\ No newline at end of file
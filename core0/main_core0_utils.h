@@ -3,10 +3,12 @@
 
 #include <stdint.h>
 #include "core0/fila_circular.h" // Para MensagemInterCore
+#include "core1/entrada_mqtt.h" // Para MensagemEntrada
 
 // Constantes para identificar tipos de mensagem na FIFO
 #define FIFO_TIPO_IP_ADDRESS 0xFFFE // Indica que o payload é um endereço IP
 #define FIFO_TIPO_MQTT_PUB_ACK 0x9999 // Indica que é um ACK de publicação MQTT
+#define FIFO_TIPO_TRABALHO 0xFFFD // Campainha do executor: há trabalhos do Núcleo 0 concluídos
 
 /**
  * @brief Aguarda até que a conexão USB (console serial) esteja pronta.
@@ -35,4 +37,24 @@ void util_tratar_ip_recebido(uint32_t ip_bin);
  */
 void util_exibir_status_mqtt_oled(const char *texto);
 
+/**
+ * @brief Lê (sem bloquear) os comandos de um caractere recebidos pela serial USB e os executa.
+ * Ex.: COMANDO_DESPEJAR_RASTREIO exporta o buffer de rastreio (se habilitado) e
+ * COMANDO_IMPRIMIR_METRICAS imprime o retrato atual das métricas; COMANDO_BENCHMARK
+ * roda o benchmark do Núcleo 0 (comparação entre perfis de clock).
+ */
+void util_processar_comando_serial();
+
+/**
+ * @brief Executa um comando de um caractere (os mesmos da serial); desconhecidos são ignorados.
+ */
+void util_executar_comando(int comando);
+
+/**
+ * @brief Manipulador de TOPICO_COMANDO na tabela de entrada do MQTT: executa
+ * no Núcleo 0 cada caractere do payload que esteja na lista de comandos
+ * permitidos remotamente (só leitura, ex.: COMANDO_IMPRIMIR_METRICAS).
+ */
+void util_tratar_comando_mqtt(const MensagemEntrada *mensagem);
+
 #endif
\ No newline at end of file
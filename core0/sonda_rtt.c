@@ -0,0 +1,118 @@
+/**
+ * @file sonda_rtt.c
+ * @brief Sonda de latência fim a fim pelo broker MQTT.
+ *
+ * O ACK do callback de publicação só diz que o lwIP entregou a mensagem ao TCP.
+ * Aqui cada sonda leva "seq:instante_us" em TOPICO_SONDA; um cliente de eco a
+ * devolve em TOPICO_SONDA_ECO, que chega pelo caminho de entrada do MQTT
+ * (core1/entrada_mqtt.h) com o instante de recepção no lwIP (o mesmo timer
+ * serve aos dois núcleos). O Núcleo 0 casa a sequência com as sondas
+ * pendentes, conta as perdidas por timeout e mantém o p50/p99 da janela em
+ * memória fixa (estatistica_fluxo), publicados nas métricas e mostrados no OLED.
+ */
+
+#include "core0/sonda_rtt.h"
+#include "config/config_geral.h"
+#include "core1/mqtt_client_core1.h" // Para publicar_topico
+#include "core0/janela_transmissao.h" // Para enviar só na janela de transmissão
+#include "shared/estatistica_fluxo.h"
+#include "shared/metricas.h"
+#include "pico/time.h"
+#include <stdio.h>
+#include <stdlib.h> // Para strtoul
+
+typedef struct {
+    uint16_t seq;
+    uint32_t enviada_ms;
+    bool ativa;
+} SondaPendente;
+
+static SondaPendente pendentes[SONDA_MAX_PENDENTES];
+static uint16_t proxima_seq = 0;
+static absolute_time_t proximo_envio;
+static absolute_time_t fim_janela;
+static EstatisticaFluxo rtt_janela; // ~170 bytes: estático, fora da pilha do Núcleo 0
+
+void sonda_rtt_inicializar(void) {
+    for (int i = 0; i < SONDA_MAX_PENDENTES; i++) pendentes[i].ativa = false;
+    estatistica_reiniciar(&rtt_janela);
+    proximo_envio = make_timeout_time_ms(SONDA_INTERVALO_MS);
+    fim_janela = make_timeout_time_ms(SONDA_JANELA_MS);
+}
+
+uint32_t sonda_rtt_executar(void) {
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    uint32_t espera_ms = SONDA_TIMEOUT_MS; // Uma sonda enviada agora vence nesse prazo
+    SondaPendente *livre = NULL;
+    for (int i = 0; i < SONDA_MAX_PENDENTES; i++) {
+        SondaPendente *p = &pendentes[i];
+        if (p->ativa && agora_ms - p->enviada_ms >= SONDA_TIMEOUT_MS) {
+            p->ativa = false;
+            metricas_incrementar(METRICA_SONDA_PERDIDAS);
+            printf("[SONDA] Sonda %u sem resposta em %u ms.\n", p->seq, SONDA_TIMEOUT_MS);
+        }
+        if (p->ativa && SONDA_TIMEOUT_MS - (agora_ms - p->enviada_ms) < espera_ms) {
+            espera_ms = SONDA_TIMEOUT_MS - (agora_ms - p->enviada_ms);
+        }
+        if (!p->ativa && !livre) livre = p;
+    }
+
+    int64_t ate_envio_us = absolute_time_diff_us(get_absolute_time(), proximo_envio);
+    if (ate_envio_us > 0) {
+        uint32_t ate_envio_ms = (uint32_t)((ate_envio_us + 999) / 1000);
+        return ate_envio_ms < espera_ms ? ate_envio_ms : espera_ms;
+    }
+    if (!janela_tx_aberta()) { // Com as demais publicações
+        uint32_t ate_janela_ms = janela_tx_espera_ms();
+        return ate_janela_ms < espera_ms ? ate_janela_ms : espera_ms;
+    }
+    proximo_envio = make_timeout_time_ms(SONDA_INTERVALO_MS);
+    if (SONDA_INTERVALO_MS < espera_ms) espera_ms = SONDA_INTERVALO_MS;
+    if (!livre || !mqtt_cliente_conectado()) return espera_ms;
+
+    char texto[24];
+    snprintf(texto, sizeof(texto), "%u:%lu", proxima_seq, (unsigned long)time_us_32());
+    if (publicar_topico(TOPICO_ID_SONDA, texto)) {
+        *livre = (SondaPendente){proxima_seq, agora_ms, true};
+        metricas_incrementar(METRICA_SONDA_ENVIADAS);
+    }
+    proxima_seq++;
+    return espera_ms;
+}
+
+/**
+ * @brief Registra a resposta da sonda `seq`, se ela ainda estiver pendente.
+ */
+static void registrar_resposta(uint16_t seq, uint32_t rtt_us) {
+    SondaPendente *p = NULL;
+    for (int i = 0; i < SONDA_MAX_PENDENTES && !p; i++) {
+        if (pendentes[i].ativa && pendentes[i].seq == seq) p = &pendentes[i];
+    }
+    if (!p) return;
+    p->ativa = false;
+    metricas_incrementar(METRICA_SONDA_RESPOSTAS);
+
+    if (time_reached(fim_janela)) {
+        estatistica_reiniciar(&rtt_janela);
+        fim_janela = make_timeout_time_ms(SONDA_JANELA_MS);
+    }
+    estatistica_adicionar(&rtt_janela, (int32_t)rtt_us);
+    metricas_definir(METRICA_SONDA_RTT_P50_US, (uint32_t)estatistica_quantil(&rtt_janela, 500));
+    metricas_definir(METRICA_SONDA_RTT_P99_US, (uint32_t)estatistica_quantil(&rtt_janela, 990));
+}
+
+void sonda_rtt_tratar_eco(const MensagemEntrada *mensagem) {
+    char *fim;
+    unsigned long seq = strtoul((const char *)mensagem->dados, &fim, 10);
+    if (*fim != ':') return;
+    unsigned long enviado_us = strtoul(fim + 1, &fim, 10);
+    if (*fim != '\0') return;
+    registrar_resposta((uint16_t)seq, mensagem->instante_us - (uint32_t)enviado_us);
+}
+
+bool sonda_rtt_quantis(uint32_t *p50_us, uint32_t *p99_us) {
+    if (rtt_janela.n == 0) return false;
+    *p50_us = (uint32_t)estatistica_quantil(&rtt_janela, 500);
+    *p99_us = (uint32_t)estatistica_quantil(&rtt_janela, 990);
+    return true;
+}
\ No newline at end of file
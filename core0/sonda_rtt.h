@@ -0,0 +1,39 @@
+#ifndef SONDA_RTT_H
+#define SONDA_RTT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "core1/entrada_mqtt.h" // Para MensagemEntrada
+
+/**
+ * @brief Reinicia as sondas pendentes e a janela do histograma de RTT.
+ */
+void sonda_rtt_inicializar(void);
+
+/**
+ * @brief Chamada a cada iteração do loop do Núcleo 0: conta como perdidas as
+ * sondas sem resposta em SONDA_TIMEOUT_MS e publica a próxima a cada
+ * SONDA_INTERVALO_MS, se houver conexão e a janela de transmissão estiver
+ * aberta (em MODO_ENERGIA_ECONOMIA o RTT inclui a espera do eco no AP).
+ *
+ * @return Tempo até o próximo envio ou prazo de resposta, em ms, para o agendador
+ * do Núcleo 0 (core0/temporizador.h).
+ */
+uint32_t sonda_rtt_executar(void);
+
+/**
+ * @brief Manipulador de TOPICO_SONDA_ECO na tabela de entrada do MQTT.
+ * O RTT vai da publicação ao instante em que o lwIP terminou de receber o eco,
+ * não ao despacho no Núcleo 0. Ecos de sondas já dadas como perdidas, repetidos,
+ * desconhecidos ou malformados são ignorados.
+ */
+void sonda_rtt_tratar_eco(const MensagemEntrada *mensagem);
+
+/**
+ * @brief Mediana e percentil 99 do RTT na janela atual.
+ *
+ * @return false se a janela ainda não tem respostas.
+ */
+bool sonda_rtt_quantis(uint32_t *p50_us, uint32_t *p99_us);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+/**
+ * @file temporizador.c
+ * @brief Roda de temporizadores do Núcleo 0 (ver temporizador.h).
+ *
+ * As posições são indexadas pelo tempo absoluto em resoluções (prazo_us /
+ * RESOLUCAO_US) módulo TEMPORIZADOR_NUM_POSICOES. temporizador_processar visita
+ * as posições desde a última visitada até a atual, inclusive, e a atual volta a
+ * ser visitada na chamada seguinte: um prazo ainda no futuro dentro dela não se
+ * perde, e o disparo não é arredondado para a resolução. O prazo mais próximo é
+ * procurado só ao dormir, numa varredura das poucas listas.
+ */
+
+#include "core0/temporizador.h"
+#include "config/config_geral.h" // Para TEMPORIZADOR_*
+#include "shared/executor.h" // Para dormir executando trabalhos
+#include "shared/metricas.h"
+#include "pico/time.h"
+#include "shared/secao_ram.h" // Para FUNC_RAM no sinal chamado pelos callbacks do lwIP
+#include "pico/platform.h" // Para __sev
+
+_Static_assert((TEMPORIZADOR_NUM_POSICOES & (TEMPORIZADOR_NUM_POSICOES - 1)) == 0,
+               "TEMPORIZADOR_NUM_POSICOES deve ser potência de 2");
+
+#define RESOLUCAO_US ((uint64_t)TEMPORIZADOR_RESOLUCAO_MS * 1000u)
+
+static Temporizador *posicoes[TEMPORIZADOR_NUM_POSICOES];
+static uint64_t proxima_visita = 0; // Em resoluções: posição de onde processar recomeça
+static volatile bool sinalizado = false;
+static bool (*acordar_loop)(void) = NULL;
+
+// Jitter: atraso de cada disparo em relação ao prazo
+static uint32_t disparos = 0;
+static uint64_t atraso_total_us = 0;
+static uint32_t atraso_max_us = 0;
+
+static void inserir(Temporizador *t) {
+    uint64_t resolucao = t->prazo_us / RESOLUCAO_US;
+    if (resolucao < proxima_visita) resolucao = proxima_visita; // Já vencido: na próxima visita
+    t->posicao = (uint8_t)(resolucao % TEMPORIZADOR_NUM_POSICOES);
+    t->anterior = NULL;
+    t->proximo = posicoes[t->posicao];
+    if (t->proximo) t->proximo->anterior = t;
+    posicoes[t->posicao] = t;
+    t->ativo = true;
+}
+
+void temporizador_cancelar(Temporizador *t) {
+    if (!t->ativo) return;
+    if (t->anterior) t->anterior->proximo = t->proximo;
+    else posicoes[t->posicao] = t->proximo;
+    if (t->proximo) t->proximo->anterior = t->anterior;
+    t->ativo = false;
+}
+
+void temporizador_agendar_em(Temporizador *t, uint64_t prazo_us) {
+    temporizador_cancelar(t);
+    t->prazo_us = prazo_us;
+    inserir(t);
+}
+
+void temporizador_agendar(Temporizador *t, uint32_t espera_ms) {
+    if (espera_ms == TEMPORIZADOR_SEM_PRAZO) {
+        temporizador_cancelar(t);
+        return;
+    }
+    temporizador_agendar_em(t, time_us_64() + (uint64_t)espera_ms * 1000u);
+}
+
+void temporizador_repetir(Temporizador *t, uint32_t periodo_ms) {
+    uint64_t agora_us = time_us_64();
+    uint64_t prazo_us = t->prazo_us + (uint64_t)periodo_ms * 1000u;
+    temporizador_agendar_em(t, prazo_us > agora_us ? prazo_us : agora_us + (uint64_t)periodo_ms * 1000u);
+}
+
+/**
+ * @brief Dispara os vencidos de uma posição. Depois de cada disparo a lista é
+ * percorrida de novo: o disparo pode ter agendado ou cancelado outros.
+ */
+static void processar_posicao(uint32_t indice, uint64_t agora_us) {
+    Temporizador *t = posicoes[indice];
+    while (t) {
+        if (t->prazo_us > agora_us) {
+            t = t->proximo;
+            continue;
+        }
+        temporizador_cancelar(t);
+        uint32_t atraso_us = (uint32_t)(time_us_64() - t->prazo_us);
+        disparos++;
+        atraso_total_us += atraso_us;
+        if (atraso_us > atraso_max_us) atraso_max_us = atraso_us;
+        t->disparar(t);
+        t = posicoes[indice];
+    }
+}
+
+void temporizador_processar(void) {
+    uint64_t agora_us = time_us_64();
+    uint64_t atual = agora_us / RESOLUCAO_US;
+    uint64_t primeira = proxima_visita;
+    if (atual - primeira >= TEMPORIZADOR_NUM_POSICOES) primeira = atual - (TEMPORIZADOR_NUM_POSICOES - 1); // Uma volta inteira
+    proxima_visita = atual; // Antes dos disparos: o que eles agendarem no passado cai na posição atual
+    for (uint64_t r = primeira; r <= atual; r++) processar_posicao((uint32_t)(r % TEMPORIZADOR_NUM_POSICOES), agora_us);
+}
+
+/**
+ * @brief Prazo mais próximo entre os agendados, limitado a TEMPORIZADOR_ESPERA_MAX_MS.
+ */
+static uint64_t prazo_mais_proximo(void) {
+    uint64_t prazo = time_us_64() + (uint64_t)TEMPORIZADOR_ESPERA_MAX_MS * 1000u;
+    for (int i = 0; i < TEMPORIZADOR_NUM_POSICOES; i++) {
+        for (Temporizador *t = posicoes[i]; t; t = t->proximo) {
+            if (t->prazo_us < prazo) prazo = t->prazo_us;
+        }
+    }
+    return prazo;
+}
+
+static bool interromper_sono(void) {
+    if (sinalizado) {
+        sinalizado = false;
+        return true;
+    }
+    return acordar_loop && acordar_loop();
+}
+
+void temporizador_dormir(bool (*acordar)(void)) {
+#if TEMPORIZADOR_PAUSA_FIXA_MS
+    (void)acordar;
+    executor_ocioso_ate(make_timeout_time_ms(TEMPORIZADOR_PAUSA_FIXA_MS), NULL); // Loop antigo, para comparação
+#else
+    acordar_loop = acordar;
+    executor_ocioso_ate(from_us_since_boot(prazo_mais_proximo()), interromper_sono);
+#endif
+}
+
+void FUNC_RAM(temporizador_sinalizar)(void) {
+    sinalizado = true;
+    __sev();
+}
+
+void temporizador_atualizar_metricas(void) {
+    metricas_definir(METRICA_AGENDADOR_DISPAROS, disparos);
+    metricas_definir(METRICA_AGENDADOR_ATRASO_MEDIO_US, disparos ? (uint32_t)(atraso_total_us / disparos) : 0);
+    metricas_definir(METRICA_AGENDADOR_ATRASO_MAX_US, atraso_max_us);
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef TEMPORIZADOR_H
+#define TEMPORIZADOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file temporizador.h
+ * @brief Agendador por prazos do trabalho periódico do Núcleo 0.
+ *
+ * Uma roda de TEMPORIZADOR_NUM_POSICOES posições de TEMPORIZADOR_RESOLUCAO_MS
+ * cada: o temporizador entra, em O(1), na lista da posição do seu prazo, e
+ * prazos além de uma volta ficam na mesma posição até a volta deles. O loop
+ * dispara os vencidos (temporizador_processar) e dorme em temporizador_dormir
+ * até o prazo mais próximo, acordado pelo alarme de hardware do SDK
+ * (best_effort_wfe_or_timeout) ou antes por um evento (temporizador_sinalizar).
+ *
+ * O atraso de cada disparo em relação ao prazo é o jitter do agendador,
+ * publicado em gd/gm/gx. Só o Núcleo 0 agenda e processa; só
+ * temporizador_sinalizar pode ser chamada de qualquer núcleo ou IRQ.
+ */
+
+#define TEMPORIZADOR_SEM_PRAZO UINT32_MAX // Espera que cancela o temporizador
+
+typedef struct Temporizador Temporizador;
+typedef void (*FuncaoTemporizador)(Temporizador *temporizador);
+
+struct Temporizador {
+    FuncaoTemporizador disparar;    // Chamada no Núcleo 0 no prazo; pode reagendar o temporizador
+    uint64_t prazo_us;              // Absoluto (time_us_64)
+    Temporizador *anterior;         // Lista da posição da roda
+    Temporizador *proximo;
+    uint8_t posicao;
+    bool ativo;
+};
+
+/**
+ * @brief (Re)agenda o temporizador para daqui a `espera_ms`; TEMPORIZADOR_SEM_PRAZO o cancela.
+ */
+void temporizador_agendar(Temporizador *temporizador, uint32_t espera_ms);
+
+/**
+ * @brief (Re)agenda o temporizador para o instante absoluto `prazo_us` (time_us_64).
+ */
+void temporizador_agendar_em(Temporizador *temporizador, uint64_t prazo_us);
+
+/**
+ * @brief Reagenda um temporizador periódico (em geral dentro do próprio disparo)
+ * para o prazo anterior + `periodo_ms`. Se esse prazo já passou, conta o período
+ * a partir de agora, sem uma rajada de disparos atrasados.
+ */
+void temporizador_repetir(Temporizador *temporizador, uint32_t periodo_ms);
+
+/**
+ * @brief Remove o temporizador da roda, se estiver agendado.
+ */
+void temporizador_cancelar(Temporizador *temporizador);
+
+/**
+ * @brief Dispara os temporizadores vencidos.
+ */
+void temporizador_processar(void);
+
+/**
+ * @brief Dorme até o prazo mais próximo (no máximo TEMPORIZADOR_ESPERA_MAX_MS),
+ * executando trabalhos do executor enquanto isso. Volta antes com
+ * temporizador_sinalizar ou quando `acordar` (opcional) for verdadeira.
+ */
+void temporizador_dormir(bool (*acordar)(void));
+
+/**
+ * @brief Acorda o loop do Núcleo 0: há um evento para ele (mensagem recebida,
+ * mudança na conexão, comando na serial).
+ */
+void temporizador_sinalizar(void);
+
+/**
+ * @brief Atualiza as métricas gd/gm/gx (registrada com metricas_registrar_atualizacao).
+ */
+void temporizador_atualizar_metricas(void);
+
+#endif
\ No newline at end of file
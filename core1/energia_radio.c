@@ -0,0 +1,106 @@
+/**
+ * @file energia_radio.c
+ * @brief Modo de energia do CYW43 e modelo da fração acordada (ver energia_radio.h).
+ *
+ * O firmware do rádio não informa quando dorme, então a fração é modelada pelo
+ * tráfego: cada quadro enviado ou recebido mantém o rádio acordado até
+ * RETORNO_SONO_US depois dele (o pm2_sleep_ret do PM2), e no restante do tempo
+ * ele só acorda RADIO_ESCUTA_BEACON_US para cada beacon escutado. Os quadros são
+ * vistos pelos ponteiros linkoutput/input da netif da estação, trocados por
+ * versões que anotam o instante e chamam os originais no contexto do lwIP.
+ */
+
+#include "core1/energia_radio.h"
+#include "config/config_geral.h" // Para MODO_ENERGIA e RADIO_*
+#include "shared/metricas.h"
+#include "pico/cyw43_arch.h"
+#include "pico/time.h"
+#include "lwip/netif.h"
+#include <stdio.h>
+
+#define INTERVALO_BEACON_US 102400u // 100 TU, o intervalo de beacon usual dos APs
+
+#if MODO_ENERGIA == MODO_ENERGIA_ECONOMIA
+#define RETORNO_SONO_US (RADIO_RETORNO_SONO_MS * 1000u)
+#define ESCUTA_A_CADA_US (RADIO_INTERVALO_DTIM * INTERVALO_BEACON_US)
+#else
+// CYW43_DEFAULT_PM do SDK (CYW43_PERFORMANCE_PM): 200 ms de retorno, todo beacon
+#define RETORNO_SONO_US 200000u
+#define ESCUTA_A_CADA_US INTERVALO_BEACON_US
+#endif
+
+static netif_linkoutput_fn linkoutput_original;
+static netif_input_fn input_original;
+static uint64_t inicio_us = 0;          // Início da medida (primeira conexão)
+static uint64_t acordado_ate_us = 0;    // Fim do retorno ao sono do último quadro
+static uint64_t acordado_us = 0;        // Tempo acordado pelo tráfego, contado até acordado_ate_us
+
+/**
+ * @brief Anota um quadro: o rádio fica acordado até RETORNO_SONO_US depois dele.
+ */
+static void registrar_quadro(void) {
+    uint64_t agora = time_us_64();
+    uint64_t fim = agora + RETORNO_SONO_US;
+    acordado_us += fim - (acordado_ate_us > agora ? acordado_ate_us : agora);
+    acordado_ate_us = fim;
+}
+
+static err_t linkoutput_medido(struct netif *netif, struct pbuf *p) {
+    registrar_quadro();
+    return linkoutput_original(netif, p);
+}
+
+static err_t input_medido(struct pbuf *p, struct netif *netif) {
+    registrar_quadro();
+    return input_original(p, netif);
+}
+
+void energia_radio_aplicar(void) {
+#if MODO_ENERGIA == MODO_ENERGIA_LATENCIA
+    int resultado = cyw43_wifi_pm(&cyw43_state, CYW43_NONE_PM);
+#elif MODO_ENERGIA == MODO_ENERGIA_ECONOMIA
+    int resultado = cyw43_wifi_pm(&cyw43_state, cyw43_pm_value(CYW43_PM2_POWERSAVE_MODE, RADIO_RETORNO_SONO_MS,
+                                                               1, RADIO_INTERVALO_DTIM, 10));
+#else
+    int resultado = 0; // Fica o PM aplicado pelo SDK
+#endif
+    if (resultado != 0) printf("[CORE1] Falha ao aplicar o modo de energia do rádio: %d\n", resultado);
+
+    // A netif é recriada quando a interface volta: a troca é refeita, nunca empilhada
+    cyw43_arch_lwip_begin();
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+    if (netif->linkoutput != linkoutput_medido) {
+        linkoutput_original = netif->linkoutput;
+        netif->linkoutput = linkoutput_medido;
+    }
+    if (netif->input != input_medido) {
+        input_original = netif->input;
+        netif->input = input_medido;
+    }
+    if (inicio_us == 0) inicio_us = time_us_64();
+    cyw43_arch_lwip_end();
+}
+
+uint16_t energia_radio_ativo_permil(void) {
+#if MODO_ENERGIA == MODO_ENERGIA_LATENCIA
+    return 1000;
+#else
+    cyw43_arch_lwip_begin();
+    uint64_t agora = time_us_64();
+    uint64_t inicio = inicio_us;
+    uint64_t acordado = acordado_us;
+    if (acordado_ate_us > agora) acordado -= acordado_ate_us - agora; // Retorno ao sono ainda em curso
+    cyw43_arch_lwip_end();
+
+    if (inicio == 0 || agora <= inicio) return 0;
+    uint64_t decorrido = agora - inicio;
+    if (acordado > decorrido) acordado = decorrido;
+    // Sem tráfego, só os beacons escutados
+    acordado += (decorrido - acordado) * RADIO_ESCUTA_BEACON_US / ESCUTA_A_CADA_US;
+    return (uint16_t)(acordado * 1000u / decorrido);
+#endif
+}
+
+void energia_radio_atualizar_metricas(void) {
+    metricas_definir(METRICA_RADIO_ATIVO_PERMIL, energia_radio_ativo_permil());
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef ENERGIA_RADIO_H
+#define ENERGIA_RADIO_H
+
+#include <stdint.h>
+
+/**
+ * @file energia_radio.h
+ * @brief Modo de energia do CYW43 (MODO_ENERGIA) e fração do tempo com o rádio acordado.
+ *
+ * PADRAO mantém o PM que o SDK aplica; LATENCIA desliga o power-save (o rádio
+ * nunca dorme e tudo sai e chega na hora); ECONOMIA usa o PM2 com retorno ao
+ * sono de RADIO_RETORNO_SONO_MS e escuta só 1 a cada RADIO_INTERVALO_DTIM
+ * beacons DTIM. Nesse modo o Núcleo 0 concentra a saída nas janelas de
+ * core0/janela_transmissao.h, e o que chega do broker espera no AP até o
+ * próximo beacon escutado (até RADIO_INTERVALO_DTIM x ~102 ms a mais).
+ *
+ * A fração acordada é estimada pelo tráfego da netif da estação (ver
+ * energia_radio.c) e publicada na métrica `ra`.
+ */
+
+/**
+ * @brief Aplica o modo de energia e passa a observar os quadros da estação.
+ * Chamada pelo Núcleo 1 depois de cada conexão Wi-Fi.
+ */
+void energia_radio_aplicar(void);
+
+/**
+ * @brief Fração estimada do tempo com o rádio acordado desde a primeira conexão,
+ * em milésimos. Toma a trava do lwIP.
+ */
+uint16_t energia_radio_ativo_permil(void);
+
+/**
+ * @brief Atualiza a métrica `ra` (registrada com metricas_registrar_atualizacao).
+ */
+void energia_radio_atualizar_metricas(void);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,184 @@
+/**
+ * @file entrada_mqtt.c
+ * @brief Caminho de entrada do MQTT (ver entrada_mqtt.h).
+ *
+ * A fila é o próprio pool: `cabeca` só é escrita no contexto do lwIP (produtor)
+ * e `cauda` só no Núcleo 0 (consumidor). O buffer em `cabeca` recebe os
+ * fragmentos e só é publicado (cabeca++) completo; a barreira antes de cada
+ * avanço garante que o outro núcleo veja o conteúdo antes do índice.
+ */
+
+#include "core1/entrada_mqtt.h"
+#include "core0/main_core0_utils.h" // Para util_tratar_comando_mqtt
+#include "core0/sonda_rtt.h"        // Para sonda_rtt_tratar_eco
+#include "core0/temporizador.h"     // Para acordar o Núcleo 0
+#include "shared/metricas.h"
+#include "shared/secao_ram.h"       // Para os callbacks fora da flash
+#include "hardware/sync.h"          // Para __dmb
+#include "pico/time.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    const char *filtro;             // Tópico exato ou filtro com '+'/'#'
+    ManipuladorEntrada tratar;      // Executado no Núcleo 0
+} TopicoEntrada;
+
+static const TopicoEntrada tabela_entrada[] = {
+#if SONDA_RTT_HABILITADA
+    {TOPICO_SONDA_ECO, sonda_rtt_tratar_eco},
+#endif
+    {TOPICO_COMANDO, util_tratar_comando_mqtt},
+};
+#define NUM_TOPICOS_ENTRADA (sizeof(tabela_entrada) / sizeof(tabela_entrada[0]))
+#define SEM_MANIPULADOR 0xFF
+
+_Static_assert((ENTRADA_NUM_BUFFERS & (ENTRADA_NUM_BUFFERS - 1)) == 0, "ENTRADA_NUM_BUFFERS deve ser potência de 2");
+_Static_assert(NUM_TOPICOS_ENTRADA < ENTRADA_TAM_HASH, "ENTRADA_TAM_HASH pequeno demais para a tabela");
+
+// Índice hash (endereçamento aberto) dos tópicos exatos: posição + 1, 0 = vazio
+static uint8_t indice_hash[ENTRADA_TAM_HASH];
+
+static MensagemEntrada pool[ENTRADA_NUM_BUFFERS];
+static volatile uint32_t cabeca = 0; // Escrita só pelo lwIP
+static volatile uint32_t cauda = 0;  // Escrita só pelo Núcleo 0
+
+// Mensagem em remontagem no contexto do lwIP (NULL = descartando a atual)
+static MensagemEntrada *em_montagem = NULL;
+static uint16_t esperado = 0;
+
+static void mqtt_callback_publicacao_entrada(void *arg, const char *topic, u32_t tot_len);
+static void mqtt_callback_dados_entrada(void *arg, const uint8_t *data, uint16_t len, uint8_t flags);
+static void mqtt_callback_inscricao(void *arg, err_t result);
+
+static uint32_t FUNC_RAM_NUCLEO1(hash_topico)(const char *topico) {
+    uint32_t h = 2166136261u; // FNV-1a
+    while (*topico) h = (h ^ (uint8_t)*topico++) * 16777619u;
+    return h;
+}
+
+static bool filtro_com_curinga(const char *filtro) {
+    return strchr(filtro, '+') || strchr(filtro, '#');
+}
+
+/**
+ * @brief Casamento de um tópico com um filtro MQTT ('+' = um nível, '#' = o resto, inclusive nenhum).
+ */
+static bool FUNC_RAM_NUCLEO1(casar_filtro)(const char *filtro, const char *topico) {
+    while (*filtro) {
+        if (*filtro == '#') return true;
+        if (*filtro == '+') {
+            while (*topico && *topico != '/') topico++;
+            filtro++;
+            continue;
+        }
+        if (*topico != *filtro) {
+            // "a/#" também casa com "a"
+            return *topico == '\0' && filtro[0] == '/' && filtro[1] == '#' && filtro[2] == '\0';
+        }
+        filtro++;
+        topico++;
+    }
+    return *topico == '\0';
+}
+
+void entrada_mqtt_inicializar(void) {
+    memset(indice_hash, 0, sizeof(indice_hash));
+    for (uint8_t i = 0; i < NUM_TOPICOS_ENTRADA; i++) {
+        if (filtro_com_curinga(tabela_entrada[i].filtro)) continue;
+        uint32_t pos = hash_topico(tabela_entrada[i].filtro) & (ENTRADA_TAM_HASH - 1);
+        while (indice_hash[pos]) pos = (pos + 1) & (ENTRADA_TAM_HASH - 1);
+        indice_hash[pos] = i + 1;
+    }
+}
+
+/**
+ * @brief Manipulador do tópico: primeiro o índice hash, depois os filtros com curinga.
+ */
+static uint8_t FUNC_RAM_NUCLEO1(buscar_manipulador)(const char *topico) {
+    uint32_t pos = hash_topico(topico) & (ENTRADA_TAM_HASH - 1);
+    while (indice_hash[pos]) {
+        uint8_t i = indice_hash[pos] - 1;
+        if (strcmp(tabela_entrada[i].filtro, topico) == 0) return i;
+        pos = (pos + 1) & (ENTRADA_TAM_HASH - 1);
+    }
+    for (uint8_t i = 0; i < NUM_TOPICOS_ENTRADA; i++) {
+        if (filtro_com_curinga(tabela_entrada[i].filtro) && casar_filtro(tabela_entrada[i].filtro, topico)) return i;
+    }
+    return SEM_MANIPULADOR;
+}
+
+void entrada_mqtt_assinar(mqtt_client_t *cliente) {
+    em_montagem = NULL;
+    mqtt_set_inpub_callback(cliente, mqtt_callback_publicacao_entrada, mqtt_callback_dados_entrada, NULL);
+    for (uint8_t i = 0; i < NUM_TOPICOS_ENTRADA; i++) {
+        mqtt_subscribe(cliente, tabela_entrada[i].filtro, 0, mqtt_callback_inscricao, (void *)tabela_entrada[i].filtro);
+    }
+}
+
+/**
+ * @brief Resultado da inscrição em um filtro da tabela.
+ */
+static void mqtt_callback_inscricao(void *arg, err_t result) {
+    if (result == ERR_OK) {
+        printf("[MQTT] Inscrito em '%s'.\n", (const char *)arg);
+    } else {
+        printf("[MQTT] Falha na inscrição em '%s'. Erro: %d\n", (const char *)arg, result);
+    }
+}
+
+/**
+ * @brief Início de uma mensagem recebida: reserva o buffer em `cabeca`, se o tópico interessar.
+ */
+static void FUNC_RAM_NUCLEO1(mqtt_callback_publicacao_entrada)(void *arg, const char *topic, u32_t tot_len) {
+    LWIP_UNUSED_ARG(arg);
+    em_montagem = NULL;
+    uint8_t manipulador = buscar_manipulador(topic);
+    if (manipulador == SEM_MANIPULADOR) return;
+    if (tot_len > ENTRADA_TAM_BUFFER || strlen(topic) >= ENTRADA_TAM_TOPICO ||
+        cabeca - cauda >= ENTRADA_NUM_BUFFERS) {
+        metricas_incrementar(METRICA_ENTRADA_DESCARTADAS);
+        return;
+    }
+
+    em_montagem = &pool[cabeca & (ENTRADA_NUM_BUFFERS - 1)];
+    em_montagem->manipulador = manipulador;
+    em_montagem->tamanho = 0;
+    strcpy(em_montagem->topico, topic);
+    esperado = (uint16_t)tot_len;
+}
+
+/**
+ * @brief Fragmento de dados: copiado para o buffer reservado; o último publica a mensagem.
+ */
+static void FUNC_RAM_NUCLEO1(mqtt_callback_dados_entrada)(void *arg, const uint8_t *data, uint16_t len, uint8_t flags) {
+    LWIP_UNUSED_ARG(arg);
+    if (!em_montagem) return;
+    if (em_montagem->tamanho + len > esperado) {
+        em_montagem = NULL; // Mais dados que o anunciado: descarta
+        metricas_incrementar(METRICA_ENTRADA_DESCARTADAS);
+        return;
+    }
+    if (len) memcpy(em_montagem->dados + em_montagem->tamanho, data, len);
+    em_montagem->tamanho += len;
+    if (!(flags & MQTT_DATA_FLAG_LAST)) return;
+
+    em_montagem->dados[em_montagem->tamanho] = '\0';
+    em_montagem->instante_us = time_us_32();
+    em_montagem = NULL;
+    __dmb(); // Conteúdo visível ao Núcleo 0 antes do novo índice
+    cabeca = cabeca + 1;
+    temporizador_sinalizar(); // O Núcleo 0 despacha sem esperar o próximo prazo
+    metricas_incrementar(METRICA_ENTRADA_RECEBIDAS);
+    metricas_maximo(METRICA_ENTRADA_FILA_MAX, cabeca - cauda);
+}
+
+void entrada_mqtt_despachar(void) {
+    while (cauda != cabeca) {
+        __dmb(); // Lê o buffer só depois de ver o índice publicado
+        const MensagemEntrada *m = &pool[cauda & (ENTRADA_NUM_BUFFERS - 1)];
+        tabela_entrada[m->manipulador].tratar(m);
+        __dmb(); // Termina de ler antes de devolver o buffer ao lwIP
+        cauda = cauda + 1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef ENTRADA_MQTT_H
+#define ENTRADA_MQTT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config/config_geral.h" // Para ENTRADA_*
+#include "lwip/apps/mqtt.h"      // Para mqtt_client_t
+
+/**
+ * @file entrada_mqtt.h
+ * @brief Caminho de entrada do MQTT: tabela de tópicos, remontagem e despacho ao Núcleo 0.
+ *
+ * Os tópicos assinados e seus manipuladores ficam numa tabela fixa em
+ * entrada_mqtt.c. No contexto do lwIP, o início de cada mensagem é casado com a
+ * tabela (hash para tópicos exatos, varredura só para filtros com '+' ou '#') e
+ * os fragmentos dos callbacks de dados são remontados direto num dos
+ * ENTRADA_NUM_BUFFERS buffers fixos. A mensagem completa entra numa fila SPSC
+ * sem trava e o Núcleo 0 chama o manipulador lendo o próprio buffer, que só
+ * então volta ao pool. O lwIP nunca bloqueia nem roda lógica da aplicação: sem
+ * buffer livre, a mensagem é descartada e contada nas métricas.
+ */
+
+// Mensagem recebida, remontada no buffer do pool
+typedef struct {
+    uint8_t manipulador;                    // Índice na tabela de entrada
+    uint16_t tamanho;
+    uint32_t instante_us;                   // Chegada do último fragmento (time_us_32)
+    char topico[ENTRADA_TAM_TOPICO];
+    uint8_t dados[ENTRADA_TAM_BUFFER + 1];  // Sempre terminado em '\0' após o conteúdo
+} MensagemEntrada;
+
+typedef void (*ManipuladorEntrada)(const MensagemEntrada *mensagem);
+
+/**
+ * @brief Monta o índice hash dos tópicos exatos. Chamada uma vez, antes da primeira conexão.
+ */
+void entrada_mqtt_inicializar(void);
+
+/**
+ * @brief Registra os callbacks de entrada e assina todos os filtros da tabela.
+ * Chamada no contexto do lwIP, quando o broker aceita a conexão.
+ */
+void entrada_mqtt_assinar(mqtt_client_t *cliente);
+
+/**
+ * @brief Chama, no Núcleo 0, o manipulador de cada mensagem completa na fila e
+ * devolve os buffers ao pool. Chamada a cada iteração do loop.
+ */
+void entrada_mqtt_despachar(void);
+
+#endif
\ No newline at end of file
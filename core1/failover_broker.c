@@ -0,0 +1,138 @@
+/**
+ * @file failover_broker.c
+ * @brief Lista de brokers MQTT com pontuação de saúde, troca rápida e volta ao preferido.
+ */
+
+#include "core1/failover_broker.h"
+#include "config/config_geral.h" // Para MQTT_BROKERS e BROKER_*
+#include "shared/metricas.h"
+#include <stdio.h>
+
+typedef struct {
+    const char *ip;
+    uint16_t porta;
+} BrokerMqtt;
+
+static const BrokerMqtt brokers[] = MQTT_BROKERS;
+#define NUM_BROKERS (sizeof(brokers) / sizeof(brokers[0]))
+
+typedef struct {
+    uint32_t latencia_ms;       // Média móvel do tempo até o CONNACK (0 = ainda sem medida)
+    uint8_t falhas;             // Falhas recentes, sem o decaimento desde ultima_falha_ms
+    uint32_t ultima_falha_ms;
+} SaudeBroker;
+
+static SaudeBroker saude[NUM_BROKERS];
+static uint8_t atual = 0;
+static uint32_t inicio_tentativa_ms = 0;
+static bool conectado = false;
+static uint32_t conectado_desde_ms = 0;
+static bool voltando = false;               // A tentativa atual é uma volta ao preferido
+static uint32_t espera_retorno_ms = BROKER_RETORNO_MS;
+
+// Interrupção: do primeiro sinal de falha até o próximo CONNACK, em qualquer broker
+static bool em_interrupcao = false;
+static uint32_t interrupcao_desde_ms = 0;
+static int ultimo_conectado = -1;
+
+/**
+ * @brief Falhas recentes do broker, já com o decaimento (metade por BROKER_RETORNO_MS).
+ */
+static uint32_t falhas_recentes(const SaudeBroker *s, uint32_t agora_ms) {
+    uint32_t periodos = (agora_ms - s->ultima_falha_ms) / BROKER_RETORNO_MS;
+    return periodos >= 8 ? 0 : (uint32_t)s->falhas >> periodos;
+}
+
+static uint32_t pontuacao(uint8_t indice, uint32_t agora_ms) {
+    const SaudeBroker *s = &saude[indice];
+    return s->latencia_ms + falhas_recentes(s, agora_ms) * BROKER_PENALIDADE_FALHA_MS;
+}
+
+static void iniciar_interrupcao(uint32_t agora_ms) {
+    if (em_interrupcao) return;
+    em_interrupcao = true;
+    interrupcao_desde_ms = agora_ms;
+}
+
+uint8_t failover_broker_quantidade(void) {
+    return NUM_BROKERS;
+}
+
+const char *failover_broker_ip(uint8_t indice) {
+    return brokers[indice].ip;
+}
+
+uint16_t failover_broker_porta(uint8_t indice) {
+    return brokers[indice].porta;
+}
+
+uint8_t failover_broker_atual(void) {
+    return atual;
+}
+
+void failover_broker_tentativa(uint32_t agora_ms) {
+    inicio_tentativa_ms = agora_ms;
+}
+
+void failover_broker_conectou(uint32_t agora_ms) {
+    SaudeBroker *s = &saude[atual];
+    uint32_t latencia_ms = agora_ms - inicio_tentativa_ms;
+    s->latencia_ms = s->latencia_ms ? (3 * s->latencia_ms + latencia_ms) / 4 : latencia_ms;
+    conectado = true;
+    conectado_desde_ms = agora_ms;
+    voltando = false;
+    if (atual == 0) espera_retorno_ms = BROKER_RETORNO_MS;
+
+    printf("[BROKER] Conectado a %s:%u (#%u) em %lu ms.\n", brokers[atual].ip, brokers[atual].porta, atual,
+           (unsigned long)latencia_ms);
+    if (em_interrupcao) {
+        uint32_t duracao_ms = agora_ms - interrupcao_desde_ms;
+        em_interrupcao = false;
+        metricas_definir(METRICA_BROKER_INTERRUPCAO_MS, duracao_ms);
+        metricas_maximo(METRICA_BROKER_INTERRUPCAO_MAX_MS, duracao_ms);
+        printf("[BROKER] Sem broker por %lu ms.\n", (unsigned long)duracao_ms);
+    }
+    if (ultimo_conectado >= 0 && ultimo_conectado != atual) metricas_incrementar(METRICA_BROKER_TROCAS);
+    ultimo_conectado = atual;
+    metricas_definir(METRICA_BROKER_ATUAL, atual);
+}
+
+void failover_broker_falhou(uint32_t agora_ms) {
+    iniciar_interrupcao(agora_ms);
+    SaudeBroker *s = &saude[atual];
+    uint32_t falhas = falhas_recentes(s, agora_ms) + 1;
+    s->falhas = falhas > UINT8_MAX ? UINT8_MAX : (uint8_t)falhas;
+    s->ultima_falha_ms = agora_ms;
+    conectado = false;
+    if (voltando) {
+        voltando = false;
+        espera_retorno_ms = espera_retorno_ms * 2 > BROKER_RETORNO_MAX_MS ? BROKER_RETORNO_MAX_MS : espera_retorno_ms * 2;
+    }
+
+    // Menor pontuação entre os outros; no empate, a ordem da lista
+    uint8_t anterior = atual;
+    for (uint8_t i = 0; i < NUM_BROKERS; i++) {
+        if (i == anterior) continue;
+        if (atual == anterior || pontuacao(i, agora_ms) < pontuacao(atual, agora_ms)) atual = i;
+    }
+    printf("[BROKER] Falha em %s:%u (#%u, %u falha(s) recente(s)); próximo: %s:%u (#%u).\n",
+           brokers[anterior].ip, brokers[anterior].porta, anterior, s->falhas,
+           brokers[atual].ip, brokers[atual].porta, atual);
+}
+
+uint32_t failover_broker_espera_voltar_ms(uint32_t agora_ms) {
+    if (!conectado || atual == 0) return UINT32_MAX;
+    uint32_t decorrido_ms = agora_ms - conectado_desde_ms;
+    return decorrido_ms < espera_retorno_ms ? espera_retorno_ms - decorrido_ms : 0;
+}
+
+bool failover_broker_voltar(uint32_t agora_ms) {
+    if (!conectado || atual == 0 || agora_ms - conectado_desde_ms < espera_retorno_ms) return false;
+    printf("[BROKER] %lu ms no reserva #%u: voltando ao preferido %s:%u.\n", (unsigned long)espera_retorno_ms,
+           atual, brokers[0].ip, brokers[0].porta);
+    iniciar_interrupcao(agora_ms);
+    conectado = false;
+    voltando = true;
+    atual = 0;
+    return true;
+}
\ No newline at end of file
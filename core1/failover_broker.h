@@ -0,0 +1,68 @@
+#ifndef FAILOVER_BROKER_H
+#define FAILOVER_BROKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file failover_broker.h
+ * @brief Escolha do broker MQTT entre os de MQTT_BROKERS, por saúde e preferência.
+ *
+ * Cada broker tem uma pontuação de saúde: a latência média do CONNACK mais
+ * BROKER_PENALIDADE_FALHA_MS por falha recente (tentativa sem resposta, conexão
+ * recusada ou keep-alive perdido), com as falhas valendo metade a cada
+ * BROKER_RETORNO_MS sem falhar. Uma falha troca de imediato para o broker de
+ * menor pontuação entre os outros; conectado a um reserva por BROKER_RETORNO_MS,
+ * volta ao preferido (o primeiro da lista). Uma volta que falha dobra essa espera,
+ * até BROKER_RETORNO_MAX_MS.
+ *
+ * Só decide: quem conecta e desconecta é loop_mqtt() (mqtt_client_core1.c), no
+ * Núcleo 0, que também é o único a chamar estas funções.
+ */
+
+/**
+ * @brief Endereço e porta do broker de índice `indice` na lista.
+ */
+const char *failover_broker_ip(uint8_t indice);
+uint16_t failover_broker_porta(uint8_t indice);
+
+/**
+ * @brief Número de brokers em MQTT_BROKERS.
+ */
+uint8_t failover_broker_quantidade(void);
+
+/**
+ * @brief Broker da próxima tentativa de conexão.
+ */
+uint8_t failover_broker_atual(void);
+
+/**
+ * @brief Uma tentativa de conexão com o broker atual começou.
+ */
+void failover_broker_tentativa(uint32_t agora_ms);
+
+/**
+ * @brief O broker atual aceitou a conexão. Encerra a interrupção em curso, se
+ * houver, e registra sua duração (tempo de troca) nas métricas.
+ */
+void failover_broker_conectou(uint32_t agora_ms);
+
+/**
+ * @brief A tentativa com o broker atual falhou ou a conexão caiu: pontua a
+ * falha e escolhe o próximo broker.
+ */
+void failover_broker_falhou(uint32_t agora_ms);
+
+/**
+ * @brief Informa se já é hora de deixar o reserva atual e tentar o preferido.
+ * Quando devolve true, o broker atual passa a ser o preferido.
+ */
+bool failover_broker_voltar(uint32_t agora_ms);
+
+/**
+ * @brief Tempo até failover_broker_voltar passar a devolver true, em ms
+ * (UINT32_MAX se conectado ao preferido ou sem conexão).
+ */
+uint32_t failover_broker_espera_voltar_ms(uint32_t agora_ms);
+
+#endif
\ No newline at end of file
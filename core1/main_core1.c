@@ -5,23 +5,38 @@
  * Este núcleo é responsável por:
  * - Inicializar o chip CYW43 (para Wi-Fi).
  * - Conectar-se à rede Wi-Fi especificada.
+ * - Aplicar o modo de energia do rádio (MODO_ENERGIA) a cada conexão.
  * - Monitorar o status da conexão e tentar reconectar em caso de falha.
  * - Enviar o status da conexão e o endereço IP obtido para o Núcleo 0 via FIFO.
+ * - Entre as verificações do Wi-Fi, executar os trabalhos do executor.
+ *
+ * Com REDE_POLL (pico_cyw43_arch_lwip_poll) toda a pilha de rede roda aqui, sem
+ * IRQ: o laço chama cyw43_arch_poll, a supervisão do MQTT e a verificação do
+ * Wi-Fi, e fica no executor até o prazo mais próximo ou até haver trabalho para
+ * o contexto do CYW43 (pacote, timer do lwIP ou publicação do Núcleo 0).
  */
 
 #include "core1/main_core1.h"
+#include "core1/energia_radio.h" // Para o modo de energia do rádio
 #include "config/config_geral.h"
 #include "core0/main_core0_utils.h" // Para FIFO_TIPO_IP_ADDRESS
 #include "pico/cyw43_arch.h"
 #include "pico/multicore.h"
 #include <stdio.h>  // Para printf no Core 1 (debug)
 #include <string.h> // Para memset
+#include "shared/rastreio.h" // Para RASTREIO_INSTANTE
+#include "shared/secao_ram.h" // Para FUNC_RAM_NUCLEO1
+#include "shared/executor.h" // Para executar trabalhos entre as verificações
+#if REDE_POLL
+#include "core1/mqtt_client_core1.h" // Para a supervisão do MQTT neste núcleo
+#endif
 
 // Protótipos de funções locais
 static bool verificar_conexao_wifi();
 static void enviar_status_wifi_para_core0(uint16_t status_wifi, uint16_t tentativa);
 static void enviar_ip_para_core0(const uint8_t *ip);
 static void tentar_conectar_wifi();
+static void verificar_e_reconectar_wifi(uint32_t *contador_sem_conexao);
 static void monitorar_e_reconectar_wifi();
 
 
@@ -30,6 +45,10 @@ static void monitorar_e_reconectar_wifi();
  */
 void main_core1_entry(void) {
     printf("[CORE1] Núcleo 1 iniciado.\n");
+#if MQTT_TLS && TLS_SESSAO_FLASH
+    // O Núcleo 0 grava as sessões TLS na flash com este núcleo pausado (flash_safe_execute)
+    multicore_lockout_victim_init();
+#endif
 
     if (cyw43_arch_init()) {
         printf("[CORE1] Falha ao inicializar CYW43.\n");
@@ -37,6 +56,9 @@ void main_core1_entry(void) {
         return; // Não há muito o que fazer se o chip Wi-Fi falhar ao iniciar
     }
     printf("[CORE1] CYW43 inicializado.\n");
+#if REDE_POLL
+    mqtt_rede_inicializar(); // Antes de o Núcleo 0 pedir a conexão
+#endif
 
     tentar_conectar_wifi();
     monitorar_e_reconectar_wifi(); // Loop infinito de monitoramento
@@ -56,10 +78,11 @@ static bool verificar_conexao_wifi(void) {
  * @param status_wifi Status da conexão (0=DOWN, 1=UP, 2=FAIL, 3=CONNECTING).
  * @param tentativa Número da tentativa de conexão (0 se for um evento geral).
  */
-static void enviar_status_wifi_para_core0(uint16_t status_wifi, uint16_t tentativa) {
+static void FUNC_RAM_NUCLEO1(enviar_status_wifi_para_core0)(uint16_t status_wifi, uint16_t tentativa) {
     // Empacota tentativa e status em um único uint32_t
     // Tentativa nos 16 bits mais significativos, status nos 16 bits menos significativos
     uint32_t pacote_fifo = ((tentativa & 0xFFFF) << 16) | (status_wifi & 0xFFFF);
+    RASTREIO_INSTANTE(RASTREIO_ID_FIFO_PUSH_CORE1);
     multicore_fifo_push_blocking(pacote_fifo);
     printf("[CORE1] FIFO -> CORE0: Status WiFi=%u, Tentativa=%u\n", status_wifi, tentativa);
 }
@@ -96,6 +119,7 @@ static void tentar_conectar_wifi() {
 
         if (resultado_conexao == 0 && verificar_conexao_wifi()) {
             printf("[CORE1] Wi-Fi conectado com sucesso!\n");
+            energia_radio_aplicar();
             enviar_status_wifi_para_core0(1, tentativa); // 1 = Conectado (UP)
             
             // Envia o endereço IP para o Núcleo 0
@@ -115,47 +139,92 @@ static void tentar_conectar_wifi() {
 }
 
 /**
- * @brief Monitora a conexão Wi-Fi e tenta reconectar se cair.
+ * @brief Verifica a conexão Wi-Fi e tenta reconectar se caiu.
+ */
+static void verificar_e_reconectar_wifi(uint32_t *contador_sem_conexao) {
+    if (verificar_conexao_wifi()) {
+        *contador_sem_conexao = 0; // Reseta se estiver conectado
+        return;
+    }
+    (*contador_sem_conexao)++;
+    printf("[CORE1] Conexão Wi-Fi perdida ou não estabelecida (Cont: %lu).\n", *contador_sem_conexao);
+    enviar_status_wifi_para_core0(0, 0); // 0 = Down (Perdida)
+
+    // Tenta reconectar
+    cyw43_arch_enable_sta_mode(); // Garante que o modo STA está ativo
+    printf("[CORE1] Tentando reconectar ao Wi-Fi...\n");
+    enviar_status_wifi_para_core0(3,0); // 3 = Conectando (para reconexão)
+
+    for (uint16_t tentativa_reconexao = 1; tentativa_reconexao <= 3; tentativa_reconexao++) {
+         printf("[CORE1] Tentativa de reconexão Wi-Fi #%u...\n", tentativa_reconexao);
+        int resultado_reconexao = cyw43_arch_wifi_connect_timeout_ms(
+            WIFI_SSID, WIFI_PASS, CYW43_AUTH_WPA2_AES_PSK, TEMPO_CONEXAO
+        );
+
+        if (resultado_reconexao == 0 && verificar_conexao_wifi()) {
+            printf("[CORE1] Wi-Fi reconectado com sucesso!\n");
+            energia_radio_aplicar();
+            enviar_status_wifi_para_core0(1, tentativa_reconexao); // 1 = Conectado
+            const uint8_t *ip_addr = (const uint8_t *)&(cyw43_state.netif[CYW43_ITF_STA].ip_addr.addr);
+            enviar_ip_para_core0(ip_addr);
+            *contador_sem_conexao = 0; // Reseta contador
+            break; // Sai do loop de tentativas de reconexão
+        } else {
+            printf("[CORE1] Falha na tentativa de reconexão #%u.\n", tentativa_reconexao);
+            enviar_status_wifi_para_core0(2, tentativa_reconexao); // 2 = Falha
+            sleep_ms(TEMPO_CONEXAO);
+        }
+    }
+    if (!verificar_conexao_wifi()) {
+         printf("[CORE1] Falha ao reconectar após tentativas.\n");
+         enviar_status_wifi_para_core0(2, 0); // Falha final de reconexão
+    }
+}
+
+#if REDE_POLL
+/**
+ * @brief Laço da rede em modo poll: processa o CYW43 e o lwIP, supervisiona o
+ * MQTT, verifica o Wi-Fi a cada INTERVALO_PING_MS e executa um trabalho por
+ * volta. Sem trabalho, dorme em cyw43_arch_wait_for_work_until até o prazo mais
+ * próximo (o próprio contexto acorda com pacotes, timers do lwIP e pedidos do
+ * Núcleo 0), no máximo REDE_POLL_OCIOSO_MAX_US: o WFE dele não volta com um
+ * trabalho submetido pelo Núcleo 0, que fica então para a volta seguinte.
  */
 static void monitorar_e_reconectar_wifi() {
     uint32_t contador_sem_conexao = 0;
+    absolute_time_t proxima_verificacao = make_timeout_time_ms(INTERVALO_PING_MS);
     while (true) {
-        if (!verificar_conexao_wifi()) {
-            contador_sem_conexao++;
-            printf("[CORE1] Conexão Wi-Fi perdida ou não estabelecida (Cont: %lu).\n", contador_sem_conexao);
-            enviar_status_wifi_para_core0(0, 0); // 0 = Down (Perdida)
-            
-            // Tenta reconectar
-            cyw43_arch_enable_sta_mode(); // Garante que o modo STA está ativo
-            printf("[CORE1] Tentando reconectar ao Wi-Fi...\n");
-            enviar_status_wifi_para_core0(3,0); // 3 = Conectando (para reconexão)
-
-            for (uint16_t tentativa_reconexao = 1; tentativa_reconexao <= 3; tentativa_reconexao++) {
-                 printf("[CORE1] Tentativa de reconexão Wi-Fi #%u...\n", tentativa_reconexao);
-                int resultado_reconexao = cyw43_arch_wifi_connect_timeout_ms(
-                    WIFI_SSID, WIFI_PASS, CYW43_AUTH_WPA2_AES_PSK, TEMPO_CONEXAO
-                );
-
-                if (resultado_reconexao == 0 && verificar_conexao_wifi()) {
-                    printf("[CORE1] Wi-Fi reconectado com sucesso!\n");
-                    enviar_status_wifi_para_core0(1, tentativa_reconexao); // 1 = Conectado
-                    const uint8_t *ip_addr = (const uint8_t *)&(cyw43_state.netif[CYW43_ITF_STA].ip_addr.addr);
-                    enviar_ip_para_core0(ip_addr);
-                    contador_sem_conexao = 0; // Reseta contador
-                    break; // Sai do loop de tentativas de reconexão
-                } else {
-                    printf("[CORE1] Falha na tentativa de reconexão #%u.\n", tentativa_reconexao);
-                    enviar_status_wifi_para_core0(2, tentativa_reconexao); // 2 = Falha
-                    sleep_ms(TEMPO_CONEXAO);
-                }
-            }
-            if (!verificar_conexao_wifi()) {
-                 printf("[CORE1] Falha ao reconectar após tentativas.\n");
-                 enviar_status_wifi_para_core0(2, 0); // Falha final de reconexão
-            }
-        } else {
-            contador_sem_conexao = 0; // Reseta se estiver conectado
+        cyw43_arch_poll(); // Eventos do CYW43, timers do lwIP e a fila de saída do Núcleo 0
+        uint32_t espera_mqtt_ms = mqtt_rede_processar();
+        if (time_reached(proxima_verificacao)) {
+            verificar_e_reconectar_wifi(&contador_sem_conexao);
+            energia_radio_atualizar_metricas(); // Usa a trava do lwIP, que só este núcleo pode tomar
+            proxima_verificacao = make_timeout_time_ms(INTERVALO_PING_MS);
         }
-        sleep_ms(INTERVALO_PING_MS); // Verifica o status da conexão periodicamente (ex: a cada 5s)
+
+        executor_processar_concluidos();
+        if (executor_executar_um()) continue;
+
+        uint64_t limite_us = time_us_64() + REDE_POLL_OCIOSO_MAX_US;
+        uint64_t prazo_verificacao_us = to_us_since_boot(proxima_verificacao);
+        if (prazo_verificacao_us < limite_us) limite_us = prazo_verificacao_us;
+        if (espera_mqtt_ms != UINT32_MAX) {
+            uint64_t prazo_mqtt_us = time_us_64() + (uint64_t)espera_mqtt_ms * 1000u;
+            if (prazo_mqtt_us < limite_us) limite_us = prazo_mqtt_us;
+        }
+        cyw43_arch_wait_for_work_until(from_us_since_boot(limite_us));
+    }
+}
+#else
+/**
+ * @brief Monitora a conexão Wi-Fi e tenta reconectar se cair.
+ */
+static void monitorar_e_reconectar_wifi() {
+    uint32_t contador_sem_conexao = 0;
+    while (true) {
+        verificar_e_reconectar_wifi(&contador_sem_conexao);
+        // Verifica o status da conexão periodicamente (ex: a cada 5s); até lá, executa trabalhos
+        executor_ocioso_ate(make_timeout_time_ms(INTERVALO_PING_MS), NULL);
     }
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
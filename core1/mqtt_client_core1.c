@@ -3,9 +3,19 @@
  * @brief Implementação do cliente MQTT utilizando a pilha lwIP.
  *
  * Gerencia a conexão com o broker MQTT e a publicação de mensagens.
+ * Cada tópico tem uma entrada na tabela de publicação: os de texto saem sempre,
+ * os numéricos só por exceção (mudança além da zona morta ou intervalo máximo
+ * vencido), comparados com o último valor enviado. Os tópicos de lotes levam
+ * um byte de cabeçalho e, com COMPRESSAO_PAYLOAD, o restante vai comprimido
+ * com LZSS quando isso economiza bytes. Com PUBLICACAO_DIRETA, esses lotes vão
+ * ao TCP por referência (core1/mqtt_envio_direto.h), sem passar pelo anel de
+ * saída do cliente, e podem ser maiores que ele.
  * As funções são chamadas pelo Núcleo 0, mas as operações de rede
  * são executadas no contexto da pilha lwIP (geralmente associada ao Núcleo 1
  * quando se usa `pico_cyw43_arch_lwip_threadsafe_background`).
+ * Com REDE_POLL o Núcleo 0 não toca no lwIP: as publicações e os pedidos de
+ * conexão vão pela fila de core1/saida_mqtt.h, e a conexão, a supervisão e os
+ * envios rodam no laço de polling do Núcleo 1 (mqtt_rede_processar).
  */
 
 #include "core1/mqtt_client_core1.h"
@@ -13,113 +23,246 @@
 #include "core0/main_core0_utils.h" // Para FIFO_TIPO_MQTT_PUB_ACK e util_exibir_status_mqtt_oled
 #include "lwip/apps/mqtt.h"
 #include "lwip/ip_addr.h"
-#include "pico/multicore.h" // Para multicore_fifo_push_blocking
+#include "pico/cyw43_arch.h" // Para cyw43_arch_lwip_begin/end
+#include "pico/multicore.h" // Para multicore_fifo_wready e multicore_fifo_push_blocking
+#include "shared/rastreio.h" // Para instrumentação dos callbacks
+#include "shared/metricas.h" // Para contagem das publicações
+#include "shared/secao_ram.h" // Para os callbacks fora da flash
+#include "lwip/apps/mqtt_priv.h" // Para mqtt_client_t (instância estática e ocupação do anel de saída)
+#include "shared/compressao_lzss.h" // Para a compressão dos lotes
+#include "core1/entrada_mqtt.h" // Para as assinaturas e a recepção
+#include "core1/mqtt_envio_direto.h" // Para os lotes publicados sem cópia
+#include "core1/failover_broker.h" // Para a escolha do broker
+#include "core0/janela_transmissao.h" // Para adiar os tópicos de estado até a janela
+#include "shared/executor.h" // Para a montagem dos lotes no outro núcleo
+#include "core0/temporizador.h" // Para acordar o Núcleo 0 nos eventos da conexão
+#include "core1/saida_mqtt.h" // Para a fila de saída com REDE_POLL
+#if MQTT_TLS
+#include "core1/transporte_tls.h" // Para a configuração TLS e a retomada de sessão
+#endif
 #include <stdio.h>
 #include <string.h>
 
+#if MEMORIA_ESTATICA
+
+// Instância única do cliente, com o buffer de saída (MQTT_OUTPUT_RINGBUF_SIZE) embutido
+static mqtt_client_t cliente_mqtt_estatico;
+#endif
 
 // Ponteiro para a instância do cliente MQTT
 static mqtt_client_t *cliente_mqtt_inst;
 
+// 'arg' do callback de publicação para mensagens cujo resultado não vai ao Núcleo 0
+static int publicacao_silenciosa;
+#define ARG_PUBLICACAO_SILENCIOSA (&publicacao_silenciosa)
+
 // Informações de conexão do cliente MQTT
 static struct mqtt_connect_client_info_t cliente_info_mqtt;
 
+// Resultados do callback de conexão (contexto do lwIP), lidos por loop_mqtt no Núcleo 0
+static volatile uint32_t conexoes_aceitas = 0;
+static volatile uint32_t conexoes_perdidas = 0; // Recusas, quedas e keep-alive sem resposta
+static uint32_t aceitas_vistas = 0, perdidas_vistas = 0;
+static bool conectando = false;
+static uint32_t inicio_conexao_ms = 0;
+static volatile uint8_t broker_conexao = 0; // Broker da tentativa atual (sessão TLS no CONNACK)
+
+#if REDE_POLL
+// Pedidos do Núcleo 0, atendidos no Núcleo 1 por atender_pedidos_nucleo0
+static volatile bool pedido_conexao = false;
+static volatile bool pedido_encerramento = false;
+// Estado da conexão e do anel de saída mantidos pelo Núcleo 1, lidos pelo Núcleo 0 sem trava
+static volatile bool conectado_espelho = false;
+static volatile uint16_t ocupacao_anel_espelho = 0;
+#endif
+
+// Entrada da tabela de publicação
+typedef struct {
+    const char *nome;
+    const char *formato;        // printf do valor numérico (NULL = tópico de texto, sem filtro)
+    uint32_t intervalo_min_ms;  // Menor espaço entre duas publicações
+    uint32_t intervalo_max_ms;  // Republica o último valor após este tempo (0 = nunca)
+    int32_t zona_morta;         // Variação tolerada sem publicar
+    bool reter;                 // Retain no broker: quem assinar depois recebe o estado atual
+    bool notificar_core0;       // Resultado vai ao Núcleo 0 como FIFO_TIPO_MQTT_PUB_ACK
+    bool com_cabecalho;         // Payload precedido do byte CABECALHO_PAYLOAD_* (e comprimível)
+} TopicoPublicacao;
+
+static const TopicoPublicacao tabela_topicos[TOPICO_NUM] = {
+    [TOPICO_ID_PING]        = {TOPICO_PING, NULL, 0, 0, 0, false, true, false},
+    [TOPICO_ID_SENSORES]    = {TOPICO_SENSORES, NULL, 0, 0, 0, false, true, true},
+    [TOPICO_ID_METRICAS]    = {TOPICO_METRICAS, NULL, 0, 0, 0, false, false, false},
+    [TOPICO_ID_ESTADO_WIFI] = {TOPICO_ESTADO_WIFI, "%ld", ESTADO_INTERVALO_MIN_MS,
+                               ESTADO_INTERVALO_MAX_MS, 0, true, false, false},
+    [TOPICO_ID_COR_LED]     = {TOPICO_COR_LED, "#%06lX", ESTADO_INTERVALO_MIN_MS,
+                               ESTADO_INTERVALO_MAX_MS, 0, true, false, false},
+    [TOPICO_ID_TEMPERATURA] = {TOPICO_TEMPERATURA, "%ld", TEMPERATURA_INTERVALO_MIN_MS,
+                               ESTADO_INTERVALO_MAX_MS, TEMPERATURA_ZONA_MORTA_MC, true, false, false},
+    [TOPICO_ID_SONDA]       = {TOPICO_SONDA, NULL, 0, 0, 0, false, false, false},
+};
+
+// Último valor enviado e valor mais recente de cada tópico numérico (só o Núcleo 0 acessa)
+typedef struct {
+    int32_t ultimo_enviado;
+    int32_t valor_atual;
+    uint32_t instante_envio_ms;
+    bool enviado;   // ultimo_enviado é válido
+    bool pendente;  // valor_atual saiu da zona morta e ainda não foi publicado
+    bool aguardando_janela;     // Pronto desde pronto_ms, esperando a janela de transmissão
+    uint32_t pronto_ms;
+} CacheTopico;
+
+static CacheTopico cache_topicos[TOPICO_NUM];
+
+#if PUBLICACAO_DIRETA
+// Payload com cabeçalho, referenciado pelo TCP até a confirmação (payload_referenciado)
+static uint8_t payload_com_cabecalho[ENVIO_DIRETO_TAM_MAX];
+#else
+// Payload com cabeçalho montado antes do mqtt_publish, que o copia para o anel de saída
+static uint8_t payload_com_cabecalho[MQTT_OUTPUT_RINGBUF_SIZE];
+#endif
+#if PUBLICACAO_DIRETA || REDE_POLL
+// payload_com_cabecalho ainda em uso: pelo TCP (envio direto) ou pela fila de saída (REDE_POLL)
+static volatile bool payload_referenciado = false;
+#endif
+
 // Callbacks MQTT
 static void mqtt_callback_conexao(mqtt_client_t *client, void *arg, mqtt_connection_status_t status);
 static void mqtt_callback_publicacao(void *arg, err_t result);
-// static void mqtt_callback_dados_entrada(void *arg, const uint8_t *data, uint16_t len, uint8_t flags);
-// static void mqtt_callback_inscricao(void *arg, err_t result);
 
 
+/**
+ * @brief Envia a confirmação de uma publicação ao Núcleo 0 sem bloquear. Roda no
+ * contexto do lwIP: esperar a FIFO esvaziar travaria o Núcleo 0 parado na trava do
+ * lwIP em mqtt_publish. Com a FIFO cheia a confirmação é descartada e contada; o
+ * controle de publicação trata o ACK que não veio como congestionamento.
+ */
+static void FUNC_RAM_NUCLEO1(notificar_publicacao_core0)(uint16_t status_pub) {
+    if (!multicore_fifo_wready()) {
+        metricas_incrementar(METRICA_MQTT_ACK_DESCARTADO);
+        return;
+    }
+    multicore_fifo_push_blocking(((uint32_t)FIFO_TIPO_MQTT_PUB_ACK << 16) | status_pub);
+}
+
 /**
  * @brief Callback invocado após uma tentativa de conexão com o broker MQTT.
  */
-static void mqtt_callback_conexao(mqtt_client_t *client, void *arg, mqtt_connection_status_t status) {
+static void FUNC_RAM_NUCLEO1(mqtt_callback_conexao)(mqtt_client_t *client, void *arg, mqtt_connection_status_t status) {
     LWIP_UNUSED_ARG(client);
     LWIP_UNUSED_ARG(arg);
+    RASTREIO_INICIO(RASTREIO_ID_MQTT_CB_CONEXAO);
 
     if (status == MQTT_CONNECT_ACCEPTED) {
         printf("[MQTT] Conexão com broker ACEITA.\n");
+        conexoes_aceitas = conexoes_aceitas + 1;
+#if REDE_POLL
+        conectado_espelho = true;
+#endif
+        temporizador_sinalizar(); // loop_mqtt registra a conexão
         // A exibição no OLED é melhor controlada pelo Core 0.
         // O Core 0 chamará util_exibir_status_mqtt_oled("Conectado") se desejar.
         // Aqui, poderíamos enviar uma mensagem para o Core 0, mas o util_exibir_status_mqtt_oled
         // já é chamado pelo core0 ao iniciar o cliente.
         // Vamos apenas imprimir no console por enquanto.
 
-        // Exemplo: inscrever-se em um tópico após conectar (se necessário)
-        // mqtt_set_inpub_callback(client, mqtt_callback_dados_entrada, mqtt_callback_inscricao, arg);
-        // mqtt_subscribe(client, "pico/comandos", 1, mqtt_callback_inscricao, arg);
+        // Já no contexto do lwIP: sem cyw43_arch_lwip_begin/end
+#if MQTT_TLS
+        transporte_tls_conectou(client->conn, broker_conexao);
+#endif
+        entrada_mqtt_assinar(client);
+#if PUBLICACAO_DIRETA
+        envio_direto_conectado(client);
+#endif
 
     } else {
         printf("[MQTT] Falha na conexão com broker. Status: %d\n", status);
         // Similarmente, o Core 0 pode exibir "Falha MQTT"
+        conexoes_perdidas = conexoes_perdidas + 1; // loop_mqtt troca de broker
+#if REDE_POLL
+        conectado_espelho = false;
+#endif
+        temporizador_sinalizar();
+#if PUBLICACAO_DIRETA
+        envio_direto_desconectado();
+#endif
     }
+    RASTREIO_FIM(RASTREIO_ID_MQTT_CB_CONEXAO);
 }
 
 /**
  * @brief Callback invocado após uma tentativa de publicação de mensagem.
  */
-static void mqtt_callback_publicacao(void *arg, err_t result) {
-    LWIP_UNUSED_ARG(arg);
+static void FUNC_RAM_NUCLEO1(mqtt_callback_publicacao)(void *arg, err_t result) {
+    RASTREIO_INICIO(RASTREIO_ID_MQTT_CB_PUBLICACAO);
     uint16_t status_pub;
 
     if (result == ERR_OK) {
         printf("[MQTT] Publicação MQTT bem-sucedida.\n");
+        metricas_incrementar(METRICA_MQTT_PUB_OK);
         status_pub = 0; // 0 para sucesso
     } else {
         printf("[MQTT] Falha na publicação MQTT. Erro: %d\n", result);
+        metricas_incrementar(METRICA_MQTT_PUB_FALHA);
         status_pub = 1; // 1 para falha
     }
 
+    // Publicações internas (ex.: métricas) não geram ACK para o Núcleo 0
+    if (arg == ARG_PUBLICACAO_SILENCIOSA) {
+        RASTREIO_FIM(RASTREIO_ID_MQTT_CB_PUBLICACAO);
+        return;
+    }
+
     // Envia o status da publicação (ACK do PING) de volta para o Núcleo 0
-    // Usando FIFO_TIPO_MQTT_PUB_ACK para identificar esta mensagem
-    uint32_t pacote_fifo = (FIFO_TIPO_MQTT_PUB_ACK << 16) | status_pub;
-    multicore_fifo_push_blocking(pacote_fifo);
+    notificar_publicacao_core0(status_pub);
+    RASTREIO_FIM(RASTREIO_ID_MQTT_CB_PUBLICACAO);
 }
 
 /**
- * @brief Inicializa e conecta o cliente MQTT.
+ * @brief Inicia a conexão com o broker escolhido por failover_broker. O resultado
+ * chega em mqtt_callback_conexao e é tratado por loop_mqtt.
  */
-void iniciar_cliente_mqtt(void) {
-    ip_addr_t ip_broker;
+static void conectar_broker_atual(void) {
+    uint8_t indice = failover_broker_atual();
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    failover_broker_tentativa(agora_ms);
+    conectando = true; // Sem CONNACK em BROKER_TIMEOUT_CONEXAO_MS, loop_mqtt troca de broker
+    inicio_conexao_ms = agora_ms;
+    broker_conexao = indice;
 
     // Converte o endereço IP do broker de string para o formato lwIP
-    if (!ip4addr_aton(MQTT_BROKER_IP, &ip_broker)) {
-        printf("[MQTT] Endereço IP do broker inválido: %s\n", MQTT_BROKER_IP);
-        // O Core 0 já exibiu "Iniciando...", agora pode exibir falha
-        // util_exibir_status_mqtt_oled("IP Broker Inv."); // Chamado pelo Core 0
-        return;
-    }
-
-    // Cria uma nova instância do cliente MQTT
-    cliente_mqtt_inst = mqtt_client_new();
-    if (!cliente_mqtt_inst) {
-        printf("[MQTT] Erro ao criar cliente MQTT.\n");
-        // util_exibir_status_mqtt_oled("Erro Criacao"); // Chamado pelo Core 0
+    ip_addr_t ip_broker;
+    if (!ip4addr_aton(failover_broker_ip(indice), &ip_broker)) {
+        printf("[MQTT] Endereço IP do broker inválido: %s\n", failover_broker_ip(indice));
         return;
     }
 
-    // Configura as informações do cliente
-    memset(&cliente_info_mqtt, 0, sizeof(cliente_info_mqtt));
-    cliente_info_mqtt.client_id = "rp2040_pico_w_client"; // ID do cliente
-    // cliente_info_mqtt.client_user = "usuario"; // Se houver autenticação
-    // cliente_info_mqtt.client_pass = "senha";   // Se houver autenticação
-    // cliente_info_mqtt.keep_alive = 60; // Keep-alive em segundos
-
     // Tenta conectar ao broker MQTT
     // O callback mqtt_callback_conexao será chamado com o resultado.
     // O último argumento (NULL) é o 'arg' passado para os callbacks.
+    // As chamadas ao lwIP feitas fora do contexto da pilha precisam da trava do cyw43_arch
+    cyw43_arch_lwip_begin();
+#if PUBLICACAO_DIRETA
+    envio_direto_abortar_fechado(); // O PCB da conexão anterior não segura o payload além daqui
+#endif
     err_t err = mqtt_client_connect(
         cliente_mqtt_inst,
         &ip_broker,
-        MQTT_BROKER_PORT,
+        failover_broker_porta(indice),
         mqtt_callback_conexao,
         NULL, // arg para callback
         &cliente_info_mqtt
     );
+#if MQTT_TLS
+    // A conexão TCP acabou de ser aberta: com a trava ainda tomada, o handshake
+    // não começou e a sessão guardada ainda pode ser oferecida
+    if (err == ERR_OK) transporte_tls_preparar(cliente_mqtt_inst->conn, indice);
+#endif
+    cyw43_arch_lwip_end();
 
     if (err == ERR_OK) {
-        printf("[MQTT] Tentativa de conexão MQTT iniciada...\n");
+        printf("[MQTT] Tentativa de conexão MQTT com %s:%u iniciada...\n", failover_broker_ip(indice),
+               failover_broker_porta(indice));
         // util_exibir_status_mqtt_oled("Conectando..."); // Chamado pelo Core 0
     } else {
         printf("[MQTT] Erro ao iniciar conexão MQTT: %d\n", err);
@@ -128,43 +271,592 @@ void iniciar_cliente_mqtt(void) {
 }
 
 /**
- * @brief Publica uma mensagem MQTT.
+ * @brief Fecha a conexão (ou a tentativa) atual por decisão própria, sem callback do lwIP.
  */
-void publicar_mensagem_mqtt(const char *mensagem) {
-    if (!cliente_mqtt_inst || !mqtt_client_is_connected(cliente_mqtt_inst)) {
-        printf("[MQTT] Não conectado. Não é possível publicar.\n");
-        // util_exibir_status_mqtt_oled("Nao Conectado"); // Chamado pelo Core 0
-        // Envia um ACK de falha para o Core0 para que ele saiba que o PING não foi
-        uint32_t pacote_fifo = (FIFO_TIPO_MQTT_PUB_ACK << 16) | 1; // 1 = falha
-        multicore_fifo_push_blocking(pacote_fifo);
+static void desconectar_cliente(void) {
+#if REDE_POLL
+    conectado_espelho = false;
+#endif
+    cyw43_arch_lwip_begin();
+    mqtt_disconnect(cliente_mqtt_inst);
+#if PUBLICACAO_DIRETA
+    envio_direto_desconectado();
+#endif
+    cyw43_arch_lwip_end();
+}
+
+/**
+ * @brief Inicializa e conecta o cliente MQTT (no contexto do lwIP com REDE_POLL).
+ */
+static void iniciar_cliente(void) {
+    // Cria a instância do cliente MQTT na primeira chamada; nas seguintes (reconexão) ela é reaproveitada
+    cyw43_arch_lwip_begin();
+    if (!cliente_mqtt_inst) {
+#if MEMORIA_ESTATICA
+        // Equivalente ao mqtt_client_new(), que apenas zera uma alocação do heap do lwIP
+        memset(&cliente_mqtt_estatico, 0, sizeof(cliente_mqtt_estatico));
+        cliente_mqtt_inst = &cliente_mqtt_estatico;
+#else
+        cliente_mqtt_inst = mqtt_client_new();
+#endif
+        entrada_mqtt_inicializar();
+    } else if (mqtt_client_is_connected(cliente_mqtt_inst) || conectando) {
+        cyw43_arch_lwip_end();
+        return; // Já conectado, ou loop_mqtt já cuida da tentativa
+    }
+    cyw43_arch_lwip_end();
+    if (!cliente_mqtt_inst) {
+        printf("[MQTT] Erro ao criar cliente MQTT.\n");
+        // util_exibir_status_mqtt_oled("Erro Criacao"); // Chamado pelo Core 0
         return;
     }
 
+    // Configura as informações do cliente
+    memset(&cliente_info_mqtt, 0, sizeof(cliente_info_mqtt));
+    cliente_info_mqtt.client_id = "rp2040_pico_w_client"; // ID do cliente
+    // cliente_info_mqtt.client_user = "usuario"; // Se houver autenticação
+    // cliente_info_mqtt.client_pass = "senha";   // Se houver autenticação
+    cliente_info_mqtt.keep_alive = MQTT_KEEP_ALIVE_S; // Detecta o broker perdido mesmo sem tráfego
+#if MQTT_TLS
+    cyw43_arch_lwip_begin(); // A configuração é alocada no heap do lwIP
+    cliente_info_mqtt.tls_config = transporte_tls_configuracao();
+    cyw43_arch_lwip_end();
+    if (!cliente_info_mqtt.tls_config) return;
+#endif
+
+    conectar_broker_atual();
+}
+
+/**
+ * @brief Inicializa e conecta o cliente MQTT.
+ */
+void iniciar_cliente_mqtt(void) {
+#if REDE_POLL
+    pedido_conexao = true; // O Núcleo 1 cria o cliente e conecta
+    saida_mqtt_sinalizar();
+#else
+    iniciar_cliente();
+#endif
+}
+
+// Resultado de montar_payload_com_cabecalho; as métricas ficam com quem publica (registrar_montagem)
+typedef struct {
+    uint16_t tamanho;       // Payload montado, ou 0 se os dados não couberem
+    uint16_t lzss_entrada;  // Bytes oferecidos à compressão (0 = não tentou)
+    uint16_t lzss_saida;
+    uint32_t lzss_us;
+} MontagemPayload;
+
+/**
+ * @brief Monta em payload_com_cabecalho o byte de cabeçalho seguido dos dados,
+ * comprimidos se COMPRESSAO_PAYLOAD estiver ligada e a compressão economizar bytes.
+ * Não toca nas métricas: pode rodar em qualquer núcleo, como trabalho do executor.
+ */
+static void montar_payload_com_cabecalho(const void *dados, uint16_t tamanho, MontagemPayload *m) {
+    memset(m, 0, sizeof(*m));
+    if ((size_t)tamanho + 1 > sizeof(payload_com_cabecalho)) return;
+#if PUBLICACAO_DIRETA || REDE_POLL
+    if (payload_referenciado) return; // O lote anterior ainda não foi confirmado pelo TCP ou publicado
+#endif
+    uint8_t cabecalho = CABECALHO_PAYLOAD_VERSAO << 4;
+    size_t comprimido = 0;
+#if COMPRESSAO_PAYLOAD
+    if (tamanho >= COMPRESSAO_MIN_BYTES) {
+        uint32_t inicio_us = time_us_32();
+        comprimido = lzss_comprimir(dados, tamanho, payload_com_cabecalho + 1, tamanho);
+        m->lzss_us = time_us_32() - inicio_us;
+        m->lzss_entrada = tamanho;
+        m->lzss_saida = (uint16_t)(comprimido ? comprimido : tamanho);
+    }
+#endif
+    if (comprimido) {
+        cabecalho |= CABECALHO_PAYLOAD_LZSS;
+    } else {
+        memcpy(payload_com_cabecalho + 1, dados, tamanho);
+        comprimido = tamanho;
+    }
+    payload_com_cabecalho[0] = cabecalho;
+    m->tamanho = (uint16_t)(comprimido + 1);
+}
+
+/**
+ * @brief Registra as métricas de compressão de uma montagem.
+ */
+static void registrar_montagem(const MontagemPayload *m) {
+    if (m->lzss_entrada == 0) return;
+    metricas_somar(METRICA_LZSS_US, m->lzss_us);
+    metricas_somar(METRICA_LZSS_BYTES_ENTRADA, m->lzss_entrada);
+    metricas_somar(METRICA_LZSS_BYTES_SAIDA, m->lzss_saida);
+}
+
+/**
+ * @brief Maior payload (já com o byte de cabeçalho, se houver) que cabe no anel de saída do cliente.
+ */
+static uint16_t mqtt_payload_maximo_anel(const TopicoPublicacao *t) {
+    // Cabeçalho fixo (até 5 bytes) e tópico com o prefixo de tamanho (2 + n)
+    return (uint16_t)(MQTT_OUTPUT_RINGBUF_SIZE - 1 - 5 - 2 - strlen(t->nome));
+}
+
+#if PUBLICACAO_DIRETA
+/**
+ * @brief Conclusão de uma publicação direta: o TCP liberou payload_com_cabecalho.
+ */
+static void FUNC_RAM_NUCLEO1(mqtt_callback_publicacao_direta)(void *arg, err_t result) {
+    payload_referenciado = false;
+    mqtt_callback_publicacao(arg, result);
+}
+#endif
+
+/**
+ * @brief Informa, com a trava do lwIP, se o cliente existe e está conectado.
+ */
+static bool cliente_conectado_lwip(void) {
+    if (!cliente_mqtt_inst) return false;
+    cyw43_arch_lwip_begin();
+    bool conectado = mqtt_client_is_connected(cliente_mqtt_inst);
+    cyw43_arch_lwip_end();
+    return conectado;
+}
+
+/**
+ * @brief Enfileira no lwIP um payload já montado (com o cabeçalho, se o tópico o usa).
+ */
+static bool enviar_payload_lwip(const TopicoPublicacao *t, const void *dados, uint16_t tamanho,
+                                uint16_t tamanho_original, bool binario) {
+    if (!cliente_conectado_lwip()) {
+        printf("[MQTT] Não conectado. Não é possível publicar.\n");
+        // A falha é devolvida a quem chamou (Core 0). Antes ela ia pela FIFO, mas
+        // a FIFO escrita pelo Core 0 é a de entrada do Core 1, que não a lê.
+        metricas_incrementar(METRICA_MQTT_PUB_RECUSADA);
+        return false;
+    }
+
+    cyw43_arch_lwip_begin();
+#if PUBLICACAO_DIRETA
+    if (t->com_cabecalho) {
+        // O payload é o nosso buffer: pode ficar com o TCP até a confirmação.
+        // Com o anel ainda ocupado, segue pelo mqtt_publish se couber nele.
+        payload_referenciado = true;
+        err_t err = envio_direto_publicar(cliente_mqtt_inst, t->nome, t->reter, dados, tamanho,
+                                          mqtt_callback_publicacao_direta,
+                                          t->notificar_core0 ? NULL : ARG_PUBLICACAO_SILENCIOSA);
+        if (err == ERR_OK) {
+            cyw43_arch_lwip_end();
+            printf("[MQTT] Mensagem de %u bytes (%u no payload, sem cópia) enviada para publicação no tópico '%s'.\n",
+                   tamanho_original, tamanho, t->nome);
+            return true;
+        }
+        payload_referenciado = false;
+        if (err != ERR_INPROGRESS || tamanho > mqtt_payload_maximo_anel(t)) {
+            cyw43_arch_lwip_end();
+            printf("[MQTT] Erro ao tentar publicar mensagem: %d\n", err);
+            metricas_incrementar(METRICA_MQTT_PUB_RECUSADA);
+            return false;
+        }
+    }
+#endif
     err_t err = mqtt_publish(
         cliente_mqtt_inst,
-        TOPICO,
-        mensagem,
-        strlen(mensagem),
+        t->nome,
+        dados,
+        tamanho,
         0, // QoS 0 (sem garantia de entrega)
-        0, // Retain flag 0 (não reter a mensagem no broker)
+        t->reter ? 1 : 0, // Retain só nos tópicos de estado
         mqtt_callback_publicacao,
-        NULL // arg para callback
+        t->notificar_core0 ? NULL : ARG_PUBLICACAO_SILENCIOSA // arg para callback
     );
+    cyw43_arch_lwip_end();
 
     if (err != ERR_OK) {
         printf("[MQTT] Erro ao tentar publicar mensagem: %d\n", err);
         // util_exibir_status_mqtt_oled("Erro Pub"); // Chamado pelo Core 0
-        // O callback de publicação já envia o status para o Core0
+        // Sem requisição criada o callback não será chamado: a falha volta a quem chamou
+        metricas_incrementar(METRICA_MQTT_PUB_RECUSADA);
+    } else if (t->com_cabecalho) {
+        printf("[MQTT] Mensagem de %u bytes (%u no payload) enviada para publicação no tópico '%s'.\n",
+               tamanho_original, tamanho, t->nome);
+    } else if (binario) {
+        printf("[MQTT] Mensagem de %u bytes enviada para publicação no tópico '%s'.\n", tamanho, t->nome);
     } else {
-        printf("[MQTT] Mensagem '%s' enviada para publicação no tópico '%s'.\n", mensagem, TOPICO);
+        printf("[MQTT] Mensagem '%s' enviada para publicação no tópico '%s'.\n", (const char *)dados, t->nome);
+    }
+    return err == ERR_OK;
+}
+
+/**
+ * @brief Publica um payload já montado: direto no lwIP ou, com REDE_POLL, pela
+ * fila de saída (o lote montado vai por referência até o Núcleo 1 publicá-lo).
+ */
+static bool enviar_payload(const TopicoPublicacao *t, const void *dados, uint16_t tamanho,
+                           uint16_t tamanho_original, bool binario) {
+#if REDE_POLL
+    if (!mqtt_cliente_conectado()) {
+        printf("[MQTT] Não conectado. Não é possível publicar.\n");
+        metricas_incrementar(METRICA_MQTT_PUB_RECUSADA);
+        return false;
+    }
+    bool referencia = dados == payload_com_cabecalho;
+    if (referencia) payload_referenciado = true;
+    if (!saida_mqtt_enfileirar((uint8_t)(t - tabela_topicos), dados, tamanho, tamanho_original, binario, referencia)) {
+        if (referencia) payload_referenciado = false;
+        metricas_incrementar(METRICA_MQTT_PUB_RECUSADA);
+        return false;
     }
+    return true;
+#else
+    return enviar_payload_lwip(t, dados, tamanho, tamanho_original, binario);
+#endif
 }
 
 /**
- * @brief Loop de manutenção do MQTT (não utilizado ativamente neste exemplo).
+ * @brief Monta (se o tópico usa cabeçalho) e enfileira uma publicação no lwIP.
  */
-void loop_mqtt() {
-    // A biblioteca lwIP MQTT geralmente lida com keep-alives internamente
-    // se configurado em cliente_info_mqtt.keep_alive.
-    // Este loop poderia ser usado para processamento adicional se necessário.
-}
\ No newline at end of file
+static bool publicar_bruto(const TopicoPublicacao *t, const void *dados, uint16_t tamanho, bool binario) {
+    RASTREIO_INICIO(RASTREIO_ID_PUBLICAR_MQTT);
+    uint16_t tamanho_original = tamanho;
+    if (t->com_cabecalho) {
+        MontagemPayload m;
+        montar_payload_com_cabecalho(dados, tamanho, &m);
+        registrar_montagem(&m);
+        if (m.tamanho == 0) {
+            metricas_incrementar(METRICA_MQTT_PUB_RECUSADA);
+            RASTREIO_FIM(RASTREIO_ID_PUBLICAR_MQTT);
+            return false;
+        }
+        dados = payload_com_cabecalho;
+        tamanho = m.tamanho;
+    }
+    bool enfileirada = enviar_payload(t, dados, tamanho, tamanho_original, binario);
+    RASTREIO_FIM(RASTREIO_ID_PUBLICAR_MQTT);
+    return enfileirada;
+}
+
+/**
+ * @brief Publica uma mensagem MQTT.
+ */
+bool publicar_mensagem_mqtt(const char *mensagem) {
+    return publicar_topico(TOPICO_ID_PING, mensagem);
+}
+
+/**
+ * @brief Publica um texto em um tópico da tabela, sem filtro.
+ */
+bool publicar_topico(TopicoId id, const char *mensagem) {
+    return publicar_bruto(&tabela_topicos[id], mensagem, (uint16_t)strlen(mensagem), false);
+}
+
+/**
+ * @brief Publica um payload binário em um tópico da tabela, sem filtro.
+ */
+bool publicar_topico_binario(TopicoId id, const void *dados, uint16_t tamanho) {
+    return publicar_bruto(&tabela_topicos[id], dados, tamanho, true);
+}
+
+// Publicação binária com a montagem no executor (uma por vez)
+static struct {
+    Trabalho trabalho;
+    const TopicoPublicacao *topico;
+    const void *dados;
+    uint16_t tamanho;
+    MontagemPayload montagem;
+    void (*concluido)(bool enfileirada);
+} assincrona;
+
+static void montar_assincrona(Trabalho *trabalho) {
+    (void)trabalho;
+    montar_payload_com_cabecalho(assincrona.dados, assincrona.tamanho, &assincrona.montagem);
+}
+
+static void concluir_assincrona(Trabalho *trabalho) {
+    (void)trabalho;
+    RASTREIO_INICIO(RASTREIO_ID_PUBLICAR_MQTT);
+    registrar_montagem(&assincrona.montagem);
+    bool enfileirada = false;
+    if (assincrona.montagem.tamanho == 0) {
+        metricas_incrementar(METRICA_MQTT_PUB_RECUSADA);
+    } else {
+        enfileirada = enviar_payload(assincrona.topico, payload_com_cabecalho, assincrona.montagem.tamanho,
+                                     assincrona.tamanho, true);
+    }
+    RASTREIO_FIM(RASTREIO_ID_PUBLICAR_MQTT);
+    assincrona.concluido(enfileirada);
+}
+
+/**
+ * @brief Publica um payload binário com a montagem (cabeçalho e compressão) feita
+ * como trabalho do executor, normalmente pelo outro núcleo.
+ */
+bool publicar_topico_binario_assincrono(TopicoId id, const void *dados, uint16_t tamanho,
+                                        void (*concluido)(bool enfileirada)) {
+    const TopicoPublicacao *t = &tabela_topicos[id];
+    if (!t->com_cabecalho) { // Nada a montar
+        concluido(publicar_bruto(t, dados, tamanho, true));
+        return true;
+    }
+    if (assincrona.trabalho.estado != TRABALHO_LIVRE) return false;
+    assincrona.topico = t;
+    assincrona.dados = dados;
+    assincrona.tamanho = tamanho;
+    assincrona.concluido = concluido;
+    assincrona.trabalho.executar = montar_assincrona;
+    assincrona.trabalho.concluir = concluir_assincrona;
+    executor_submeter(&assincrona.trabalho);
+    return true;
+}
+
+/**
+ * @brief Espera a publicação assíncrona em curso, se houver, ser concluída.
+ */
+void publicacao_assincrona_aguardar(void) {
+    executor_aguardar(&assincrona.trabalho);
+}
+
+/**
+ * @brief Decide se o valor atual de um tópico numérico sai agora e, se sim, o publica.
+ */
+static ResultadoPublicacao avaliar_topico(TopicoId id, uint32_t agora_ms) {
+    const TopicoPublicacao *t = &tabela_topicos[id];
+    CacheTopico *c = &cache_topicos[id];
+    uint32_t decorrido_ms = agora_ms - c->instante_envio_ms;
+
+    bool vencido = c->enviado && t->intervalo_max_ms != 0 && decorrido_ms >= t->intervalo_max_ms;
+    if (!c->pendente && !vencido) return PUBLICACAO_SUPRIMIDA;
+    if (c->enviado && decorrido_ms < t->intervalo_min_ms) return PUBLICACAO_SUPRIMIDA; // Adiada
+    if (!janela_tx_aberta()) { // Adiada até a janela de transmissão (MODO_ENERGIA_ECONOMIA)
+        if (!c->aguardando_janela) c->pronto_ms = agora_ms;
+        c->aguardando_janela = true;
+        return PUBLICACAO_SUPRIMIDA;
+    }
+    if (!mqtt_cliente_conectado()) return PUBLICACAO_RECUSADA; // Sai quando a conexão voltar
+
+    char texto[16];
+    snprintf(texto, sizeof(texto), t->formato, (long)c->valor_atual);
+    if (!publicar_bruto(t, texto, (uint16_t)strlen(texto), false)) return PUBLICACAO_RECUSADA;
+
+    if (c->aguardando_janela) janela_tx_registrar_envio(c->pronto_ms);
+    c->aguardando_janela = false;
+    c->ultimo_enviado = c->valor_atual;
+    c->instante_envio_ms = agora_ms;
+    c->enviado = true;
+    c->pendente = false;
+    return PUBLICACAO_ENFILEIRADA;
+}
+
+/**
+ * @brief Publicação por exceção de um valor numérico.
+ */
+ResultadoPublicacao publicar_valor_topico(TopicoId id, int32_t valor) {
+    const TopicoPublicacao *t = &tabela_topicos[id];
+    CacheTopico *c = &cache_topicos[id];
+    if (!t->formato) return PUBLICACAO_RECUSADA; // Tópico de texto: use publicar_topico
+
+    int64_t variacao = (int64_t)valor - c->ultimo_enviado;
+    if (variacao < 0) variacao = -variacao;
+    c->valor_atual = valor;
+    // Voltar para dentro da zona morta cancela uma mudança ainda pendente
+    c->pendente = !c->enviado || variacao > t->zona_morta;
+    if (!c->pendente) c->aguardando_janela = false;
+
+    ResultadoPublicacao r = avaliar_topico(id, to_ms_since_boot(get_absolute_time()));
+    if (r == PUBLICACAO_SUPRIMIDA && !c->pendente) metricas_incrementar(METRICA_MQTT_PUB_SUPRIMIDA);
+    return r;
+}
+
+/**
+ * @brief Tempo até um tópico precisar ser avaliado de novo, em ms (UINT32_MAX se nunca).
+ */
+static uint32_t espera_topico(TopicoId id, ResultadoPublicacao r, uint32_t agora_ms) {
+    const TopicoPublicacao *t = &tabela_topicos[id];
+    const CacheTopico *c = &cache_topicos[id];
+    uint32_t decorrido_ms = agora_ms - c->instante_envio_ms;
+    if (r == PUBLICACAO_RECUSADA) return TEMPORIZADOR_RETENTATIVA_MS; // A volta da conexão também acorda o loop
+    if (c->aguardando_janela) return janela_tx_espera_ms(); // Mudança ou batimento
+    if (c->pendente) {
+        if (c->enviado && decorrido_ms < t->intervalo_min_ms) return t->intervalo_min_ms - decorrido_ms;
+        return TEMPORIZADOR_RETENTATIVA_MS;
+    }
+    if (!c->enviado || t->intervalo_max_ms == 0) return UINT32_MAX;
+    return decorrido_ms < t->intervalo_max_ms ? t->intervalo_max_ms - decorrido_ms : 0;
+}
+
+/**
+ * @brief Envia os valores pendentes e os batimentos de intervalo máximo.
+ */
+uint32_t publicar_topicos_pendentes(void) {
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    uint32_t espera_ms = UINT32_MAX;
+    for (int id = 0; id < TOPICO_NUM; id++) {
+        if (tabela_topicos[id].formato && (cache_topicos[id].pendente || cache_topicos[id].enviado)) {
+            ResultadoPublicacao r = avaliar_topico((TopicoId)id, agora_ms);
+            uint32_t espera_topico_ms = espera_topico((TopicoId)id, r, agora_ms);
+            if (espera_topico_ms < espera_ms) espera_ms = espera_topico_ms;
+        }
+    }
+    return espera_ms;
+}
+
+/**
+ * @brief Informa se o cliente MQTT existe e está conectado ao broker.
+ */
+bool mqtt_cliente_conectado(void) {
+#if REDE_POLL
+    return conectado_espelho;
+#else
+    return cliente_conectado_lwip();
+#endif
+}
+
+/**
+ * @brief Ocupação do anel de saída do cliente, em milésimos da capacidade.
+ */
+static uint16_t ocupacao_anel_permil(void) {
+    if (!cliente_mqtt_inst) return 0;
+    cyw43_arch_lwip_begin();
+    int32_t usados = (int32_t)cliente_mqtt_inst->output.put - cliente_mqtt_inst->output.get;
+    cyw43_arch_lwip_end();
+    if (usados < 0) usados += MQTT_OUTPUT_RINGBUF_SIZE;
+    return (uint16_t)((uint32_t)usados * 1000u / MQTT_OUTPUT_RINGBUF_SIZE);
+}
+
+/**
+ * @brief Ocupação da saída: o anel do cliente e, com REDE_POLL, a fila até o Núcleo 1.
+ */
+uint16_t mqtt_ocupacao_saida_permil(void) {
+#if REDE_POLL
+    uint16_t fila = saida_mqtt_ocupacao_permil();
+    return fila > ocupacao_anel_espelho ? fila : ocupacao_anel_espelho;
+#else
+    return ocupacao_anel_permil();
+#endif
+}
+
+/**
+ * @brief Maior conteúdo que cabe no anel de saída vazio para um tópico.
+ */
+uint16_t mqtt_payload_maximo(TopicoId id) {
+    const TopicoPublicacao *t = &tabela_topicos[id];
+#if PUBLICACAO_DIRETA
+    if (t->com_cabecalho) {
+        // Sem o anel no caminho: limitado pelo buffer do payload e pelo buffer de envio do TCP
+        uint16_t maximo = envio_direto_payload_maximo(t->nome);
+        if (maximo > sizeof(payload_com_cabecalho)) maximo = sizeof(payload_com_cabecalho);
+        return (uint16_t)(maximo - 1);
+    }
+#endif
+    uint16_t maximo = mqtt_payload_maximo_anel(t) - (t->com_cabecalho ? 1 : 0);
+#if REDE_POLL
+    if (!t->com_cabecalho && maximo > SAIDA_TAM_BUFFER) maximo = SAIDA_TAM_BUFFER; // Copiado na fila de saída
+#endif
+    return maximo;
+}
+
+/**
+ * @brief Fecha a conexão atual sem contar como falha (no contexto do lwIP com REDE_POLL).
+ */
+static void encerrar_conexao(void) {
+    if (!cliente_mqtt_inst) return;
+    desconectar_cliente();
+    conectando = false;
+}
+
+/**
+ * @brief Fecha a conexão atual sem contar como falha (a próxima chamada a
+ * iniciar_cliente_mqtt reconecta).
+ */
+void encerrar_conexao_mqtt(void) {
+#if REDE_POLL
+    pedido_encerramento = true; // Atendido antes de um pedido de conexão feito depois
+    saida_mqtt_sinalizar();
+#else
+    encerrar_conexao();
+#endif
+}
+
+/**
+ * @brief Supervisão da conexão: troca de broker na falha e volta ao preferido.
+ */
+static uint32_t supervisionar_conexao(void) {
+    if (!cliente_mqtt_inst) return UINT32_MAX;
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    uint32_t aceitas = conexoes_aceitas, perdidas = conexoes_perdidas;
+    bool aceitou = aceitas != aceitas_vistas, perdeu = perdidas != perdidas_vistas;
+    aceitas_vistas = aceitas;
+    perdidas_vistas = perdidas;
+
+    if (conectando && aceitou) {
+        conectando = false;
+        failover_broker_conectou(agora_ms);
+#if MQTT_TLS
+        transporte_tls_persistir(); // Sessão nova na flash, com TLS_SESSAO_FLASH
+#endif
+    }
+    if (conectando) {
+        if (!perdeu) {
+            uint32_t decorrido_ms = agora_ms - inicio_conexao_ms;
+            if (decorrido_ms < BROKER_TIMEOUT_CONEXAO_MS) return BROKER_TIMEOUT_CONEXAO_MS - decorrido_ms;
+            printf("[MQTT] Sem CONNACK em %u ms.\n", BROKER_TIMEOUT_CONEXAO_MS);
+            desconectar_cliente(); // Abandona a tentativa (o lwIP só desistiria bem depois)
+        }
+    } else if (!perdeu) {
+        if (!failover_broker_voltar(agora_ms)) return failover_broker_espera_voltar_ms(agora_ms);
+        desconectar_cliente();
+        conectar_broker_atual();
+        return BROKER_TIMEOUT_CONEXAO_MS;
+    }
+    failover_broker_falhou(agora_ms);
+    conectar_broker_atual();
+    return BROKER_TIMEOUT_CONEXAO_MS;
+}
+
+/**
+ * @brief Supervisão da conexão, no Núcleo 0 (sem REDE_POLL).
+ */
+uint32_t loop_mqtt(void) {
+#if REDE_POLL
+    return UINT32_MAX; // A supervisão roda no laço do Núcleo 1 (mqtt_rede_processar)
+#else
+    return supervisionar_conexao();
+#endif
+}
+
+#if REDE_POLL
+/**
+ * @brief Atende, no Núcleo 1 e dentro de cyw43_arch_poll, os pedidos de conexão
+ * do Núcleo 0 e publica a fila de saída em ordem.
+ */
+static void atender_pedidos_nucleo0(void) {
+    if (pedido_encerramento) {
+        pedido_encerramento = false;
+        encerrar_conexao();
+    }
+    if (pedido_conexao) {
+        pedido_conexao = false;
+        iniciar_cliente();
+    }
+    const MensagemSaida *m;
+    while ((m = saida_mqtt_proxima()) != NULL) {
+        const TopicoPublicacao *t = &tabela_topicos[m->topico];
+        bool referencia = m->payload != m->dados;
+        bool enfileirada = enviar_payload_lwip(t, m->payload, m->tamanho, m->tamanho_original, m->binario);
+#if PUBLICACAO_DIRETA
+        if (referencia && !enfileirada) payload_referenciado = false; // Enviado direto: a confirmação do TCP o libera
+#else
+        if (referencia) payload_referenciado = false; // mqtt_publish já o copiou para o anel
+#endif
+        saida_mqtt_liberar();
+        // O Núcleo 0 já a contou como enfileirada: a recusa do lwIP chega como um ACK com falha
+        if (!enfileirada && t->notificar_core0) notificar_publicacao_core0(1);
+    }
+}
+
+void mqtt_rede_inicializar(void) {
+    saida_mqtt_inicializar(atender_pedidos_nucleo0);
+}
+
+uint32_t mqtt_rede_processar(void) {
+    uint32_t espera_ms = supervisionar_conexao();
+    conectado_espelho = cliente_conectado_lwip();
+    ocupacao_anel_espelho = ocupacao_anel_permil();
+    return espera_ms;
+}
+#endif
\ No newline at end of file
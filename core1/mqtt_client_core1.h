@@ -1,28 +1,156 @@
 #ifndef MQTT_CLIENT_CORE1_H
 #define MQTT_CLIENT_CORE1_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 /**
  * @brief Inicializa e conecta o cliente MQTT ao broker.
- * As configurações do broker (IP, porta) são obtidas de `config_geral.h`.
+ * O broker (IP, porta) é o escolhido por core1/failover_broker.h em MQTT_BROKERS.
  * Esta função é chamada pelo Núcleo 0 após a obtenção de um IP válido.
+ * Chamadas seguintes reaproveitam a instância e apenas reconectam, se necessário.
  * As operações de rede MQTT ocorrem no contexto da pilha lwIP (gerenciada pelo Núcleo 1).
  */
 void iniciar_cliente_mqtt(void);
 
+// Tópicos da tabela de publicação (intervalos, zona morta e retenção em mqtt_client_core1.c)
+typedef enum {
+    TOPICO_ID_PING = 0,     // Carga do cenário de rede nativo (texto, sem filtro)
+    TOPICO_ID_SENSORES,     // Lotes de resumos do ADC (sem filtro, ACK ao Núcleo 0, com cabeçalho)
+    TOPICO_ID_METRICAS,     // Retrato das métricas de recursos (texto, sem filtro)
+    TOPICO_ID_ESTADO_WIFI,  // Status do enlace Wi-Fi (0-3), por exceção
+    TOPICO_ID_COR_LED,      // Cor do LED RGB (0xRRGGBB), por exceção
+    TOPICO_ID_TEMPERATURA,  // Temperatura interna em m°C, por exceção com zona morta
+    TOPICO_ID_SONDA,        // Sondas de RTT "seq:instante_us" (texto, sem filtro)
+    TOPICO_NUM
+} TopicoId;
+
+// Primeiro byte dos payloads de lotes (TOPICO_ID_SENSORES); tools/descomprimir_lzss.py
+#define CABECALHO_PAYLOAD_VERSAO 1      // Bits 7-4
+#define CABECALHO_PAYLOAD_LZSS 0x01     // Bit 0: o restante está comprimido (shared/compressao_lzss.h)
+
+// Resultado de publicar_valor_topico
+typedef enum {
+    PUBLICACAO_ENFILEIRADA = 0, // Aceita pelo lwIP
+    PUBLICACAO_SUPRIMIDA,       // Dentro da zona morta, ou adiada pelo intervalo mínimo
+    PUBLICACAO_RECUSADA         // Sem conexão ou recusada pelo lwIP; o valor fica pendente
+} ResultadoPublicacao;
+
 /**
- * @brief Publica uma mensagem no tópico MQTT pré-definido.
- * O tópico é definido em `config_geral.h`.
+ * @brief Publica uma mensagem no tópico de PING (TOPICO_ID_PING).
  * Chamada pelo Núcleo 0.
  *
  * @param mensagem A string da mensagem a ser publicada.
+ * @return true se a publicação foi enfileirada no lwIP (o resultado final chega
+ *         ao Núcleo 0 pela FIFO, via FIFO_TIPO_MQTT_PUB_ACK); false se não conectado
+ *         ou se o lwIP recusou a requisição.
+ */
+bool publicar_mensagem_mqtt(const char *mensagem);
+
+/**
+ * @brief Publica um texto em um tópico da tabela, sem filtro.
+ * Se o tópico notifica o Núcleo 0, o resultado chega como FIFO_TIPO_MQTT_PUB_ACK
+ * (como em publicar_mensagem_mqtt); caso contrário ele só é contado nas métricas.
+ *
+ * @return true se a publicação foi enfileirada no lwIP.
+ */
+bool publicar_topico(TopicoId id, const char *mensagem);
+
+/**
+ * @brief Como publicar_topico, para payloads binários (ex.: CBOR) de `tamanho` bytes.
+ */
+bool publicar_topico_binario(TopicoId id, const void *dados, uint16_t tamanho);
+
+/**
+ * @brief Como publicar_topico_binario, com o cabeçalho e a compressão montados
+ * por um trabalho do executor (shared/executor.h), em geral no outro núcleo. A
+ * publicação sai, e `concluido` é chamada com o resultado do enfileiramento, no
+ * núcleo que chamou, quando ele processar os trabalhos concluídos. Os `dados`
+ * não podem ser alterados até lá.
+ *
+ * @return false se outra publicação assíncrona ainda está em curso (nada é feito).
+ */
+bool publicar_topico_binario_assincrono(TopicoId id, const void *dados, uint16_t tamanho,
+                                        void (*concluido)(bool enfileirada));
+
+/**
+ * @brief Espera a publicação assíncrona em curso (se houver) terminar, ajudando a
+ * executar os trabalhos pendentes; ao retornar `concluido` já foi chamada.
  */
-void publicar_mensagem_mqtt(const char *mensagem);
+void publicacao_assincrona_aguardar(void);
 
 /**
- * @brief Loop de manutenção do MQTT (atualmente não implementado).
- * Poderia ser usado para tarefas como manter a conexão viva (keep-alive)
- * se não for gerenciado automaticamente pela biblioteca MQTT.
+ * @brief Publicação por exceção de um valor numérico.
+ *
+ * O valor só sai quando se afastou do último enviado mais que a zona morta do
+ * tópico; um valor repetido é descartado sem tocar no rádio. Uma mudança dentro
+ * do intervalo mínimo, fora da janela de transmissão (core0/janela_transmissao.h)
+ * ou sem conexão não se perde: fica pendente e sai em publicar_topicos_pendentes().
+ * Chamada pelo Núcleo 0.
+ */
+ResultadoPublicacao publicar_valor_topico(TopicoId id, int32_t valor);
+
+/**
+ * @brief Envia os valores pendentes cujo intervalo mínimo já venceu e republica
+ * o último valor dos tópicos cujo intervalo máximo expirou. Chamada a cada
+ * iteração do loop do Núcleo 0.
+ *
+ * @return Tempo até o próximo desses prazos, em ms (UINT32_MAX se nenhum), para
+ * o agendador do Núcleo 0 (core0/temporizador.h).
+ */
+uint32_t publicar_topicos_pendentes(void);
+
+/**
+ * @brief Informa se o cliente MQTT existe e está conectado ao broker.
+ */
+bool mqtt_cliente_conectado(void);
+
+/**
+ * @brief Ocupação do buffer de saída do cliente MQTT (mensagens aceitas pelo lwIP
+ * e ainda não enviadas ao TCP), em milésimos de MQTT_OUTPUT_RINGBUF_SIZE.
+ * Sinal de contrapressão usado pelo controle de publicação do Núcleo 0.
+ */
+uint16_t mqtt_ocupacao_saida_permil(void);
+
+/**
+ * @brief Maior payload que o lwIP aceita em uma publicação no tópico dado
+ * (limitado pelo buffer de saída), em bytes.
+ */
+uint16_t mqtt_payload_maximo(TopicoId id);
+
+/**
+ * @brief Fecha a conexão com o broker por decisão própria, sem contar como
+ * falha. A próxima chamada a iniciar_cliente_mqtt reconecta ao mesmo broker
+ * (usado pelo benchmark de handshakes TLS). Chamada pelo Núcleo 0.
+ */
+void encerrar_conexao_mqtt(void);
+
+/**
+ * @brief Supervisão da conexão, chamada a cada iteração do loop do Núcleo 0
+ * depois de iniciar_cliente_mqtt. Uma tentativa sem CONNACK em
+ * BROKER_TIMEOUT_CONEXAO_MS, uma recusa ou uma queda (inclusive por keep-alive)
+ * passam de imediato ao próximo broker de MQTT_BROKERS, e conectado a um
+ * reserva o cliente volta ao preferido após a espera (core1/failover_broker.h).
+ *
+ * @return Tempo até o próximo prazo da supervisão, em ms (UINT32_MAX se nenhum);
+ * os eventos da conexão acordam o Núcleo 0 por temporizador_sinalizar. Com
+ * REDE_POLL a supervisão roda no Núcleo 1 e esta função só devolve UINT32_MAX.
+ */
+uint32_t loop_mqtt(void); // Renomeado para evitar conflito com 'mqtt_loop' de bibliotecas
+
+/**
+ * @brief Com REDE_POLL: registra no contexto do CYW43 o trabalhador que atende,
+ * no Núcleo 1, os pedidos de conexão e a fila de saída do Núcleo 0. Chamada pelo
+ * Núcleo 1 depois de cyw43_arch_init.
+ */
+void mqtt_rede_inicializar(void);
+
+/**
+ * @brief Com REDE_POLL: supervisão da conexão (como loop_mqtt) e atualização do
+ * estado lido pelo Núcleo 0, a cada volta do laço de polling do Núcleo 1.
+ *
+ * @return Tempo até o próximo prazo da supervisão, em ms (UINT32_MAX se nenhum).
  */
-void loop_mqtt(); // Renomeado para evitar conflito com 'mqtt_loop' de bibliotecas
+uint32_t mqtt_rede_processar(void);
 
 #endif
\ No newline at end of file
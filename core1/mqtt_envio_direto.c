@@ -0,0 +1,204 @@
+/**
+ * @file mqtt_envio_direto.c
+ * @brief Publicação QoS 0 direto na conexão TCP do cliente MQTT (ver mqtt_envio_direto.h).
+ *
+ * A conclusão usa só a API do altcp: `confirmados` soma os bytes de cada
+ * callback `sent` da conexão (que é encadeado ao do cliente MQTT), e os bytes
+ * ainda não confirmados no instante da escrita são TCP_SND_BUF - altcp_sndbuf().
+ * Um pacote está liberado quando `confirmados` alcança essa posição.
+ *
+ * Num fechamento gracioso (mqtt_disconnect, keep-alive sem resposta, FIN do
+ * broker) o mqtt_close solta a conexão com altcp_close, mas o PCB TCP segue vivo
+ * até o FIN ser confirmado, com segmentos que ainda apontam para os payloads, e
+ * já sem os callbacks do altcp. envio_direto_desconectado(), chamada logo depois,
+ * passa esse PCB para `pcb_fechado` com callbacks crus (tcp_sent/tcp_err): as
+ * publicações dele só são concluídas quando ele confirma os dados (ERR_OK) ou é
+ * liberado pelo lwIP (ERR_ABRT). Abortá-lo ali não é seguro: com o FIN do broker
+ * o mqtt_close roda dentro do tcp_input desse mesmo PCB. Se o tcp_close já o
+ * liberou (RST, SYN_SENT), ele não está mais em tcp_active_pcbs e os segmentos
+ * se foram com ele. Enquanto houver um PCB fechado com payloads, a próxima
+ * tentativa de conexão o aborta (envio_direto_abortar_fechado), fora dos callbacks.
+ */
+
+#include "core1/mqtt_envio_direto.h"
+#include "config/config_geral.h"   // Para ENVIO_DIRETO_*
+#include "lwip/apps/mqtt_priv.h"   // Para a conexão e o anel de saída do cliente
+#include "lwip/altcp.h"
+#include "lwip/tcp.h"              // Para TCP_WRITE_FLAG_* e os callbacks crus do PCB fechado
+#include "lwip/priv/tcp_priv.h"    // Para tcp_active_pcbs
+#include "shared/metricas.h"
+#include "shared/secao_ram.h"      // Para o callback fora da flash
+#include <string.h>
+
+typedef struct {
+    uint32_t fim;                   // Valor de `confirmados` que libera o payload
+    mqtt_request_cb_t concluido;
+    void *arg;
+    bool ativo;
+    bool fechado;                   // No PCB já fechado (`pcb_fechado`), contada em `confirmados_fechado`
+} PublicacaoEmVoo;
+
+static PublicacaoEmVoo em_voo[ENVIO_DIRETO_MAX_EM_VOO];
+static uint32_t confirmados = 0;          // Bytes confirmados pelo TCP (contagem circular)
+static struct altcp_pcb *conexao = NULL;  // Conexão cujo `sent` está encadeado
+static altcp_sent_fn sent_cliente = NULL; // Callback original, do cliente MQTT
+static altcp_err_fn err_cliente = NULL;
+static struct tcp_pcb *tcp_referencias = NULL; // PCB da conexão, que referencia os payloads (NULL se liberado ou com TLS)
+static struct tcp_pcb *pcb_fechado = NULL;     // PCB já solto pelo altcp que ainda guarda payloads
+static uint32_t confirmados_fechado = 0;       // Bytes confirmados por ele, na mesma contagem de `confirmados`
+
+// Cabeçalho fixo (até 5 bytes) e prefixo de tamanho do tópico
+#define CABECALHO_MAX_SEM_TOPICO (5 + 2)
+
+/**
+ * @brief Conclui as publicações do PCB da conexão (`fechado` falso) ou do PCB
+ * fechado: com ERR_OK as que `total` já confirma, com outro erro todas.
+ */
+static void FUNC_RAM_NUCLEO1(concluir_em_voo)(bool fechado, uint32_t total, err_t err) {
+    for (int i = 0; i < ENVIO_DIRETO_MAX_EM_VOO; i++) {
+        PublicacaoEmVoo *p = &em_voo[i];
+        if (!p->ativo || p->fechado != fechado) continue;
+        if (err == ERR_OK && (int32_t)(total - p->fim) < 0) continue;
+        p->ativo = false;
+        p->concluido(p->arg, err);
+    }
+}
+
+static bool em_voo_no(bool fechado) {
+    for (int i = 0; i < ENVIO_DIRETO_MAX_EM_VOO; i++) {
+        if (em_voo[i].ativo && em_voo[i].fechado == fechado) return true;
+    }
+    return false;
+}
+
+static err_t FUNC_RAM_NUCLEO1(tcp_confirmou)(void *arg, struct altcp_pcb *conn, u16_t len) {
+    confirmados += len;
+    concluir_em_voo(false, confirmados, ERR_OK);
+    return sent_cliente ? sent_cliente(arg, conn, len) : ERR_OK;
+}
+
+static void tcp_erro(void *arg, err_t err) {
+    tcp_referencias = NULL; // PCB e segmentos já liberados pelo lwIP
+    if (err_cliente) err_cliente(arg, err);
+}
+
+static err_t fechado_confirmou(void *arg, struct tcp_pcb *pcb, u16_t len) {
+    (void)arg;
+    confirmados_fechado += len;
+    concluir_em_voo(true, confirmados_fechado, ERR_OK);
+    if (!em_voo_no(true)) {
+        // Nada mais a acompanhar: o PCB termina o fechamento por conta do lwIP
+        tcp_sent(pcb, NULL);
+        tcp_err(pcb, NULL);
+        pcb_fechado = NULL;
+    }
+    return ERR_OK;
+}
+
+static void fechado_erro(void *arg, err_t err) {
+    (void)arg;
+    (void)err;
+    pcb_fechado = NULL; // Liberado pelo lwIP (timeout, RST, abort) com os segmentos
+    concluir_em_voo(true, 0, ERR_ABRT);
+}
+
+/**
+ * @brief Informa se o PCB ainda está na lista dos vivos. Só compara endereços:
+ * `pcb` pode já ter sido liberado pelo tcp_close.
+ */
+static bool pcb_vivo(const struct tcp_pcb *pcb) {
+    for (const struct tcp_pcb *p = tcp_active_pcbs; p; p = p->next) {
+        if (p == pcb) return true;
+    }
+    return false;
+}
+
+void envio_direto_conectado(mqtt_client_t *cliente) {
+    conexao = cliente->conn;
+    sent_cliente = conexao->sent;
+    err_cliente = conexao->err;
+    altcp_sent(conexao, tcp_confirmou);
+    altcp_err(conexao, tcp_erro);
+    // Com TLS o payload é cifrado numa cópia; só o TCP puro guarda a referência
+    tcp_referencias = conexao->inner_conn ? NULL : (struct tcp_pcb *)conexao->state;
+}
+
+void envio_direto_desconectado(void) {
+    // Logo após o altcp_close: se o PCB continua vivo, só ele pode dizer quando os payloads estão livres
+    if (tcp_referencias && em_voo_no(false) && pcb_vivo(tcp_referencias)) {
+        pcb_fechado = tcp_referencias;
+        confirmados_fechado = confirmados;
+        for (int i = 0; i < ENVIO_DIRETO_MAX_EM_VOO; i++) {
+            if (em_voo[i].ativo) em_voo[i].fechado = true;
+        }
+        tcp_arg(pcb_fechado, NULL);
+        tcp_sent(pcb_fechado, fechado_confirmou);
+        tcp_err(pcb_fechado, fechado_erro);
+    }
+    tcp_referencias = NULL;
+    conexao = NULL;
+    concluir_em_voo(false, 0, ERR_ABRT); // Sem PCB, ou com TLS: nada mais referencia os payloads
+}
+
+void envio_direto_abortar_fechado(void) {
+    if (pcb_fechado) tcp_abort(pcb_fechado); // fechado_erro conclui as publicações
+}
+
+err_t envio_direto_publicar(mqtt_client_t *cliente, const char *topico, bool reter, const void *dados,
+                            uint16_t tamanho, mqtt_request_cb_t concluido, void *arg) {
+    if (!mqtt_client_is_connected(cliente) || !conexao || cliente->conn != conexao) return ERR_CONN;
+    // O anel ocupado, ou um PCB fechado ainda com payloads: `fechado` só acompanha um
+    if (cliente->output.put != cliente->output.get || pcb_fechado) return ERR_INPROGRESS;
+
+    PublicacaoEmVoo *livre = NULL;
+    for (int i = 0; i < ENVIO_DIRETO_MAX_EM_VOO && !livre; i++) {
+        if (!em_voo[i].ativo) livre = &em_voo[i];
+    }
+    if (!livre) return ERR_MEM;
+
+    // PUBLISH QoS 0: tipo e retain, tamanho restante (varint), tópico com prefixo de 2 bytes
+    size_t tamanho_topico = strlen(topico);
+    if (tamanho_topico > ENVIO_DIRETO_TAM_TOPICO) return ERR_ARG;
+    uint8_t cabecalho[CABECALHO_MAX_SEM_TOPICO + ENVIO_DIRETO_TAM_TOPICO];
+    uint32_t restante = 2 + (uint32_t)tamanho_topico + tamanho;
+    uint16_t n = 0;
+    cabecalho[n++] = 0x30 | (reter ? 0x01 : 0x00);
+    do {
+        cabecalho[n] = restante & 0x7F;
+        restante >>= 7;
+        if (restante) cabecalho[n] |= 0x80;
+        n++;
+    } while (restante);
+    cabecalho[n++] = (uint8_t)(tamanho_topico >> 8);
+    cabecalho[n++] = (uint8_t)tamanho_topico;
+    memcpy(cabecalho + n, topico, tamanho_topico);
+    n += (uint16_t)tamanho_topico;
+
+    // O pacote só entra inteiro: o espaço no buffer e na fila de segmentos é
+    // verificado antes (cada segmento do payload usa um pbuf de cabeçalho e um por referência)
+    uint16_t segmentos = (uint16_t)(((uint32_t)n + tamanho) / TCP_MSS + 2);
+    if (altcp_sndbuf(conexao) < (uint32_t)n + tamanho ||
+        altcp_sndqueuelen(conexao) + 2u * segmentos > TCP_SND_QUEUELEN) {
+        return ERR_MEM;
+    }
+    err_t err = altcp_write(conexao, cabecalho, n, TCP_WRITE_FLAG_COPY | TCP_WRITE_FLAG_MORE);
+    if (err != ERR_OK) return err;
+    err = altcp_write(conexao, dados, tamanho, 0);
+    if (err != ERR_OK) {
+        // Cabeçalho sem payload deixaria o fluxo inválido para o broker. O abort
+        // libera o PCB e passa pelo `err` do cliente, que avisa a queda pelo
+        // callback de conexão (loop_mqtt reconecta) e chama envio_direto_desconectado()
+        altcp_abort(conexao);
+        return ERR_ABRT;
+    }
+
+    *livre = (PublicacaoEmVoo){confirmados + (TCP_SND_BUF - altcp_sndbuf(conexao)), concluido, arg, true, false};
+    altcp_output(conexao);
+    metricas_incrementar(METRICA_MQTT_PUB_DIRETA);
+    metricas_somar(METRICA_MQTT_BYTES_DIRETOS, tamanho);
+    return ERR_OK;
+}
+
+uint16_t envio_direto_payload_maximo(const char *topico) {
+    return (uint16_t)(TCP_SND_BUF - CABECALHO_MAX_SEM_TOPICO - strlen(topico));
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef MQTT_ENVIO_DIRETO_H
+#define MQTT_ENVIO_DIRETO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lwip/apps/mqtt.h"  // Para mqtt_client_t e mqtt_request_cb_t
+
+/**
+ * @file mqtt_envio_direto.h
+ * @brief Publicação QoS 0 sem o anel de saída do cliente MQTT do lwIP.
+ *
+ * O mqtt_publish copia cada payload para o anel de MQTT_OUTPUT_RINGBUF_SIZE
+ * bytes, e o TCP copia de novo ao enviar; o anel ainda limita o tamanho de uma
+ * publicação. Aqui só o cabeçalho fixo e o tópico (poucos bytes) são copiados
+ * para o TCP, e o payload entra por referência (altcp_write sem
+ * TCP_WRITE_FLAG_COPY): o buffer precisa ficar intacto até a conclusão, avisada
+ * quando o TCP confirma o último byte do pacote e libera a referência.
+ *
+ * O pacote vai direto para a conexão do cliente, então só é escrito inteiro e
+ * com o anel vazio; do contrário ele se intercalaria com um pacote do anel ainda
+ * pela metade no fluxo TCP.
+ *
+ * Todas as funções rodam no contexto do lwIP (ou com cyw43_arch_lwip_begin).
+ */
+
+/**
+ * @brief Passa a acompanhar as confirmações da conexão recém-aceita do cliente.
+ */
+void envio_direto_conectado(mqtt_client_t *cliente);
+
+/**
+ * @brief Chamada logo após o fechamento da conexão (callback de conexão ou
+ * mqtt_disconnect). Se o PCB TCP fechado ainda guarda segmentos com os
+ * payloads, as publicações em voo ficam com ele até a confirmação (ERR_OK) ou
+ * até ele ser liberado (ERR_ABRT); do contrário são concluídas com ERR_ABRT.
+ * Não aborta nada: pode rodar dentro do tcp_input do próprio PCB.
+ */
+void envio_direto_desconectado(void);
+
+/**
+ * @brief Aborta o PCB fechado que ainda guarda payloads, se houver, concluindo
+ * as publicações dele com ERR_ABRT. Só fora dos callbacks do lwIP (ex.: antes de
+ * uma nova conexão), com a trava do lwIP.
+ */
+void envio_direto_abortar_fechado(void);
+
+/**
+ * @brief Publica `tamanho` bytes de `dados` em `topico` (QoS 0) sem copiar o payload.
+ *
+ * @param concluido Chamado no contexto do lwIP com ERR_OK quando o TCP liberou
+ *        `dados`, ou com ERR_ABRT se a conexão caiu antes.
+ * @return ERR_OK se o pacote foi entregue ao TCP; ERR_INPROGRESS se o anel do
+ *         cliente ainda tem dados ou o PCB da conexão anterior ainda guarda
+ *         payloads (use mqtt_publish); ERR_MEM sem espaço no TCP
+ *         ou sem posição livre para acompanhar a conclusão; ERR_CONN sem conexão;
+ *         ERR_ABRT se a conexão foi abortada (o callback de conexão avisa a queda).
+ *         Só com ERR_OK `concluido` será chamado.
+ */
+err_t envio_direto_publicar(mqtt_client_t *cliente, const char *topico, bool reter, const void *dados,
+                            uint16_t tamanho, mqtt_request_cb_t concluido, void *arg);
+
+/**
+ * @brief Maior payload que cabe no buffer de envio do TCP em uma publicação em `topico`.
+ */
+uint16_t envio_direto_payload_maximo(const char *topico);
+
+#endif
\ No newline at end of file
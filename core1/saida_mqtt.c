@@ -0,0 +1,89 @@
+/**
+ * @file saida_mqtt.c
+ * @brief Fila de publicações do Núcleo 0 para o laço de rede do Núcleo 1 (ver saida_mqtt.h).
+ *
+ * Como a fila de entrada_mqtt.c, no sentido oposto: `cabeca` só é escrita pelo
+ * Núcleo 0 (produtor) e `cauda` só pelo Núcleo 1 (consumidor), com a barreira
+ * antes de cada avanço.
+ */
+
+#include "core1/saida_mqtt.h"
+
+#if REDE_POLL
+
+#include "pico/cyw43_arch.h"     // Para cyw43_arch_async_context
+#include "pico/async_context.h"
+#include "shared/metricas.h"
+#include "hardware/sync.h"       // Para __dmb
+#include "pico/time.h"
+#include <string.h>
+
+_Static_assert((SAIDA_NUM_BUFFERS & (SAIDA_NUM_BUFFERS - 1)) == 0, "SAIDA_NUM_BUFFERS deve ser potência de 2");
+
+static MensagemSaida pool[SAIDA_NUM_BUFFERS];
+static volatile uint32_t cabeca = 0; // Escrita só pelo Núcleo 0
+static volatile uint32_t cauda = 0;  // Escrita só pelo Núcleo 1
+
+static void (*atender_pedidos)(void) = NULL;
+
+static void executar_trabalhador(async_context_t *contexto, async_when_pending_worker_t *trabalhador) {
+    (void)contexto;
+    (void)trabalhador;
+    if (atender_pedidos) atender_pedidos();
+}
+
+static async_when_pending_worker_t trabalhador = {.do_work = executar_trabalhador};
+
+void saida_mqtt_inicializar(void (*atender)(void)) {
+    atender_pedidos = atender;
+    async_context_add_when_pending_worker(cyw43_arch_async_context(), &trabalhador);
+}
+
+void saida_mqtt_sinalizar(void) {
+    async_context_set_work_pending(cyw43_arch_async_context(), &trabalhador);
+}
+
+bool saida_mqtt_enfileirar(uint8_t topico, const void *dados, uint16_t tamanho, uint16_t tamanho_original,
+                           bool binario, bool referencia) {
+    if (cabeca - cauda >= SAIDA_NUM_BUFFERS) {
+        metricas_incrementar(METRICA_SAIDA_CHEIA);
+        return false;
+    }
+    if (!referencia && tamanho > SAIDA_TAM_BUFFER) return false;
+
+    MensagemSaida *m = &pool[cabeca & (SAIDA_NUM_BUFFERS - 1)];
+    m->topico = topico;
+    m->binario = binario;
+    m->tamanho = tamanho;
+    m->tamanho_original = tamanho_original;
+    if (referencia) {
+        m->payload = dados;
+    } else {
+        memcpy(m->dados, dados, tamanho);
+        m->payload = m->dados;
+    }
+    m->instante_us = time_us_32();
+    __dmb(); // Conteúdo visível ao Núcleo 1 antes do novo índice
+    cabeca = cabeca + 1;
+    metricas_maximo(METRICA_SAIDA_FILA_MAX, cabeca - cauda);
+    saida_mqtt_sinalizar();
+    return true;
+}
+
+const MensagemSaida *saida_mqtt_proxima(void) {
+    if (cauda == cabeca) return NULL;
+    __dmb(); // Lê a posição só depois de ver o índice publicado
+    return &pool[cauda & (SAIDA_NUM_BUFFERS - 1)];
+}
+
+void saida_mqtt_liberar(void) {
+    metricas_maximo(METRICA_SAIDA_ESPERA_MAX_US, time_us_32() - pool[cauda & (SAIDA_NUM_BUFFERS - 1)].instante_us);
+    __dmb(); // Termina de ler antes de devolver a posição ao Núcleo 0
+    cauda = cauda + 1;
+}
+
+uint16_t saida_mqtt_ocupacao_permil(void) {
+    return (uint16_t)((cabeca - cauda) * 1000u / SAIDA_NUM_BUFFERS);
+}
+
+#endif
\ No newline at end of file
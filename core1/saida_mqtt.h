@@ -0,0 +1,74 @@
+#ifndef SAIDA_MQTT_H
+#define SAIDA_MQTT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config/config_geral.h" // Para REDE_POLL e SAIDA_*
+
+/**
+ * @file saida_mqtt.h
+ * @brief Caminho de saída do MQTT na arquitetura por polling (REDE_POLL).
+ *
+ * Com REDE_POLL o CYW43 e o lwIP pertencem ao laço do Núcleo 1, que chama
+ * cyw43_arch_poll a cada volta e só dorme até o próximo timer do lwIP ou o
+ * próximo evento: nenhuma IRQ de rede roda a pilha no meio de outro código, e o
+ * Núcleo 0 nunca toma a trava do lwIP. As publicações dele entram nesta fila SPSC
+ * sem trava, de SAIDA_NUM_BUFFERS posições fixas: textos copiados (até
+ * SAIDA_TAM_BUFFER bytes) e lotes por referência ao payload já montado. Cada
+ * entrada, como os pedidos de conexão, marca o trabalhador do contexto do CYW43
+ * (async_context_set_work_pending): o Núcleo 1 acorda e o atende dentro do
+ * próximo cyw43_arch_poll. Com a fila cheia a publicação é recusada, como com o
+ * anel do cliente MQTT cheio, e contada nas métricas.
+ *
+ * Sem REDE_POLL o módulo fica vazio e o Núcleo 0 publica direto no lwIP.
+ */
+
+// Publicação aguardando o Núcleo 1
+typedef struct {
+    uint8_t topico;             // TopicoId
+    bool binario;
+    uint16_t tamanho;           // Bytes em `payload`
+    uint16_t tamanho_original;  // Antes do cabeçalho e da compressão (registro)
+    uint32_t instante_us;       // Entrada na fila (time_us_32)
+    const uint8_t *payload;     // `dados`, ou o payload referenciado
+    uint8_t dados[SAIDA_TAM_BUFFER];
+} MensagemSaida;
+
+/**
+ * @brief Registra `atender` como trabalhador do contexto do CYW43: ele roda no
+ * Núcleo 1, dentro de cyw43_arch_poll, a cada saida_mqtt_sinalizar. Chamada pelo
+ * Núcleo 1 depois de cyw43_arch_init.
+ */
+void saida_mqtt_inicializar(void (*atender)(void));
+
+/**
+ * @brief Põe uma publicação na fila e acorda o Núcleo 1. Chamada pelo Núcleo 0.
+ *
+ * @param referencia Se true, `dados` não é copiado e precisa continuar válido até
+ * o Núcleo 1 publicá-lo.
+ * @return false com a fila cheia, ou com um payload copiado maior que SAIDA_TAM_BUFFER.
+ */
+bool saida_mqtt_enfileirar(uint8_t topico, const void *dados, uint16_t tamanho, uint16_t tamanho_original,
+                           bool binario, bool referencia);
+
+/**
+ * @brief Publicação mais antiga da fila (NULL se vazia). Chamada pelo Núcleo 1.
+ */
+const MensagemSaida *saida_mqtt_proxima(void);
+
+/**
+ * @brief Devolve ao Núcleo 0 a posição da publicação mais antiga. Chamada pelo Núcleo 1.
+ */
+void saida_mqtt_liberar(void);
+
+/**
+ * @brief Acorda o Núcleo 1 para chamar `atender` (pedidos além das publicações).
+ */
+void saida_mqtt_sinalizar(void);
+
+/**
+ * @brief Ocupação da fila em milésimos de SAIDA_NUM_BUFFERS (contrapressão).
+ */
+uint16_t saida_mqtt_ocupacao_permil(void);
+
+#endif
\ No newline at end of file
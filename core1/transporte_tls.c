@@ -0,0 +1,245 @@
+/**
+ * @file transporte_tls.c
+ * @brief Configuração TLS do cliente MQTT e sessões por broker (ver transporte_tls.h).
+ *
+ * As sessões são guardadas e oferecidas direto no contexto mbedTLS da conexão
+ * (altcp_tls_context), antes do handshake e depois do CONNACK. Uma conexão é
+ * classificada como retomada quando o segredo mestre negociado é o da sessão
+ * oferecida: num handshake completo o broker sempre deriva um novo.
+ *
+ * O Núcleo 0 não toma a trava do lwIP (com REDE_POLL ele nem pode): o pedido de
+ * esquecer uma sessão é um contador por broker, atendido pelo Núcleo 1 em
+ * transporte_tls_preparar antes de oferecê-la, e o resultado da última conexão
+ * é publicado com um contador de versão (ímpar durante a escrita).
+ */
+
+#include "config/config_geral.h" // Para MQTT_TLS e TLS_*
+
+#if MQTT_TLS
+
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS // Para o segredo mestre (classificação do handshake)
+
+#include "core1/transporte_tls.h"
+#include "core1/failover_broker.h" // Para o IP e a porta de cada broker
+#include "lwip/altcp_tls.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/memory_buffer_alloc.h"
+#include "shared/metricas.h"
+#include "hardware/sync.h" // Para __dmb
+#include <stdio.h>
+#include <string.h>
+
+#if MQTT_TLS_CA_ARQUIVO
+#include "tls_ca.h" // tls_ca_pem[], gerado pelo CMake a partir de MQTT_TLS_CA
+#endif
+
+#if TLS_SESSAO_FLASH
+#if !PICO_ON_DEVICE
+#error "TLS_SESSAO_FLASH só existe no RP2040"
+#endif
+#include "hardware/flash.h"
+#include "pico/flash.h" // Para flash_safe_execute (pausa o Núcleo 1 durante a escrita)
+#endif
+
+static uint8_t heap_tls[TLS_HEAP_BYTES] __attribute__((aligned(8)));
+static struct altcp_tls_config *configuracao = NULL;
+
+static mbedtls_ssl_session sessoes[TLS_MAX_BROKERS];
+static bool guardada[TLS_MAX_BROKERS];
+static bool oferecida = false;          // A conexão atual ofereceu a sessão guardada
+static uint64_t inicio_us = 0;
+static ConexaoTls ultima;
+static volatile uint32_t versao_ultima = 0;                // Escrita só pelo Núcleo 1
+static volatile uint8_t pedidos_esquecer[TLS_MAX_BROKERS]; // Escrita só pelo Núcleo 0
+static uint8_t esquecer_atendidos[TLS_MAX_BROKERS];        // Escrita só pelo Núcleo 1
+
+// Registros de entrada limitados pela extensão max_fragment_length (RFC 6066)
+#define TLS_FRAGMENTO_CODIGO MBEDTLS_SSL_MAX_FRAG_LEN_4096
+#define TLS_FRAGMENTO_BYTES 4096
+_Static_assert(MBEDTLS_SSL_IN_CONTENT_LEN >= TLS_FRAGMENTO_BYTES, "Buffer de entrada menor que o fragmento pedido ao broker");
+
+#if TLS_SESSAO_FLASH
+#define TLS_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE) // Último setor
+#define TLS_FLASH_MAGICO 0x544C5331u // "TLS1"
+
+// Uma entrada por broker; o IP e a porta invalidam a sessão se MQTT_BROKERS mudar
+typedef struct {
+    uint32_t magico;
+    uint16_t porta;
+    uint16_t tamanho;                   // Bytes válidos de `dados`
+    char ip[16];
+    uint8_t dados[TLS_SESSAO_TAM_MAX];
+} SessaoFlash;
+
+#define TAM_GRAVACAO ((sizeof(SessaoFlash) * TLS_MAX_BROKERS + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE)
+
+static union {
+    SessaoFlash entradas[TLS_MAX_BROKERS];
+    uint8_t bytes[TAM_GRAVACAO];
+} gravacao;
+static volatile uint8_t alteradas = 0;  // Bit por broker: sessão nova desde a última gravação
+
+_Static_assert(TAM_GRAVACAO <= FLASH_SECTOR_SIZE, "TLS_MAX_BROKERS sessões não cabem num setor");
+
+static const SessaoFlash *sessao_na_flash(uint8_t indice) {
+    return (const SessaoFlash *)(XIP_BASE + TLS_FLASH_OFFSET) + indice;
+}
+
+/**
+ * @brief Carrega as sessões gravadas cujo broker ainda está em MQTT_BROKERS.
+ */
+static void carregar_da_flash(void) {
+    uint8_t n = failover_broker_quantidade();
+    for (uint8_t i = 0; i < n && i < TLS_MAX_BROKERS; i++) {
+        const SessaoFlash *s = sessao_na_flash(i);
+        if (s->magico != TLS_FLASH_MAGICO || s->porta != failover_broker_porta(i) ||
+            s->tamanho > TLS_SESSAO_TAM_MAX || strncmp(s->ip, failover_broker_ip(i), sizeof(s->ip)) != 0) {
+            continue;
+        }
+        guardada[i] = mbedtls_ssl_session_load(&sessoes[i], s->dados, s->tamanho) == 0;
+        if (guardada[i]) printf("[TLS] Sessão do broker %u carregada da flash.\n", i);
+    }
+}
+
+static void gravar_setor(void *arg) {
+    (void)arg;
+    flash_range_erase(TLS_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(TLS_FLASH_OFFSET, gravacao.bytes, sizeof(gravacao.bytes));
+}
+#endif
+
+struct altcp_tls_config *transporte_tls_configuracao(void) {
+    if (configuracao) return configuracao;
+
+    // Antes de qualquer alocação do mbedTLS (ALTCP_MBEDTLS_PLATFORM_ALLOC 0 em lwipopts.h)
+    mbedtls_memory_buffer_alloc_init(heap_tls, sizeof(heap_tls));
+    for (int i = 0; i < TLS_MAX_BROKERS; i++) mbedtls_ssl_session_init(&sessoes[i]);
+
+#if MQTT_TLS_CA_ARQUIVO
+    // O parser PEM do mbedTLS exige o terminador na contagem
+    configuracao = altcp_tls_create_config_client((const u8_t *)tls_ca_pem, sizeof(tls_ca_pem));
+#else
+    printf("[TLS] Sem MQTT_TLS_CA: o certificado do broker não será verificado.\n");
+    configuracao = altcp_tls_create_config_client(NULL, 0);
+#endif
+    if (!configuracao) {
+        printf("[TLS] Falha ao criar a configuração TLS.\n");
+        return NULL;
+    }
+#if TLS_SESSAO_FLASH
+    carregar_da_flash();
+#endif
+    return configuracao;
+}
+
+/**
+ * @brief Atende o pedido de esquecer a sessão do broker `indice`, se houver.
+ */
+static void atender_esquecer(uint8_t indice) {
+    uint8_t pedidos = pedidos_esquecer[indice];
+    if (pedidos == esquecer_atendidos[indice]) return;
+    esquecer_atendidos[indice] = pedidos;
+    mbedtls_ssl_session_free(&sessoes[indice]);
+    mbedtls_ssl_session_init(&sessoes[indice]);
+    guardada[indice] = false;
+}
+
+void transporte_tls_preparar(struct altcp_pcb *conn, uint8_t indice) {
+    mbedtls_ssl_context *ssl = (mbedtls_ssl_context *)altcp_tls_context(conn);
+    if (!ssl) return;
+
+    // Sem a extensão o broker pode mandar registros de 16 KB, maiores que
+    // MBEDTLS_SSL_IN_CONTENT_LEN; a configuração é a mesma em todas as conexões
+    mbedtls_ssl_conf_max_frag_len((mbedtls_ssl_config *)ssl->MBEDTLS_PRIVATE(conf), TLS_FRAGMENTO_CODIGO);
+
+    const char *nome = MQTT_TLS_NOME_SERVIDOR;
+    mbedtls_ssl_set_hostname(ssl, nome ? nome : failover_broker_ip(indice));
+
+    if (indice < TLS_MAX_BROKERS) atender_esquecer(indice);
+    oferecida = indice < TLS_MAX_BROKERS && guardada[indice] &&
+                mbedtls_ssl_set_session(ssl, &sessoes[indice]) == 0;
+    mbedtls_memory_buffer_alloc_max_reset(); // O pico medido passa a ser o desta conexão
+    inicio_us = time_us_64();
+}
+
+void transporte_tls_conectou(struct altcp_pcb *conn, uint8_t indice) {
+    mbedtls_ssl_context *ssl = (mbedtls_ssl_context *)altcp_tls_context(conn);
+    if (!ssl || !ssl->MBEDTLS_PRIVATE(session)) return;
+
+    size_t pico_heap, blocos;
+    mbedtls_memory_buffer_alloc_max_get(&pico_heap, &blocos);
+    ConexaoTls c;
+    c.duracao_us = (uint32_t)(time_us_64() - inicio_us);
+    c.pico_heap = (uint32_t)pico_heap;
+    c.retomada = oferecida &&
+                 memcmp(ssl->MBEDTLS_PRIVATE(session)->MBEDTLS_PRIVATE(master),
+                        sessoes[indice].MBEDTLS_PRIVATE(master),
+                        sizeof(sessoes[indice].MBEDTLS_PRIVATE(master))) == 0;
+
+    versao_ultima = versao_ultima + 1; // Ímpar: o Núcleo 0 não lê pela metade
+    __dmb();
+    ultima = c;
+    __dmb();
+    versao_ultima = versao_ultima + 1;
+
+    metricas_incrementar(c.retomada ? METRICA_TLS_RETOMADOS : METRICA_TLS_COMPLETOS);
+    metricas_definir(c.retomada ? METRICA_TLS_RETOMADO_MS : METRICA_TLS_COMPLETO_MS, c.duracao_us / 1000);
+    metricas_maximo(METRICA_TLS_HEAP_MAX, c.pico_heap);
+    printf("[TLS] Handshake %s em %lu ms (pico do heap: %lu bytes).\n",
+           c.retomada ? "retomado" : "completo", (unsigned long)(c.duracao_us / 1000),
+           (unsigned long)c.pico_heap);
+
+    // Numa retomada o broker pode ter renovado o ticket: a sessão é sempre substituída
+    if (indice >= TLS_MAX_BROKERS) return;
+    guardada[indice] = mbedtls_ssl_get_session(ssl, &sessoes[indice]) == 0;
+#if TLS_SESSAO_FLASH
+    if (guardada[indice] && !c.retomada) alteradas = alteradas | (1u << indice);
+#endif
+}
+
+void transporte_tls_esquecer(uint8_t indice) {
+    if (indice >= TLS_MAX_BROKERS) return;
+    pedidos_esquecer[indice] = pedidos_esquecer[indice] + 1; // Atendido antes da próxima oferta
+}
+
+void transporte_tls_persistir(void) {
+#if TLS_SESSAO_FLASH
+    if (!alteradas) return;
+
+    // Parte do setor atual e reescreve só as entradas novas; serializa com a
+    // trava porque o contexto do lwIP substitui as sessões a cada CONNACK
+    memcpy(gravacao.entradas, sessao_na_flash(0), sizeof(gravacao.entradas));
+    cyw43_arch_lwip_begin();
+    uint8_t mascara = alteradas;
+    alteradas = 0;
+    for (uint8_t i = 0; i < TLS_MAX_BROKERS; i++) {
+        if (!(mascara & (1u << i))) continue;
+        SessaoFlash *e = &gravacao.entradas[i];
+        size_t tamanho = 0;
+        if (!guardada[i] || mbedtls_ssl_session_save(&sessoes[i], e->dados, sizeof(e->dados), &tamanho) != 0) {
+            e->magico = 0; // Não cabe em TLS_SESSAO_TAM_MAX: a entrada é invalidada
+            continue;
+        }
+        e->magico = TLS_FLASH_MAGICO;
+        e->porta = failover_broker_porta(i);
+        e->tamanho = (uint16_t)tamanho;
+        strncpy(e->ip, failover_broker_ip(i), sizeof(e->ip));
+    }
+    cyw43_arch_lwip_end();
+
+    int resultado = flash_safe_execute(gravar_setor, NULL, 100);
+    if (resultado != PICO_OK) printf("[TLS] Falha ao gravar as sessões na flash: %d\n", resultado);
+#endif
+}
+
+void transporte_tls_ultima_conexao(ConexaoTls *destino) {
+    uint32_t versao;
+    do {
+        versao = versao_ultima;
+        __dmb();
+        *destino = ultima;
+        __dmb();
+    } while ((versao & 1) || versao != versao_ultima);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef TRANSPORTE_TLS_H
+#define TRANSPORTE_TLS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lwip/altcp_tls.h" // Para struct altcp_tls_config
+
+/**
+ * @file transporte_tls.h
+ * @brief Transporte TLS do cliente MQTT (altcp_tls + mbedTLS) com retomada de sessão.
+ *
+ * Um handshake completo custa no M0+ uma geração de chave ECDHE, um segredo
+ * compartilhado e uma verificação ECDSA, segundos de CPU e o pico de RAM do
+ * mbedTLS. Depois do primeiro CONNACK de cada broker de MQTT_BROKERS a sessão
+ * negociada (ID e ticket do broker) fica guardada em RAM e é oferecida na
+ * próxima conexão com ele: aceita, o handshake abreviado dispensa toda a
+ * criptografia assimétrica. Com TLS_SESSAO_FLASH a sessão também vai para o
+ * último setor da flash e sobrevive ao reboot.
+ *
+ * O mbedTLS aloca de um heap estático de TLS_HEAP_BYTES. As métricas contam os
+ * handshakes completos e retomados, o tempo até o CONNACK de cada tipo e o pico
+ * desse heap (ver metricas.h).
+ *
+ * transporte_tls_configuracao, transporte_tls_preparar e transporte_tls_conectou
+ * rodam no contexto do lwIP (ou com cyw43_arch_lwip_begin). transporte_tls_esquecer
+ * e transporte_tls_ultima_conexao, chamadas pelo Núcleo 0, não tomam a trava do
+ * lwIP e valem também com REDE_POLL; transporte_tls_persistir a toma.
+ */
+
+// Resultado da última conexão aceita (benchmarks)
+typedef struct {
+    bool retomada;          // O broker aceitou a sessão oferecida
+    uint32_t duracao_us;    // Do início da conexão TCP ao CONNACK
+    uint32_t pico_heap;     // Pico do heap do mbedTLS nessa conexão (bytes)
+} ConexaoTls;
+
+/**
+ * @brief Configuração TLS do cliente, criada na primeira chamada com a CA de
+ * MQTT_TLS_CA (CMake) e as sessões guardadas na flash, se houver.
+ *
+ * @return NULL se o mbedTLS não pôde ser configurado.
+ */
+struct altcp_tls_config *transporte_tls_configuracao(void);
+
+/**
+ * @brief Antes do handshake da conexão recém-criada com o broker `indice`:
+ * pede registros de até 4 KB (max_fragment_length), define o nome conferido no
+ * certificado e oferece a sessão guardada, se não foi pedido para esquecê-la.
+ */
+void transporte_tls_preparar(struct altcp_pcb *conn, uint8_t indice);
+
+/**
+ * @brief Depois do CONNACK: classifica o handshake (completo ou retomado),
+ * registra as métricas e guarda a sessão negociada para a próxima conexão.
+ */
+void transporte_tls_conectou(struct altcp_pcb *conn, uint8_t indice);
+
+/**
+ * @brief Pede para descartar a sessão guardada do broker `indice`: a próxima
+ * conexão com ele faz o handshake completo.
+ */
+void transporte_tls_esquecer(uint8_t indice);
+
+/**
+ * @brief Grava na flash as sessões que mudaram desde a última gravação. Sem
+ * TLS_SESSAO_FLASH não faz nada. Pausa o Núcleo 1 durante a escrita do setor.
+ */
+void transporte_tls_persistir(void);
+
+/**
+ * @brief Copia o resultado da última conexão aceita.
+ */
+void transporte_tls_ultima_conexao(ConexaoTls *destino);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,266 @@
+/**
+ * @file aquisicao_adc.c
+ * @brief Aquisição contínua do ADC por DMA, com decimação e filtro em ponto fixo.
+ *
+ * O ADC roda livre em round-robin, cadenciado pelo próprio divisor (clk_adc de
+ * 48 MHz do PLL USB, independente do perfil de clock), e cada conversão vai para
+ * a FIFO do ADC. Dois canais de DMA pelo DREQ_ADC se revezam: cada um escreve um
+ * bloco de ADC_AMOSTRAS_BLOCO amostras no seu buffer e dispara o outro. O anel de
+ * escrita do DMA faz o endereço voltar ao início do buffer sozinho, então um IRQ
+ * atrasado nunca escreve fora dele.
+ *
+ * No IRQ de fim de bloco cada entrada é decimada (média do bloco) e passa por um
+ * IIR de primeira ordem em Q8: y += (x - y) >> ADC_FILTRO_DESLOCAMENTO. Como o
+ * bloco nem sempre é múltiplo do número de entradas, a fase do round-robin é
+ * carregada de um bloco para o outro. A média de cada bloco também alimenta a
+ * janela de estatísticas da entrada; há dois conjuntos de janelas e o fechamento
+ * só troca o conjunto ativo, então o IRQ nunca espera o cálculo do resumo.
+ */
+
+#include "drivers/adc/aquisicao_adc.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "shared/secao_ram.h" // Para o IRQ do DMA fora da flash
+#include <stdio.h>
+#include <string.h>
+
+#define PRIMEIRO_GPIO_ADC 26
+#define ENTRADA_TEMPERATURA 4
+
+_Static_assert((ADC_AMOSTRAS_BLOCO & (ADC_AMOSTRAS_BLOCO - 1)) == 0,
+               "ADC_AMOSTRAS_BLOCO deve ser potência de 2 (anel de escrita do DMA)");
+
+// Um buffer por canal de DMA, cada um alinhado ao próprio tamanho para o anel de escrita
+static uint16_t blocos_adc[2][ADC_AMOSTRAS_BLOCO] __attribute__((aligned(ADC_AMOSTRAS_BLOCO * 2)));
+static int canal_dma[2];
+
+// Entradas na ordem em que o round-robin as converte
+static uint8_t ordem_entradas[ADC_NUM_ENTRADAS_MAX];
+static uint num_entradas = 0;
+static uint fase = 0; // Posição no round-robin da primeira amostra do próximo bloco
+
+// Resultados, escritos só pelo IRQ (Q8: unidades do ADC multiplicadas por 256)
+static int32_t filtro_q8[ADC_NUM_ENTRADAS_MAX];
+static uint16_t pico_a_pico[ADC_NUM_ENTRADAS_MAX];
+static volatile uint32_t blocos_processados = 0;
+
+static EstatisticaFluxo janelas[2][ADC_NUM_ENTRADAS_MAX];
+static volatile uint janela_ativa = 0;
+
+/**
+ * @brief Temperatura em milésimos de °C para uma leitura em unidades do ADC Q8.
+ * Datasheet do RP2040: T = 27 - (V - 0,706) / 0,001721, com V em microvolts.
+ */
+static int32_t q8_para_mc(int64_t valor_q8) {
+    int64_t uv = (valor_q8 * ADC_VREF_MV * 1000) >> 20;
+    return (int32_t)(27000 - (uv - 706000) * 1000 / 1721);
+}
+
+/**
+ * @brief Decima e filtra um bloco completo. O laço por amostra só soma e compara.
+ */
+static void FUNC_RAM_NUCLEO0(processar_bloco)(const uint16_t *amostras) {
+    uint32_t soma[ADC_NUM_ENTRADAS_MAX] = {0};
+    uint32_t quantidade[ADC_NUM_ENTRADAS_MAX] = {0};
+    uint16_t minimo[ADC_NUM_ENTRADAS_MAX], maximo[ADC_NUM_ENTRADAS_MAX];
+    for (uint k = 0; k < num_entradas; k++) {
+        minimo[k] = 0xFFFF;
+        maximo[k] = 0;
+    }
+
+    uint k = fase;
+    for (uint i = 0; i < ADC_AMOSTRAS_BLOCO; i++) {
+        uint16_t v = amostras[i] & 0x0FFF;
+        soma[k] += v;
+        quantidade[k]++;
+        if (v < minimo[k]) minimo[k] = v;
+        if (v > maximo[k]) maximo[k] = v;
+        if (++k == num_entradas) k = 0;
+    }
+    fase = k;
+
+    for (k = 0; k < num_entradas; k++) {
+        if (quantidade[k] == 0) continue;
+        int32_t media_q8 = (int32_t)((soma[k] << 8) / quantidade[k]);
+        // A temperatura entra na janela já em m°C: a conversão é decrescente e
+        // inverteria mínimo/máximo e quantis se fosse aplicada só no resumo
+        estatistica_adicionar(&janelas[janela_ativa][k],
+                              ordem_entradas[k] == ENTRADA_TEMPERATURA ? q8_para_mc(media_q8) : media_q8);
+        if (blocos_processados == 0) filtro_q8[k] = media_q8; // Sem rampa a partir de zero
+        else filtro_q8[k] += (media_q8 - filtro_q8[k]) >> ADC_FILTRO_DESLOCAMENTO;
+        pico_a_pico[k] = maximo[k] - minimo[k];
+    }
+    blocos_processados++;
+}
+
+/**
+ * @brief IRQ de fim de bloco: o canal que terminou já disparou o outro, então só
+ * resta processar o buffer dele antes que volte a ser escrito.
+ */
+static void FUNC_RAM_NUCLEO0(aquisicao_adc_irq_dma)(void) {
+    for (int b = 0; b < 2; b++) {
+        if (dma_irqn_get_channel_status(1, canal_dma[b])) {
+            dma_channel_acknowledge_irq1(canal_dma[b]);
+            processar_bloco(blocos_adc[b]);
+        }
+    }
+}
+
+void aquisicao_adc_inicializar(void) {
+    adc_init();
+    for (uint e = 0; e < ADC_NUM_ENTRADAS_MAX; e++) {
+        if (!(ADC_ENTRADAS & (1u << e))) continue;
+        ordem_entradas[num_entradas++] = (uint8_t)e;
+        if (e == ENTRADA_TEMPERATURA) adc_set_temp_sensor_enabled(true);
+        else adc_gpio_init(PRIMEIRO_GPIO_ADC + e);
+    }
+    if (num_entradas == 0) return;
+
+    adc_select_input(ordem_entradas[0]);
+    adc_set_round_robin(num_entradas > 1 ? ADC_ENTRADAS : 0);
+    adc_fifo_setup(true, true, 1, false, false); // DREQ a cada amostra, 12 bits em meia palavra
+    // Uma conversão a cada (1 + div) ciclos de clk_adc
+    adc_set_clkdiv((float)clock_get_hz(clk_adc) / ADC_TAXA_AMOSTRAS_HZ - 1.0f);
+
+    for (int b = 0; b < 2; b++) canal_dma[b] = dma_claim_unused_channel(true);
+    for (int b = 0; b < 2; b++) {
+        dma_channel_config c = dma_channel_get_default_config(canal_dma[b]);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        channel_config_set_ring(&c, true, __builtin_ctz(sizeof(blocos_adc[b])));
+        channel_config_set_dreq(&c, DREQ_ADC);
+        channel_config_set_chain_to(&c, canal_dma[1 - b]);
+        dma_channel_configure(canal_dma[b], &c, blocos_adc[b], &adc_hw->fifo, ADC_AMOSTRAS_BLOCO, false);
+        dma_channel_set_irq1_enabled(canal_dma[b], true);
+    }
+    irq_set_exclusive_handler(DMA_IRQ_1, aquisicao_adc_irq_dma);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    dma_channel_start(canal_dma[0]);
+    adc_run(true);
+}
+
+/**
+ * @brief Converte unidades do ADC em Q8 para mV.
+ */
+static uint16_t q8_para_mv(int32_t valor_q8) {
+    return (uint16_t)(((uint32_t)valor_q8 * ADC_VREF_MV) >> 20);
+}
+
+void aquisicao_adc_ler(LeituraSensores *leitura) {
+    memset(leitura, 0, sizeof(*leitura));
+
+    // O IRQ roda neste núcleo: basta mascará-lo durante a cópia
+    int32_t copia_filtro[ADC_NUM_ENTRADAS_MAX];
+    uint16_t copia_pp[ADC_NUM_ENTRADAS_MAX];
+    uint32_t estado = save_and_disable_interrupts();
+    memcpy(copia_filtro, filtro_q8, sizeof(copia_filtro));
+    memcpy(copia_pp, pico_a_pico, sizeof(copia_pp));
+    leitura->blocos = blocos_processados;
+    restore_interrupts(estado);
+
+    leitura->num_entradas = (uint8_t)num_entradas;
+    for (uint k = 0; k < num_entradas; k++) {
+        leitura->entradas[k].entrada = ordem_entradas[k];
+        leitura->entradas[k].media_mv = q8_para_mv(copia_filtro[k]);
+        leitura->entradas[k].pico_a_pico_mv = q8_para_mv((int32_t)copia_pp[k] << 8);
+        if (ordem_entradas[k] == ENTRADA_TEMPERATURA && leitura->blocos > 0) {
+            leitura->temperatura_mc = q8_para_mc(copia_filtro[k]);
+        }
+    }
+}
+
+void aquisicao_adc_resumir_janela(ResumoSensores *resumo) {
+    uint32_t estado = save_and_disable_interrupts();
+    uint fechada = janela_ativa;
+    janela_ativa = fechada ^ 1u;
+    resumo->blocos = blocos_processados;
+    restore_interrupts(estado);
+
+    resumo->num_entradas = (uint8_t)num_entradas;
+    for (uint k = 0; k < num_entradas; k++) {
+        resumo->entradas[k].entrada = ordem_entradas[k];
+        estatistica_resumir(&janelas[fechada][k], &resumo->entradas[k].resumo, true);
+    }
+}
+
+int aquisicao_adc_formatar_resumo(const ResumoSensores *resumo, char *destino, size_t tamanho) {
+    size_t n = 0;
+#define ANEXAR(...) do { \
+        if (n < tamanho) n += snprintf(destino + n, tamanho - n, __VA_ARGS__); \
+    } while (0)
+
+    ANEXAR("blocos=%lu,n=%lu", (unsigned long)resumo->blocos,
+           (unsigned long)(resumo->num_entradas ? resumo->entradas[0].resumo.n : 0));
+    for (uint k = 0; k < resumo->num_entradas; k++) {
+        const ResumoEstatistica *r = &resumo->entradas[k].resumo;
+        if (r->n == 0) continue;
+        if (resumo->entradas[k].entrada == ENTRADA_TEMPERATURA) {
+            ANEXAR(",temp_mc=%ld/%ld/%ld/%ld/%ld/%ld/%ld", (long)r->minimo, (long)r->maximo,
+                   (long)(r->media_q8 >> 8), (long)(r->desvio_q8 >> 8), (long)r->p50, (long)r->p90, (long)r->p99);
+        } else {
+            uint32_t media_dmv = (uint32_t)((r->media_q8 * ADC_VREF_MV * 10) >> 28);
+            uint32_t dp_dmv = (uint32_t)(((uint64_t)r->desvio_q8 * ADC_VREF_MV * 10) >> 28);
+            ANEXAR(",a%u=%u/%u/%lu.%lu/%lu.%lu/%u/%u/%u", resumo->entradas[k].entrada,
+                   q8_para_mv(r->minimo), q8_para_mv(r->maximo), (unsigned long)(media_dmv / 10),
+                   (unsigned long)(media_dmv % 10), (unsigned long)(dp_dmv / 10), (unsigned long)(dp_dmv % 10),
+                   q8_para_mv(r->p50), q8_para_mv(r->p90), q8_para_mv(r->p99));
+        }
+    }
+
+#undef ANEXAR
+    return (int)(n < tamanho ? n : tamanho - 1);
+}
+
+void aquisicao_adc_codificar_resumo(const ResumoSensores *resumo, uint32_t janela_ms, CodificadorCbor *c) {
+    uint32_t com_amostras = 0;
+    for (uint k = 0; k < resumo->num_entradas; k++) {
+        if (resumo->entradas[k].resumo.n > 0) com_amostras++;
+    }
+
+    cbor_vetor(c, 5);
+    cbor_uint(c, ADC_ESQUEMA_CBOR_VERSAO);
+    cbor_uint(c, resumo->blocos);
+    cbor_uint(c, janela_ms);
+    cbor_uint(c, ADC_VREF_MV);
+    cbor_vetor(c, com_amostras);
+    for (uint k = 0; k < resumo->num_entradas; k++) {
+        const ResumoEstatistica *r = &resumo->entradas[k].resumo;
+        if (r->n == 0) continue;
+        // Externas: Q8 passa a 1/16 de contagem (>> 4) e média/dp Q16 também (>> 12)
+        bool temperatura = resumo->entradas[k].entrada == ENTRADA_TEMPERATURA;
+        int desloc = temperatura ? 0 : 4;
+        int32_t minimo = temperatura ? r->minimo : (r->minimo >> 8) << 4; // Contagem inteira, em 1/16
+        cbor_vetor(c, 9);
+        cbor_uint(c, resumo->entradas[k].entrada);
+        cbor_uint(c, r->n);
+        cbor_int(c, temperatura ? minimo : minimo >> 4);
+        cbor_int(c, (r->maximo >> desloc) - minimo);
+        cbor_int(c, (r->media_q8 >> (8 + desloc)) - minimo);
+        cbor_uint(c, r->desvio_q8 >> (8 + desloc));
+        cbor_int(c, (r->p50 >> desloc) - minimo);
+        cbor_int(c, (r->p90 >> desloc) - minimo);
+        cbor_int(c, (r->p99 >> desloc) - minimo);
+    }
+}
+
+int aquisicao_adc_formatar(const LeituraSensores *leitura, char *destino, size_t tamanho) {
+    size_t n = 0;
+#define ANEXAR(...) do { \
+        if (n < tamanho) n += snprintf(destino + n, tamanho - n, __VA_ARGS__); \
+    } while (0)
+
+    ANEXAR("blocos=%lu,temp_mc=%ld", (unsigned long)leitura->blocos, (long)leitura->temperatura_mc);
+    for (uint k = 0; k < leitura->num_entradas; k++) {
+        const LeituraEntradaAdc *e = &leitura->entradas[k];
+        if (e->entrada == ENTRADA_TEMPERATURA) continue;
+        ANEXAR(",a%u_mv=%u,a%u_pp=%u", e->entrada, e->media_mv, e->entrada, e->pico_a_pico_mv);
+    }
+
+#undef ANEXAR
+    return (int)(n < tamanho ? n : tamanho - 1);
+}
\ No newline at end of file
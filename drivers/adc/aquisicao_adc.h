@@ -0,0 +1,88 @@
+#ifndef AQUISICAO_ADC_H
+#define AQUISICAO_ADC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config/config_geral.h" // Para ADC_*
+#include "shared/estatistica_fluxo.h" // Para ResumoEstatistica
+#include "shared/cbor_escrita.h" // Para CodificadorCbor
+
+#define ADC_NUM_ENTRADAS_MAX 5 // Entradas 0-3 (GPIO26-29) e 4 (sensor de temperatura interno)
+
+// Leitura filtrada de uma entrada do ADC
+typedef struct {
+    uint8_t entrada;          // Entrada do ADC (0-3 = GPIO26-29, 4 = sensor de temperatura)
+    uint16_t media_mv;        // Média decimada e filtrada (mV)
+    uint16_t pico_a_pico_mv;  // Excursão dentro do último bloco (mV)
+} LeituraEntradaAdc;
+
+// Retrato consistente de todas as entradas do round-robin
+typedef struct {
+    uint32_t blocos;          // Blocos de DMA processados desde a inicialização
+    int32_t temperatura_mc;   // Sensor interno em milésimos de °C (0 sem a entrada 4)
+    uint8_t num_entradas;
+    LeituraEntradaAdc entradas[ADC_NUM_ENTRADAS_MAX];
+} LeituraSensores;
+
+// Resumo de uma janela de publicação para uma entrada (unidades do ADC em Q8; temperatura em m°C)
+typedef struct {
+    uint8_t entrada;
+    ResumoEstatistica resumo;
+} ResumoEntradaAdc;
+
+typedef struct {
+    uint32_t blocos;          // Blocos de DMA processados desde a inicialização
+    uint8_t num_entradas;
+    ResumoEntradaAdc entradas[ADC_NUM_ENTRADAS_MAX];
+} ResumoSensores;
+
+/**
+ * @brief Configura o ADC em round-robin contínuo nas entradas de ADC_ENTRADAS e
+ * dois canais de DMA encadeados (pingue-pongue) que escrevem blocos de
+ * ADC_AMOSTRAS_BLOCO amostras. A CPU só entra no fim de cada bloco (IRQ do DMA),
+ * onde o bloco é decimado e filtrado em ponto fixo. Deve rodar no Núcleo 0.
+ */
+void aquisicao_adc_inicializar(void);
+
+/**
+ * @brief Copia o resultado do último bloco processado.
+ */
+void aquisicao_adc_ler(LeituraSensores *leitura);
+
+/**
+ * @brief Fecha a janela atual de estatísticas (médias por bloco de cada entrada
+ * desde a chamada anterior), abre outra e devolve o resumo da que fechou.
+ */
+void aquisicao_adc_resumir_janela(ResumoSensores *resumo);
+
+/**
+ * @brief Formata um resumo como "blocos=N,n=M,a0=mín/máx/média/dp/p50/p90/p99,...,
+ * temp_mc=..." com as entradas externas em mV (média e dp com uma casa decimal)
+ * e o sensor de temperatura em milésimos de °C.
+ *
+ * @return Número de caracteres escritos (sem o terminador).
+ */
+int aquisicao_adc_formatar_resumo(const ResumoSensores *resumo, char *destino, size_t tamanho);
+
+// Versão do esquema CBOR de aquisicao_adc_codificar_resumo (tools/decodificar_cbor.py)
+#define ADC_ESQUEMA_CBOR_VERSAO 1
+
+/**
+ * @brief Codifica um resumo em CBOR com esquema posicional, sem formatar números
+ * em texto:
+ *   [versão, blocos, janela_ms, vref_mv, [entrada, ...]]
+ *   entrada = [número, n, mín, máx - mín, média - mín, dp, p50 - mín, p90 - mín, p99 - mín]
+ * Nas entradas externas mín está em contagens do ADC (0-4095) e média, dp e os
+ * deslocamentos em 1/16 de contagem; na entrada 4 (temperatura), tudo em m°C.
+ * Os deslocamentos a partir do mínimo cabem em 1-3 bytes cada.
+ */
+void aquisicao_adc_codificar_resumo(const ResumoSensores *resumo, uint32_t janela_ms, CodificadorCbor *c);
+
+/**
+ * @brief Formata uma leitura como "blocos=N,temp_mc=T,a0_mv=...,a0_pp=...".
+ *
+ * @return Número de caracteres escritos (sem o terminador).
+ */
+int aquisicao_adc_formatar(const LeituraSensores *leitura, char *destino, size_t tamanho);
+
+#endif
\ No newline at end of file
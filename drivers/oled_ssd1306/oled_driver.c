@@ -8,8 +8,11 @@
 #include "drivers/oled_ssd1306/ssd1306_font.h" // Para a fonte de caracteres
 #include "config/config_geral.h"         // Para SDA_PIN, SCL_PIN e I2C_PORT (i2c1)
 #include "hardware/i2c.h"
+#include "shared/rastreio.h"          // Para RASTREIO_INICIO/FIM
+#include "shared/metricas.h"          // Para contagem e tempo das renderizações
+#include "shared/secao_ram.h"         // Para FUNC_RAM_NUCLEO0 no caminho de renderização
 #include <string.h> // Para memset, memcpy
-#include <stdlib.h> // Para malloc, free
+#include <stdlib.h> // Para abs
 #include <ctype.h>  // Para toupper (se usado)
 #include "pico/stdlib.h" // Para assert
 
@@ -20,27 +23,29 @@ void calculate_render_area_buffer_length(struct render_area *area) {
     area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
 }
 
-void ssd1306_send_cmd(uint8_t cmd) {
+void FUNC_RAM_NUCLEO0(ssd1306_send_cmd)(uint8_t cmd) {
     uint8_t buf[2] = {0x80, cmd}; // 0x80 para Co=0, D/C#=0 (comando)
     i2c_write_blocking(I2C_PORT, SSD1306_I2C_ADDR, buf, 2, false);
 }
 
-void ssd1306_send_cmd_list(const uint8_t *cmd_list, int size) {
+void FUNC_RAM_NUCLEO0(ssd1306_send_cmd_list)(const uint8_t *cmd_list, int size) {
     for (int i = 0; i < size; i++) {
         ssd1306_send_cmd(cmd_list[i]);
     }
 }
 
-void ssd1306_send_buffer(const uint8_t *buf, int buflen) {
-    // Para enviar dados, o primeiro byte é 0x40 (Co=0, D/C#=1)
-    uint8_t *temp_buf = malloc(buflen + 1);
-    if (!temp_buf) return;
+// Quadro de envio (byte de controle + tela inteira), reaproveitado a cada renderização.
+// Só o Núcleo 0 desenha no OLED, então um único buffer estático basta.
+static uint8_t buffer_envio[ssd1306_buffer_length + 1];
+
+void FUNC_RAM_NUCLEO0(ssd1306_send_buffer)(const uint8_t *buf, int buflen) {
+    if (buflen > ssd1306_buffer_length) return;
 
-    temp_buf[0] = 0x40; // Byte de controle para dados
-    memcpy(temp_buf + 1, buf, buflen);
+    // Para enviar dados, o primeiro byte é 0x40 (Co=0, D/C#=1)
+    buffer_envio[0] = 0x40; // Byte de controle para dados
+    memcpy(buffer_envio + 1, buf, buflen);
 
-    i2c_write_blocking(I2C_PORT, SSD1306_I2C_ADDR, temp_buf, buflen + 1, false);
-    free(temp_buf);
+    i2c_write_blocking(I2C_PORT, SSD1306_I2C_ADDR, buffer_envio, buflen + 1, false);
 }
 
 void ssd1306_init() {
@@ -82,7 +87,9 @@ void ssd1306_init() {
     ssd1306_send_cmd_list(cmds, sizeof(cmds));
 }
 
-void ssd1306_render(const uint8_t *buf, struct render_area *area) {
+void FUNC_RAM_NUCLEO0(ssd1306_render)(const uint8_t *buf, struct render_area *area) {
+    RASTREIO_INICIO(RASTREIO_ID_SSD1306_RENDER);
+    uint32_t inicio_us = time_us_32();
     uint8_t cmds[] = {
         SSD1306_COLUMN_ADDR,
         area->start_column,
@@ -93,6 +100,36 @@ void ssd1306_render(const uint8_t *buf, struct render_area *area) {
     };
     ssd1306_send_cmd_list(cmds, sizeof(cmds));
     ssd1306_send_buffer(buf, area->buffer_length);
+    uint32_t duracao_us = time_us_32() - inicio_us;
+    metricas_incrementar(METRICA_OLED_FLUSHES);
+    metricas_somar(METRICA_OLED_FLUSH_US, duracao_us);
+    metricas_maximo(METRICA_OLED_FLUSH_MAX_US, duracao_us);
+    RASTREIO_FIM(RASTREIO_ID_SSD1306_RENDER);
+}
+
+/**
+ * @brief Escreve uma transação conferindo o ACK de todos os bytes, com prazo de duas
+ * vezes o tempo nominal no barramento (9 bits por byte, mais o endereço) mais 1 ms.
+ */
+static bool escrever_verificado(const uint8_t *dados, size_t len, uint freq_hz) {
+    uint prazo_us = (uint)((uint64_t)(len + 1) * 9 * 2 * 1000000u / freq_hz) + 1000;
+    return i2c_write_timeout_us(I2C_PORT, SSD1306_I2C_ADDR, dados, len, false, prazo_us) == (int)len;
+}
+
+bool ssd1306_render_verificado(const uint8_t *buf, struct render_area *area, uint freq_hz) {
+    if (area->buffer_length > ssd1306_buffer_length) return false;
+
+    // Byte de controle 0x00 (Co=0, D/C#=0): os bytes seguintes são todos comandos
+    const uint8_t cmds[] = {
+        0x00,
+        SSD1306_COLUMN_ADDR, area->start_column, area->end_column,
+        SSD1306_PAGE_ADDR, area->start_page, area->end_page
+    };
+    if (!escrever_verificado(cmds, sizeof(cmds), freq_hz)) return false;
+
+    buffer_envio[0] = 0x40;
+    memcpy(buffer_envio + 1, buf, area->buffer_length);
+    return escrever_verificado(buffer_envio, area->buffer_length + 1, freq_hz);
 }
 
 void ssd1306_set_pixel(uint8_t *buf, int x, int y, bool on) {
@@ -180,7 +217,8 @@ static inline int get_font_char_offset(uint8_t character_code) {
 }
 
 
-void ssd1306_draw_char(uint8_t *buf, int16_t x, int16_t y, uint8_t character_code) {
+// A fonte (ssd1306_font.h) não é const: já fica na SRAM (.data) em qualquer modo
+void FUNC_RAM_NUCLEO0(ssd1306_draw_char)(uint8_t *buf, int16_t x, int16_t y, uint8_t character_code) {
     if (x < 0 || x > SSD1306_WIDTH - 8 || y < 0 || y > SSD1306_HEIGHT - 8) {
         return;
     }
@@ -66,6 +66,15 @@ void ssd1306_send_cmd(uint8_t cmd);
 void ssd1306_send_cmd_list(const uint8_t *cmd_list, int size);
 void ssd1306_send_buffer(const uint8_t *buf, int buflen);
 void ssd1306_render(const uint8_t *buf, struct render_area *area);
+
+/**
+ * @brief Como ssd1306_render, mas confere o ACK de cada transação e limita cada uma
+ * a um prazo proporcional a freq_hz. Usado pelo autoajuste de velocidade do I2C;
+ * não entra nas métricas de renderização.
+ *
+ * @return true se todas as transações foram reconhecidas dentro do prazo.
+ */
+bool ssd1306_render_verificado(const uint8_t *buf, struct render_area *area, uint freq_hz);
 void ssd1306_set_pixel(uint8_t *buf, int x, int y, bool on);
 void ssd1306_draw_line(uint8_t *buf, int x0, int y0, int x1, int y1, bool on);
 void ssd1306_draw_char(uint8_t *buf, int16_t x, int16_t y, uint8_t character);
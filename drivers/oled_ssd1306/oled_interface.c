@@ -11,16 +11,66 @@
 #include "hardware/i2c.h"
 #include "pico/stdlib.h" // Para gpio_set_function, gpio_pull_up
 #include <string.h>      // Para memset
+#include <stdio.h>       // Para printf do resultado do autoajuste
 
 // O i2c_inst_t usado é i2c1
 #define I2C_PORT i2c1
 
+// Velocidade escolhida e vazão medida com ela (quadros completos, em bytes/s)
+static uint freq_i2c_hz = OLED_I2C_FREQ_HZ;
+static uint32_t vazao_i2c_bytes_s = 0;
+static uint32_t quadros_enviados = 0; // Renderizações e limpezas enviadas ao display
+
+/**
+ * @brief Envia OLED_I2C_QUADROS_TESTE quadros com ACK conferido a uma velocidade.
+ *
+ * @param vazao_bytes_s Recebe a vazão medida (só válida se retornar true).
+ * @return true se todas as transações foram reconhecidas.
+ */
+static bool testar_velocidade_i2c(uint freq_hz, uint32_t *vazao_bytes_s) {
+    uint freq_real = i2c_set_baudrate(I2C_PORT, freq_hz);
+    uint32_t inicio = time_us_32();
+    for (int i = 0; i < OLED_I2C_QUADROS_TESTE; i++) {
+        if (!ssd1306_render_verificado(buffer_oled, &area, freq_real)) return false;
+    }
+    uint32_t duracao_us = time_us_32() - inicio;
+    // Bytes no barramento por quadro: endereço + comandos (7) e endereço + dados
+    uint32_t bytes = OLED_I2C_QUADROS_TESTE * (8 + area.buffer_length + 2);
+    *vazao_bytes_s = duracao_us ? (uint32_t)((uint64_t)bytes * 1000000u / duracao_us) : 0;
+    return true;
+}
+
+/**
+ * @brief Sobe a velocidade do I2C de OLED_I2C_FREQ_HZ até OLED_I2C_FREQ_MAX_HZ e fica
+ * com a última em que todos os quadros de teste foram reconhecidos.
+ *
+ * Não há leitura de volta no SSD1306: a verificação é o ACK de cada byte. Um NAK
+ * no meio de um comando pode deixar o controlador dessincronizado, por isso a
+ * sequência de inicialização é reenviada na velocidade escolhida. Acima de 400 kHz
+ * os pull-ups internos (~50 kΩ) são fracos demais; o teste depende dos resistores
+ * da placa e rejeita as velocidades em que as bordas não fecham.
+ */
+static void autoajustar_velocidade_i2c(void) {
+    uint32_t vazao;
+    for (uint freq = OLED_I2C_FREQ_HZ; freq <= OLED_I2C_FREQ_MAX_HZ; freq += OLED_I2C_PASSO_HZ) {
+        if (!testar_velocidade_i2c(freq, &vazao)) {
+            printf("[OLED] I2C sem ACK a %u kHz\n", freq / 1000);
+            break;
+        }
+        freq_i2c_hz = freq;
+        vazao_i2c_bytes_s = vazao;
+    }
+    i2c_set_baudrate(I2C_PORT, freq_i2c_hz);
+    ssd1306_init();
+}
+
 /**
  * @brief Inicializa o barramento I2C e o display OLED.
  */
 void oled_setup_interface() {
-    // Inicializa o barramento I2C na porta i2c1 com frequência de 400 kHz
-    i2c_init(I2C_PORT, 400 * 1000);
+    // Inicializa o barramento I2C na porta i2c1 com a frequência inicial (400 kHz).
+    // O divisor vem do clk_sys atual, então o perfil de clock já deve ter sido aplicado.
+    i2c_init(I2C_PORT, OLED_I2C_FREQ_HZ);
 
     // Define os pinos SDA e SCL como função I2C
     gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);
@@ -42,10 +92,27 @@ void oled_setup_interface() {
     // Calcula o tamanho do buffer necessário para essa área
     calculate_render_area_buffer_length(&area); // Passa o ponteiro da 'area' global
 
+    // Os quadros de teste usam o buffer global, então ele é zerado antes
+    memset(buffer_oled, 0, ssd1306_buffer_length);
+#if OLED_I2C_AUTOAJUSTE
+    autoajustar_velocidade_i2c();
+#else
+    if (!testar_velocidade_i2c(freq_i2c_hz, &vazao_i2c_bytes_s)) printf("[OLED] I2C sem ACK\n");
+#endif
+    printf("[OLED] I2C a %u kHz, %lu bytes/s\n", freq_i2c_hz / 1000, (unsigned long)vazao_i2c_bytes_s);
+
     // Limpa completamente o display usando o buffer global
     oled_clear_global_buffer();
 }
 
+uint oled_i2c_frequencia_hz(void) {
+    return freq_i2c_hz;
+}
+
+uint32_t oled_i2c_vazao_bytes_s(void) {
+    return vazao_i2c_bytes_s;
+}
+
 /**
  * @brief Limpa o buffer gráfico global do OLED e atualiza o display.
  */
@@ -55,19 +122,14 @@ void oled_clear_global_buffer() {
 
     // Envia o buffer global atualizado para o display, usando a 'area' global
     ssd1306_render(buffer_oled, &area);
+    quadros_enviados++;
 }
 
 /**
  * @brief Exibe uma mensagem no display OLED por um tempo e depois limpa.
  */
 void oled_exibir_mensagem_temporaria(const char *mensagem, int linha_y) {
-    oled_clear_global_buffer(); // Limpa usando o buffer global
-
-    // Escreve o texto no buffer global
-    ssd1306_draw_utf8_multiline(buffer_oled, 0, linha_y, mensagem);
-
-    // Renderiza o buffer global
-    oled_render_global_buffer();
+    oled_exibir_mensagem(mensagem, linha_y);
 
     // Espera TEMPO_MENSAGEM milissegundos
     sleep_ms(TEMPO_MENSAGEM);
@@ -77,9 +139,27 @@ void oled_exibir_mensagem_temporaria(const char *mensagem, int linha_y) {
     oled_render_global_buffer();
 }
 
+/**
+ * @brief Exibe uma mensagem no display OLED, sem esperar.
+ */
+void oled_exibir_mensagem(const char *mensagem, int linha_y) {
+    oled_clear_global_buffer(); // Limpa usando o buffer global
+
+    // Escreve o texto no buffer global
+    ssd1306_draw_utf8_multiline(buffer_oled, 0, linha_y, mensagem);
+
+    // Renderiza o buffer global
+    oled_render_global_buffer();
+}
+
 /**
  * @brief Renderiza o conteúdo do buffer global na área global do display.
  */
 void oled_render_global_buffer() {
     ssd1306_render(buffer_oled, &area);
+    quadros_enviados++;
+}
+
+uint32_t oled_quadros_enviados(void) {
+    return quadros_enviados;
 }
\ No newline at end of file
@@ -13,9 +13,21 @@ struct render_area;
  * Configura os pinos I2C, inicializa o controlador SSD1306,
  * define a área de renderização global e limpa o display.
  * Usa as definições de pinos e porta I2C de config_geral.h e oled_driver.h.
+ * Com OLED_I2C_AUTOAJUSTE, escolhe a velocidade do I2C por autoteste e imprime
+ * a velocidade e a vazão medida.
  */
 void oled_setup_interface();
 
+/**
+ * @brief Velocidade do I2C do OLED escolhida na inicialização (Hz).
+ */
+uint oled_i2c_frequencia_hz(void);
+
+/**
+ * @brief Vazão medida no I2C do OLED com a velocidade escolhida (bytes/s).
+ */
+uint32_t oled_i2c_vazao_bytes_s(void);
+
 /**
  * @brief Limpa o buffer gráfico global do OLED e atualiza o display.
  * O buffer e a área são os globais definidos em estado_compartilhado.
@@ -31,9 +43,24 @@ void oled_clear_global_buffer();
  */
 void oled_exibir_mensagem_temporaria(const char *mensagem, int linha_y);
 
+/**
+ * @brief Exibe uma mensagem no display OLED, sem esperar nem limpar depois
+ * (quem chama agenda a limpeza). Usa o buffer e área globais.
+ *
+ * @param mensagem Texto UTF-8 a ser exibido.
+ * @param linha_y Posição vertical (em pixels) para iniciar a mensagem.
+ */
+void oled_exibir_mensagem(const char *mensagem, int linha_y);
+
 /**
  * @brief Renderiza o conteúdo do buffer global na área global do display.
  */
 void oled_render_global_buffer();
 
+/**
+ * @brief Quadros enviados ao display até agora (renderizações e limpezas do
+ * buffer global): se mudou desde que uma tela foi desenhada, outra a substituiu.
+ */
+uint32_t oled_quadros_enviados(void);
+
 #endif
\ No newline at end of file
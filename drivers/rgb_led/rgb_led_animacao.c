@@ -0,0 +1,314 @@
+/**
+ * @file rgb_led_animacao.c
+ * @brief Motor de animação do LED RGB temporizado pelo hardware de PWM.
+ *
+ * Duas formas de execução, ambas com a taxa de quadros igual à frequência de
+ * wrap do PWM (~476 Hz a 125 MHz):
+ * - DMA: a sequência é pré-calculada em uma tabela de palavras CC por slice;
+ *   um canal de DMA, cadenciado pelo DREQ de wrap do slice, copia uma palavra
+ *   por período para o registrador de comparação. Em sequências cíclicas um
+ *   segundo canal (controle) reinicia o canal de dados ao fim da tabela.
+ *   Nenhum ciclo de CPU é gasto por quadro.
+ * - IRQ: o handler de PWM_IRQ_WRAP calcula o quadro seguinte. Usado quando a
+ *   sequência não cabe na tabela ou quando ANIM_LED_MODO_DMA = 0.
+ */
+
+#include "drivers/rgb_led/rgb_led_animacao.h"
+#include "drivers/rgb_led/rgb_led_pwm.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "shared/secao_ram.h" // Para o handler do IRQ e a tabela gama fora da flash
+#include <string.h>
+
+// Slice de PWM de um GPIO, em tempo de compilação (mesma regra de pwm_gpio_to_slice_num)
+#define SLICE_DO_GPIO(gpio) (((gpio) >> 1) & 7)
+#define ANIM_LED_NUM_SLICES (1 + (SLICE_DO_GPIO(LED_G) != SLICE_DO_GPIO(LED_R)) + \
+    (SLICE_DO_GPIO(LED_B) != SLICE_DO_GPIO(LED_R) && SLICE_DO_GPIO(LED_B) != SLICE_DO_GPIO(LED_G)))
+
+// Correção gama 2.2: tabela_gama[i] = round(65535 * (i / 255)^2.2)
+static const uint16_t tabela_gama[256] DADOS_RAM("tabela_gama") = {
+        0,     0,     2,     4,     7,    11,    17,    24,
+       32,    42,    53,    65,    79,    94,   111,   129,
+      148,   169,   192,   216,   242,   270,   299,   330,
+      362,   396,   432,   469,   508,   549,   591,   635,
+      681,   729,   779,   830,   883,   938,   995,  1053,
+     1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+     1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,
+     2334,  2427,  2521,  2618,  2717,  2817,  2920,  3024,
+     3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+     4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,
+     5115,  5257,  5401,  5547,  5695,  5845,  5998,  6152,
+     6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+     7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,
+     9111,  9305,  9501,  9699,  9900, 10102, 10307, 10515,
+    10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+    12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140,
+    14386, 14635, 14885, 15138, 15394, 15652, 15912, 16174,
+    16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+    18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694,
+    20996, 21301, 21609, 21919, 22231, 22546, 22863, 23182,
+    23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+    26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627,
+    28988, 29351, 29717, 30086, 30457, 30830, 31206, 31585,
+    31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+    35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981,
+    38402, 38825, 39252, 39680, 40112, 40546, 40982, 41421,
+    41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+    45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793,
+    49275, 49761, 50249, 50739, 51232, 51728, 52226, 52727,
+    53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+    57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097,
+    61642, 62190, 62741, 63295, 63851, 64410, 64971, 65535,
+};
+
+// Sequências de estado da conexão
+static const QuadroChaveLed quadros_wifi_tentando[] = {
+    {255, 255, 0, 0}, {255, 255, 0, 500}, {0, 0, 0, 0}, {0, 0, 0, 500},
+};
+static const QuadroChaveLed quadros_wifi_conectando[] = {
+    {0, 0, 255, 900}, {0, 0, 20, 900},
+};
+static const QuadroChaveLed quadros_wifi_conectado[] = {
+    {0, 255, 0, 400},
+};
+static const QuadroChaveLed quadros_wifi_falha[] = {
+    {255, 0, 0, 0}, {255, 0, 0, 120}, {0, 0, 0, 0}, {0, 0, 0, 120},
+};
+
+const SequenciaLed ANIM_LED_WIFI_TENTANDO = {quadros_wifi_tentando, 4, true};
+const SequenciaLed ANIM_LED_WIFI_CONECTANDO = {quadros_wifi_conectando, 2, true};
+const SequenciaLed ANIM_LED_WIFI_CONECTADO = {quadros_wifi_conectado, 1, false};
+const SequenciaLed ANIM_LED_WIFI_FALHA = {quadros_wifi_falha, 4, true};
+
+// Animação em curso (cópia dos quadros-chave já convertidos para quadros de PWM)
+typedef struct {
+    QuadroChaveLed quadros[ANIM_LED_MAX_QUADROS_CHAVE];
+    uint32_t duracao_quadros[ANIM_LED_MAX_QUADROS_CHAVE];
+    QuadroChaveLed origem;   // Cor de partida de sequências não cíclicas
+    uint8_t num_quadros;
+    bool repetir;
+    uint32_t total_quadros;
+} AnimacaoLed;
+
+static AnimacaoLed animacao;
+static QuadroChaveLed cor_alvo;         // Última cor-alvo (ponto de partida das transições)
+static volatile bool irq_ativo = false;
+static volatile uint32_t quadro_atual = 0;
+
+// Slice e canal (A/B) de cada cor, na ordem R, G, B
+static uint slice_led[3], canal_led[3];
+static uint slices_unicos[ANIM_LED_NUM_SLICES];
+static uint slice_irq;
+
+#if ANIM_LED_MODO_DMA
+// Palavras CC (canal A nos 16 bits baixos, B nos altos) por quadro, por slice
+static uint32_t tabelas_dma[ANIM_LED_NUM_SLICES][ANIM_LED_DMA_MAX_QUADROS];
+static const uint32_t *enderecos_tabela[ANIM_LED_NUM_SLICES]; // Lidos pelos canais de controle
+static int canal_dados[ANIM_LED_NUM_SLICES], canal_controle[ANIM_LED_NUM_SLICES];
+static bool dma_ativo = false;
+#endif
+
+uint16_t FUNC_RAM_NUCLEO0(anim_led_gama)(uint16_t valor_q8) {
+    uint8_t indice = valor_q8 >> 8;
+    uint8_t fracao = valor_q8 & 0xFF;
+    if (indice == 255) return tabela_gama[255];
+    // Interpolação linear entre entradas vizinhas para fades suaves em baixa intensidade
+    return tabela_gama[indice] + (((tabela_gama[indice + 1] - tabela_gama[indice]) * fracao) >> 8);
+}
+
+static uint16_t FUNC_RAM_NUCLEO0(interpolar_canal)(uint8_t de, uint8_t para, uint32_t fracao_q8) {
+    int32_t delta = ((int32_t)para - (int32_t)de) * (int32_t)fracao_q8;
+    return anim_led_gama((uint16_t)(((int32_t)de << 8) + delta));
+}
+
+/**
+ * @brief Calcula os níveis de PWM (R, G, B) da animação no quadro indicado.
+ */
+static void FUNC_RAM_NUCLEO0(calcular_quadro)(uint32_t quadro, uint16_t niveis[3]) {
+    const QuadroChaveLed *anterior = animacao.repetir ? &animacao.quadros[animacao.num_quadros - 1]
+                                                       : &animacao.origem;
+    uint32_t acumulado = 0;
+
+    for (uint8_t i = 0; i < animacao.num_quadros; i++) {
+        const QuadroChaveLed *atual = &animacao.quadros[i];
+        uint32_t duracao = animacao.duracao_quadros[i];
+        if (quadro < acumulado + duracao) {
+            uint32_t fracao_q8 = ((quadro - acumulado) << 8) / duracao;
+            niveis[0] = interpolar_canal(anterior->r, atual->r, fracao_q8);
+            niveis[1] = interpolar_canal(anterior->g, atual->g, fracao_q8);
+            niveis[2] = interpolar_canal(anterior->b, atual->b, fracao_q8);
+            return;
+        }
+        acumulado += duracao;
+        anterior = atual;
+    }
+    // Depois do último quadro-chave a cor fica parada
+    niveis[0] = anim_led_gama(anterior->r << 8);
+    niveis[1] = anim_led_gama(anterior->g << 8);
+    niveis[2] = anim_led_gama(anterior->b << 8);
+}
+
+/**
+ * @brief Handler do IRQ de wrap do PWM (modo IRQ): avança um quadro.
+ */
+static void FUNC_RAM_NUCLEO0(anim_led_irq_wrap)() {
+    pwm_clear_irq(slice_irq);
+    if (!irq_ativo) return;
+
+    uint32_t quadro = quadro_atual + 1;
+    if (quadro >= animacao.total_quadros) {
+        if (animacao.repetir) {
+            quadro = 0;
+        } else {
+            quadro = animacao.total_quadros;
+            irq_ativo = false;
+            pwm_set_irq_enabled(slice_irq, false);
+        }
+    }
+    quadro_atual = quadro;
+
+    uint16_t niveis[3];
+    calcular_quadro(quadro, niveis);
+    set_rgb_pwm(niveis[0], niveis[1], niveis[2]);
+}
+
+#if ANIM_LED_MODO_DMA
+static void parar_dma() {
+    if (!dma_ativo) return;
+    // O canal de controle primeiro, para que não reinicie o de dados durante o abort
+    for (int k = 0; k < ANIM_LED_NUM_SLICES; k++) {
+        dma_channel_abort(canal_controle[k]);
+        dma_channel_abort(canal_dados[k]);
+        dma_channel_abort(canal_controle[k]);
+    }
+    dma_ativo = false;
+}
+
+/**
+ * @brief Pré-calcula a sequência nas tabelas e dispara os canais de DMA.
+ */
+static void iniciar_dma(uint32_t num_quadros) {
+    for (uint32_t q = 0; q < num_quadros; q++) {
+        uint16_t niveis[3];
+        calcular_quadro(q, niveis);
+        for (int k = 0; k < ANIM_LED_NUM_SLICES; k++) {
+            uint32_t palavra = 0;
+            for (int cor = 0; cor < 3; cor++) {
+                if (slice_led[cor] != slices_unicos[k]) continue;
+                palavra |= (canal_led[cor] == PWM_CHAN_B) ? ((uint32_t)niveis[cor] << 16) : niveis[cor];
+            }
+            tabelas_dma[k][q] = palavra;
+        }
+    }
+
+    uint32_t mascara = 0;
+    for (int k = 0; k < ANIM_LED_NUM_SLICES; k++) {
+        enderecos_tabela[k] = tabelas_dma[k];
+
+        // Controle: reescreve o endereço de leitura do canal de dados (e o dispara)
+        dma_channel_config cfg_controle = dma_channel_get_default_config(canal_controle[k]);
+        channel_config_set_transfer_data_size(&cfg_controle, DMA_SIZE_32);
+        channel_config_set_read_increment(&cfg_controle, false);
+        channel_config_set_write_increment(&cfg_controle, false);
+        dma_channel_configure(canal_controle[k], &cfg_controle, &dma_hw->ch[canal_dados[k]].al3_read_addr_trig,
+                              &enderecos_tabela[k], 1, false);
+
+        // Dados: uma palavra por wrap do slice; cíclico encadeia no controle
+        dma_channel_config cfg_dados = dma_channel_get_default_config(canal_dados[k]);
+        channel_config_set_transfer_data_size(&cfg_dados, DMA_SIZE_32);
+        channel_config_set_read_increment(&cfg_dados, true);
+        channel_config_set_write_increment(&cfg_dados, false);
+        channel_config_set_dreq(&cfg_dados, pwm_get_dreq(slices_unicos[k]));
+        channel_config_set_chain_to(&cfg_dados, animacao.repetir ? canal_controle[k] : canal_dados[k]);
+        dma_channel_configure(canal_dados[k], &cfg_dados, &pwm_hw->slice[slices_unicos[k]].cc,
+                              tabelas_dma[k], num_quadros, false);
+        mascara |= 1u << canal_dados[k];
+    }
+    dma_start_channel_mask(mascara);
+    dma_ativo = true;
+}
+#endif
+
+void anim_led_inicializar() {
+    const uint pinos[3] = {LED_R, LED_G, LED_B};
+    int n = 0;
+    for (int cor = 0; cor < 3; cor++) {
+        slice_led[cor] = pwm_gpio_to_slice_num(pinos[cor]);
+        canal_led[cor] = pwm_gpio_to_channel(pinos[cor]);
+        bool repetido = false;
+        for (int k = 0; k < n; k++) repetido |= (slices_unicos[k] == slice_led[cor]);
+        if (!repetido) slices_unicos[n++] = slice_led[cor];
+    }
+
+    slice_irq = slice_led[0];
+    pwm_clear_irq(slice_irq);
+    irq_set_exclusive_handler(PWM_IRQ_WRAP, anim_led_irq_wrap);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
+
+#if ANIM_LED_MODO_DMA
+    for (int k = 0; k < ANIM_LED_NUM_SLICES; k++) {
+        canal_dados[k] = dma_claim_unused_channel(true);
+        canal_controle[k] = dma_claim_unused_channel(true);
+    }
+#endif
+}
+
+void anim_led_parar() {
+    irq_ativo = false;
+    pwm_set_irq_enabled(slice_irq, false);
+#if ANIM_LED_MODO_DMA
+    parar_dma();
+#endif
+}
+
+bool anim_led_executar(const SequenciaLed *seq) {
+    if (!seq || seq->num_quadros == 0 || seq->num_quadros > ANIM_LED_MAX_QUADROS_CHAVE) return false;
+
+    anim_led_parar();
+
+    float quadros_por_ms = rgb_pwm_frequencia_wrap_hz() / 1000.f;
+    animacao.origem = cor_alvo;
+    animacao.num_quadros = seq->num_quadros;
+    animacao.repetir = seq->repetir;
+    animacao.total_quadros = 0;
+    for (uint8_t i = 0; i < seq->num_quadros; i++) {
+        animacao.quadros[i] = seq->quadros[i];
+        animacao.duracao_quadros[i] = (uint32_t)(seq->quadros[i].duracao_ms * quadros_por_ms + 0.5f);
+        animacao.total_quadros += animacao.duracao_quadros[i];
+    }
+    cor_alvo = seq->quadros[seq->num_quadros - 1];
+
+    // Sequência sem duração: apenas fixa a cor final
+    if (animacao.total_quadros == 0) {
+        uint16_t niveis[3];
+        calcular_quadro(0, niveis);
+        set_rgb_pwm(niveis[0], niveis[1], niveis[2]);
+        return true;
+    }
+
+#if ANIM_LED_MODO_DMA
+    // Não cíclica: um quadro extra no fim deixa a cor final nos registradores
+    uint32_t quadros_tabela = animacao.total_quadros + (animacao.repetir ? 0 : 1);
+    if (quadros_tabela <= ANIM_LED_DMA_MAX_QUADROS) {
+        iniciar_dma(quadros_tabela);
+        return true;
+    }
+#endif
+
+    quadro_atual = 0;
+    irq_ativo = true;
+    pwm_clear_irq(slice_irq);
+    pwm_set_irq_enabled(slice_irq, true);
+    return true;
+}
+
+void anim_led_transicionar(uint8_t r, uint8_t g, uint8_t b, uint16_t duracao_ms) {
+    const QuadroChaveLed destino = {r, g, b, duracao_ms};
+    const SequenciaLed seq = {&destino, 1, false};
+    anim_led_executar(&seq);
+}
+
+void anim_led_cor(uint8_t r, uint8_t g, uint8_t b) {
+    anim_led_transicionar(r, g, b, 0);
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef RGB_LED_ANIMACAO_H
+#define RGB_LED_ANIMACAO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config/config_geral.h" // Para ANIM_LED_*
+
+/**
+ * @brief Quadro-chave de uma animação do LED RGB.
+ * A cor é dada em 8 bits por canal, antes da correção gama.
+ * `duracao_ms` é o tempo da transição linear desde o quadro-chave anterior
+ * até este (0 = salto imediato). Dois quadros seguidos com a mesma cor formam uma pausa.
+ */
+typedef struct {
+    uint8_t r, g, b;
+    uint16_t duracao_ms;
+} QuadroChaveLed;
+
+/**
+ * @brief Sequência de quadros-chave. Se `repetir` for verdadeiro, o primeiro
+ * quadro-chave parte da cor do último (animação cíclica).
+ */
+typedef struct {
+    const QuadroChaveLed *quadros;
+    uint8_t num_quadros;
+    bool repetir;
+} SequenciaLed;
+
+// Sequências prontas para indicar o estado da conexão
+extern const SequenciaLed ANIM_LED_WIFI_TENTANDO;   // Amarelo piscando
+extern const SequenciaLed ANIM_LED_WIFI_CONECTANDO; // Azul "respirando"
+extern const SequenciaLed ANIM_LED_WIFI_CONECTADO;  // Verde acendendo suavemente
+extern const SequenciaLed ANIM_LED_WIFI_FALHA;      // Vermelho piscando rápido
+
+/**
+ * @brief Inicializa o motor de animação. Deve ser chamada depois de init_rgb_pwm().
+ * Reserva os canais de DMA (modo DMA) e registra o handler do IRQ de wrap do PWM.
+ */
+void anim_led_inicializar();
+
+/**
+ * @brief Inicia uma sequência, substituindo a animação em curso.
+ * Os quadros-chave são copiados, então a sequência pode estar na pilha.
+ * No modo DMA a sequência é pré-calculada em tabelas de níveis que o DMA
+ * escreve nos registradores de comparação a cada wrap do PWM (custo zero de CPU
+ * por quadro); sequências mais longas que a tabela usam o IRQ de wrap.
+ *
+ * @param seq Sequência a executar.
+ * @return false se a sequência for vazia ou tiver mais que ANIM_LED_MAX_QUADROS_CHAVE quadros.
+ */
+bool anim_led_executar(const SequenciaLed *seq);
+
+/**
+ * @brief Faz uma transição suave da cor atual para a cor indicada.
+ *
+ * @param r, g, b Cor final (8 bits por canal, antes da correção gama).
+ * @param duracao_ms Duração da transição.
+ */
+void anim_led_transicionar(uint8_t r, uint8_t g, uint8_t b, uint16_t duracao_ms);
+
+/**
+ * @brief Interrompe a animação e fixa a cor indicada imediatamente.
+ */
+void anim_led_cor(uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Interrompe a animação em curso, mantendo a última cor escrita.
+ */
+void anim_led_parar();
+
+/**
+ * @brief Aplica a correção gama (2.2) a um valor de 8 bits com 8 bits de fração.
+ *
+ * @param valor_q8 Intensidade em ponto fixo 8.8 (0 a 0xFF00).
+ * @return Nível de PWM de 16 bits (0 a PWM_STEP).
+ */
+uint16_t anim_led_gama(uint16_t valor_q8);
+
+#endif
\ No newline at end of file
@@ -1,10 +1,26 @@
 #include "drivers/rgb_led/rgb_led_pwm.h"
 #include "hardware/pwm.h" // Para funções pwm_*
 #include "pico/stdlib.h"  // Para gpio_set_function
+#include "hardware/clocks.h" // Para clock_get_hz
 
 // Variáveis estáticas para armazenar os números dos slices de PWM
 static uint slice_r, slice_g, slice_b;
 
+// Divisor efetivamente programado (8 bits inteiros + 4 bits de fração)
+static float divisor_pwm = 4.f;
+
+/**
+ * @brief Divisor que aproxima RGB_PWM_FREQUENCIA_WRAP_HZ com o clk_sys atual,
+ * arredondado para a resolução de 1/16 do divisor do PWM.
+ */
+static float calcular_divisor_pwm() {
+    float divisor = (float)clock_get_hz(clk_sys) / (RGB_PWM_FREQUENCIA_WRAP_HZ * 65536.f);
+    divisor = (float)(int)(divisor * 16.f + 0.5f) / 16.f;
+    if (divisor < 1.f) divisor = 1.f;
+    if (divisor > 255.9375f) divisor = 255.9375f;
+    return divisor;
+}
+
 /**
  * @brief Inicializa os pinos GPIO conectados ao LED RGB para operarem com PWM.
  */
@@ -21,10 +37,12 @@ void init_rgb_pwm() {
 
     // Obtém a configuração padrão do PWM
     pwm_config config = pwm_get_default_config();
-    // Define um divisor de clock para o PWM (ajuste conforme necessário para a frequência desejada)
+    // Define um divisor de clock para o PWM a partir do clk_sys atual.
     // Um divisor de 4.f com clock de sistema de 125MHz resulta em ~31.25MHz para o contador PWM.
-    // Com um TOP de 0xFFFF (65535), a frequência do PWM será ~476Hz.
-    pwm_config_set_clkdiv(&config, 4.f);
+    // Com um TOP de 0xFFFF (65535), a frequência do PWM será ~476Hz. O divisor é arredondado
+    // para 1/16: 6.375 a 200 MHz (~479 Hz) e 1.5625 a 48 MHz (~469 Hz).
+    divisor_pwm = calcular_divisor_pwm();
+    pwm_config_set_clkdiv(&config, divisor_pwm);
     // Para PWM_STEP (0xFFFF), o wrap é automático.
 
     // Inicializa cada slice de PWM com a configuração e habilita-o
@@ -44,4 +62,12 @@ void set_rgb_pwm(uint16_t r_val, uint16_t g_val, uint16_t b_val) {
     pwm_set_gpio_level(LED_R, r_val);
     pwm_set_gpio_level(LED_G, g_val);
     pwm_set_gpio_level(LED_B, b_val);
+}
+
+/**
+ * @brief Frequência de wrap (fim de período) dos slices do LED RGB, em Hz.
+ */
+float rgb_pwm_frequencia_wrap_hz() {
+    // O contador vai de 0 a TOP (0xFFFF), ou seja, 65536 contagens por período
+    return (float)clock_get_hz(clk_sys) / (divisor_pwm * 65536.f);
 }
\ No newline at end of file
@@ -3,9 +3,14 @@
 
 #include "config/config_geral.h" // Para definições de pinos LED_R, LED_G, LED_B
 
+// Frequência de wrap desejada para os slices do LED: a original com divisor 4 a
+// 125 MHz (125 MHz / 4 / 65536). O divisor é recalculado a partir do clk_sys atual.
+#define RGB_PWM_FREQUENCIA_WRAP_HZ 476.837f
+
 /**
  * @brief Inicializa os pinos GPIO conectados ao LED RGB para operarem com PWM.
- * Configura os slices de PWM e a divisão de clock.
+ * Configura os slices de PWM e a divisão de clock, calculada para o clk_sys
+ * atual (ver perfil_clock.h). Deve ser chamada depois da troca de clock.
  */
 void init_rgb_pwm();
 
@@ -18,4 +23,12 @@ void init_rgb_pwm();
  */
 void set_rgb_pwm(uint16_t r_val, uint16_t g_val, uint16_t b_val);
 
+/**
+ * @brief Frequência de wrap (fim de período) dos slices do LED RGB.
+ * É a taxa de quadros do motor de animação (rgb_led_animacao.c).
+ *
+ * @return Frequência em Hz, calculada a partir do clock de sistema atual.
+ */
+float rgb_pwm_frequencia_wrap_hz();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,336 @@
+/**
+ * @file bench_host.c
+ * @brief Micro-benchmarks dos módulos do firmware no build nativo.
+ *
+ * Mede, no host, as operações que pesam no loop do núcleo 0:
+ * - glifos desenhados por segundo (ssd1306_draw_char / draw_utf8_string);
+ * - operações por segundo da fila inter-core (inserir + remover);
+ * - bytes de I2C por renderização completa do OLED;
+ * - mensagens inter-core tratadas por segundo;
+ * - atualizações por segundo das estatísticas de fluxo, com o erro do resumo
+ *   em relação ao cálculo exato (média, desvio e quantis por ordenação);
+ * - tamanho e custo de um resumo de sensores em texto e em CBOR;
+ * - taxa e custo da compressão LZSS de um lote cheio nos dois formatos,
+ *   conferida pela descompressão;
+ * - a mesma compressão como trabalho do executor: vazão com o núcleo 1
+ *   roubando os trabalhos, fração feita por ele e latência da submissão à
+ *   conclusão no núcleo 0.
+ *
+ * Uso: MQTTPicoRF_bench [iteracoes] > /dev/null
+ * Termina com código 1 se o mínimo ou o máximo das estatísticas divergir (ctest).
+ * O relatório vai para stderr; stdout recebe os printf do próprio firmware.
+ */
+
+#include "config/config_geral.h"
+#include "core0/fila_circular.h"
+#include "core0/main_core0_utils.h"
+#include "drivers/oled_ssd1306/oled_driver.h"
+#include "drivers/oled_ssd1306/oled_interface.h"
+#include "drivers/rgb_led/rgb_led_animacao.h"
+#include "drivers/rgb_led/rgb_led_pwm.h"
+#include "shared/estado_compartilhado.h"
+#include "shared/estatistica_fluxo.h"
+#include "shared/cbor_escrita.h"
+#include "shared/compressao_lzss.h"
+#include "shared/executor.h"
+#include "drivers/adc/aquisicao_adc.h"
+#include "pico/multicore.h"
+#include "host_mocks.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static uint64_t inicio_us;
+
+static void cronometro_iniciar(void) {
+    inicio_us = time_us_64();
+}
+
+static void cronometro_relatar(const char *nome, uint64_t operacoes, const char *unidade) {
+    uint64_t decorrido = time_us_64() - inicio_us;
+    if (decorrido == 0) decorrido = 1;
+    fprintf(stderr, "%-28s %12.0f %s/s  (%llu em %.3f ms)\n", nome, (double)operacoes * 1e6 / (double)decorrido, unidade,
+           (unsigned long long)operacoes, decorrido / 1000.0);
+}
+
+static void bench_glifos(uint32_t iteracoes) {
+    cronometro_iniciar();
+    uint64_t glifos = 0;
+    for (uint32_t i = 0; i < iteracoes; i++) {
+        for (int y = 0; y < SSD1306_HEIGHT; y += 8) {
+            for (int x = 0; x <= SSD1306_WIDTH - 8; x += 8) {
+                ssd1306_draw_char(buffer_oled, x, y, (uint8_t)('A' + (x / 8 + i) % 26));
+                glifos++;
+            }
+        }
+    }
+    cronometro_relatar("ssd1306_draw_char", glifos, "glifos");
+
+    static const char texto[] = "Conexão: ação é rápida";
+    cronometro_iniciar();
+    for (uint32_t i = 0; i < iteracoes; i++) ssd1306_draw_utf8_string(buffer_oled, 0, (i % 8) * 8, texto);
+    cronometro_relatar("ssd1306_draw_utf8_string", iteracoes, "linhas");
+}
+
+static void bench_fila(uint32_t iteracoes) {
+    static FilaCircularInterCore fila;
+    fila_intercore_inicializar(&fila);
+    MensagemInterCore m = {1, 2}, saida;
+
+    cronometro_iniciar();
+    for (uint32_t i = 0; i < iteracoes * 64; i++) {
+        fila_intercore_inserir(&fila, m);
+        fila_intercore_remover(&fila, &saida);
+    }
+    cronometro_relatar("fila inserir+remover", (uint64_t)iteracoes * 64, "pares");
+}
+
+static void bench_renderizacao(uint32_t iteracoes) {
+    host_i2c_zerar_estatisticas();
+    cronometro_iniciar();
+    for (uint32_t i = 0; i < iteracoes; i++) oled_render_global_buffer();
+    cronometro_relatar("oled_render_global_buffer", iteracoes, "quadros");
+
+    const HostEstatisticasI2C *e = host_i2c_estatisticas();
+    fprintf(stderr, "%-28s %12.1f bytes/quadro  (%.1f transações/quadro)\n", "I2C por renderização",
+           (double)e->bytes_escritos / iteracoes, (double)e->transacoes / iteracoes);
+    // Tempo de barramento equivalente a 400 kHz: 9 bits por byte (8 + ACK)
+    fprintf(stderr, "%-28s %12.2f ms/quadro a 400 kHz\n", "tempo de barramento estimado",
+           (double)e->bytes_escritos / iteracoes * 9.0 / 400.0);
+}
+
+static void bench_mensagens(uint32_t iteracoes) {
+    ultimo_ip_bin = 0x3200A8C0u;
+    MensagemInterCore status = {1, 1};
+    cronometro_iniciar();
+    for (uint32_t i = 0; i < iteracoes; i++) {
+        status.status_ou_dado = i % 4;
+        util_tratar_mensagem_intercore(status);
+    }
+    cronometro_relatar("util_tratar_mensagem_intercore", iteracoes, "msgs");
+}
+
+static int comparar_i32(const void *a, const void *b) {
+    int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @return false se o mínimo ou o máximo do resumo diverge do cálculo exato.
+ */
+static bool bench_estatistica(uint32_t iteracoes) {
+    uint32_t n = iteracoes * 64;
+    int32_t *valores = malloc(sizeof(int32_t) * n);
+    if (!valores) return false;
+    // Soma de dois uniformes (distribuição triangular) em torno de 2^19, como médias Q8 do ADC
+    uint32_t x = 1;
+    for (uint32_t i = 0; i < n; i++) {
+        x = x * 1664525u + 1013904223u;
+        uint32_t y = x * 1664525u + 1013904223u;
+        x = y;
+        valores[i] = (int32_t)((x >> 14) + (y >> 22) * 64);
+    }
+
+    static EstatisticaFluxo e;
+    ResumoEstatistica r;
+    estatistica_reiniciar(&e);
+    cronometro_iniciar();
+    for (uint32_t i = 0; i < n; i++) estatistica_adicionar(&e, valores[i]);
+    cronometro_relatar("estatistica_adicionar", n, "valores");
+    estatistica_resumir(&e, &r, true);
+
+    double soma = 0, soma_quadrados = 0;
+    for (uint32_t i = 0; i < n; i++) soma += valores[i];
+    double media = soma / n;
+    for (uint32_t i = 0; i < n; i++) soma_quadrados += (valores[i] - media) * (valores[i] - media);
+    double desvio = sqrt(soma_quadrados / (n - 1));
+    qsort(valores, n, sizeof(int32_t), comparar_i32);
+    double alcance = (double)valores[n - 1] - valores[0];
+    const uint32_t permil[3] = {500, 900, 990};
+    const int32_t aproximados[3] = {r.p50, r.p90, r.p99};
+    double pior_quantil = 0;
+    for (int q = 0; q < 3; q++) {
+        uint32_t posicao = (uint32_t)(((uint64_t)n * permil[q] + 999) / 1000);
+        double erro = fabs((double)aproximados[q] - valores[posicao - 1]) / alcance;
+        if (erro > pior_quantil) pior_quantil = erro;
+    }
+    bool exatos = r.minimo == valores[0] && r.maximo == valores[n - 1];
+    fprintf(stderr, "%-28s média %.3g  desvio %.3g  quantis %.2f%% do alcance  (mín/máx %s)\n", "erro do resumo",
+            fabs(r.media_q8 / 256.0 - media), fabs(r.desvio_q8 / 256.0 - desvio), pior_quantil * 100,
+            exatos ? "exatos" : "DIVERGENTES");
+    free(valores);
+    return exatos;
+}
+
+// Janela de 5 s com as quatro entradas do round-robin (médias Q8 de um ADC de 12 bits)
+static ResumoSensores resumo_exemplo;
+
+static void bench_payload_resumo(uint32_t iteracoes) {
+    ResumoSensores resumo = resumo_exemplo;
+    const uint8_t entradas[4] = {0, 1, 2, 4};
+    resumo.blocos = 123456;
+    resumo.num_entradas = 4;
+    for (int k = 0; k < 4; k++) {
+        ResumoEstatistica *r = &resumo.entradas[k].resumo;
+        resumo.entradas[k].entrada = entradas[k];
+        r->n = 78;
+        if (entradas[k] == 4) {
+            *r = (ResumoEstatistica){78, 24810, 25960, 25270 * 256, 0, 180 * 256, 25240, 25610, 25900};
+        } else {
+            int32_t base = (1000 + 700 * k) << 8;
+            *r = (ResumoEstatistica){78, base - 9000, base + 11000, (int64_t)base * 256 + 4321, 0,
+                                     2100 * 256 + 77, base + 300, base + 6400, base + 10200};
+        }
+    }
+
+    char texto[SENSORES_TAM_RESUMO];
+    int tamanho_texto = 0;
+    cronometro_iniciar();
+    for (uint32_t i = 0; i < iteracoes; i++) {
+        int n = snprintf(texto, sizeof(texto), "janela_ms=%lu,", 5000ul);
+        tamanho_texto = n + aquisicao_adc_formatar_resumo(&resumo, texto + n, sizeof(texto) - n);
+    }
+    cronometro_relatar("resumo em texto", iteracoes, "resumos");
+
+    uint8_t binario[SENSORES_TAM_RESUMO];
+    CodificadorCbor c;
+    cronometro_iniciar();
+    for (uint32_t i = 0; i < iteracoes; i++) {
+        cbor_iniciar(&c, binario, sizeof(binario));
+        aquisicao_adc_codificar_resumo(&resumo, 5000, &c);
+    }
+    cronometro_relatar("resumo em CBOR", iteracoes, "resumos");
+    fprintf(stderr, "%-28s %12d bytes texto, %zu bytes CBOR (%.1fx)%s\n", "tamanho do resumo", tamanho_texto,
+            c.tamanho, (double)tamanho_texto / c.tamanho, c.estouro ? "  ESTOURO" : "");
+    resumo_exemplo = resumo;
+}
+
+/**
+ * @brief Comprime um lote e confere a descompressão.
+ */
+static void bench_lzss_lote(const char *nome, const uint8_t *lote, size_t tamanho, uint32_t iteracoes) {
+    static uint8_t comprimido[CONTROLE_LOTE_MAX * SENSORES_TAM_RESUMO];
+    static uint8_t restaurado[CONTROLE_LOTE_MAX * SENSORES_TAM_RESUMO];
+    size_t n = 0;
+    cronometro_iniciar();
+    for (uint32_t i = 0; i < iteracoes; i++) n = lzss_comprimir(lote, tamanho, comprimido, tamanho);
+    uint64_t decorrido_us = time_us_64() - inicio_us;
+    cronometro_relatar(nome, iteracoes, "lotes");
+    size_t m = n ? lzss_descomprimir(comprimido, n, restaurado, sizeof(restaurado)) : 0;
+    bool confere = m == tamanho && memcmp(lote, restaurado, tamanho) == 0;
+    fprintf(stderr, "%-28s %12zu -> %zu bytes (%.2fx, %.2f MB/s)  %s\n", "", tamanho, n ? n : tamanho,
+            n ? (double)tamanho / n : 1.0, (double)tamanho * iteracoes / decorrido_us,
+            n == 0 ? "sem ganho" : confere ? "ida e volta OK" : "DIVERGENTE");
+}
+
+// Compressão de um lote como trabalho do executor
+typedef struct {
+    Trabalho trabalho;
+    const uint8_t *lote;
+    size_t tamanho;
+    uint8_t saida[CONTROLE_LOTE_MAX * SENSORES_TAM_RESUMO];
+    uint64_t submetido_us;
+} TrabalhoLzss;
+
+static uint32_t concluidos_lzss, feitos_nucleo1;
+static uint64_t latencia_total_us, latencia_max_us;
+
+static void executar_lzss(Trabalho *trabalho) {
+    TrabalhoLzss *t = trabalho->arg;
+    lzss_comprimir(t->lote, t->tamanho, t->saida, t->tamanho);
+}
+
+static void concluir_lzss(Trabalho *trabalho) {
+    TrabalhoLzss *t = trabalho->arg;
+    uint64_t latencia = time_us_64() - t->submetido_us;
+    latencia_total_us += latencia;
+    if (latencia > latencia_max_us) latencia_max_us = latencia;
+    if (trabalho->nucleo_execucao == 1) feitos_nucleo1++;
+    concluidos_lzss++;
+}
+
+static void nucleo1_executor(void) {
+    while (true) executor_ocioso_ate(make_timeout_time_ms(1000), NULL);
+}
+
+/**
+ * @brief Submete `iteracoes` compressões do lote mantendo o deque do núcleo 0
+ * cheio; o núcleo 1 as rouba e a campainha da FIFO traz as conclusões.
+ */
+static void bench_executor(const uint8_t *lote, size_t tamanho, uint32_t iteracoes) {
+    static TrabalhoLzss trabalhos[EXECUTOR_TAM_DEQUE];
+    executor_inicializar();
+    multicore_launch_core1(nucleo1_executor);
+
+    uint32_t submetidos = 0;
+    cronometro_iniciar();
+    while (concluidos_lzss < iteracoes) {
+        for (int i = 0; i < EXECUTOR_TAM_DEQUE && submetidos < iteracoes; i++) {
+            TrabalhoLzss *t = &trabalhos[i];
+            if (t->trabalho.estado != TRABALHO_LIVRE) continue;
+            t->lote = lote;
+            t->tamanho = tamanho;
+            t->trabalho.executar = executar_lzss;
+            t->trabalho.concluir = concluir_lzss;
+            t->trabalho.arg = t;
+            t->submetido_us = time_us_64();
+            executor_submeter(&t->trabalho);
+            submetidos++;
+        }
+        if (multicore_fifo_rvalid() && (multicore_fifo_pop_blocking() >> 16) == FIFO_TIPO_TRABALHO) {
+            executor_campainha();
+        }
+    }
+    cronometro_relatar("executor lzss lote CBOR", iteracoes, "lotes");
+    fprintf(stderr, "%-28s %11.1f%% no núcleo 1, latência média %.1f us, máxima %llu us\n", "",
+            100.0 * feitos_nucleo1 / iteracoes, (double)latencia_total_us / iteracoes,
+            (unsigned long long)latencia_max_us);
+}
+
+static void bench_compressao(uint32_t iteracoes) {
+    // Lote cheio de CONTROLE_LOTE_MAX janelas consecutivas, como publicar_sensores_periodicamente monta
+    static uint8_t lote_cbor[CONTROLE_LOTE_MAX * SENSORES_TAM_RESUMO];
+    static char lote_texto[CONTROLE_LOTE_MAX * SENSORES_TAM_RESUMO];
+    size_t tamanho_cbor = 0, tamanho_texto = 0;
+    ResumoSensores resumo = resumo_exemplo;
+    for (int j = 0; j < CONTROLE_LOTE_MAX; j++) {
+        resumo.blocos += 78;
+        for (int k = 0; k < resumo.num_entradas; k++) {
+            ResumoEstatistica *r = &resumo.entradas[k].resumo;
+            r->media_q8 += (j * 37 - 50) * 256;
+            r->p50 += j * 11;
+            r->maximo += j * 5;
+        }
+        CodificadorCbor c;
+        cbor_iniciar(&c, lote_cbor + tamanho_cbor, sizeof(lote_cbor) - tamanho_cbor);
+        aquisicao_adc_codificar_resumo(&resumo, 5000, &c);
+        tamanho_cbor += c.tamanho;
+        if (j > 0) lote_texto[tamanho_texto++] = '\n';
+        int n = snprintf(lote_texto + tamanho_texto, sizeof(lote_texto) - tamanho_texto, "janela_ms=5000,");
+        tamanho_texto += n;
+        tamanho_texto += aquisicao_adc_formatar_resumo(&resumo, lote_texto + tamanho_texto,
+                                                       sizeof(lote_texto) - tamanho_texto);
+    }
+    bench_lzss_lote("lzss lote CBOR", lote_cbor, tamanho_cbor, iteracoes);
+    bench_lzss_lote("lzss lote texto", (const uint8_t *)lote_texto, tamanho_texto, iteracoes);
+    bench_executor(lote_cbor, tamanho_cbor, iteracoes);
+}
+
+int main(int argc, char **argv) {
+    uint32_t iteracoes = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 2000u;
+
+    oled_setup_interface();
+    init_rgb_pwm();
+    anim_led_inicializar();
+
+    fprintf(stderr, "MQTTPicoRF bench nativo: %u iterações\n", iteracoes);
+    bench_glifos(iteracoes);
+    bench_fila(iteracoes);
+    bench_renderizacao(iteracoes);
+    bench_mensagens(iteracoes);
+    bool estatistica_ok = bench_estatistica(iteracoes);
+    bench_payload_resumo(iteracoes);
+    bench_compressao(iteracoes);
+    return estatistica_ok ? 0 : 1; // O ctest falha se o resumo divergir
+}
\ No newline at end of file
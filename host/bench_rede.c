@@ -0,0 +1,213 @@
+/**
+ * @file bench_rede.c
+ * @brief Benchmark da arquitetura de rede no build nativo: lwIP em segundo plano
+ * (threadsafe_background, padrão) ou em polling no núcleo 1 (-DREDE_POLL=ON).
+ *
+ * Com o núcleo 1 real (main_core1_entry) e o cliente MQTT emulado, mede:
+ * - vazão: publicações no tópico de PING o mais rápido possível, as confirmações
+ *   (FIFO_TIPO_MQTT_PUB_ACK) por segundo, as recusas e as confirmações que o
+ *   núcleo 1 descartou com a FIFO cheia;
+ * - latência: uma publicação por vez, da chamada à confirmação na FIFO, com
+ *   média, desvio padrão, p50, p99 e máximo;
+ * - determinismo do loop do núcleo 0: iterações com um trabalho fixo e uma
+ *   publicação silenciosa (TOPICO_ID_METRICAS), com p50, p99 e máximo da duração.
+ *
+ * Uso: HOST_LATENCIA_ACK_US=0 MQTTPicoRF_bench_rede [publicacoes] > saida.txt
+ * O relatório vai para stderr; stdout recebe os printf do firmware e, na última
+ * linha, o "RESULTADO ..." lido por tools/bench_rede.sh.
+ */
+
+#include "config/config_geral.h"
+#include "core0/main_core0_utils.h"
+#include "core1/main_core1.h"
+#include "core1/mqtt_client_core1.h"
+#include "shared/executor.h"
+#include "pico/multicore.h"
+#include "pico/time.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define DURACAO_VAZAO_US 1000000u
+#define TRABALHO_FIXO_ITERACOES 2000u // Laço de cálculo de cada iteração do núcleo 0
+#define SILENCIO_FINAL_US 50000u      // Sem confirmações por esse tempo: as restantes foram descartadas
+
+static uint32_t confirmacoes_ok = 0;
+static uint32_t confirmacoes_falha = 0;
+
+/**
+ * @brief Trata uma mensagem da FIFO (como o loop do núcleo 0): conta as
+ * confirmações e descarta o resto, inclusive a palavra que segue um IP.
+ */
+static bool tratar_fifo(void) {
+    if (!multicore_fifo_rvalid()) return false;
+    uint32_t pacote = multicore_fifo_pop_blocking();
+    uint16_t tipo = (uint16_t)(pacote >> 16);
+    if (tipo == FIFO_TIPO_MQTT_PUB_ACK) {
+        if ((pacote & 0xFFFF) == 0) confirmacoes_ok++;
+        else confirmacoes_falha++;
+    } else if (tipo == FIFO_TIPO_IP_ADDRESS) {
+        multicore_fifo_pop_blocking();
+    }
+    return true;
+}
+
+static uint32_t confirmacoes(void) {
+    return confirmacoes_ok + confirmacoes_falha;
+}
+
+/**
+ * @brief Espera até `alvo` confirmações, no máximo `limite_us`.
+ */
+static bool aguardar_confirmacoes(uint32_t alvo, uint64_t limite_us) {
+    uint64_t fim = time_us_64() + limite_us;
+    while (confirmacoes() < alvo) {
+        if (time_us_64() >= fim) return false;
+        if (!tratar_fifo()) executor_ocioso_ate(make_timeout_time_us(100), multicore_fifo_rvalid);
+    }
+    return true;
+}
+
+static int comparar_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+typedef struct {
+    double media, desvio;
+    uint32_t p50, p99, maximo;
+} Resumo;
+
+static Resumo resumir(uint32_t *amostras, uint32_t n) {
+    Resumo r = {0};
+    if (n == 0) return r;
+    double soma = 0, soma_quadrados = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        soma += amostras[i];
+        soma_quadrados += (double)amostras[i] * amostras[i];
+    }
+    r.media = soma / n;
+    r.desvio = sqrt(fmax(0.0, soma_quadrados / n - r.media * r.media));
+    qsort(amostras, n, sizeof(amostras[0]), comparar_u32);
+    r.p50 = amostras[n / 2];
+    r.p99 = amostras[(uint64_t)n * 99 / 100];
+    r.maximo = amostras[n - 1];
+    return r;
+}
+
+/**
+ * @brief Liga o núcleo 1 e espera o Wi-Fi e o CONNACK.
+ */
+static bool conectar(void) {
+    executor_inicializar();
+    multicore_launch_core1(main_core1_entry);
+    uint64_t fim = time_us_64() + 10000000u;
+    bool ip = false;
+    while (!ip && time_us_64() < fim) {
+        if (!multicore_fifo_rvalid()) {
+            sleep_ms(1);
+            continue;
+        }
+        uint32_t pacote = multicore_fifo_pop_blocking();
+        if ((pacote >> 16) == FIFO_TIPO_IP_ADDRESS) {
+            multicore_fifo_pop_blocking();
+            ip = true;
+        }
+    }
+    if (!ip) return false;
+    iniciar_cliente_mqtt();
+    while (!mqtt_cliente_conectado() && time_us_64() < fim) {
+        loop_mqtt();
+        tratar_fifo();
+        sleep_ms(1);
+    }
+    return mqtt_cliente_conectado();
+}
+
+static void bench_vazao(double *vazao_ack_s, uint32_t *recusadas, uint32_t *descartadas) {
+    uint32_t base = confirmacoes(), base_falha = confirmacoes_falha, enviadas = 0;
+    *recusadas = 0;
+    uint64_t inicio = time_us_64();
+    while (time_us_64() - inicio < DURACAO_VAZAO_US) {
+        while (tratar_fifo()) {}
+        if (publicar_mensagem_mqtt("vazao")) {
+            enviadas++;
+            continue;
+        }
+        (*recusadas)++; // Saída cheia: espera uma confirmação liberar espaço
+        aguardar_confirmacoes(confirmacoes() + 1, 1000);
+    }
+    uint64_t decorrido = time_us_64() - inicio;
+    uint32_t anteriores;
+    do {
+        anteriores = confirmacoes();
+    } while (!aguardar_confirmacoes(base + enviadas, SILENCIO_FINAL_US) && confirmacoes() != anteriores);
+    uint32_t confirmadas = confirmacoes() - base;
+    *descartadas = enviadas - confirmadas;
+    *recusadas += confirmacoes_falha - base_falha; // Com REDE_POLL, a recusa do lwIP chega como falha
+    *vazao_ack_s = (double)(confirmadas - (confirmacoes_falha - base_falha)) * 1e6 / (double)decorrido;
+    fprintf(stderr, "%-28s %12.0f ACK/s  (%u enviadas, %u recusadas, %u ACKs descartados em %.3f ms)\n",
+            "vazao (PING)", *vazao_ack_s, enviadas, *recusadas, *descartadas, decorrido / 1000.0);
+}
+
+static Resumo bench_latencia(uint32_t publicacoes) {
+    uint32_t *amostras = malloc(publicacoes * sizeof(uint32_t));
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < publicacoes; i++) {
+        while (tratar_fifo()) {}
+        uint32_t alvo = confirmacoes() + 1;
+        uint64_t t0 = time_us_64();
+        if (!publicar_mensagem_mqtt("latencia")) continue;
+        if (!aguardar_confirmacoes(alvo, 1000000u)) break;
+        amostras[n++] = (uint32_t)(time_us_64() - t0);
+    }
+    Resumo r = resumir(amostras, n);
+    fprintf(stderr, "%-28s media %.1f us, desvio %.1f us, p50 %u us, p99 %u us, max %u us (%u amostras)\n",
+            "latencia publicar->ACK", r.media, r.desvio, r.p50, r.p99, r.maximo, n);
+    free(amostras);
+    return r;
+}
+
+static Resumo bench_loop_core0(uint32_t iteracoes) {
+    uint32_t *amostras = malloc(iteracoes * sizeof(uint32_t));
+    volatile uint32_t acumulador = 1;
+    uint32_t recusadas = 0;
+    for (uint32_t i = 0; i < iteracoes; i++) {
+        uint64_t t0 = time_us_64();
+        for (uint32_t k = 0; k < TRABALHO_FIXO_ITERACOES; k++) acumulador = acumulador * 1664525u + 1013904223u;
+        if (!publicar_topico(TOPICO_ID_METRICAS, "m")) recusadas++;
+        while (tratar_fifo()) {}
+        amostras[i] = (uint32_t)(time_us_64() - t0);
+        sleep_us(50); // Pausa entre iterações: o anel de saída esvazia
+    }
+    Resumo r = resumir(amostras, iteracoes);
+    fprintf(stderr, "%-28s p50 %u us, p99 %u us, max %u us, desvio %.1f us (%u recusadas)\n", "iteracao do nucleo 0",
+            r.p50, r.p99, r.maximo, r.desvio, recusadas);
+    free(amostras);
+    return r;
+}
+
+int main(int argc, char **argv) {
+    uint32_t publicacoes = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 2000u;
+    const char *arquitetura = REDE_POLL ? "poll" : "background";
+    fprintf(stderr, "Benchmark de rede: lwIP %s, %u publicacoes por fase\n", arquitetura, publicacoes);
+    if (!conectar()) {
+        fprintf(stderr, "Sem conexão com o broker emulado.\n");
+        return 1;
+    }
+
+    double vazao_ack_s;
+    uint32_t recusadas, descartadas;
+    bench_vazao(&vazao_ack_s, &recusadas, &descartadas);
+    Resumo latencia = bench_latencia(publicacoes);
+    Resumo loop = bench_loop_core0(publicacoes * 5);
+
+    fflush(stdout);
+    printf("RESULTADO arquitetura=%s vazao_ack_s=%.0f recusadas=%u acks_descartados=%u lat_media_us=%.1f lat_desvio_us=%.1f "
+           "lat_p50_us=%u lat_p99_us=%u lat_max_us=%u loop_p50_us=%u loop_p99_us=%u loop_max_us=%u "
+           "loop_desvio_us=%.1f\n",
+           arquitetura, vazao_ack_s, recusadas, descartadas, latencia.media, latencia.desvio, latencia.p50, latencia.p99,
+           latencia.maximo, loop.p50, loop.p99, loop.maximo, loop.desvio);
+    fflush(stdout);
+    return 0;
+}
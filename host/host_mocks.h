@@ -0,0 +1,53 @@
+#ifndef HOST_MOCKS_H
+#define HOST_MOCKS_H
+
+// Funções exclusivas do build nativo para inspecionar os periféricos emulados
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Estatísticas do barramento I2C emulado
+typedef struct {
+    uint64_t bytes_escritos;   // Bytes transferidos (inclui endereço e bytes de controle)
+    uint32_t transacoes;       // Chamadas a i2c_write_*
+    uint32_t quadros_dados;    // Transferências de dados (0x40) para a GDDRAM
+    uint32_t pbm_gravados;     // Quadros exportados como PBM
+} HostEstatisticasI2C;
+
+const HostEstatisticasI2C *host_i2c_estatisticas(void);
+void host_i2c_zerar_estatisticas(void);
+
+// Cópia da GDDRAM emulada do SSD1306 (128x64, 1 bit por pixel, organizada por páginas)
+const uint8_t *host_ssd1306_gddram(void);
+
+// Grava a GDDRAM atual como PBM (P4); devolve 0 em caso de sucesso
+int host_ssd1306_gravar_pbm(const char *caminho);
+
+// Agenda uma função para rodar na thread que emula o contexto lwIP do núcleo 1
+void host_lwip_agendar(void (*funcao)(void *), void *arg, uint32_t atraso_us);
+
+// Um quadro emulado passou pelo enlace da estação (netif->linkoutput ou netif->input);
+// chamada no contexto lwIP emulado
+void host_radio_quadro(bool recebido);
+
+// Estatísticas do cliente MQTT emulado
+typedef struct {
+    uint32_t publicacoes;
+    uint64_t bytes_payload;
+} HostEstatisticasMQTT;
+
+const HostEstatisticasMQTT *host_mqtt_estatisticas(void);
+
+// FIN do broker na conexão do cliente: o fechamento e o callback de conexão rodam
+// dentro do tcp_input emulado, que encerra o processo se o PCB for liberado ali
+struct mqtt_client_s;
+void host_mqtt_broker_fechar(struct mqtt_client_s *cliente);
+
+// Canal de DMA ativo cadenciado pelo DREQ informado (-1 se nenhum)
+int host_dma_canal_ativo(uint32_t dreq);
+
+// Encerra a transferência de um canal: dispara o encadeado e o IRQ do canal
+void host_dma_concluir(uint32_t canal);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+
+#include "pico/types.h"
+
+// ADC emulado: com adc_run(true), uma thread entrega amostras sintéticas ao canal
+// de DMA cadenciado por DREQ_ADC, no ritmo do divisor (ver host/mock_adc.c)
+
+#define DREQ_ADC 36
+
+typedef struct {
+    volatile uint32_t cs;
+    volatile uint32_t result;
+    volatile uint32_t fcs;
+    volatile uint32_t fifo;
+    volatile uint32_t div;
+} host_adc_hw_t;
+
+extern host_adc_hw_t host_adc_hw;
+#define adc_hw (&host_adc_hw)
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint entrada);
+void adc_set_round_robin(uint mascara);
+void adc_set_temp_sensor_enabled(bool habilitar);
+void adc_set_clkdiv(float divisor);
+void adc_fifo_setup(bool habilitar, bool dreq, uint16_t limiar_dreq, bool erro_na_fifo, bool deslocar_byte);
+void adc_run(bool rodar);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef HOST_HARDWARE_CLOCKS_H
+#define HOST_HARDWARE_CLOCKS_H
+
+#include "pico/types.h"
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+// Frequências emuladas (padrão do SDK: clk_sys = clk_peri = 125 MHz)
+uint32_t clock_get_hz(enum clock_index clk);
+bool set_sys_clock_khz(uint32_t freq_khz, bool obrigatorio);
+void set_sys_clock_48mhz(void);
+
+#endif
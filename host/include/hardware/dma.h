@@ -0,0 +1,63 @@
+#ifndef HOST_HARDWARE_DMA_H
+#define HOST_HARDWARE_DMA_H
+
+#include "pico/types.h"
+
+// DMA emulado: as configurações são aceitas, as transferências não acontecem.
+// A exceção são os canais cadenciados por DREQ_ADC, que o ADC emulado completa
+// (ver host/mock_adc.c), disparando o encadeamento e o IRQ do canal.
+
+#define NUM_DMA_CHANNELS 12
+
+typedef struct {
+    volatile const void *read_addr;
+    volatile void *write_addr;
+    volatile uint32_t transfer_count;
+    volatile uint32_t ctrl_trig;
+    uint32_t _pad[11];
+    volatile const void *al3_read_addr_trig;
+} host_dma_channel_hw_t;
+
+typedef struct {
+    host_dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+} host_dma_hw_t;
+
+extern host_dma_hw_t host_dma_hw;
+#define dma_hw (&host_dma_hw)
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    uint32_t ctrl;
+    uint dreq;
+    uint chain_to;
+    bool inc_leitura, inc_escrita;
+    uint anel_bits;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool obrigatorio);
+void dma_channel_unclaim(uint canal);
+dma_channel_config dma_channel_get_default_config(uint canal);
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size t) { c->ctrl = (uint32_t)t; }
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool inc) { c->inc_leitura = inc; }
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool inc) { c->inc_escrita = inc; }
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) { c->dreq = dreq; }
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint canal) { c->chain_to = canal; }
+static inline void channel_config_set_ring(dma_channel_config *c, bool escrita, uint bits) { (void)escrita; c->anel_bits = bits; }
+void dma_channel_configure(uint canal, const dma_channel_config *c, volatile void *destino, const volatile void *origem,
+                           uint32_t contagem, bool iniciar);
+void dma_channel_start(uint canal);
+void dma_start_channel_mask(uint32_t mascara);
+void dma_channel_abort(uint canal);
+bool dma_channel_is_busy(uint canal);
+void dma_channel_set_irq0_enabled(uint canal, bool habilitar);
+void dma_channel_set_irq1_enabled(uint canal, bool habilitar);
+void dma_channel_acknowledge_irq0(uint canal);
+void dma_channel_acknowledge_irq1(uint canal);
+bool dma_channel_get_irq0_status(uint canal);
+void dma_channel_set_read_addr(uint canal, const volatile void *origem, bool iniciar);
+void dma_channel_set_trans_count(uint canal, uint32_t contagem, bool iniciar);
+void dma_channel_set_write_addr(uint canal, volatile void *destino, bool iniciar);
+bool dma_irqn_get_channel_status(uint irq, uint canal);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef HOST_HARDWARE_GPIO_H
+#define HOST_HARDWARE_GPIO_H
+
+#include "pico/types.h"
+
+enum gpio_function {
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_NULL = 0x1f,
+};
+
+static inline void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+static inline void gpio_init(uint gpio) { (void)gpio; }
+
+#endif
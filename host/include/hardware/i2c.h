@@ -0,0 +1,18 @@
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include "pico/types.h"
+
+// Instância I2C emulada; o escravo 0x3C é um SSD1306 virtual (ver host/mock_i2c.c)
+typedef struct i2c_inst i2c_inst_t;
+
+extern i2c_inst_t host_i2c0, host_i2c1;
+#define i2c0 (&host_i2c0)
+#define i2c1 (&host_i2c1)
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+
+#include "pico/types.h"
+
+// Números de IRQ do RP2040 usados pelo firmware
+#define TIMER_IRQ_0   0
+#define TIMER_IRQ_1   1
+#define TIMER_IRQ_2   2
+#define TIMER_IRQ_3   3
+#define PWM_IRQ_WRAP  4
+#define DMA_IRQ_0     11
+#define DMA_IRQ_1     12
+#define SIO_IRQ_PROC0 15
+#define SIO_IRQ_PROC1 16
+#define ADC_IRQ_FIFO  22
+
+typedef void (*irq_handler_t)(void);
+
+// Handlers são apenas registrados: não há fonte de interrupção no host
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool habilitar);
+irq_handler_t host_irq_handler(uint num);
+
+#endif
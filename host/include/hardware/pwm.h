@@ -0,0 +1,52 @@
+#ifndef HOST_HARDWARE_PWM_H
+#define HOST_HARDWARE_PWM_H
+
+#include "pico/types.h"
+
+// PWM emulado: guarda os níveis de cada canal para inspeção pelos testes de bancada
+typedef struct {
+    uint32_t csr;
+    uint32_t div;
+    uint32_t top;
+} pwm_config;
+
+#define PWM_CHAN_A 0
+#define PWM_CHAN_B 1
+
+static inline uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1u) & 7u; }
+static inline uint pwm_gpio_to_channel(uint gpio) { return gpio & 1u; }
+
+static inline pwm_config pwm_get_default_config(void) {
+    pwm_config c = {0, 1u << 4, 0xffffu};
+    return c;
+}
+static inline void pwm_config_set_clkdiv(pwm_config *c, float div) { c->div = (uint32_t)(div * 16.0f); }
+static inline void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) { c->top = wrap; }
+
+typedef struct {
+    volatile uint32_t csr;
+    volatile uint32_t div;
+    volatile uint32_t ctr;
+    volatile uint32_t cc;
+    volatile uint32_t top;
+} host_pwm_slice_hw_t;
+
+typedef struct {
+    host_pwm_slice_hw_t slice[8];
+} host_pwm_hw_t;
+
+extern host_pwm_hw_t host_pwm_hw;
+#define pwm_hw (&host_pwm_hw)
+
+#define DREQ_PWM_WRAP0 24
+static inline uint pwm_get_dreq(uint slice_num) { return DREQ_PWM_WRAP0 + slice_num; }
+
+void pwm_init(uint slice_num, pwm_config *c, bool iniciar);
+void pwm_clear_irq(uint slice_num);
+void pwm_set_irq_enabled(uint slice_num, bool habilitar);
+void pwm_set_enabled(uint slice_num, bool habilitar);
+void pwm_set_gpio_level(uint gpio, uint16_t nivel);
+void pwm_set_clkdiv(uint slice_num, float div);
+uint16_t host_pwm_nivel(uint gpio);
+
+#endif
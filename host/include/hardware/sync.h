@@ -0,0 +1,29 @@
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico/types.h"
+#include "pico/platform.h"
+
+// Não há interrupções reais no host: desabilitar/restaurar não faz nada
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t estado) { (void)estado; }
+
+// Spinlocks de hardware emulados com troca atômica (as threads são os núcleos)
+typedef volatile uint32_t spin_lock_t;
+
+#define NUM_SPIN_LOCKS 32
+
+int spin_lock_claim_unused(bool obrigatorio);
+spin_lock_t *spin_lock_init(uint lock_num);
+
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock) {
+    while (__atomic_exchange_n(lock, 1u, __ATOMIC_ACQUIRE)) {}
+    return 0;
+}
+
+static inline void spin_unlock(spin_lock_t *lock, uint32_t estado) {
+    (void)estado;
+    __atomic_store_n(lock, 0u, __ATOMIC_RELEASE);
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef HOST_HARDWARE_TIMER_H
+#define HOST_HARDWARE_TIMER_H
+
+#include "pico/time.h"
+
+// Registradores do timer: a leitura de timerawl devolve o relógio do host
+typedef struct {
+    uint32_t timerawh;
+    uint32_t timerawl;
+} host_timer_hw_t;
+
+host_timer_hw_t *host_timer_hw(void);
+#define timer_hw (host_timer_hw())
+
+static inline void busy_wait_us(uint64_t us) {
+    uint64_t fim = time_us_64() + us;
+    while (time_us_64() < fim) {}
+}
+
+#endif
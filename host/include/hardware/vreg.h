@@ -0,0 +1,20 @@
+#ifndef HOST_HARDWARE_VREG_H
+#define HOST_HARDWARE_VREG_H
+
+// Substituto de hardware/vreg.h: a tensão do núcleo não tem efeito no host
+
+enum vreg_voltage {
+    VREG_VOLTAGE_0_95 = 0b0110,
+    VREG_VOLTAGE_1_00 = 0b0111,
+    VREG_VOLTAGE_1_05 = 0b1000,
+    VREG_VOLTAGE_1_10 = 0b1001,
+    VREG_VOLTAGE_1_15 = 0b1010,
+    VREG_VOLTAGE_1_20 = 0b1011,
+    VREG_VOLTAGE_1_25 = 0b1100,
+    VREG_VOLTAGE_1_30 = 0b1101,
+    VREG_VOLTAGE_DEFAULT = VREG_VOLTAGE_1_10,
+};
+
+static inline void vreg_set_voltage(enum vreg_voltage tensao) { (void)tensao; }
+
+#endif
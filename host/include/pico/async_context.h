@@ -0,0 +1,30 @@
+#ifndef HOST_PICO_ASYNC_CONTEXT_H
+#define HOST_PICO_ASYNC_CONTEXT_H
+
+// Substituto de pico/async_context.h: os trabalhadores "quando pendente" do
+// contexto do CYW43, com os mesmos campos do SDK (implementação em mock_cyw43.c)
+
+#include "pico/types.h"
+
+typedef struct async_context async_context_t;
+
+typedef struct async_when_pending_worker {
+    struct async_when_pending_worker *next;
+    void (*do_work)(async_context_t *context, struct async_when_pending_worker *worker);
+    volatile bool work_pending;
+    void *user_data;
+} async_when_pending_worker_t;
+
+struct async_context {
+    const void *type;
+    async_when_pending_worker_t *when_pending_list;
+    void *at_time_list;
+    volatile absolute_time_t next_time; // Próximo trabalho agendado (timers do lwIP)
+    uint16_t flags;
+    uint8_t core_num;
+};
+
+bool async_context_add_when_pending_worker(async_context_t *context, async_when_pending_worker_t *worker);
+void async_context_set_work_pending(async_context_t *context, async_when_pending_worker_t *worker);
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef HOST_PICO_ASYNC_CONTEXT_POLL_H
+#define HOST_PICO_ASYNC_CONTEXT_POLL_H
+
+// Substituto de pico/async_context_poll.h (contexto de pico_cyw43_arch_lwip_poll)
+
+#include "pico/async_context.h"
+#include "pico/sem.h"
+
+typedef struct async_context_poll {
+    async_context_t core;
+    semaphore_t sem; // Liberado quando há trabalho para cyw43_arch_poll
+} async_context_poll_t;
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef HOST_PICO_CYW43_ARCH_H
+#define HOST_PICO_CYW43_ARCH_H
+
+// Substituto do driver CYW43: o "Wi-Fi" conecta imediatamente com um IP fixo.
+
+#include "pico/types.h"
+#include "pico/async_context.h"
+#include "lwip/netif.h"
+
+#define CYW43_ITF_STA 0
+#define CYW43_ITF_AP  1
+
+#define CYW43_LINK_DOWN    0
+#define CYW43_LINK_JOIN    1
+#define CYW43_LINK_NOIP    2
+#define CYW43_LINK_UP      3
+#define CYW43_LINK_FAIL    -1
+#define CYW43_LINK_NONET   -2
+#define CYW43_LINK_BADAUTH -3
+
+#define CYW43_AUTH_OPEN           0
+#define CYW43_AUTH_WPA2_AES_PSK   0x00400004
+
+// Modos de energia, com a mesma codificação do driver do SDK
+#define CYW43_NO_POWERSAVE_MODE   0
+#define CYW43_PM1_POWERSAVE_MODE  1
+#define CYW43_PM2_POWERSAVE_MODE  2
+#define cyw43_pm_value(pm_mode, pm2_sleep_ret_ms, li_beacon_period, li_dtim_period, li_assoc) \
+    ((li_assoc) << 20 | (li_dtim_period) << 16 | (li_beacon_period) << 12 | ((pm2_sleep_ret_ms) / 10) << 4 | (pm_mode))
+#define CYW43_PERFORMANCE_PM      cyw43_pm_value(CYW43_PM2_POWERSAVE_MODE, 200, 1, 1, 10)
+#define CYW43_DEFAULT_PM          CYW43_PERFORMANCE_PM
+#define CYW43_NONE_PM             cyw43_pm_value(CYW43_NO_POWERSAVE_MODE, 10, 0, 0, 0)
+
+typedef struct {
+    struct netif netif[2];
+} cyw43_t;
+
+extern cyw43_t cyw43_state;
+
+int cyw43_arch_init(void);
+void cyw43_arch_deinit(void);
+void cyw43_arch_enable_sta_mode(void);
+int cyw43_arch_wifi_connect_timeout_ms(const char *ssid, const char *pw, uint32_t auth, uint32_t timeout_ms);
+int cyw43_tcpip_link_status(cyw43_t *self, int itf);
+int cyw43_wifi_pm(cyw43_t *self, uint32_t pm);
+void cyw43_arch_lwip_begin(void);
+void cyw43_arch_lwip_end(void);
+void cyw43_arch_poll(void);
+void cyw43_arch_wait_for_work_until(absolute_time_t until); // Só com REDE_POLL
+async_context_t *cyw43_arch_async_context(void);
+
+#endif
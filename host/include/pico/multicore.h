@@ -0,0 +1,16 @@
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#include "pico/types.h"
+
+// Núcleo 1 emulado por uma thread; FIFOs inter-core emuladas por filas de 8 palavras
+void multicore_launch_core1(void (*entrada)(void));
+
+bool multicore_fifo_rvalid(void);
+bool multicore_fifo_wready(void);
+void multicore_fifo_push_blocking(uint32_t dado);
+uint32_t multicore_fifo_pop_blocking(void);
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t *saida);
+void multicore_fifo_drain(void);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef HOST_PICO_MUTEX_H
+#define HOST_PICO_MUTEX_H
+
+#include <pthread.h>
+#include "pico/types.h"
+
+// mutex_t do SDK emulado com pthread (os "núcleos" são threads)
+typedef struct {
+    pthread_mutex_t m;
+} mutex_t;
+
+static inline void mutex_init(mutex_t *mtx) { pthread_mutex_init(&mtx->m, NULL); }
+static inline void mutex_enter_blocking(mutex_t *mtx) { pthread_mutex_lock(&mtx->m); }
+static inline bool mutex_try_enter(mutex_t *mtx, uint32_t *dono) { (void)dono; return pthread_mutex_trylock(&mtx->m) == 0; }
+static inline void mutex_exit(mutex_t *mtx) { pthread_mutex_unlock(&mtx->m); }
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef HOST_PICO_PLATFORM_H
+#define HOST_PICO_PLATFORM_H
+
+#include "pico/types.h"
+
+// No host cada "núcleo" é uma thread; a thread registra qual núcleo emula
+extern __thread uint host_nucleo_atual;
+
+static inline uint get_core_num(void) { return host_nucleo_atual; }
+
+// Atributos de seção não têm efeito no host
+#define __not_in_flash(grupo)
+#define __not_in_flash_func(func) func
+#define __time_critical_func(func) func
+#define __scratch_x(grupo)
+#define __scratch_y(grupo)
+#define __no_inline_not_in_flash_func(func) __attribute__((noinline)) func
+
+static inline void tight_loop_contents(void) {}
+void __sev(void); // Acorda o outro núcleo de best_effort_wfe_or_timeout (mock_pico.c)
+static inline void __wfe(void) {}
+static inline void __dmb(void) { __sync_synchronize(); }
+static inline void __compiler_memory_barrier(void) { __asm__ volatile("" ::: "memory"); }
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef HOST_PICO_RAND_H
+#define HOST_PICO_RAND_H
+
+#include "pico/types.h"
+
+uint32_t get_rand_32(void);
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef HOST_PICO_SEM_H
+#define HOST_PICO_SEM_H
+
+// Substituto de pico/sem.h: só o tipo, para o contexto de polling emulado em
+// mock_cyw43.c, que libera e consome as permissões
+
+#include "pico/types.h"
+
+typedef struct {
+    volatile int16_t permits;
+    int16_t max_permits;
+} semaphore_t;
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// Substituto de pico/stdlib.h: tempo, stdio e GPIO para a compilação nativa
+
+#include <stdio.h>
+#include "pico/types.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+bool stdio_init_all(void);
+bool stdio_usb_connected(void);
+int getchar_timeout_us(uint32_t timeout_us);
+void stdio_set_chars_available_callback(void (*fn)(void *), void *param);
+
+#endif
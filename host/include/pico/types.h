@@ -0,0 +1,19 @@
+#ifndef HOST_PICO_TYPES_H
+#define HOST_PICO_TYPES_H
+
+// Substituto mínimo de pico/types.h para a compilação nativa (host)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define _u(x) x##u
+
+#define PICO_OK             0
+#define PICO_ERROR_GENERIC  -1
+#define PICO_ERROR_TIMEOUT  -2
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef HOST_LWIP_ALTCP_H
+#define HOST_LWIP_ALTCP_H
+
+// Substituto de lwip/altcp.h: só o necessário para escrever direto na conexão do
+// cliente MQTT emulado (core1/mqtt_envio_direto.c). Como o altcp_tcp, a conexão
+// repassa os callbacks crus do PCB TCP (lwip/tcp.h) para os seus. A escrita é
+// entregue ao broker emulado em altcp_output e confirmada após
+// HOST_LATENCIA_ACK_US, pelo callback `sent`. altcp_close solta o PCB, que fica
+// sem callbacks, e altcp_abort o derruba pelo callback `err`.
+
+#include "lwip/err.h"
+#include "lwip/tcp.h"
+#include "lwipopts.h" // Para TCP_SND_BUF e TCP_SND_QUEUELEN do perfil
+
+struct altcp_pcb;
+typedef err_t (*altcp_sent_fn)(void *arg, struct altcp_pcb *conn, u16_t len);
+typedef void (*altcp_err_fn)(void *arg, err_t err);
+
+struct altcp_pcb {
+    struct altcp_pcb *inner_conn; // Sempre NULL: TCP puro, sem TLS
+    void *arg;
+    void *state;           // Como no altcp_tcp: o PCB TCP (NULL depois de fechado ou liberado)
+    altcp_sent_fn sent;
+    altcp_err_fn err;
+};
+
+void altcp_sent(struct altcp_pcb *conn, altcp_sent_fn sent);
+void altcp_err(struct altcp_pcb *conn, altcp_err_fn err);
+err_t altcp_close(struct altcp_pcb *conn);
+void altcp_abort(struct altcp_pcb *conn);
+err_t altcp_write(struct altcp_pcb *conn, const void *dataptr, u16_t len, u8_t apiflags);
+err_t altcp_output(struct altcp_pcb *conn);
+u16_t altcp_sndbuf(struct altcp_pcb *conn);
+u16_t altcp_sndqueuelen(struct altcp_pcb *conn);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef HOST_LWIP_APPS_MQTT_PRIV_H
+#define HOST_LWIP_APPS_MQTT_PRIV_H
+
+// Substituto de lwip/apps/mqtt_priv.h: estado do cliente MQTT emulado, visível
+// para que o firmware possa declarar a instância estaticamente (MEMORIA_ESTATICA)
+// e ler a ocupação do buffer de saída.
+
+#include "lwip/apps/mqtt.h"
+#include "lwip/altcp.h"
+#include "lwipopts.h" // Para MQTT_OUTPUT_RINGBUF_SIZE do perfil
+#include <stdbool.h>
+
+// Mesmo layout do lwIP: índices de escrita e leitura no anel de saída
+struct mqtt_ringbuf_t {
+    u16_t put;
+    u16_t get;
+    u8_t buf[MQTT_OUTPUT_RINGBUF_SIZE];
+};
+
+struct mqtt_client_s {
+    bool conectado;
+    bool conectando;            // CONNECT enviado, sem resposta ainda
+    u16_t porta;                // Broker da conexão atual (HOST_BROKER_FORA)
+    u16_t keep_alive;
+    u32_t geracao;              // Incrementada a cada conexão, para descartar eventos antigos
+    mqtt_connection_cb_t cb_conexao;
+    void *arg_conexao;
+    mqtt_incoming_publish_cb_t cb_pub_entrada;
+    mqtt_incoming_data_cb_t cb_dados_entrada;
+    void *arg_entrada;
+    char assinaturas[4][64]; // Filtros assinados (com + e #), entregues de volta pelo broker emulado
+    u8_t num_assinaturas;
+    struct mqtt_ringbuf_t output;
+    struct altcp_pcb *conn;     // Como no lwIP; aponta para conexao_emulada enquanto conectado
+    struct altcp_pcb conexao_emulada; // O PCB TCP dela vem do pool do mock
+};
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef HOST_LWIP_IP_ADDR_H
+#define HOST_LWIP_IP_ADDR_H
+
+#include "lwip/arch.h"
+
+// Apenas IPv4, como no firmware
+typedef struct ip4_addr {
+    u32_t addr;
+} ip4_addr_t;
+
+typedef ip4_addr_t ip_addr_t;
+
+int ip4addr_aton(const char *cp, ip4_addr_t *addr);
+char *ip4addr_ntoa_r(const ip4_addr_t *addr, char *buf, int buflen);
+
+#endif
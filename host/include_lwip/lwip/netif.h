@@ -0,0 +1,20 @@
+#ifndef HOST_LWIP_NETIF_H
+#define HOST_LWIP_NETIF_H
+
+#include "lwip/ip_addr.h"
+#include "lwip/err.h"
+
+struct pbuf;
+struct netif;
+
+// Enlace da interface: o mock_cyw43.c chama estes ponteiros a cada quadro emulado
+typedef err_t (*netif_linkoutput_fn)(struct netif *netif, struct pbuf *p);
+typedef err_t (*netif_input_fn)(struct pbuf *p, struct netif *inp);
+
+struct netif {
+    ip_addr_t ip_addr;
+    netif_input_fn input;
+    netif_linkoutput_fn linkoutput;
+};
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef HOST_LWIP_PRIV_TCP_PRIV_H
+#define HOST_LWIP_PRIV_TCP_PRIV_H
+
+// Substituto de lwip/priv/tcp_priv.h: só a lista dos PCBs vivos
+
+#include "lwip/tcp.h"
+
+extern struct tcp_pcb *tcp_active_pcbs;
+
+#endif
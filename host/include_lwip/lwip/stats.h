@@ -0,0 +1,10 @@
+#ifndef HOST_LWIP_STATS_H
+#define HOST_LWIP_STATS_H
+
+// Substituto de lwip/stats.h: a pilha simulada não mantém estatísticas de pools,
+// então as métricas do lwIP ficam fora do retrato no build nativo sem lwIP.
+
+#define MEM_STATS 0
+#define MEMP_STATS 0
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef HOST_LWIP_TCP_H
+#define HOST_LWIP_TCP_H
+
+// Substituto de lwip/tcp.h: flags de tcp_write/altcp_write, o PCB TCP emulado e a
+// API crua de callbacks, que segue valendo depois que o altcp solta um PCB
+// fechado. O PCB tem os campos do lwIP usados pelo firmware e, depois deles, o
+// estado da emulação (mock_lwip_mqtt.c). Um PCB liberado volta ao pool do mock, e
+// qualquer uso dele depois disso encerra o processo.
+
+#include "lwip/err.h"
+#include <stdbool.h>
+
+#define TCP_WRITE_FLAG_COPY 0x01
+#define TCP_WRITE_FLAG_MORE 0x02
+
+struct tcp_pcb;
+typedef err_t (*tcp_sent_fn)(void *arg, struct tcp_pcb *tpcb, u16_t len);
+typedef void (*tcp_err_fn)(void *arg, err_t err);
+
+// Trecho escrito e ainda não entregue por altcp_output
+typedef struct {
+    const void *dados; // Referência (sem TCP_WRITE_FLAG_COPY) ou cópia em `copia`
+    u16_t tamanho;
+    u8_t copia[64];
+} HostTrechoTcp;
+
+struct tcp_pcb {
+    struct tcp_pcb *next;  // Como no lwIP: em tcp_active_pcbs enquanto vivo
+    void *callback_arg;
+    tcp_sent_fn sent;
+    tcp_err_fn errf;
+
+    void *cliente;         // mqtt_client_t dono da conexão, para o broker emulado
+    u16_t snd_buf;         // Espaço livre no buffer de envio, como tcp_sndbuf
+    u16_t snd_queuelen;    // Trechos aguardando confirmação
+    HostTrechoTcp trechos[8];
+    u8_t num_trechos;
+    u32_t geracao;         // Muda ao alocar e ao liberar: descarta confirmações de um PCB antigo
+    bool liberado;         // Devolvido ao pool
+    bool abortada;         // Liberado por tcp_abort, para os testes
+    bool dados_nao_lidos;  // tcp_close responde com RST e libera o PCB na hora, como o lwIP
+};
+
+void tcp_arg(struct tcp_pcb *pcb, void *arg);
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent);
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err);
+// Envia o FIN: o PCB vive até ele ser confirmado, ou é liberado na hora (dados_nao_lidos)
+err_t tcp_close(struct tcp_pcb *pcb);
+// Descarta os trechos e as confirmações futuras e avisa pelo callback `err`, como o lwIP
+void tcp_abort(struct tcp_pcb *pcb);
+
+#endif
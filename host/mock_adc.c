@@ -0,0 +1,109 @@
+/**
+ * @file mock_adc.c
+ * @brief ADC emulado em modo contínuo, entregando blocos por DMA.
+ *
+ * Enquanto o ADC está rodando, uma thread procura o canal de DMA ativo
+ * cadenciado por DREQ_ADC, preenche o destino dele com a quantidade de amostras
+ * configurada (em round-robin, como o hardware), espera o tempo que as
+ * conversões levariam e conclui o canal, o que dispara o IRQ do DMA nessa
+ * thread, marcada como núcleo 0. Os sinais são sintéticos: joystick no centro
+ * com ruído, microfone com uma onda triangular e o sensor de temperatura a ~25 °C.
+ */
+
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "host_mocks.h"
+#include "pico/platform.h"
+#include "pico/rand.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define CLK_ADC_HZ 48000000u
+#define CICLOS_CONVERSAO 96u
+#define ENTRADA_TEMPERATURA 4
+
+host_adc_hw_t host_adc_hw;
+
+static uint entrada_atual = 0, mascara_round_robin = 0;
+static float divisor = 0.0f;
+static atomic_bool rodando = false;
+static bool thread_criada = false;
+static uint32_t amostras_geradas = 0;
+
+/**
+ * @brief Próxima entrada do round-robin após a atual (mesma regra do hardware).
+ */
+static uint proxima_entrada(uint entrada) {
+    if (mascara_round_robin == 0) return entrada;
+    do {
+        entrada = (entrada + 1) % 5;
+    } while (!(mascara_round_robin & (1u << entrada)));
+    return entrada;
+}
+
+static uint16_t amostra_sintetica(uint entrada) {
+    uint32_t ruido = get_rand_32() % 5; // ±2 LSB
+    switch (entrada) {
+        case ENTRADA_TEMPERATURA: return (uint16_t)(880 + ruido - 2); // ~0,709 V = ~25 °C
+        case 2: {
+            uint32_t fase = amostras_geradas % 64; // Onda triangular de ±256 LSB
+            int32_t onda = fase < 32 ? (int32_t)fase * 16 - 256 : 256 - (int32_t)(fase - 32) * 16;
+            return (uint16_t)(2048 + onda + (int32_t)ruido - 2);
+        }
+        default: return (uint16_t)(2048 + ruido - 2);
+    }
+}
+
+static void *converter(void *arg) {
+    (void)arg;
+    host_nucleo_atual = 0; // O IRQ do DMA é atendido pelo núcleo 0
+    while (true) {
+        int canal = atomic_load(&rodando) ? host_dma_canal_ativo(DREQ_ADC) : -1;
+        if (canal < 0) {
+            usleep(1000);
+            continue;
+        }
+        uint32_t contagem = dma_hw->ch[canal].transfer_count;
+        volatile uint16_t *destino = (volatile uint16_t *)dma_hw->ch[canal].write_addr;
+        for (uint32_t i = 0; i < contagem; i++) {
+            destino[i] = amostra_sintetica(entrada_atual);
+            entrada_atual = proxima_entrada(entrada_atual);
+            amostras_geradas++;
+        }
+        uint32_t ciclos = divisor >= CICLOS_CONVERSAO ? (uint32_t)divisor + 1 : CICLOS_CONVERSAO;
+        usleep((useconds_t)((uint64_t)contagem * ciclos * 1000000u / CLK_ADC_HZ));
+        host_dma_concluir((uint)canal);
+    }
+    return NULL;
+}
+
+void adc_init(void) {}
+
+void adc_gpio_init(uint gpio) { (void)gpio; }
+
+void adc_select_input(uint entrada) { entrada_atual = entrada; }
+
+void adc_set_round_robin(uint mascara) { mascara_round_robin = mascara; }
+
+void adc_set_temp_sensor_enabled(bool habilitar) { (void)habilitar; }
+
+void adc_set_clkdiv(float d) { divisor = d; }
+
+void adc_fifo_setup(bool habilitar, bool dreq, uint16_t limiar_dreq, bool erro_na_fifo, bool deslocar_byte) {
+    (void)habilitar;
+    (void)dreq;
+    (void)limiar_dreq;
+    (void)erro_na_fifo;
+    (void)deslocar_byte;
+}
+
+void adc_run(bool rodar) {
+    atomic_store(&rodando, rodar);
+    if (rodar && !thread_criada) {
+        thread_criada = true;
+        pthread_t t;
+        pthread_create(&t, NULL, converter, NULL);
+        pthread_detach(t);
+    }
+}
@@ -0,0 +1,254 @@
+/**
+ * @file mock_cyw43.c
+ * @brief Driver CYW43 emulado e thread que faz o papel do contexto lwIP em background.
+ *
+ * Em `pico_cyw43_arch_lwip_threadsafe_background` os callbacks do lwIP rodam em
+ * IRQ no núcleo que chamou cyw43_arch_init (core1). Aqui uma thread marcada
+ * como núcleo 1 executa o trabalho agendado com host_lwip_agendar().
+ *
+ * Com REDE_POLL (`pico_cyw43_arch_lwip_poll`) não há essa thread: o trabalho
+ * vencido e os trabalhadores pendentes do contexto (async_context) rodam em
+ * cyw43_arch_poll, chamada pelo laço do núcleo 1, e o instante do próximo
+ * trabalho fica em next_time do contexto, como os timers do lwIP no SDK. Como
+ * no SDK, só cyw43_arch_wait_for_work_until consome a permissão do semáforo,
+ * que começa com uma. Uma chamada ao lwIP fora do núcleo 1 encerra o processo.
+ *
+ * Variáveis de ambiente reconhecidas:
+ * - HOST_IP: endereço entregue pelo "DHCP" (padrão 192.168.0.50).
+ *
+ * O cliente MQTT emulado anuncia cada quadro "transmitido" ou "recebido" com
+ * host_radio_quadro(), que passa pelos ponteiros linkoutput/input da netif da
+ * estação, como o driver real.
+ */
+
+#include "pico/cyw43_arch.h"
+#include "pico/async_context_poll.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "host_mocks.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HOST_MAX_TRABALHOS 64
+
+typedef struct {
+    void (*funcao)(void *);
+    void *arg;
+    uint64_t quando_us;
+} TrabalhoLwip;
+
+cyw43_t cyw43_state;
+
+static TrabalhoLwip trabalhos[HOST_MAX_TRABALHOS];
+static int num_trabalhos = 0;
+static pthread_mutex_t mutex_trabalhos = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond_trabalhos = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t mutex_lwip;
+static bool contexto_iniciado = false;
+
+#if REDE_POLL
+static async_context_poll_t contexto_poll;
+#endif
+
+/**
+ * @brief Executa o trabalho vencido mais antigo, se houver. Chamada com
+ * mutex_trabalhos tomado, que fica livre durante a execução.
+ * @return false se nada venceu; `proximo` recebe então o instante do próximo
+ * trabalho (UINT64_MAX se nenhum).
+ */
+static bool executar_vencido(uint64_t *proximo) {
+    int escolhido = -1;
+    uint64_t agora = time_us_64();
+    *proximo = UINT64_MAX;
+    for (int i = 0; i < num_trabalhos; i++) {
+        if (trabalhos[i].quando_us <= agora) {
+            if (escolhido < 0 || trabalhos[i].quando_us < trabalhos[escolhido].quando_us) escolhido = i;
+        } else if (trabalhos[i].quando_us < *proximo) {
+            *proximo = trabalhos[i].quando_us;
+        }
+    }
+    if (escolhido < 0) return false;
+    TrabalhoLwip t = trabalhos[escolhido];
+    trabalhos[escolhido] = trabalhos[--num_trabalhos];
+    pthread_mutex_unlock(&mutex_trabalhos);
+
+    cyw43_arch_lwip_begin();
+    t.funcao(t.arg);
+    cyw43_arch_lwip_end();
+
+    pthread_mutex_lock(&mutex_trabalhos);
+    return true;
+}
+
+#if !REDE_POLL
+static void *contexto_lwip(void *arg) {
+    (void)arg;
+    host_nucleo_atual = 1;
+    pthread_mutex_lock(&mutex_trabalhos);
+    while (true) {
+        uint64_t proximo;
+        if (executar_vencido(&proximo)) continue;
+        if (proximo == UINT64_MAX) {
+            pthread_cond_wait(&cond_trabalhos, &mutex_trabalhos);
+        } else {
+            pthread_mutex_unlock(&mutex_trabalhos);
+            // Em fatias de até 1 ms: um trabalho agendado para antes de `proximo` não espera por ele
+            uint64_t agora = time_us_64();
+            if (proximo > agora) sleep_us(proximo - agora > 1000 ? 1000 : proximo - agora);
+            pthread_mutex_lock(&mutex_trabalhos);
+        }
+    }
+    return NULL;
+}
+#endif
+
+// Enlace emulado: os quadros só existem para quem observa a netif (core1/energia_radio.c)
+static err_t linkoutput_vazio(struct netif *netif, struct pbuf *p) {
+    (void)netif;
+    (void)p;
+    return ERR_OK;
+}
+
+static err_t input_vazio(struct pbuf *p, struct netif *netif) {
+    (void)p;
+    (void)netif;
+    return ERR_OK;
+}
+
+void host_radio_quadro(bool recebido) {
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+    if (recebido && netif->input) {
+        netif->input(NULL, netif);
+    } else if (!recebido && netif->linkoutput) {
+        netif->linkoutput(netif, NULL);
+    }
+}
+
+void host_lwip_agendar(void (*funcao)(void *), void *arg, uint32_t atraso_us) {
+    pthread_mutex_lock(&mutex_trabalhos);
+    if (num_trabalhos < HOST_MAX_TRABALHOS) {
+        trabalhos[num_trabalhos++] = (TrabalhoLwip){funcao, arg, time_us_64() + atraso_us};
+        pthread_cond_signal(&cond_trabalhos);
+#if REDE_POLL
+        uint64_t quando = trabalhos[num_trabalhos - 1].quando_us;
+        if (quando < contexto_poll.core.next_time) contexto_poll.core.next_time = quando;
+#endif
+    }
+    pthread_mutex_unlock(&mutex_trabalhos);
+}
+
+int cyw43_arch_init(void) {
+    if (contexto_iniciado) return 0;
+    pthread_mutexattr_t atributos;
+    pthread_mutexattr_init(&atributos);
+    pthread_mutexattr_settype(&atributos, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&mutex_lwip, &atributos);
+
+#if REDE_POLL
+    contexto_poll.core.next_time = UINT64_MAX;
+    contexto_poll.core.core_num = (uint8_t)get_core_num();
+    contexto_poll.sem = (semaphore_t){.permits = 1, .max_permits = 1}; // Como async_context_poll_init
+#else
+    pthread_t t;
+    pthread_create(&t, NULL, contexto_lwip, NULL);
+    pthread_detach(t);
+#endif
+    contexto_iniciado = true;
+    return 0;
+}
+
+void cyw43_arch_deinit(void) {}
+
+void cyw43_arch_enable_sta_mode(void) {}
+
+int cyw43_arch_wifi_connect_timeout_ms(const char *ssid, const char *pw, uint32_t auth, uint32_t timeout_ms) {
+    (void)ssid;
+    (void)pw;
+    (void)auth;
+    (void)timeout_ms;
+    const char *ip = getenv("HOST_IP");
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+    ip4addr_aton(ip ? ip : "192.168.0.50", &netif->ip_addr);
+    if (!netif->linkoutput) netif->linkoutput = linkoutput_vazio;
+    if (!netif->input) netif->input = input_vazio;
+    return 0;
+}
+
+int cyw43_wifi_pm(cyw43_t *self, uint32_t pm) {
+    (void)self;
+    (void)pm;
+    return 0;
+}
+
+int cyw43_tcpip_link_status(cyw43_t *self, int itf) {
+    return self->netif[itf].ip_addr.addr != 0 ? CYW43_LINK_UP : CYW43_LINK_DOWN;
+}
+
+void cyw43_arch_lwip_begin(void) {
+#if REDE_POLL
+    // No SDK a trava do contexto de polling só pode ser tomada pelo núcleo dele
+    if (get_core_num() != 1) {
+        fprintf(stderr, "[HOST] lwIP acessado pelo núcleo %u com REDE_POLL\n", get_core_num());
+        abort();
+    }
+#endif
+    if (contexto_iniciado) pthread_mutex_lock(&mutex_lwip);
+}
+
+void cyw43_arch_lwip_end(void) {
+    if (contexto_iniciado) pthread_mutex_unlock(&mutex_lwip);
+}
+
+#if REDE_POLL
+void cyw43_arch_poll(void) {
+    pthread_mutex_lock(&mutex_trabalhos);
+    uint64_t proximo;
+    while (executar_vencido(&proximo)) {}
+    contexto_poll.core.next_time = proximo;
+    pthread_mutex_unlock(&mutex_trabalhos);
+
+    for (async_when_pending_worker_t *w = contexto_poll.core.when_pending_list; w; w = w->next) {
+        if (!w->work_pending) continue;
+        w->work_pending = false;
+        cyw43_arch_lwip_begin();
+        w->do_work(&contexto_poll.core, w);
+        cyw43_arch_lwip_end();
+    }
+}
+
+void cyw43_arch_wait_for_work_until(absolute_time_t until) {
+    // Como sem_acquire_block_until no SDK: consome a permissão ou espera por ela
+    // até `until` ou o próximo trabalho do contexto, o que vier antes
+    while (contexto_poll.sem.permits == 0) {
+        absolute_time_t limite = contexto_poll.core.next_time < until ? contexto_poll.core.next_time : until;
+        if (time_reached(limite)) return;
+        best_effort_wfe_or_timeout(limite);
+    }
+    contexto_poll.sem.permits--;
+}
+
+async_context_t *cyw43_arch_async_context(void) {
+    return &contexto_poll.core;
+}
+
+bool async_context_add_when_pending_worker(async_context_t *context, async_when_pending_worker_t *worker) {
+    worker->next = context->when_pending_list;
+    context->when_pending_list = worker;
+    return true;
+}
+
+void async_context_set_work_pending(async_context_t *context, async_when_pending_worker_t *worker) {
+    (void)context;
+    worker->work_pending = true;
+    contexto_poll.sem.permits = 1; // Como sem_release: acorda o laço do núcleo 1
+    __sev();
+}
+#else
+void cyw43_arch_poll(void) {}
+
+async_context_t *cyw43_arch_async_context(void) {
+    static async_context_t contexto_background;
+    return &contexto_background;
+}
+#endif
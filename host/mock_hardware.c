@@ -0,0 +1,198 @@
+/**
+ * @file mock_hardware.c
+ * @brief Clocks, IRQ, DMA e spinlocks emulados: guardam a configuração, sem efeito físico.
+ * Canais de DMA cadenciados pelo ADC são completados pelo ADC emulado (mock_adc.c).
+ */
+
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "host_mocks.h"
+#include <pthread.h>
+#include <string.h>
+
+host_dma_hw_t host_dma_hw;
+
+static uint32_t freq_sys_hz = 125000000u;
+static irq_handler_t handlers[32];
+static uint32_t canais_reservados = 0;
+static spin_lock_t spin_locks[NUM_SPIN_LOCKS];
+static uint32_t spin_locks_reservados = 0;
+
+// Estado dos canais usado para completar transferências emuladas
+static pthread_mutex_t mutex_dma = PTHREAD_MUTEX_INITIALIZER;
+static uint dreq_canal[NUM_DMA_CHANNELS], encadeado_canal[NUM_DMA_CHANNELS];
+static uint32_t canais_ativos = 0, irq_habilitados[2] = {0, 0}, irq_pendentes[2] = {0, 0};
+
+uint32_t clock_get_hz(enum clock_index clk) {
+    switch (clk) {
+        case clk_sys:
+        case clk_peri: return freq_sys_hz;
+        case clk_usb:
+        case clk_adc: return 48000000u;
+        case clk_ref: return 12000000u;
+        default: return 0;
+    }
+}
+
+bool set_sys_clock_khz(uint32_t freq_khz, bool obrigatorio) {
+    (void)obrigatorio;
+    freq_sys_hz = freq_khz * 1000u;
+    return true;
+}
+
+void set_sys_clock_48mhz(void) {
+    freq_sys_hz = 48000000u;
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    if (num < 32) handlers[num] = handler;
+}
+
+void irq_set_enabled(uint num, bool habilitar) {
+    (void)num;
+    (void)habilitar;
+}
+
+irq_handler_t host_irq_handler(uint num) {
+    return num < 32 ? handlers[num] : NULL;
+}
+
+int dma_claim_unused_channel(bool obrigatorio) {
+    for (uint c = 0; c < NUM_DMA_CHANNELS; c++) {
+        if (!(canais_reservados & (1u << c))) {
+            canais_reservados |= 1u << c;
+            return (int)c;
+        }
+    }
+    return obrigatorio ? 0 : -1;
+}
+
+void dma_channel_unclaim(uint canal) {
+    canais_reservados &= ~(1u << canal);
+}
+
+dma_channel_config dma_channel_get_default_config(uint canal) {
+    dma_channel_config c;
+    memset(&c, 0, sizeof(c));
+    c.ctrl = DMA_SIZE_32;
+    c.inc_leitura = true;
+    c.chain_to = canal;
+    c.dreq = 0x3f; // DREQ_FORCE
+    return c;
+}
+
+void dma_channel_configure(uint canal, const dma_channel_config *c, volatile void *destino, const volatile void *origem,
+                           uint32_t contagem, bool iniciar) {
+    host_dma_hw.ch[canal].read_addr = origem;
+    host_dma_hw.ch[canal].write_addr = destino;
+    host_dma_hw.ch[canal].transfer_count = contagem;
+    host_dma_hw.ch[canal].ctrl_trig = c->ctrl;
+    pthread_mutex_lock(&mutex_dma);
+    dreq_canal[canal] = c->dreq;
+    encadeado_canal[canal] = c->chain_to;
+    if (iniciar) canais_ativos |= 1u << canal;
+    pthread_mutex_unlock(&mutex_dma);
+}
+
+void dma_start_channel_mask(uint32_t mascara) {
+    pthread_mutex_lock(&mutex_dma);
+    canais_ativos |= mascara;
+    pthread_mutex_unlock(&mutex_dma);
+}
+
+void dma_channel_start(uint canal) { dma_start_channel_mask(1u << canal); }
+
+void dma_channel_abort(uint canal) {
+    pthread_mutex_lock(&mutex_dma);
+    canais_ativos &= ~(1u << canal);
+    pthread_mutex_unlock(&mutex_dma);
+}
+
+// Sem transferências reais, nenhum canal fica ocupado
+bool dma_channel_is_busy(uint canal) { (void)canal; return false; }
+
+static void habilitar_irq_canal(int irq, uint canal, bool habilitar) {
+    pthread_mutex_lock(&mutex_dma);
+    if (habilitar) irq_habilitados[irq] |= 1u << canal;
+    else irq_habilitados[irq] &= ~(1u << canal);
+    pthread_mutex_unlock(&mutex_dma);
+}
+
+static void reconhecer_irq_canal(int irq, uint canal) {
+    pthread_mutex_lock(&mutex_dma);
+    irq_pendentes[irq] &= ~(1u << canal);
+    pthread_mutex_unlock(&mutex_dma);
+}
+
+void dma_channel_set_irq0_enabled(uint canal, bool habilitar) { habilitar_irq_canal(0, canal, habilitar); }
+void dma_channel_set_irq1_enabled(uint canal, bool habilitar) { habilitar_irq_canal(1, canal, habilitar); }
+void dma_channel_acknowledge_irq0(uint canal) { reconhecer_irq_canal(0, canal); }
+void dma_channel_acknowledge_irq1(uint canal) { reconhecer_irq_canal(1, canal); }
+
+bool dma_irqn_get_channel_status(uint irq, uint canal) {
+    pthread_mutex_lock(&mutex_dma);
+    bool pendente = (irq_pendentes[irq & 1] >> canal) & 1u;
+    pthread_mutex_unlock(&mutex_dma);
+    return pendente;
+}
+
+bool dma_channel_get_irq0_status(uint canal) { return dma_irqn_get_channel_status(0, canal); }
+
+int host_dma_canal_ativo(uint dreq) {
+    int encontrado = -1;
+    pthread_mutex_lock(&mutex_dma);
+    for (uint c = 0; c < NUM_DMA_CHANNELS && encontrado < 0; c++) {
+        if ((canais_ativos & (1u << c)) && dreq_canal[c] == dreq) encontrado = (int)c;
+    }
+    pthread_mutex_unlock(&mutex_dma);
+    return encontrado;
+}
+
+void host_dma_concluir(uint canal) {
+    irq_handler_t handlers_disparados[2] = {NULL, NULL};
+    pthread_mutex_lock(&mutex_dma);
+    canais_ativos &= ~(1u << canal);
+    if (encadeado_canal[canal] != canal) canais_ativos |= 1u << encadeado_canal[canal];
+    for (int irq = 0; irq < 2; irq++) {
+        if (irq_habilitados[irq] & (1u << canal)) {
+            irq_pendentes[irq] |= 1u << canal;
+            handlers_disparados[irq] = handlers[irq ? DMA_IRQ_1 : DMA_IRQ_0];
+        }
+    }
+    pthread_mutex_unlock(&mutex_dma);
+    for (int irq = 0; irq < 2; irq++) {
+        if (handlers_disparados[irq]) handlers_disparados[irq]();
+    }
+}
+
+void dma_channel_set_read_addr(uint canal, const volatile void *origem, bool iniciar) {
+    host_dma_hw.ch[canal].read_addr = origem;
+    (void)iniciar;
+}
+
+void dma_channel_set_trans_count(uint canal, uint32_t contagem, bool iniciar) {
+    host_dma_hw.ch[canal].transfer_count = contagem;
+    (void)iniciar;
+}
+
+void dma_channel_set_write_addr(uint canal, volatile void *destino, bool iniciar) {
+    host_dma_hw.ch[canal].write_addr = destino;
+    if (iniciar) dma_channel_start(canal);
+}
+
+int spin_lock_claim_unused(bool obrigatorio) {
+    for (uint n = 0; n < NUM_SPIN_LOCKS; n++) {
+        if (!(spin_locks_reservados & (1u << n))) {
+            spin_locks_reservados |= 1u << n;
+            return (int)n;
+        }
+    }
+    return obrigatorio ? 0 : -1;
+}
+
+spin_lock_t *spin_lock_init(uint lock_num) {
+    spin_locks[lock_num] = 0;
+    return &spin_locks[lock_num];
+}
@@ -0,0 +1,150 @@
+/**
+ * @file mock_i2c.c
+ * @brief Barramento I2C emulado com um SSD1306 virtual no endereço 0x3C.
+ *
+ * Os comandos são interpretados o suficiente para posicionar a escrita na
+ * GDDRAM (modo de endereçamento horizontal). Com a variável de ambiente
+ * HOST_PBM_DIR definida, cada transferência de dados gera um arquivo
+ * quadro_NNNNN.pbm com o conteúdo da tela. HOST_I2C_MAX_HZ simula um barramento
+ * que só funciona até essa velocidade: acima dela toda escrita recebe NAK.
+ */
+
+#include "hardware/i2c.h"
+#include "host_mocks.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LARGURA 128
+#define PAGINAS 8
+#define ENDERECO_SSD1306 0x3C
+
+struct i2c_inst {
+    uint baudrate;
+};
+
+i2c_inst_t host_i2c0 = {0}, host_i2c1 = {0};
+
+static pthread_mutex_t mutex_barramento = PTHREAD_MUTEX_INITIALIZER;
+static HostEstatisticasI2C estatisticas;
+static uint8_t gddram[PAGINAS * LARGURA];
+
+// Estado do controlador virtual
+static uint8_t col_inicio = 0, col_fim = LARGURA - 1, pag_inicio = 0, pag_fim = PAGINAS - 1;
+static uint8_t coluna = 0, pagina = 0;
+static uint8_t cmd_pendente = 0;
+static int args_restantes = 0, arg_indice = 0;
+
+static int argumentos_do_comando(uint8_t cmd) {
+    switch (cmd) {
+        case 0x21: case 0x22: return 2;  // COLUMN_ADDR, PAGE_ADDR
+        case 0x81: case 0xD5: case 0xA8: case 0xD3:
+        case 0x8D: case 0x20: case 0xDA: case 0xD9: case 0xDB: return 1;
+        default: return 0;
+    }
+}
+
+static void tratar_byte_comando(uint8_t b) {
+    if (args_restantes > 0) {
+        if (cmd_pendente == 0x21) {
+            if (arg_indice == 0) col_inicio = b & 0x7F; else col_fim = b & 0x7F;
+        } else if (cmd_pendente == 0x22) {
+            if (arg_indice == 0) pag_inicio = b & 0x07; else pag_fim = b & 0x07;
+        }
+        arg_indice++;
+        if (--args_restantes == 0) {
+            coluna = col_inicio;
+            pagina = pag_inicio;
+        }
+        return;
+    }
+    cmd_pendente = b;
+    arg_indice = 0;
+    args_restantes = argumentos_do_comando(b);
+}
+
+static void tratar_byte_dado(uint8_t b) {
+    gddram[pagina * LARGURA + coluna] = b;
+    if (coluna++ >= col_fim) {
+        coluna = col_inicio;
+        pagina = (pagina >= pag_fim) ? pag_inicio : pagina + 1;
+    }
+}
+
+int host_ssd1306_gravar_pbm(const char *caminho) {
+    FILE *f = fopen(caminho, "wb");
+    if (!f) return -1;
+    fprintf(f, "P4\n%d %d\n", LARGURA, PAGINAS * 8);
+    for (int y = 0; y < PAGINAS * 8; y++) {
+        for (int xb = 0; xb < LARGURA / 8; xb++) {
+            uint8_t linha = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                int x = xb * 8 + bit;
+                if (gddram[(y / 8) * LARGURA + x] & (1u << (y % 8))) linha |= 0x80u >> bit;
+            }
+            fputc(linha, f);
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+static uint velocidade_maxima(void) {
+    const char *max = getenv("HOST_I2C_MAX_HZ");
+    return max ? (uint)strtoul(max, NULL, 10) : 1000000u;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)nostop;
+    if (addr != ENDERECO_SSD1306) return PICO_ERROR_GENERIC; // NAK: ninguém no endereço
+    if (i2c->baudrate > velocidade_maxima()) return PICO_ERROR_GENERIC; // Bordas lentas demais
+    if (len == 0) return 0;
+
+    pthread_mutex_lock(&mutex_barramento);
+    estatisticas.transacoes++;
+    estatisticas.bytes_escritos += len + 1; // + byte de endereço
+
+    // Byte de controle: bit 6 (D/C#) indica dados; Co=1 indica um único byte de comando
+    bool dados = (src[0] & 0x40) != 0;
+    for (size_t i = 1; i < len; i++) {
+        if (dados) tratar_byte_dado(src[i]);
+        else tratar_byte_comando(src[i]);
+    }
+
+    if (dados) {
+        estatisticas.quadros_dados++;
+        const char *dir = getenv("HOST_PBM_DIR");
+        if (dir) {
+            char caminho[512];
+            snprintf(caminho, sizeof(caminho), "%s/quadro_%05u.pbm", dir, estatisticas.pbm_gravados);
+            if (host_ssd1306_gravar_pbm(caminho) == 0) estatisticas.pbm_gravados++;
+        }
+    }
+    pthread_mutex_unlock(&mutex_barramento);
+    return (int)len;
+}
+
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop,
+                         uint timeout_us) {
+    (void)timeout_us;
+    return i2c_write_blocking(i2c, addr, src, len, nostop);
+}
+
+const HostEstatisticasI2C *host_i2c_estatisticas(void) { return &estatisticas; }
+
+void host_i2c_zerar_estatisticas(void) {
+    memset(&estatisticas, 0, sizeof(estatisticas));
+}
+
+const uint8_t *host_ssd1306_gddram(void) { return gddram; }
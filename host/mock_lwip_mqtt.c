@@ -0,0 +1,640 @@
+/**
+ * @file mock_lwip_mqtt.c
+ * @brief Cliente MQTT emulado (sem rede) e utilitários de endereço IPv4 do lwIP.
+ *
+ * A conexão é aceita de imediato e cada publicação é confirmada após
+ * HOST_LATENCIA_ACK_US (padrão 2000 us), sempre no contexto lwIP emulado.
+ * Até a confirmação a mensagem ocupa o anel de saída do cliente, como no lwIP,
+ * e publicações que não cabem nele são recusadas com ERR_MEM.
+ *
+ * O broker emulado devolve ao cliente as publicações nos tópicos que ele
+ * assinou, e um cliente de eco substituto republica cada TOPICO_SONDA em
+ * TOPICO_SONDA_ECO após HOST_LATENCIA_ECO_US (padrão 3000 us), descartando
+ * HOST_PERDA_ECO_PERMIL (padrão 0) das sondas. As assinaturas aceitam '+' e '#',
+ * e com HOST_MQTT_FRAGMENTO=<n> os dados chegam em partes de até n bytes, como
+ * o lwIP entrega mensagens maiores que o seu buffer de recepção.
+ *
+ * HOST_BROKER_FORA="<porta>:<início_s>:<fim_s>[,...]" tira do ar o broker da
+ * porta no intervalo (segundos desde o boot): tentativas de conexão ficam sem
+ * resposta, e uma conexão já aberta cai com MQTT_CONNECT_TIMEOUT 1,5 keep-alive
+ * após o início, como o lwIP faz quando os PINGREQ não são respondidos.
+ *
+ * HOST_MQTT_INJETAR="<tópico> <payload>" faz um cliente externo publicar essa
+ * mensagem HOST_MQTT_INJETAR_VEZES vezes de uma só vez (padrão 1), um segundo
+ * após a conexão, para exercitar o caminho de entrada (ex.: "pico/comando/x m").
+ *
+ * O cliente também tem uma conexão altcp emulada (client->conn), para o envio
+ * direto de core1/mqtt_envio_direto.c: os bytes escritos nela, por cópia ou por
+ * referência, são lidos só em altcp_output, interpretados como pacotes PUBLISH e
+ * tratados pelo broker como os de mqtt_publish; a confirmação chega pelo
+ * callback `sent` após HOST_LATENCIA_ACK_US.
+ *
+ * O PCB TCP dessa conexão tem a vida do lwIP: no fechamento pelo cliente
+ * (mqtt_close) o altcp o solta e ele segue vivo em tcp_active_pcbs até o FIN ser
+ * confirmado, junto com os dados ainda em voo, ou é liberado na hora quando o
+ * tcp_close responde com RST. host_mqtt_broker_fechar() emula o FIN do broker:
+ * o fechamento roda dentro do tcp_input, que segue usando o PCB depois.
+ *
+ * Cada envio e cada chegada (CONNACK, confirmação, mensagem assinada) passa
+ * por host_radio_quadro(), para o modelo de energia de core1/energia_radio.c.
+ *
+ * Com HOST_MQTT_CAPTURA=<arquivo>, cada publicação aceita é acrescentada ao
+ * arquivo como uma linha "<tópico> <payload em hexadecimal>", para os testes de
+ * ingestão (ex.: tools/decodificar_cbor.py).
+ */
+
+#include "lwip/apps/mqtt.h"
+#include "lwip/apps/mqtt_priv.h"
+#include "lwip/altcp.h"
+#include "lwip/tcp.h"
+#include "lwip/priv/tcp_priv.h"
+#include "host_mocks.h"
+#include "config/config_geral.h" // Para TOPICO_SONDA e TOPICO_SONDA_ECO
+#include "pico/time.h"               // Para time_us_64 (HOST_BROKER_FORA)
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    mqtt_request_cb_t cb;
+    void *arg;
+    mqtt_client_t *cliente;
+    u16_t bytes; // Ocupados no anel de saída até a confirmação
+} RequisicaoPendente;
+
+// Mensagem a caminho de um assinante
+typedef struct {
+    mqtt_client_t *cliente;
+    char topico[64];
+    u8_t payload[512];
+    u16_t tamanho;
+} EntregaPendente;
+
+static HostEstatisticasMQTT estatisticas;
+static EntregaPendente entregas[32];
+static unsigned proxima_entrega = 0;
+static RequisicaoPendente pendentes[32];
+static unsigned proximo_pendente = 0;
+
+static uint32_t latencia_ack_us(void) {
+    const char *v = getenv("HOST_LATENCIA_ACK_US");
+    return v ? (uint32_t)strtoul(v, NULL, 10) : 2000u;
+}
+
+static void capturar_publicacao(const char *topico, const void *payload, u16_t tamanho) {
+    static FILE *captura = NULL;
+    static bool verificado = false;
+    if (!verificado) {
+        verificado = true;
+        const char *caminho = getenv("HOST_MQTT_CAPTURA");
+        if (caminho) captura = fopen(caminho, "w");
+    }
+    if (!captura) return;
+    fprintf(captura, "%s ", topico);
+    for (u16_t i = 0; i < tamanho; i++) fprintf(captura, "%02x", ((const uint8_t *)payload)[i]);
+    fputc('\n', captura);
+    fflush(captura);
+}
+
+static uint32_t variavel_ambiente(const char *nome, uint32_t padrao) {
+    const char *v = getenv(nome);
+    return v ? (uint32_t)strtoul(v, NULL, 10) : padrao;
+}
+
+static void entregar_mensagem(void *arg) {
+    EntregaPendente *e = arg;
+    mqtt_client_t *c = e->cliente;
+    if (!c->conectado) return;
+    host_radio_quadro(true);
+    if (c->cb_pub_entrada) c->cb_pub_entrada(c->arg_entrada, e->topico, e->tamanho);
+    if (!c->cb_dados_entrada) return;
+    u16_t fragmento = (u16_t)variavel_ambiente("HOST_MQTT_FRAGMENTO", 0);
+    u16_t enviados = 0;
+    do {
+        u16_t parte = e->tamanho - enviados;
+        if (fragmento && parte > fragmento) parte = fragmento;
+        enviados += parte;
+        c->cb_dados_entrada(c->arg_entrada, e->payload + (enviados - parte), parte,
+                            enviados == e->tamanho ? MQTT_DATA_FLAG_LAST : 0);
+    } while (enviados < e->tamanho);
+}
+
+/**
+ * @brief Casamento de tópico com filtro de assinatura ('+' = um nível, '#' = o resto).
+ */
+static bool filtro_casa(const char *filtro, const char *topico) {
+    while (*filtro) {
+        if (*filtro == '#') return true;
+        if (*filtro == '+') {
+            while (*topico && *topico != '/') topico++;
+            filtro++;
+        } else if (*filtro++ != *topico++) {
+            return false;
+        }
+    }
+    return *topico == '\0';
+}
+
+/**
+ * @brief Agenda a entrega de uma mensagem ao cliente, se ele assina o tópico.
+ */
+static void rotear_para_assinantes(mqtt_client_t *c, const char *topico, const void *payload, u16_t tamanho,
+                                   uint32_t atraso_us) {
+    bool assinado = false;
+    for (u8_t i = 0; i < c->num_assinaturas && !assinado; i++) assinado = filtro_casa(c->assinaturas[i], topico);
+    if (!assinado || tamanho > sizeof(entregas[0].payload) || strlen(topico) >= sizeof(entregas[0].topico)) return;
+    EntregaPendente *e = &entregas[proxima_entrega++ % (sizeof(entregas) / sizeof(entregas[0]))];
+    e->cliente = c;
+    strcpy(e->topico, topico);
+    memcpy(e->payload, payload, tamanho);
+    e->tamanho = tamanho;
+    host_lwip_agendar(entregar_mensagem, e, atraso_us);
+}
+
+/**
+ * @brief Mensagem de um cliente externo (HOST_MQTT_INJETAR), publicada depois das assinaturas.
+ */
+static void injetar_mensagens(mqtt_client_t *c) {
+    const char *injetar = getenv("HOST_MQTT_INJETAR");
+    const char *payload = injetar ? strchr(injetar, ' ') : NULL;
+    if (!payload) return;
+    char topico[sizeof(entregas[0].topico)];
+    snprintf(topico, sizeof(topico), "%.*s", (int)(payload - injetar), injetar);
+    payload++;
+    for (uint32_t i = variavel_ambiente("HOST_MQTT_INJETAR_VEZES", 1); i > 0; i--) {
+        rotear_para_assinantes(c, topico, payload, (u16_t)strlen(payload), 1000000);
+    }
+}
+
+/**
+ * @brief Erro da conexão, como o mqtt_tcp_err_cb do lwIP: o PCB já foi liberado
+ * e o cliente avisa a queda pelo callback de conexão.
+ */
+static void conexao_com_erro(void *arg, err_t err) {
+    (void)err;
+    mqtt_client_t *c = arg;
+    c->conectado = false;
+    c->conn = NULL;
+    if (c->cb_conexao) c->cb_conexao(c, c->arg_conexao, MQTT_CONNECT_DISCONNECTED);
+}
+
+/**
+ * @brief Fechamento pelo cliente, como o mqtt_close do lwIP: os callbacks da
+ * conexão são removidos e ela é fechada com altcp_close.
+ */
+static void fechar_conexao(mqtt_client_t *c) {
+    c->conectado = false;
+    if (!c->conn) return;
+    altcp_sent(c->conn, NULL);
+    altcp_err(c->conn, NULL);
+    altcp_close(c->conn);
+    c->conn = NULL;
+}
+
+static struct tcp_pcb *alocar_pcb(void);
+static err_t altcp_repassar_confirmacao(void *arg, struct tcp_pcb *pcb, u16_t len);
+static void altcp_repassar_erro(void *arg, err_t err);
+
+static void entregar_conexao(void *arg) {
+    mqtt_client_t *c = arg;
+    if (!c->conectando) return; // Tentativa abandonada com mqtt_disconnect
+    struct tcp_pcb *pcb = alocar_pcb();
+    if (!pcb) {
+        fprintf(stderr, "[MOCK] Sem PCB TCP livre para a conexão.\n");
+        return;
+    }
+    c->conectando = false;
+    c->conectado = true;
+    host_radio_quadro(true);
+    memset(&c->conexao_emulada, 0, sizeof(c->conexao_emulada));
+    c->conexao_emulada.arg = c;
+    c->conexao_emulada.state = pcb;
+    c->conexao_emulada.err = conexao_com_erro;
+    pcb->cliente = c;
+    tcp_arg(pcb, &c->conexao_emulada);
+    tcp_sent(pcb, altcp_repassar_confirmacao);
+    tcp_err(pcb, altcp_repassar_erro);
+    c->conn = &c->conexao_emulada;
+    if (c->cb_conexao) c->cb_conexao(c, c->arg_conexao, MQTT_CONNECT_ACCEPTED);
+    injetar_mensagens(c);
+}
+
+void host_mqtt_broker_fechar(mqtt_client_t *c) {
+    if (!c->conn) return;
+    struct tcp_pcb *pcb = c->conn->state;
+    // mqtt_tcp_recv_cb com p == NULL: fecha e avisa pelo callback de conexão, e devolve ERR_OK
+    fechar_conexao(c);
+    if (c->cb_conexao) c->cb_conexao(c, c->arg_conexao, MQTT_CONNECT_DISCONNECTED);
+    // Com ERR_OK o tcp_input segue com o PCB (tcp_output, fechamento adiado)
+    if (pcb->liberado) {
+        fprintf(stderr, "[MOCK] PCB TCP liberado dentro do callback de recepção, ainda em uso pelo tcp_input.\n");
+        abort();
+    }
+}
+
+static u16_t ocupacao_saida(const mqtt_client_t *c) {
+    int32_t usados = (int32_t)c->output.put - c->output.get;
+    return (u16_t)(usados < 0 ? usados + MQTT_OUTPUT_RINGBUF_SIZE : usados);
+}
+
+static void entregar_requisicao(void *arg) {
+    RequisicaoPendente *r = arg;
+    host_radio_quadro(true);
+    if (r->cliente) r->cliente->output.get = (u16_t)((r->cliente->output.get + r->bytes) % MQTT_OUTPUT_RINGBUF_SIZE);
+    if (r->cb) r->cb(r->arg, ERR_OK);
+}
+
+/**
+ * @brief Publicação que chegou ao broker emulado: contada, capturada e roteada.
+ */
+static void broker_receber(mqtt_client_t *client, const char *topic, const void *payload, u16_t payload_length) {
+    estatisticas.publicacoes++;
+    estatisticas.bytes_payload += payload_length;
+    capturar_publicacao(topic, payload, payload_length);
+    rotear_para_assinantes(client, topic, payload, payload_length, latencia_ack_us());
+    if (strcmp(topic, TOPICO_SONDA) == 0 && (uint32_t)(rand() % 1000) >= variavel_ambiente("HOST_PERDA_ECO_PERMIL", 0)) {
+        // Cliente de eco: recebe a sonda do broker e a republica no tópico de eco
+        rotear_para_assinantes(client, TOPICO_SONDA_ECO, payload, payload_length,
+                               latencia_ack_us() + variavel_ambiente("HOST_LATENCIA_ECO_US", 3000));
+    }
+}
+
+// Confirmação TCP de uma transmissão, ou do FIN (`fin`), que libera o PCB
+typedef struct {
+    struct tcp_pcb *pcb;
+    u32_t geracao;
+    u16_t bytes;
+    u16_t trechos;
+    bool fin;
+} ConfirmacaoTcp;
+
+#define HOST_NUM_PCBS 4
+
+struct tcp_pcb *tcp_active_pcbs = NULL;
+static struct tcp_pcb pool_pcbs[HOST_NUM_PCBS];
+static unsigned proximo_pcb = 0;
+static ConfirmacaoTcp confirmacoes[16];
+static unsigned proxima_confirmacao = 0;
+
+static void verificar_pcb(const struct tcp_pcb *pcb, const char *operacao) {
+    if (!pcb->liberado) return;
+    fprintf(stderr, "[MOCK] %s em um PCB TCP já liberado.\n", operacao);
+    abort();
+}
+
+static bool pcb_vivo(const struct tcp_pcb *pcb) {
+    for (const struct tcp_pcb *p = tcp_active_pcbs; p; p = p->next) {
+        if (p == pcb) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Aloca um PCB do pool em rodízio, para que um PCB liberado demore a ser
+ * reaproveitado e o uso dele depois de liberado seja detectado.
+ */
+static struct tcp_pcb *alocar_pcb(void) {
+    for (unsigned i = 0; i < HOST_NUM_PCBS; i++) {
+        struct tcp_pcb *pcb = &pool_pcbs[proximo_pcb++ % HOST_NUM_PCBS];
+        if (pcb_vivo(pcb)) continue;
+        u32_t geracao = pcb->geracao + 1;
+        memset(pcb, 0, sizeof(*pcb));
+        pcb->geracao = geracao;
+        pcb->snd_buf = TCP_SND_BUF;
+        pcb->next = tcp_active_pcbs;
+        tcp_active_pcbs = pcb;
+        return pcb;
+    }
+    return NULL;
+}
+
+static void liberar_pcb(struct tcp_pcb *pcb) {
+    for (struct tcp_pcb **p = &tcp_active_pcbs; *p; p = &(*p)->next) {
+        if (*p == pcb) {
+            *p = pcb->next;
+            break;
+        }
+    }
+    pcb->next = NULL;
+    pcb->num_trechos = 0;
+    pcb->geracao++;
+    pcb->liberado = true;
+}
+
+static void entregar_confirmacao_tcp(void *arg) {
+    ConfirmacaoTcp *c = arg;
+    struct tcp_pcb *pcb = c->pcb;
+    if (pcb->geracao != c->geracao) return; // PCB liberado (abort ou RST) antes da confirmação
+    host_radio_quadro(true);
+    if (c->fin) {
+        liberar_pcb(pcb); // FIN confirmado: sem callback, como o lwIP com a recepção já fechada
+        return;
+    }
+    pcb->snd_buf += c->bytes;
+    pcb->snd_queuelen -= c->trechos;
+    if (pcb->sent) pcb->sent(pcb->callback_arg, pcb, c->bytes);
+}
+
+static void agendar_confirmacao(struct tcp_pcb *pcb, u16_t bytes, u16_t trechos, bool fin, uint32_t atraso_us) {
+    ConfirmacaoTcp *c = &confirmacoes[proxima_confirmacao++ % (sizeof(confirmacoes) / sizeof(confirmacoes[0]))];
+    *c = (ConfirmacaoTcp){pcb, pcb->geracao, bytes, trechos, fin};
+    host_lwip_agendar(entregar_confirmacao_tcp, c, atraso_us);
+}
+
+/**
+ * @brief "Transmite" os trechos escritos: o broker interpreta cada PUBLISH (QoS 0) do fluxo.
+ */
+static void transmitir(struct tcp_pcb *pcb) {
+    static u8_t fluxo[TCP_SND_BUF];
+    u16_t total = 0;
+    u8_t trechos = pcb->num_trechos;
+    for (u8_t i = 0; i < pcb->num_trechos; i++) {
+        memcpy(fluxo + total, pcb->trechos[i].dados, pcb->trechos[i].tamanho);
+        total += pcb->trechos[i].tamanho;
+    }
+    pcb->num_trechos = 0;
+    if (total == 0) return;
+    host_radio_quadro(false);
+
+    for (u16_t pos = 0; pos < total;) {
+        u16_t inicio = pos++;
+        uint32_t restante = 0;
+        for (int deslocamento = 0; pos < total; deslocamento += 7) {
+            restante |= (uint32_t)(fluxo[pos] & 0x7F) << deslocamento;
+            if (!(fluxo[pos++] & 0x80)) break;
+        }
+        if ((fluxo[inicio] & 0xF0) != 0x30 || pos + restante > total) {
+            fprintf(stderr, "[MOCK] Fluxo TCP corrompido na posição %u.\n", inicio);
+            break;
+        }
+        u16_t tamanho_topico = (u16_t)((fluxo[pos] << 8) | fluxo[pos + 1]);
+        char topico[sizeof(entregas[0].topico)];
+        snprintf(topico, sizeof(topico), "%.*s", (int)tamanho_topico, (const char *)fluxo + pos + 2);
+        u16_t cabecalho = 2 + tamanho_topico;
+        broker_receber(pcb->cliente, topico, fluxo + pos + cabecalho, (u16_t)(restante - cabecalho));
+        pos += (u16_t)restante;
+    }
+    agendar_confirmacao(pcb, total, trechos, false, latencia_ack_us());
+}
+
+void tcp_arg(struct tcp_pcb *pcb, void *arg) {
+    verificar_pcb(pcb, "tcp_arg");
+    pcb->callback_arg = arg;
+}
+
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent) {
+    verificar_pcb(pcb, "tcp_sent");
+    pcb->sent = sent;
+}
+
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err) {
+    verificar_pcb(pcb, "tcp_err");
+    pcb->errf = err;
+}
+
+err_t tcp_close(struct tcp_pcb *pcb) {
+    verificar_pcb(pcb, "tcp_close");
+    if (pcb->dados_nao_lidos) {
+        // RST: o lwIP descarta os segmentos e libera o PCB sem chamar callbacks
+        fprintf(stderr, "[MOCK] Fechamento com dados não lidos: RST, %u trechos descartados.\n", pcb->num_trechos);
+        liberar_pcb(pcb);
+        return ERR_OK;
+    }
+    transmitir(pcb); // O FIN vai depois dos dados pendentes e é confirmado depois deles
+    agendar_confirmacao(pcb, 0, 0, true, latencia_ack_us() + 1);
+    return ERR_OK;
+}
+
+void tcp_abort(struct tcp_pcb *pcb) {
+    verificar_pcb(pcb, "tcp_abort");
+    fprintf(stderr, "[MOCK] Conexão abortada com %u trechos por transmitir.\n", pcb->num_trechos);
+    tcp_err_fn errf = pcb->errf;
+    void *arg = pcb->callback_arg;
+    liberar_pcb(pcb);
+    pcb->abortada = true;
+    if (errf) errf(arg, ERR_ABRT);
+}
+
+// Como o altcp_tcp: os callbacks crus do PCB repassados aos da conexão
+static err_t altcp_repassar_confirmacao(void *arg, struct tcp_pcb *pcb, u16_t len) {
+    (void)pcb;
+    struct altcp_pcb *conn = arg;
+    return conn->sent ? conn->sent(conn->arg, conn, len) : ERR_OK;
+}
+
+static void altcp_repassar_erro(void *arg, err_t err) {
+    struct altcp_pcb *conn = arg;
+    conn->state = NULL; // PCB já liberado pelo lwIP
+    if (conn->err) conn->err(conn->arg, err);
+}
+
+void altcp_sent(struct altcp_pcb *conn, altcp_sent_fn sent) {
+    conn->sent = sent;
+}
+
+void altcp_err(struct altcp_pcb *conn, altcp_err_fn err) {
+    conn->err = err;
+}
+
+err_t altcp_close(struct altcp_pcb *conn) {
+    struct tcp_pcb *pcb = conn->state;
+    if (!pcb) return ERR_OK;
+    // Como altcp_tcp_close: o PCB fica sem callbacks e deixa de ser da conexão
+    tcp_arg(pcb, NULL);
+    tcp_sent(pcb, NULL);
+    tcp_err(pcb, NULL);
+    conn->state = NULL;
+    return tcp_close(pcb);
+}
+
+void altcp_abort(struct altcp_pcb *conn) {
+    if (conn->state) tcp_abort((struct tcp_pcb *)conn->state);
+}
+
+err_t altcp_write(struct altcp_pcb *conn, const void *dataptr, u16_t len, u8_t apiflags) {
+    struct tcp_pcb *pcb = conn->state;
+    verificar_pcb(pcb, "altcp_write");
+    const u8_t max = sizeof(pcb->trechos) / sizeof(pcb->trechos[0]);
+    if (len > pcb->snd_buf || pcb->num_trechos >= max) return ERR_MEM;
+    HostTrechoTcp *t = &pcb->trechos[pcb->num_trechos];
+    if (apiflags & TCP_WRITE_FLAG_COPY) {
+        if (len > sizeof(t->copia)) return ERR_MEM;
+        memcpy(t->copia, dataptr, len);
+        t->dados = t->copia;
+    } else {
+        t->dados = dataptr; // Lido só na transmissão, como o lwIP
+    }
+    t->tamanho = len;
+    pcb->num_trechos++;
+    pcb->snd_queuelen++;
+    pcb->snd_buf -= len;
+    return ERR_OK;
+}
+
+err_t altcp_output(struct altcp_pcb *conn) {
+    struct tcp_pcb *pcb = conn->state;
+    verificar_pcb(pcb, "altcp_output");
+    transmitir(pcb);
+    return ERR_OK;
+}
+
+u16_t altcp_sndbuf(struct altcp_pcb *conn) {
+    return ((struct tcp_pcb *)conn->state)->snd_buf;
+}
+
+u16_t altcp_sndqueuelen(struct altcp_pcb *conn) {
+    return ((struct tcp_pcb *)conn->state)->snd_queuelen;
+}
+
+mqtt_client_t *mqtt_client_new(void) {
+    return calloc(1, sizeof(mqtt_client_t));
+}
+
+void mqtt_client_free(mqtt_client_t *client) {
+    free(client);
+}
+
+// Queda de uma conexão aberta, detectada pelo keep-alive
+typedef struct {
+    mqtt_client_t *cliente;
+    u32_t geracao;
+} QuedaPendente;
+
+static QuedaPendente quedas[8];
+static unsigned proxima_queda_livre = 0;
+
+/**
+ * @brief Próximo intervalo de HOST_BROKER_FORA do broker `porta` que ainda não terminou.
+ */
+static bool proxima_queda(u16_t porta, uint64_t agora_us, uint64_t *inicio_us, uint64_t *fim_us) {
+    const char *v = getenv("HOST_BROKER_FORA");
+    bool encontrada = false;
+    while (v && *v) {
+        unsigned p, inicio_s, fim_s;
+        if (sscanf(v, "%u:%u:%u", &p, &inicio_s, &fim_s) == 3 && p == porta &&
+            (uint64_t)fim_s * 1000000u > agora_us && (!encontrada || (uint64_t)inicio_s * 1000000u < *inicio_us)) {
+            *inicio_us = (uint64_t)inicio_s * 1000000u;
+            *fim_us = (uint64_t)fim_s * 1000000u;
+            encontrada = true;
+        }
+        v = strchr(v, ',');
+        if (v) v++;
+    }
+    return encontrada;
+}
+
+static void entregar_queda(void *arg) {
+    QuedaPendente *q = arg;
+    mqtt_client_t *c = q->cliente;
+    if (c->geracao != q->geracao || !c->conectado) return;
+    fechar_conexao(c);
+    if (c->cb_conexao) c->cb_conexao(c, c->arg_conexao, MQTT_CONNECT_TIMEOUT);
+}
+
+err_t mqtt_client_connect(mqtt_client_t *client, const ip_addr_t *ipaddr, u16_t port, mqtt_connection_cb_t cb,
+                          void *arg, const struct mqtt_connect_client_info_t *client_info) {
+    (void)ipaddr;
+    if (client->conectado || client->conectando) return ERR_ISCONN;
+    client->cb_conexao = cb;
+    client->arg_conexao = arg;
+    client->porta = port;
+    client->keep_alive = client_info->keep_alive;
+    client->geracao++;
+    client->conectando = true;
+    host_radio_quadro(false);
+
+    uint64_t agora_us = time_us_64(), inicio_us, fim_us;
+    if (proxima_queda(port, agora_us, &inicio_us, &fim_us) && inicio_us <= agora_us) {
+        return ERR_OK; // Broker fora do ar: o CONNECT fica sem resposta
+    }
+    host_lwip_agendar(entregar_conexao, client, latencia_ack_us());
+    if (proxima_queda(port, agora_us, &inicio_us, &fim_us) && client->keep_alive) {
+        QuedaPendente *q = &quedas[proxima_queda_livre++ % (sizeof(quedas) / sizeof(quedas[0]))];
+        *q = (QuedaPendente){client, client->geracao};
+        uint64_t deteccao_us = (uint64_t)client->keep_alive * 1500000u; // 1,5 keep-alive sem PINGRESP
+        host_lwip_agendar(entregar_queda, q, (uint32_t)(inicio_us - agora_us + deteccao_us));
+    }
+    return ERR_OK;
+}
+
+void mqtt_disconnect(mqtt_client_t *client) {
+    fechar_conexao(client);
+    client->conectando = false;
+}
+
+u8_t mqtt_client_is_connected(mqtt_client_t *client) {
+    return client->conectado;
+}
+
+void mqtt_set_inpub_callback(mqtt_client_t *client, mqtt_incoming_publish_cb_t pub_cb,
+                             mqtt_incoming_data_cb_t data_cb, void *arg) {
+    client->cb_pub_entrada = pub_cb;
+    client->cb_dados_entrada = data_cb;
+    client->arg_entrada = arg;
+}
+
+static RequisicaoPendente *nova_requisicao(mqtt_request_cb_t cb, void *arg) {
+    RequisicaoPendente *r = &pendentes[proximo_pendente++ % (sizeof(pendentes) / sizeof(pendentes[0]))];
+    r->cb = cb;
+    r->arg = arg;
+    r->cliente = NULL;
+    r->bytes = 0;
+    return r;
+}
+
+err_t mqtt_sub_unsub(mqtt_client_t *client, const char *topic, u8_t qos, mqtt_request_cb_t cb, void *arg, u8_t sub) {
+    (void)qos;
+    if (!client->conectado) return ERR_CONN;
+    const u8_t max = sizeof(client->assinaturas) / sizeof(client->assinaturas[0]);
+    if (sub && client->num_assinaturas < max && strlen(topic) < sizeof(client->assinaturas[0])) {
+        strcpy(client->assinaturas[client->num_assinaturas++], topic);
+    } else if (!sub) {
+        for (u8_t i = 0; i < client->num_assinaturas; i++) {
+            if (strcmp(client->assinaturas[i], topic) == 0) {
+                strcpy(client->assinaturas[i], client->assinaturas[--client->num_assinaturas]);
+                break;
+            }
+        }
+    }
+    host_radio_quadro(false);
+    host_lwip_agendar(entregar_requisicao, nova_requisicao(cb, arg), latencia_ack_us());
+    return ERR_OK;
+}
+
+err_t mqtt_publish(mqtt_client_t *client, const char *topic, const void *payload, u16_t payload_length,
+                   u8_t qos, u8_t retain, mqtt_request_cb_t cb, void *arg) {
+    (void)qos;
+    (void)retain;
+    if (!client->conectado) return ERR_CONN;
+    // Cabeçalho fixo (até 5), tópico com o tamanho (2 + n) e o conteúdo, como no lwIP
+    uint32_t bytes = 5 + 2 + strlen(topic) + payload_length;
+    if (ocupacao_saida(client) + bytes >= MQTT_OUTPUT_RINGBUF_SIZE) return ERR_MEM;
+    client->output.put = (u16_t)((client->output.put + bytes) % MQTT_OUTPUT_RINGBUF_SIZE);
+    host_radio_quadro(false);
+    broker_receber(client, topic, payload, payload_length);
+    RequisicaoPendente *r = nova_requisicao(cb, arg);
+    r->cliente = client;
+    r->bytes = (u16_t)bytes;
+    host_lwip_agendar(entregar_requisicao, r, latencia_ack_us());
+    return ERR_OK;
+}
+
+const HostEstatisticasMQTT *host_mqtt_estatisticas(void) { return &estatisticas; }
+
+int ip4addr_aton(const char *cp, ip4_addr_t *addr) {
+    unsigned a, b, c, d;
+    char resto;
+    if (sscanf(cp, "%u.%u.%u.%u%c", &a, &b, &c, &d, &resto) != 4 || a > 255 || b > 255 || c > 255 || d > 255) {
+        return 0;
+    }
+    // Ordem de rede, como no lwIP
+    addr->addr = a | (b << 8) | (c << 16) | ((u32_t)d << 24);
+    return 1;
+}
+
+char *ip4addr_ntoa_r(const ip4_addr_t *addr, char *buf, int buflen) {
+    const uint8_t *b = (const uint8_t *)&addr->addr;
+    if (snprintf(buf, (size_t)buflen, "%u.%u.%u.%u", b[0], b[1], b[2], b[3]) >= buflen) return NULL;
+    return buf;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file mock_multicore.c
+ * @brief Emulação do lançamento do núcleo 1 e das FIFOs inter-core com threads POSIX.
+ */
+
+#include "pico/multicore.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include <pthread.h>
+
+#define HOST_FIFO_PROFUNDIDADE 8 // Igual à FIFO de hardware do RP2040
+
+typedef struct {
+    uint32_t dados[HOST_FIFO_PROFUNDIDADE];
+    int frente;
+    int tamanho;
+    pthread_mutex_t mutex;
+    pthread_cond_t mudou;
+} FifoHost;
+
+// fifos[n] é a caixa de entrada do núcleo n
+static FifoHost fifos[2] = {
+    {.mutex = PTHREAD_MUTEX_INITIALIZER, .mudou = PTHREAD_COND_INITIALIZER},
+    {.mutex = PTHREAD_MUTEX_INITIALIZER, .mudou = PTHREAD_COND_INITIALIZER},
+};
+
+static void *executar_core1(void *arg) {
+    host_nucleo_atual = 1;
+    ((void (*)(void))arg)();
+    return NULL;
+}
+
+void multicore_launch_core1(void (*entrada)(void)) {
+    pthread_t t;
+    pthread_create(&t, NULL, executar_core1, (void *)entrada);
+    pthread_detach(t);
+}
+
+bool multicore_fifo_rvalid(void) {
+    FifoHost *f = &fifos[get_core_num()];
+    pthread_mutex_lock(&f->mutex);
+    bool valido = f->tamanho > 0;
+    pthread_mutex_unlock(&f->mutex);
+    return valido;
+}
+
+bool multicore_fifo_wready(void) {
+    FifoHost *f = &fifos[get_core_num() ^ 1u];
+    pthread_mutex_lock(&f->mutex);
+    bool pronto = f->tamanho < HOST_FIFO_PROFUNDIDADE;
+    pthread_mutex_unlock(&f->mutex);
+    return pronto;
+}
+
+void multicore_fifo_push_blocking(uint32_t dado) {
+    FifoHost *f = &fifos[get_core_num() ^ 1u];
+    pthread_mutex_lock(&f->mutex);
+    while (f->tamanho == HOST_FIFO_PROFUNDIDADE) pthread_cond_wait(&f->mudou, &f->mutex);
+    f->dados[(f->frente + f->tamanho) % HOST_FIFO_PROFUNDIDADE] = dado;
+    f->tamanho++;
+    pthread_cond_broadcast(&f->mudou);
+    pthread_mutex_unlock(&f->mutex);
+    __sev(); // Como o SDK: acorda o outro núcleo do WFE
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+    FifoHost *f = &fifos[get_core_num()];
+    pthread_mutex_lock(&f->mutex);
+    while (f->tamanho == 0) pthread_cond_wait(&f->mudou, &f->mutex);
+    uint32_t dado = f->dados[f->frente];
+    f->frente = (f->frente + 1) % HOST_FIFO_PROFUNDIDADE;
+    f->tamanho--;
+    pthread_cond_broadcast(&f->mudou);
+    pthread_mutex_unlock(&f->mutex);
+    __sev();
+    return dado;
+}
+
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t *saida) {
+    uint64_t limite = time_us_64() + timeout_us;
+    while (!multicore_fifo_rvalid()) {
+        if (time_us_64() >= limite) return false;
+        sleep_us(50);
+    }
+    *saida = multicore_fifo_pop_blocking();
+    return true;
+}
+
+void multicore_fifo_drain(void) {
+    FifoHost *f = &fifos[get_core_num()];
+    pthread_mutex_lock(&f->mutex);
+    f->tamanho = 0;
+    pthread_cond_broadcast(&f->mudou);
+    pthread_mutex_unlock(&f->mutex);
+}
@@ -0,0 +1,141 @@
+/**
+ * @file mock_pico.c
+ * @brief Substitutos de tempo, eventos SEV/WFE, stdio, gerador aleatório e timer do Pico SDK para o build nativo.
+ *
+ * Variáveis de ambiente reconhecidas:
+ * - HOST_DURACAO_MS: encerra o processo após esse tempo (sleep_* verifica o prazo).
+ */
+
+#include "pico/stdlib.h"
+#include "pico/rand.h"
+#include "hardware/timer.h"
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+__thread uint host_nucleo_atual = 0;
+
+static uint64_t instante_inicial_ns;
+static uint64_t duracao_max_us;
+
+// Aviso de caracteres na serial (stdio_set_chars_available_callback), como a IRQ do USB
+static void (*caracteres_disponiveis)(void *) = NULL;
+static void *caracteres_param = NULL;
+static volatile bool stdin_encerrado = false;
+
+// Registrador de evento de cada núcleo: __sev liga os dois, o WFE consome o seu
+static pthread_mutex_t mutex_evento = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond_evento;
+static bool evento[2];
+
+static uint64_t relogio_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+__attribute__((constructor)) static void mock_pico_inicializar(void) {
+    instante_inicial_ns = relogio_ns();
+    const char *duracao = getenv("HOST_DURACAO_MS");
+    if (duracao) duracao_max_us = strtoull(duracao, NULL, 10) * 1000u;
+    pthread_condattr_t atributos;
+    pthread_condattr_init(&atributos);
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    pthread_cond_init(&cond_evento, &atributos);
+    setvbuf(stdout, NULL, _IOLBF, 0);
+}
+
+uint64_t time_us_64(void) {
+    return (relogio_ns() - instante_inicial_ns) / 1000u;
+}
+
+static void verificar_fim_simulacao(void) {
+    if (duracao_max_us && time_us_64() >= duracao_max_us) {
+        fflush(stdout);
+        exit(0);
+    }
+}
+
+void sleep_us(uint64_t us) {
+    struct timespec ts = {(time_t)(us / 1000000u), (long)((us % 1000000u) * 1000u)};
+    nanosleep(&ts, NULL);
+    verificar_fim_simulacao();
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+void sleep_until(absolute_time_t t) {
+    int64_t restante = absolute_time_diff_us(get_absolute_time(), t);
+    if (restante > 0) sleep_us((uint64_t)restante);
+    else verificar_fim_simulacao();
+}
+
+void __sev(void) {
+    pthread_mutex_lock(&mutex_evento);
+    evento[0] = evento[1] = true;
+    pthread_cond_broadcast(&cond_evento);
+    pthread_mutex_unlock(&mutex_evento);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t t) {
+    // Espera um __sev até o prazo, no máximo 1 ms (a serial é consultada a cada volta)
+    int64_t restante = absolute_time_diff_us(get_absolute_time(), t);
+    uint64_t espera_ns = (uint64_t)(restante > 1000 ? 1000 : (restante > 0 ? restante : 0)) * 1000u;
+    uint nucleo = get_core_num() & 1u;
+    pthread_mutex_lock(&mutex_evento);
+    if (!evento[nucleo] && espera_ns) {
+        uint64_t ate_ns = relogio_ns() + espera_ns;
+        struct timespec ts = {(time_t)(ate_ns / 1000000000u), (long)(ate_ns % 1000000000u)};
+        while (!evento[nucleo] && pthread_cond_timedwait(&cond_evento, &mutex_evento, &ts) == 0) {}
+    }
+    evento[nucleo] = false;
+    pthread_mutex_unlock(&mutex_evento);
+    verificar_fim_simulacao();
+    if (caracteres_disponiveis && get_core_num() == 0 && !stdin_encerrado) {
+        struct pollfd p = {.fd = STDIN_FILENO, .events = POLLIN};
+        if (poll(&p, 1, 0) > 0 && (p.revents & POLLIN)) caracteres_disponiveis(caracteres_param);
+    }
+    return time_reached(t);
+}
+
+bool stdio_init_all(void) { return true; }
+bool stdio_usb_connected(void) { return true; }
+
+void stdio_set_chars_available_callback(void (*fn)(void *), void *param) {
+    caracteres_param = param;
+    caracteres_disponiveis = fn;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    struct pollfd p = {.fd = STDIN_FILENO, .events = POLLIN};
+    if (poll(&p, 1, (int)(timeout_us / 1000u)) <= 0 || !(p.revents & POLLIN)) return PICO_ERROR_TIMEOUT;
+    unsigned char c;
+    ssize_t lidos = read(STDIN_FILENO, &c, 1);
+    if (lidos == 0) stdin_encerrado = true; // Fim da entrada: não há mais o que avisar
+    if (lidos != 1) return PICO_ERROR_TIMEOUT;
+    return c;
+}
+
+uint32_t get_rand_32(void) {
+    // xorshift64* semeado pelo relógio: chamadas seguidas não podem repetir o valor
+    static _Atomic uint64_t estado = 0;
+    uint64_t x = estado;
+    if (x == 0) x = relogio_ns() | 1;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    estado = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+host_timer_hw_t *host_timer_hw(void) {
+    static __thread host_timer_hw_t regs;
+    uint64_t agora = time_us_64();
+    regs.timerawl = (uint32_t)agora;
+    regs.timerawh = (uint32_t)(agora >> 32);
+    return &regs;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file mock_pwm.c
+ * @brief PWM emulado: registra os níveis escritos em cada GPIO.
+ */
+
+#include "hardware/pwm.h"
+
+host_pwm_hw_t host_pwm_hw;
+
+static volatile uint16_t niveis_gpio[30];
+
+void pwm_init(uint slice_num, pwm_config *c, bool iniciar) {
+    (void)slice_num;
+    (void)c;
+    (void)iniciar;
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t nivel) {
+    if (gpio >= 30) return;
+    niveis_gpio[gpio] = nivel;
+    // Mantém o registrador CC coerente (canal A nos 16 bits baixos, B nos altos)
+    volatile uint32_t *cc = &host_pwm_hw.slice[pwm_gpio_to_slice_num(gpio)].cc;
+    if (pwm_gpio_to_channel(gpio) == PWM_CHAN_B) *cc = (*cc & 0x0000FFFFu) | ((uint32_t)nivel << 16);
+    else *cc = (*cc & 0xFFFF0000u) | nivel;
+}
+
+void pwm_clear_irq(uint slice_num) { (void)slice_num; }
+
+void pwm_set_irq_enabled(uint slice_num, bool habilitar) {
+    (void)slice_num;
+    (void)habilitar;
+}
+
+void pwm_set_enabled(uint slice_num, bool habilitar) {
+    (void)slice_num;
+    (void)habilitar;
+}
+
+void pwm_set_clkdiv(uint slice_num, float div) {
+    (void)slice_num;
+    (void)div;
+}
+
+uint16_t host_pwm_nivel(uint gpio) {
+    return gpio < 30 ? niveis_gpio[gpio] : 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file bench_tls.c
+ * @brief Benchmark de handshakes TLS completos e retomados no alvo de rede nativo.
+ *
+ * Faz o papel do Núcleo 0: lança o Núcleo 1 (Wi-Fi emulado sobre TAP), espera o
+ * IP e conecta ao broker TLS `2 x repeticoes` vezes pelo caminho do firmware
+ * (iniciar_cliente_mqtt, core1/transporte_tls.h). Na primeira metade a sessão
+ * guardada é descartada antes de cada conexão (handshake completo); na segunda
+ * ela é oferecida (retomada). Para cada conexão são medidos o tempo até o
+ * CONNACK e o pico do heap estático do mbedTLS.
+ *
+ * O tempo de CPU do handshake no host é ordens de grandeza menor que no M0+;
+ * o que se compara aqui é a proporção entre os dois tipos e o pico de RAM, que
+ * independe do processador. Os tempos do Pico saem nas métricas tf/tk.
+ *
+ * Uso: MQTTPicoRF_tls [repeticoes]
+ * Saída final: uma linha "RESULTADO chave=valor ..." para tools/bench_tls.sh.
+ */
+
+#include "config/config_geral.h"
+#include "core0/main_core0_utils.h"
+#include "core1/main_core1.h"
+#include "core1/mqtt_client_core1.h"
+#include "core1/transporte_tls.h"
+#include "core1/failover_broker.h"
+#include "shared/estado_compartilhado.h"
+#include "pico/multicore.h"
+#include "mbedtls/ssl.h" // Para MBEDTLS_SSL_*_CONTENT_LEN
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_REPETICOES 1000
+
+typedef struct {
+    uint32_t duracao_us[MAX_REPETICOES];
+    uint32_t pico_heap_max;
+    uint32_t n;
+    uint32_t recusadas;     // Só na fase de retomada: o broker exigiu o handshake completo
+} FaseBench;
+
+/**
+ * @brief Drena a FIFO do núcleo 0 (só o IP interessa aqui).
+ */
+static void *drenar_fifo(void *arg) {
+    (void)arg;
+    host_nucleo_atual = 0;
+    while (true) {
+        uint32_t pacote = multicore_fifo_pop_blocking();
+        if ((pacote >> 16) == FIFO_TIPO_IP_ADDRESS) ultimo_ip_bin = multicore_fifo_pop_blocking();
+    }
+    return NULL;
+}
+
+static int comparar_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentil(const uint32_t *ordenado, uint32_t n, unsigned p) {
+    if (n == 0) return 0;
+    uint32_t i = (uint32_t)(((uint64_t)n * p + 99) / 100);
+    return ordenado[i == 0 ? 0 : i - 1];
+}
+
+/**
+ * @brief Conecta e espera o CONNACK.
+ * @return false se o broker não aceitou a conexão em BROKER_TIMEOUT_CONEXAO_MS.
+ */
+static bool conectar(ConexaoTls *resultado) {
+    iniciar_cliente_mqtt();
+    absolute_time_t limite = make_timeout_time_ms(BROKER_TIMEOUT_CONEXAO_MS);
+    while (!mqtt_cliente_conectado()) {
+        if (time_reached(limite)) return false;
+        sleep_ms(1);
+    }
+    transporte_tls_ultima_conexao(resultado);
+    return true;
+}
+
+static void executar_fase(FaseBench *fase, uint32_t repeticoes, bool retomar) {
+    for (uint32_t i = 0; i < repeticoes; i++) {
+        if (!retomar) transporte_tls_esquecer(failover_broker_atual());
+        ConexaoTls r;
+        if (!conectar(&r)) {
+            printf("[TLS] Conexão %u sem CONNACK\n", i);
+            encerrar_conexao_mqtt();
+            continue;
+        }
+        if (retomar && !r.retomada) fase->recusadas++;
+        fase->duracao_us[fase->n++] = r.duracao_us;
+        if (r.pico_heap > fase->pico_heap_max) fase->pico_heap_max = r.pico_heap;
+        encerrar_conexao_mqtt();
+        sleep_ms(50); // Deixa o close_notify e o FIN saírem antes da próxima conexão
+    }
+    qsort(fase->duracao_us, fase->n, sizeof(uint32_t), comparar_u32);
+}
+
+static void imprimir_fase(const char *nome, const FaseBench *fase) {
+    printf(" %s=%u %s_p50_us=%u %s_p90_us=%u %s_max_us=%u %s_heap_max=%u",
+           nome, fase->n, nome, percentil(fase->duracao_us, fase->n, 50),
+           nome, percentil(fase->duracao_us, fase->n, 90),
+           nome, fase->n ? fase->duracao_us[fase->n - 1] : 0, nome, fase->pico_heap_max);
+}
+
+int main(int argc, char **argv) {
+    uint32_t repeticoes = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 20;
+    if (repeticoes == 0 || repeticoes > MAX_REPETICOES) return 2;
+
+    static FaseBench completos, retomados;
+
+    pthread_t t;
+    pthread_create(&t, NULL, drenar_fifo, NULL);
+    multicore_launch_core1(main_core1_entry);
+
+    printf("[TLS] Aguardando IP...\n");
+    while (ultimo_ip_bin == 0) sleep_ms(10);
+
+    // Primeira conexão fora da medida: cria a configuração e aquece o ARP
+    ConexaoTls r;
+    if (!conectar(&r)) {
+        printf("RESULTADO erro=sem_conexao_broker\n");
+        return 1;
+    }
+    encerrar_conexao_mqtt();
+    sleep_ms(50);
+
+    printf("[TLS] %u handshakes completos e %u retomados com %s:%u\n", repeticoes, repeticoes,
+           failover_broker_ip(failover_broker_atual()), failover_broker_porta(failover_broker_atual()));
+    executar_fase(&completos, repeticoes, false);
+    // A última conexão completa deixou a sessão guardada
+    executar_fase(&retomados, repeticoes, true);
+
+    printf("RESULTADO");
+    imprimir_fase("completo", &completos);
+    imprimir_fase("retomado", &retomados);
+    printf(" retomada_recusada=%u heap_tls=%u in_len=%d out_len=%d\n",
+           retomados.recusadas, (unsigned)TLS_HEAP_BYTES, MBEDTLS_SSL_IN_CONTENT_LEN, MBEDTLS_SSL_OUT_CONTENT_LEN);
+    return 0;
+}
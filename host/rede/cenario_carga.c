@@ -0,0 +1,230 @@
+/**
+ * @file cenario_carga.c
+ * @brief Executor de cenários de carga MQTT no alvo de rede nativo.
+ *
+ * Faz o papel do Núcleo 0: lança o Núcleo 1 (Wi-Fi emulado sobre TAP), espera o
+ * IP, inicia o cliente MQTT e publica a uma taxa fixa pelo mesmo caminho do
+ * firmware (publicar_mensagem_mqtt). Uma thread marcada como núcleo 0 drena a
+ * FIFO e casa cada ACK com o instante de envio (ACKs de QoS 0 chegam em ordem).
+ * Quando a conexão cai, loop_mqtt reconecta (ou troca de broker, ver
+ * core1/failover_broker.h) e o tempo até o primeiro ACK bem-sucedido é medido
+ * (tempo de recuperação).
+ *
+ * Uso: MQTTPicoRF_cenario <taxa_msgs_s> <duracao_s> [bytes_payload]
+ * Saída final: uma linha "RESULTADO chave=valor ..." para os scripts de regressão,
+ * com os parâmetros do perfil lwIP compilado e, com LWIP_MEDIR_POOLS, o pico de
+ * uso do heap e dos pools.
+ */
+
+#include "config/config_geral.h"
+#include "core0/main_core0_utils.h"
+#include "core1/main_core1.h"
+#include "core1/mqtt_client_core1.h"
+#include "shared/estado_compartilhado.h"
+#include "pico/multicore.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PENDENTES 256        // Publicações aguardando ACK
+#define MAX_AMOSTRAS 1000000     // Latências guardadas para os percentis
+
+static pthread_mutex_t mutex_medidas = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t envios_pendentes[MAX_PENDENTES];
+static unsigned pendentes_inicio = 0, pendentes_total = 0;
+
+static uint32_t *latencias_us;
+static uint32_t num_latencias = 0;
+static uint32_t acks_ok = 0, acks_falha = 0;
+
+// Quedas de conexão: início da queda atual e pior tempo de recuperação
+static uint64_t inicio_queda_us = 0;
+static uint32_t quedas = 0;
+static uint64_t recuperacao_max_us = 0, recuperacao_soma_us = 0;
+static uint32_t recuperacoes = 0;
+
+static void registrar_envio(uint64_t agora) {
+    pthread_mutex_lock(&mutex_medidas);
+    if (pendentes_total < MAX_PENDENTES) {
+        envios_pendentes[(pendentes_inicio + pendentes_total) % MAX_PENDENTES] = agora;
+        pendentes_total++;
+    }
+    pthread_mutex_unlock(&mutex_medidas);
+}
+
+static void registrar_queda(uint64_t agora) {
+    pthread_mutex_lock(&mutex_medidas);
+    if (inicio_queda_us == 0) {
+        inicio_queda_us = agora;
+        quedas++;
+        // Requisições em voo foram descartadas pelo lwIP junto com a conexão
+        pendentes_total = 0;
+        printf("[CENARIO] Conexão perdida em t=%.3f s\n", agora / 1e6);
+    }
+    pthread_mutex_unlock(&mutex_medidas);
+}
+
+static void registrar_ack(bool sucesso, uint64_t agora) {
+    pthread_mutex_lock(&mutex_medidas);
+    if (pendentes_total > 0) {
+        uint64_t envio = envios_pendentes[pendentes_inicio];
+        pendentes_inicio = (pendentes_inicio + 1) % MAX_PENDENTES;
+        pendentes_total--;
+        if (sucesso && num_latencias < MAX_AMOSTRAS) latencias_us[num_latencias++] = (uint32_t)(agora - envio);
+    }
+    if (sucesso) {
+        acks_ok++;
+        if (inicio_queda_us != 0) {
+            uint64_t recuperacao = agora - inicio_queda_us;
+            recuperacao_soma_us += recuperacao;
+            if (recuperacao > recuperacao_max_us) recuperacao_max_us = recuperacao;
+            recuperacoes++;
+            inicio_queda_us = 0;
+            printf("[CENARIO] Recuperado em %.1f ms\n", recuperacao / 1000.0);
+        }
+    } else {
+        acks_falha++;
+    }
+    pthread_mutex_unlock(&mutex_medidas);
+}
+
+/**
+ * @brief Drena a FIFO do núcleo 0 (IP, status Wi-Fi e ACKs de publicação).
+ */
+static void *drenar_fifo(void *arg) {
+    (void)arg;
+    host_nucleo_atual = 0;
+    while (true) {
+        uint32_t pacote = multicore_fifo_pop_blocking();
+        uint16_t tipo = pacote >> 16;
+        if (tipo == FIFO_TIPO_IP_ADDRESS) {
+            ultimo_ip_bin = multicore_fifo_pop_blocking();
+        } else if (tipo == FIFO_TIPO_MQTT_PUB_ACK) {
+            registrar_ack((pacote & 0xFFFF) == 0, time_us_64());
+        }
+    }
+    return NULL;
+}
+
+static int comparar_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentil(const uint32_t *ordenado, uint32_t n, unsigned p) {
+    if (n == 0) return 0;
+    uint32_t i = (uint32_t)(((uint64_t)n * p + 99) / 100);
+    return ordenado[i == 0 ? 0 : i - 1];
+}
+
+/**
+ * @brief Imprime o perfil lwIP compilado e o pico de uso de heap e pools (sem quebra de linha).
+ */
+static void imprimir_uso_lwip(void) {
+    printf(" perfil=%d mem_size=%d pbuf_pool=%d tcp_wnd=%d tcp_snd_buf=%d mqtt_ringbuf=%d mqtt_em_voo=%d",
+           LWIP_PERFIL, MEM_SIZE, PBUF_POOL_SIZE, TCP_WND, TCP_SND_BUF,
+           MQTT_OUTPUT_RINGBUF_SIZE, MQTT_REQ_MAX_IN_FLIGHT);
+#if MEM_STATS && MEMP_STATS
+    cyw43_arch_lwip_begin();
+    printf(" mem_max=%u mem_err=%u pbuf_pool_max=%u pbuf_pool_err=%u tcp_seg_max=%u tcp_seg_err=%u",
+           (unsigned)lwip_stats.mem.max, (unsigned)lwip_stats.mem.err,
+           (unsigned)lwip_stats.memp[MEMP_PBUF_POOL]->max, (unsigned)lwip_stats.memp[MEMP_PBUF_POOL]->err,
+           (unsigned)lwip_stats.memp[MEMP_TCP_SEG]->max, (unsigned)lwip_stats.memp[MEMP_TCP_SEG]->err);
+    cyw43_arch_lwip_end();
+#endif
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Uso: %s <taxa_msgs_s> <duracao_s> [bytes_payload]\n", argv[0]);
+        return 2;
+    }
+    uint32_t taxa = (uint32_t)strtoul(argv[1], NULL, 10);
+    uint32_t duracao_s = (uint32_t)strtoul(argv[2], NULL, 10);
+    size_t tamanho = argc > 3 ? strtoul(argv[3], NULL, 10) : 32;
+    if (taxa == 0 || tamanho < 16) return 2;
+
+    latencias_us = malloc(sizeof(uint32_t) * MAX_AMOSTRAS);
+    char *payload = malloc(tamanho + 1);
+    if (!latencias_us || !payload) return 1;
+    memset(payload, 'x', tamanho);
+    payload[tamanho] = '\0';
+
+    pthread_t t;
+    pthread_create(&t, NULL, drenar_fifo, NULL);
+    multicore_launch_core1(main_core1_entry);
+
+    printf("[CENARIO] Aguardando IP...\n");
+    while (ultimo_ip_bin == 0) sleep_ms(10);
+
+    iniciar_cliente_mqtt();
+    absolute_time_t limite_conexao = make_timeout_time_ms(10000);
+    while (!mqtt_cliente_conectado()) {
+        if (time_reached(limite_conexao)) {
+            printf("RESULTADO erro=sem_conexao_broker");
+            imprimir_uso_lwip();
+            printf("\n");
+            return 1;
+        }
+        loop_mqtt(); // Com o primeiro broker fora, já troca para o reserva
+        sleep_ms(10);
+    }
+
+    printf("[CENARIO] Publicando %u msgs/s de %zu bytes por %u s\n", taxa, tamanho, duracao_s);
+    uint64_t periodo_us = 1000000u / taxa;
+    uint64_t inicio = time_us_64();
+    uint64_t fim = inicio + (uint64_t)duracao_s * 1000000u;
+    uint64_t proximo_envio = inicio;
+    uint32_t enviadas = 0, recusadas = 0;
+
+    while (time_us_64() < fim) {
+        uint64_t agora = time_us_64();
+        if (agora < proximo_envio) {
+            sleep_us(proximo_envio - agora > 200 ? 200 : proximo_envio - agora);
+            continue;
+        }
+        proximo_envio += periodo_us;
+
+        loop_mqtt(); // Reconexão e failover, como no loop do Núcleo 0
+        if (!mqtt_cliente_conectado()) {
+            registrar_queda(agora);
+            continue;
+        }
+
+        // Número de sequência no início do payload, para inspeção no broker
+        int n = snprintf(payload, tamanho + 1, "%010u", enviadas);
+        payload[n] = 'x';
+
+        registrar_envio(agora);
+        if (publicar_mensagem_mqtt(payload)) {
+            enviadas++;
+        } else {
+            // Não enfileirada: desfaz o registro (a última entrada é a desta tentativa)
+            pthread_mutex_lock(&mutex_medidas);
+            if (pendentes_total > 0) pendentes_total--;
+            pthread_mutex_unlock(&mutex_medidas);
+            recusadas++;
+        }
+    }
+
+    sleep_ms(1000); // Aguarda os últimos ACKs
+
+    pthread_mutex_lock(&mutex_medidas);
+    double segundos = (fim - inicio) / 1e6;
+    qsort(latencias_us, num_latencias, sizeof(uint32_t), comparar_u32);
+    printf("RESULTADO taxa_alvo=%u enviadas=%u recusadas=%u acks=%u falhas=%u msgs_s=%.1f "
+           "lat_p50_us=%u lat_p90_us=%u lat_p99_us=%u lat_max_us=%u "
+           "quedas=%u recuperacoes=%u recuperacao_media_ms=%.1f recuperacao_max_ms=%.1f",
+           taxa, enviadas, recusadas, acks_ok, acks_falha, acks_ok / segundos,
+           percentil(latencias_us, num_latencias, 50), percentil(latencias_us, num_latencias, 90),
+           percentil(latencias_us, num_latencias, 99), num_latencias ? latencias_us[num_latencias - 1] : 0,
+           quedas, recuperacoes, recuperacoes ? recuperacao_soma_us / 1000.0 / recuperacoes : 0.0,
+           recuperacao_max_us / 1000.0);
+    pthread_mutex_unlock(&mutex_medidas);
+    imprimir_uso_lwip();
+    printf("\n");
+    return 0;
+}
\ No newline at end of file
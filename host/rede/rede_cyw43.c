@@ -0,0 +1,152 @@
+/**
+ * @file rede_cyw43.c
+ * @brief CYW43 emulado sobre uma interface TAP com a pilha lwIP real (NO_SYS).
+ *
+ * cyw43_arch_init() inicializa o lwIP e cria uma thread, marcada como núcleo 1,
+ * que faz o papel do contexto em background do SDK: lê a TAP e processa os
+ * timeouts do lwIP segurando a trava de cyw43_arch_lwip_begin/end.
+ *
+ * Variáveis de ambiente reconhecidas:
+ * - PRECONFIGURED_TAPIF: nome da interface TAP já configurada (lida pelo tapif.c).
+ * - HOST_IP / HOST_MASCARA / HOST_GW: endereço estático; sem HOST_IP usa DHCP.
+ * - HOST_PERDA_PCT: porcentagem de quadros descartados em cada sentido.
+ */
+
+#include "pico/cyw43_arch.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "lwip/init.h"
+#include "lwip/netif.h"
+#include "lwip/dhcp.h"
+#include "lwip/timeouts.h"
+#include "netif/ethernet.h"
+#include "netif/tapif.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+cyw43_t cyw43_state;
+
+static pthread_mutex_t mutex_lwip;
+static bool contexto_iniciado = false;
+static unsigned perda_pct = 0;
+static netif_linkoutput_fn linkoutput_original;
+
+// Descarte aleatório de quadros para simular enlace ruim
+static bool descartar_quadro(void) {
+    return perda_pct > 0 && (unsigned)(rand() % 100) < perda_pct;
+}
+
+static err_t linkoutput_com_perda(struct netif *netif, struct pbuf *p) {
+    if (descartar_quadro()) return ERR_OK; // "Enviado", mas perdido no ar
+    return linkoutput_original(netif, p);
+}
+
+static err_t input_com_perda(struct pbuf *p, struct netif *netif) {
+    if (descartar_quadro()) {
+        pbuf_free(p);
+        return ERR_OK;
+    }
+    return ethernet_input(p, netif);
+}
+
+static void *contexto_lwip(void *arg) {
+    struct netif *netif = arg;
+    host_nucleo_atual = 1;
+    while (true) {
+        cyw43_arch_lwip_begin();
+        tapif_select(netif);
+        sys_check_timeouts();
+        cyw43_arch_lwip_end();
+        sleep_us(200);
+    }
+    return NULL;
+}
+
+int cyw43_arch_init(void) {
+    if (contexto_iniciado) return 0;
+
+    pthread_mutexattr_t atributos;
+    pthread_mutexattr_init(&atributos);
+    pthread_mutexattr_settype(&atributos, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&mutex_lwip, &atributos);
+
+    const char *perda = getenv("HOST_PERDA_PCT");
+    if (perda) perda_pct = (unsigned)atoi(perda);
+
+    lwip_init();
+
+    ip4_addr_t ip = {0}, mascara = {0}, gw = {0};
+    const char *ip_env = getenv("HOST_IP");
+    if (ip_env) {
+        const char *mascara_env = getenv("HOST_MASCARA");
+        const char *gw_env = getenv("HOST_GW");
+        ip4addr_aton(ip_env, &ip);
+        ip4addr_aton(mascara_env ? mascara_env : "255.255.255.0", &mascara);
+        if (gw_env) ip4addr_aton(gw_env, &gw);
+    }
+
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+    if (!netif_add(netif, &ip, &mascara, &gw, NULL, tapif_init, input_com_perda)) {
+        printf("[HOST] Falha ao abrir a interface TAP.\n");
+        return -1;
+    }
+    linkoutput_original = netif->linkoutput;
+    netif->linkoutput = linkoutput_com_perda;
+    netif_set_default(netif);
+
+    pthread_t t;
+    pthread_create(&t, NULL, contexto_lwip, netif);
+    pthread_detach(t);
+    contexto_iniciado = true;
+    printf("[HOST] lwIP sobre TAP iniciado (perda simulada: %u%%).\n", perda_pct);
+    return 0;
+}
+
+void cyw43_arch_deinit(void) {}
+
+void cyw43_arch_enable_sta_mode(void) {}
+
+int cyw43_arch_wifi_connect_timeout_ms(const char *ssid, const char *pw, uint32_t auth, uint32_t timeout_ms) {
+    (void)ssid;
+    (void)pw;
+    (void)auth;
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+
+    cyw43_arch_lwip_begin();
+    netif_set_link_up(netif);
+    netif_set_up(netif);
+    if (ip4_addr_isany_val(*netif_ip4_addr(netif))) dhcp_start(netif);
+    cyw43_arch_lwip_end();
+
+    // Aguarda o endereço (estático: imediato; DHCP: até o timeout)
+    absolute_time_t limite = make_timeout_time_ms(timeout_ms);
+    while (cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA) != CYW43_LINK_UP) {
+        if (time_reached(limite)) return -1;
+        sleep_ms(10);
+    }
+    return 0;
+}
+
+int cyw43_tcpip_link_status(cyw43_t *self, int itf) {
+    struct netif *netif = &self->netif[itf];
+    if (!netif_is_link_up(netif)) return CYW43_LINK_DOWN;
+    if (ip4_addr_isany_val(*netif_ip4_addr(netif))) return CYW43_LINK_NOIP;
+    return CYW43_LINK_UP;
+}
+
+int cyw43_wifi_pm(cyw43_t *self, uint32_t pm) {
+    (void)self;
+    (void)pm; // Na TAP não há rádio: o modo só altera o modelo de core1/energia_radio.c
+    return 0;
+}
+
+void cyw43_arch_lwip_begin(void) {
+    if (contexto_iniciado) pthread_mutex_lock(&mutex_lwip);
+}
+
+void cyw43_arch_lwip_end(void) {
+    if (contexto_iniciado) pthread_mutex_unlock(&mutex_lwip);
+}
+
+void cyw43_arch_poll(void) {}
@@ -0,0 +1,18 @@
+/**
+ * @file rede_entropia.c
+ * @brief Fonte de entropia do mbedTLS no alvo de rede nativo.
+ *
+ * config/mbedtls_config.h usa MBEDTLS_ENTROPY_HARDWARE_ALT, que no firmware é
+ * atendida pelo pico_mbedtls (ROSC); aqui os bytes vêm do kernel.
+ */
+
+#include <stddef.h>
+#include <sys/random.h>
+
+int mbedtls_hardware_poll(void *dados, unsigned char *saida, size_t tamanho, size_t *gerados) {
+    (void)dados;
+    ssize_t n = getrandom(saida, tamanho, 0);
+    if (n < 0) return -1;
+    *gerados = (size_t)n;
+    return 0;
+}
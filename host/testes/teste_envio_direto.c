@@ -0,0 +1,225 @@
+/**
+ * @file teste_envio_direto.c
+ * @brief Testes do fechamento da conexão com publicações diretas em voo
+ * (core1/mqtt_envio_direto.c) no cliente MQTT emulado: o payload só é devolvido
+ * quando o PCB fechado o confirma ou é liberado, nada é abortado dentro do
+ * tcp_input (FIN do broker) nem depois de o tcp_close liberar o PCB (RST), a
+ * próxima conexão aborta o PCB que ainda o segura, e uma escrita pela metade
+ * derruba a conexão avisando pelo callback de conexão.
+ *
+ * Roda no núcleo 1, que com REDE_POLL é o único a tocar no lwIP.
+ */
+
+#include "core1/mqtt_envio_direto.h"
+#include "host_mocks.h"
+#include "lwip/apps/mqtt_priv.h"
+#include "pico/cyw43_arch.h"
+#include "pico/multicore.h"
+#include "pico/time.h"
+#include "verificacao.h"
+#include <stdlib.h>
+
+static mqtt_client_t *cliente;
+static uint32_t aceitas = 0, perdidas = 0;
+static uint32_t concluidas_ok = 0, concluidas_abrt = 0;
+static uint8_t payload[64];
+static volatile bool terminado = false;
+
+static void conexao_cb(mqtt_client_t *c, void *arg, mqtt_connection_status_t status) {
+    (void)arg;
+    if (status == MQTT_CONNECT_ACCEPTED) {
+        aceitas++;
+        envio_direto_conectado(c);
+    } else {
+        perdidas++;
+        envio_direto_desconectado();
+    }
+}
+
+static void concluido(void *arg, err_t result) {
+    (void)arg;
+    if (result == ERR_OK) concluidas_ok++;
+    else if (result == ERR_ABRT) concluidas_abrt++;
+}
+
+/**
+ * @brief Processa o lwIP por `ms` milissegundos (com REDE_POLL, é este laço que o roda).
+ */
+static void processar(uint32_t ms) {
+    absolute_time_t fim = make_timeout_time_ms(ms);
+    while (absolute_time_diff_us(get_absolute_time(), fim) > 0) {
+        cyw43_arch_poll();
+        sleep_ms(1);
+    }
+}
+
+static bool conectar(void) {
+    static const ip_addr_t ip = {0};
+    static const struct mqtt_connect_client_info_t info = {.client_id = "teste", .keep_alive = 0};
+    uint32_t antes = aceitas;
+    cyw43_arch_lwip_begin();
+    mqtt_client_connect(cliente, &ip, 1883, conexao_cb, NULL, &info);
+    cyw43_arch_lwip_end();
+    for (int i = 0; i < 100 && aceitas == antes; i++) processar(5);
+    return aceitas > antes;
+}
+
+static err_t publicar(void) {
+    cyw43_arch_lwip_begin();
+    err_t err = envio_direto_publicar(cliente, "teste/direto", false, payload, sizeof(payload), concluido, NULL);
+    cyw43_arch_lwip_end();
+    return err;
+}
+
+static struct tcp_pcb *pcb_atual(void) {
+    return (struct tcp_pcb *)cliente->conn->state;
+}
+
+/**
+ * @brief Fecha como desconectar_cliente, com a segunda chamada que o callback de conexão também faria.
+ */
+static void desconectar(void) {
+    cyw43_arch_lwip_begin();
+    mqtt_disconnect(cliente);
+    envio_direto_desconectado();
+    envio_direto_desconectado();
+    cyw43_arch_lwip_end();
+}
+
+static void teste_confirmacao(void) {
+    setenv("HOST_LATENCIA_ACK_US", "1000", 1);
+    VERIFICAR(conectar());
+    VERIFICAR_IGUAL(publicar(), ERR_OK);
+    processar(50);
+    VERIFICAR_IGUAL(concluidas_ok, 1);
+
+    // Sem nada em voo, o fechamento gracioso não precisa abortar o PCB
+    struct tcp_pcb *pcb = pcb_atual();
+    desconectar();
+    VERIFICAR(!pcb->abortada);
+    VERIFICAR_IGUAL(concluidas_abrt, 0);
+    processar(10);
+    VERIFICAR(pcb->liberado); // FIN confirmado
+}
+
+static void teste_fechamento_com_payload_em_voo(void) {
+    setenv("HOST_LATENCIA_ACK_US", "1000", 1);
+    VERIFICAR(conectar());
+    setenv("HOST_LATENCIA_ACK_US", "50000", 1);
+    VERIFICAR_IGUAL(publicar(), ERR_OK);
+
+    // mqtt_disconnect fecha com graça: o PCB segue vivo com o payload por confirmar
+    struct tcp_pcb *pcb = pcb_atual();
+    uint32_t ok_antes = concluidas_ok;
+    desconectar();
+    VERIFICAR(!pcb->abortada);
+    VERIFICAR(!pcb->liberado);
+    VERIFICAR_IGUAL(concluidas_ok, ok_antes);
+    VERIFICAR_IGUAL(concluidas_abrt, 0);
+
+    // Só a confirmação do TCP devolve o payload, e depois o FIN libera o PCB
+    processar(100);
+    VERIFICAR_IGUAL(concluidas_ok, ok_antes + 1);
+    VERIFICAR_IGUAL(concluidas_abrt, 0);
+    VERIFICAR(pcb->liberado);
+    VERIFICAR(!pcb->abortada);
+}
+
+static void teste_fin_do_broker(void) {
+    setenv("HOST_LATENCIA_ACK_US", "1000", 1);
+    VERIFICAR(conectar());
+    setenv("HOST_LATENCIA_ACK_US", "20000", 1);
+    VERIFICAR_IGUAL(publicar(), ERR_OK);
+
+    // O fechamento roda dentro do tcp_input: liberar o PCB ali encerraria o processo
+    struct tcp_pcb *pcb = pcb_atual();
+    uint32_t ok_antes = concluidas_ok, perdidas_antes = perdidas;
+    cyw43_arch_lwip_begin();
+    host_mqtt_broker_fechar(cliente);
+    cyw43_arch_lwip_end();
+    VERIFICAR_IGUAL(perdidas, perdidas_antes + 1);
+    VERIFICAR(!pcb->abortada);
+    processar(60);
+    VERIFICAR_IGUAL(concluidas_ok, ok_antes + 1);
+    VERIFICAR_IGUAL(concluidas_abrt, 0);
+}
+
+static void teste_rst_no_fechamento(void) {
+    setenv("HOST_LATENCIA_ACK_US", "1000", 1);
+    VERIFICAR(conectar());
+    setenv("HOST_LATENCIA_ACK_US", "20000", 1);
+    VERIFICAR_IGUAL(publicar(), ERR_OK);
+
+    // Com dados não lidos o tcp_close libera o PCB na hora, com os segmentos: o
+    // payload está livre, e nenhuma das duas chamadas pode tocar no PCB
+    struct tcp_pcb *pcb = pcb_atual();
+    pcb->dados_nao_lidos = true;
+    uint32_t abrt_antes = concluidas_abrt;
+    desconectar();
+    VERIFICAR(pcb->liberado);
+    VERIFICAR(!pcb->abortada);
+    VERIFICAR_IGUAL(concluidas_abrt, abrt_antes + 1);
+    processar(40);
+    VERIFICAR_IGUAL(concluidas_abrt, abrt_antes + 1);
+}
+
+static void teste_reconexao_aborta_fechado(void) {
+    setenv("HOST_LATENCIA_ACK_US", "1000", 1);
+    VERIFICAR(conectar());
+    setenv("HOST_LATENCIA_ACK_US", "1000000", 1);
+    VERIFICAR_IGUAL(publicar(), ERR_OK);
+    struct tcp_pcb *fechado = pcb_atual();
+    desconectar();
+
+    // Nova conexão com o PCB anterior ainda segurando o payload: o envio direto espera
+    setenv("HOST_LATENCIA_ACK_US", "1000", 1);
+    VERIFICAR(conectar());
+    VERIFICAR_IGUAL(publicar(), ERR_INPROGRESS);
+
+    // Fora dos callbacks, como em conectar_broker_atual, o PCB anterior é abortado
+    uint32_t abrt_antes = concluidas_abrt, ok_antes = concluidas_ok;
+    cyw43_arch_lwip_begin();
+    envio_direto_abortar_fechado();
+    envio_direto_abortar_fechado();
+    cyw43_arch_lwip_end();
+    VERIFICAR(fechado->abortada);
+    VERIFICAR_IGUAL(concluidas_abrt, abrt_antes + 1);
+    VERIFICAR_IGUAL(publicar(), ERR_OK);
+    processar(20);
+    VERIFICAR_IGUAL(concluidas_ok, ok_antes + 1);
+    desconectar();
+    processar(10);
+}
+
+static void teste_escrita_pela_metade(void) {
+    setenv("HOST_LATENCIA_ACK_US", "1000", 1);
+    VERIFICAR(conectar());
+    uint32_t perdidas_antes = perdidas;
+
+    // Só cabe mais um trecho: o cabeçalho entra, o payload não
+    struct tcp_pcb *pcb = pcb_atual();
+    pcb->num_trechos = sizeof(pcb->trechos) / sizeof(pcb->trechos[0]) - 1;
+    VERIFICAR_IGUAL(publicar(), ERR_ABRT);
+    VERIFICAR(pcb->abortada);
+    VERIFICAR_IGUAL(perdidas, perdidas_antes + 1); // A queda chega pelo callback de conexão
+    VERIFICAR(!mqtt_client_is_connected(cliente));
+    VERIFICAR_IGUAL(publicar(), ERR_CONN);
+}
+
+static void executar_no_nucleo1(void) {
+    cyw43_arch_init();
+    cliente = mqtt_client_new();
+    teste_confirmacao();
+    teste_fechamento_com_payload_em_voo();
+    teste_fin_do_broker();
+    teste_rst_no_fechamento();
+    teste_reconexao_aborta_fechado();
+    teste_escrita_pela_metade();
+    terminado = true;
+}
+
+int main(void) {
+    multicore_launch_core1(executar_no_nucleo1);
+    while (!terminado) sleep_ms(1);
+    return verificacao_resultado("teste_envio_direto");
+}
@@ -0,0 +1,146 @@
+/**
+ * @file teste_estatistica_fluxo.c
+ * @brief Testes das estatísticas de fluxo (shared/estatistica_fluxo.c) contra uma
+ * referência em ponto flutuante de dupla precisão: contagem, mínimo, máximo,
+ * média, variância, desvio e quantis, e a troca de janela (estatistica_resumir
+ * com reinício).
+ */
+
+#include "shared/estatistica_fluxo.h"
+#include "verificacao.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define MAX_VALORES 4096
+
+static EstatisticaFluxo e;
+static int32_t valores[MAX_VALORES];
+
+static uint32_t semente = 1;
+
+static uint32_t aleatorio(void) {
+    semente = semente * 1664525u + 1013904223u;
+    return semente;
+}
+
+static int comparar_i32(const void *a, const void *b) {
+    int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Alimenta `n` valores já em `valores` e confere o resumo com a referência.
+ */
+static void conferir(uint32_t n, const char *caso) {
+    estatistica_reiniciar(&e);
+    for (uint32_t i = 0; i < n; i++) estatistica_adicionar(&e, valores[i]);
+    int64_t largura = (int64_t)1 << e.log2_largura; // Erro máximo de um quantil
+    ResumoEstatistica r;
+    estatistica_resumir(&e, &r, false);
+
+    double soma = 0;
+    for (uint32_t i = 0; i < n; i++) soma += valores[i];
+    double media = soma / n, dispersao = 0;
+    for (uint32_t i = 0; i < n; i++) dispersao += (valores[i] - media) * (valores[i] - media);
+    double variancia = n > 1 ? dispersao / (n - 1) : 0;
+    qsort(valores, n, sizeof(valores[0]), comparar_i32);
+
+    fprintf(stderr, "%s: n=%u largura=%lld\n", caso, n, (long long)largura);
+    VERIFICAR_IGUAL(r.n, n);
+    VERIFICAR_IGUAL(r.minimo, valores[0]);
+    VERIFICAR_IGUAL(r.maximo, valores[n - 1]);
+    // Q8 truncado: erro abaixo de 1/256 na média, e de poucos 1/256 na variância e no desvio
+    VERIFICAR(fabs(r.media_q8 / 256.0 - media) <= 1.0 / 256);
+    VERIFICAR(fabs(r.variancia_q8 / 256.0 - variancia) <= 3.0 / 256 + variancia * 1e-9);
+    VERIFICAR(fabs(r.desvio_q8 / 256.0 - sqrt(variancia)) <= 2.0 / 256 + sqrt(variancia) * 1e-6);
+
+    const uint32_t permil[3] = {500, 900, 990};
+    const int32_t aproximados[3] = {r.p50, r.p90, r.p99};
+    for (int q = 0; q < 3; q++) {
+        uint32_t posicao = (uint32_t)(((uint64_t)n * permil[q] + 999) / 1000);
+        int32_t exato = valores[(posicao ? posicao : 1) - 1];
+        VERIFICAR(aproximados[q] >= r.minimo && aproximados[q] <= r.maximo);
+        VERIFICAR(llabs((long long)aproximados[q] - exato) < largura);
+    }
+}
+
+static void teste_vazia_e_unitaria(void) {
+    ResumoEstatistica r;
+    estatistica_reiniciar(&e);
+    estatistica_resumir(&e, &r, false);
+    VERIFICAR_IGUAL(r.n, 0);
+    VERIFICAR_IGUAL(r.media_q8, 0);
+    VERIFICAR_IGUAL(r.p50, 0);
+
+    estatistica_adicionar(&e, -1234);
+    estatistica_resumir(&e, &r, false);
+    VERIFICAR_IGUAL(r.n, 1);
+    VERIFICAR_IGUAL(r.minimo, -1234);
+    VERIFICAR_IGUAL(r.maximo, -1234);
+    VERIFICAR_IGUAL(r.media_q8, -1234 * 256);
+    VERIFICAR_IGUAL(r.variancia_q8, 0);
+    VERIFICAR_IGUAL(r.p50, -1234);
+    VERIFICAR_IGUAL(r.p99, -1234);
+}
+
+static void teste_distribuicoes(void) {
+    for (uint32_t i = 0; i < 1000; i++) valores[i] = 777;
+    conferir(1000, "constante");
+
+    for (uint32_t i = 0; i < 2; i++) valores[i] = (int32_t)i * 5;
+    conferir(2, "dois valores");
+
+    for (uint32_t i = 0; i < 31; i++) valores[i] = (int32_t)(aleatorio() >> 27); // Cabe nas faixas sem alargar
+    conferir(31, "alcance curto");
+
+    for (uint32_t i = 0; i < MAX_VALORES; i++) valores[i] = (int32_t)((aleatorio() >> 12) + (aleatorio() >> 22) * 64);
+    conferir(MAX_VALORES, "triangular (medias Q8 do ADC)");
+
+    for (uint32_t i = 0; i < MAX_VALORES; i++) valores[i] = (int32_t)(aleatorio() >> 8) - (1 << 23); // Desvios > 16 bits
+    conferir(MAX_VALORES, "uniforme com negativos");
+
+    // Crescente a partir do primeiro valor: o histograma alarga várias vezes para um só lado
+    for (uint32_t i = 0; i < 1000; i++) valores[i] = 100000 + (int32_t)(i * i);
+    conferir(1000, "crescente");
+
+    // Cauda longa: a maioria perto de zero, alguns muito longe (p99 fica na cauda)
+    for (uint32_t i = 0; i < 2000; i++) valores[i] = (i % 50 == 0) ? 5000000 + (int32_t)(aleatorio() >> 16) : (int32_t)(aleatorio() >> 26);
+    conferir(2000, "cauda longa");
+}
+
+static void teste_troca_de_janela(void) {
+    ResumoEstatistica r;
+    estatistica_reiniciar(&e);
+    // Janela 1: alcance largo, que alarga o histograma
+    for (int32_t i = 0; i < 500; i++) estatistica_adicionar(&e, i * 10000);
+    estatistica_resumir(&e, &r, true);
+    VERIFICAR_IGUAL(r.n, 500);
+    VERIFICAR_IGUAL(r.maximo, 499 * 10000);
+
+    // Reiniciada: nada da janela anterior (contagem, extremos, largura das faixas)
+    VERIFICAR_IGUAL(e.n, 0);
+    VERIFICAR_IGUAL(e.log2_largura, 0);
+    for (int32_t i = 0; i < 20; i++) estatistica_adicionar(&e, -50 + i);
+    estatistica_resumir(&e, &r, true);
+    VERIFICAR_IGUAL(r.n, 20);
+    VERIFICAR_IGUAL(r.minimo, -50);
+    VERIFICAR_IGUAL(r.maximo, -31);
+    VERIFICAR_IGUAL(r.media_q8, (int64_t)(-40.5 * 256));
+    VERIFICAR_IGUAL(r.p50, -41); // Alcance menor que as faixas: quantis exatos
+    VERIFICAR_IGUAL(r.p90, -33);
+
+    // Sem reinício, a janela continua acumulando
+    estatistica_adicionar(&e, 7);
+    estatistica_resumir(&e, &r, false);
+    estatistica_adicionar(&e, 9);
+    estatistica_resumir(&e, &r, false);
+    VERIFICAR_IGUAL(r.n, 2);
+    VERIFICAR_IGUAL(r.media_q8, 8 * 256);
+}
+
+int main(void) {
+    teste_vazia_e_unitaria();
+    teste_distribuicoes();
+    teste_troca_de_janela();
+    return verificacao_resultado("teste_estatistica_fluxo");
+}
@@ -0,0 +1,51 @@
+/**
+ * @file teste_fila_circular.c
+ * @brief Testes da fila inter-core (core0/fila_circular.c): ordem FIFO, limite
+ * de TAM_FILA, volta do índice circular e profundidade máxima.
+ */
+
+#include "core0/fila_circular.h"
+#include "verificacao.h"
+
+static FilaCircularInterCore fila;
+
+static void teste_vazia(void) {
+    fila_intercore_inicializar(&fila);
+    MensagemInterCore m;
+    VERIFICAR(fila_intercore_vazia(&fila));
+    VERIFICAR(!fila_intercore_remover(&fila, &m));
+}
+
+static void teste_ordem_e_limite(void) {
+    fila_intercore_inicializar(&fila);
+    for (uint16_t i = 0; i < TAM_FILA; i++) VERIFICAR(fila_intercore_inserir(&fila, (MensagemInterCore){i, (uint16_t)(i * 3)}));
+    VERIFICAR(!fila_intercore_inserir(&fila, (MensagemInterCore){99, 99})); // Cheia: recusa sem sobrescrever
+    VERIFICAR_IGUAL(fila.tamanho_max, TAM_FILA);
+    for (uint16_t i = 0; i < TAM_FILA; i++) {
+        MensagemInterCore m;
+        VERIFICAR(fila_intercore_remover(&fila, &m));
+        VERIFICAR_IGUAL(m.tentativa_ou_tipo, i);
+        VERIFICAR_IGUAL(m.status_ou_dado, i * 3);
+    }
+    VERIFICAR(fila_intercore_vazia(&fila));
+}
+
+static void teste_volta_circular(void) {
+    fila_intercore_inicializar(&fila);
+    uint16_t proximo_inserido = 0, proximo_removido = 0;
+    // Três voltas com a fila pela metade: os índices passam várias vezes pelo fim do vetor
+    for (int passo = 0; passo < 3 * TAM_FILA; passo++) {
+        while (fila.tamanho < TAM_FILA / 2) fila_intercore_inserir(&fila, (MensagemInterCore){proximo_inserido++, 0});
+        MensagemInterCore m;
+        VERIFICAR(fila_intercore_remover(&fila, &m));
+        VERIFICAR_IGUAL(m.tentativa_ou_tipo, proximo_removido++);
+    }
+    VERIFICAR_IGUAL(fila.tamanho_max, TAM_FILA / 2);
+}
+
+int main(void) {
+    teste_vazia();
+    teste_ordem_e_limite();
+    teste_volta_circular();
+    return verificacao_resultado("teste_fila_circular");
+}
@@ -0,0 +1,76 @@
+/**
+ * @file teste_intercore.c
+ * @brief Testes da decodificação das mensagens do núcleo 1 em
+ * util_tratar_mensagem_intercore e util_tratar_ip_recebido, conferidas pelo que
+ * chega à GDDRAM do OLED emulado.
+ */
+
+#include "core0/main_core0_utils.h"
+#include "drivers/oled_ssd1306/oled_driver.h"
+#include "drivers/oled_ssd1306/oled_interface.h"
+#include "drivers/rgb_led/rgb_led_animacao.h"
+#include "drivers/rgb_led/rgb_led_pwm.h"
+#include "shared/estado_compartilhado.h"
+#include "host_mocks.h"
+#include "verificacao.h"
+#include <string.h>
+
+/**
+ * @brief A página da GDDRAM que contém a linha `y` mostra exatamente `texto`.
+ */
+static bool pagina_mostra(int y, const char *texto) {
+    static uint8_t esperado[ssd1306_buffer_length];
+    memset(esperado, 0, sizeof(esperado));
+    ssd1306_draw_utf8_string(esperado, 0, (int16_t)y, texto);
+    int inicio = (y / 8) * SSD1306_WIDTH;
+    return memcmp(host_ssd1306_gddram() + inicio, esperado + inicio, SSD1306_WIDTH) == 0;
+}
+
+/**
+ * @brief Os primeiros glifos da página da linha `y` são os de `texto` (ASCII).
+ */
+static bool pagina_comeca_com(int y, const char *texto) {
+    static uint8_t esperado[ssd1306_buffer_length];
+    memset(esperado, 0, sizeof(esperado));
+    ssd1306_draw_string(esperado, 0, (int16_t)y, texto);
+    int inicio = (y / 8) * SSD1306_WIDTH;
+    return memcmp(host_ssd1306_gddram() + inicio, esperado + inicio, strlen(texto) * 8) == 0;
+}
+
+static void teste_status_wifi(void) {
+    ultimo_ip_bin = 0;
+    util_tratar_mensagem_intercore((MensagemInterCore){2, 3});
+    VERIFICAR(pagina_mostra(0, "WiFi: Conectando (T2)"));
+    util_tratar_mensagem_intercore((MensagemInterCore){1, 1}); // Conectado: sem o número da tentativa
+    VERIFICAR(pagina_mostra(0, "WiFi: Conectado"));
+    util_tratar_mensagem_intercore((MensagemInterCore){0, 2});
+    VERIFICAR(pagina_mostra(0, "WiFi: Falha"));
+    util_tratar_mensagem_intercore((MensagemInterCore){0, 7});
+    VERIFICAR(pagina_mostra(0, "WiFi: Desconhecido"));
+}
+
+static void teste_ip(void) {
+    util_tratar_ip_recebido(0x3200A8C0u); // 192.168.0.50 na ordem de rede
+    VERIFICAR_IGUAL(ultimo_ip_bin, 0x3200A8C0u);
+    VERIFICAR(pagina_comeca_com(16, "IP Broker: "));
+}
+
+static void teste_ack_publicacao(void) {
+    ultimo_ip_bin = 0x3200A8C0u;
+    util_tratar_mensagem_intercore((MensagemInterCore){FIFO_TIPO_MQTT_PUB_ACK, 0});
+    VERIFICAR(pagina_mostra(0, ""));               // O ACK não é um status de Wi-Fi
+    VERIFICAR(pagina_mostra(16, "192.168.0.50")); // O IP é redesenhado
+    VERIFICAR(pagina_mostra(32, "ACK lwIP: OK"));
+    util_tratar_mensagem_intercore((MensagemInterCore){FIFO_TIPO_MQTT_PUB_ACK, 1});
+    VERIFICAR(pagina_mostra(32, "ACK lwIP: FALHOU"));
+}
+
+int main(void) {
+    oled_setup_interface();
+    init_rgb_pwm();
+    anim_led_inicializar();
+    teste_status_wifi();
+    teste_ip();
+    teste_ack_publicacao();
+    return verificacao_resultado("teste_intercore");
+}
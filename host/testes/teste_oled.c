@@ -0,0 +1,115 @@
+/**
+ * @file teste_oled.c
+ * @brief Testes do rasterizador do SSD1306 (drivers/oled_ssd1306/oled_driver.c)
+ * e da captura pelo I2C emulado: layout por páginas, linhas, glifos, renderização
+ * para a GDDRAM e exportação em PBM.
+ */
+
+#include "drivers/oled_ssd1306/oled_driver.h"
+#include "drivers/oled_ssd1306/oled_interface.h"
+#include "shared/estado_compartilhado.h"
+#include "host_mocks.h"
+#include "verificacao.h"
+#include <stdlib.h>
+#include <string.h>
+
+static uint8_t quadro[ssd1306_buffer_length];
+
+static bool pixel(const uint8_t *buf, int x, int y) {
+    return buf[(y / 8) * SSD1306_WIDTH + x] & (1u << (y % 8));
+}
+
+static int pixels_acesos(const uint8_t *buf, int x0, int y0, int x1, int y1) {
+    int n = 0;
+    for (int y = y0; y < y1; y++)
+        for (int x = x0; x < x1; x++) n += pixel(buf, x, y);
+    return n;
+}
+
+static void teste_pixel(void) {
+    memset(quadro, 0, sizeof(quadro));
+    ssd1306_set_pixel(quadro, 5, 11, true);
+    VERIFICAR_IGUAL(quadro[SSD1306_WIDTH + 5], 1u << 3); // Página 1, bit 3
+    ssd1306_set_pixel(quadro, -1, 0, true); // Fora da tela: ignorado
+    ssd1306_set_pixel(quadro, SSD1306_WIDTH, SSD1306_HEIGHT, true);
+    VERIFICAR_IGUAL(pixels_acesos(quadro, 0, 0, SSD1306_WIDTH, SSD1306_HEIGHT), 1);
+    ssd1306_set_pixel(quadro, 5, 11, false);
+    VERIFICAR_IGUAL(pixels_acesos(quadro, 0, 0, SSD1306_WIDTH, SSD1306_HEIGHT), 0);
+}
+
+static void teste_linhas(void) {
+    memset(quadro, 0, sizeof(quadro));
+    ssd1306_draw_line(quadro, 10, 20, 29, 20, true);
+    VERIFICAR_IGUAL(pixels_acesos(quadro, 0, 0, SSD1306_WIDTH, SSD1306_HEIGHT), 20);
+    VERIFICAR(pixel(quadro, 10, 20) && pixel(quadro, 29, 20));
+    memset(quadro, 0, sizeof(quadro));
+    ssd1306_draw_line(quadro, 0, 0, 63, 63, true); // Diagonal: um pixel por coluna
+    VERIFICAR_IGUAL(pixels_acesos(quadro, 0, 0, SSD1306_WIDTH, SSD1306_HEIGHT), 64);
+    VERIFICAR(pixel(quadro, 0, 0) && pixel(quadro, 31, 31) && pixel(quadro, 63, 63));
+}
+
+static void teste_glifos(void) {
+    memset(quadro, 0, sizeof(quadro));
+    ssd1306_draw_char(quadro, 16, 8, ' ');
+    VERIFICAR_IGUAL(pixels_acesos(quadro, 0, 0, SSD1306_WIDTH, SSD1306_HEIGHT), 0);
+    ssd1306_draw_char(quadro, 16, 8, 'A');
+    int dentro = pixels_acesos(quadro, 16, 8, 24, 16);
+    VERIFICAR(dentro > 0);
+    VERIFICAR_IGUAL(pixels_acesos(quadro, 0, 0, SSD1306_WIDTH, SSD1306_HEIGHT), dentro); // Só na célula 8x8
+
+    // UTF-8: "ã" (2 bytes) vira um só glifo, o código Latin-1 227 da fonte
+    static uint8_t esperado[ssd1306_buffer_length];
+    memset(quadro, 0, sizeof(quadro));
+    memset(esperado, 0, sizeof(esperado));
+    ssd1306_draw_utf8_string(quadro, 0, 0, "Conexão");
+    const uint8_t codigos[] = {'C', 'o', 'n', 'e', 'x', 227, 'o'};
+    for (int i = 0; i < 7; i++) ssd1306_draw_char(esperado, (int16_t)(i * 8), 0, codigos[i]);
+    VERIFICAR(memcmp(quadro, esperado, sizeof(quadro)) == 0);
+    VERIFICAR(memcmp(quadro + 5 * 8, quadro + 6 * 8, 8) != 0); // 'ã' não é o 'o' seguinte
+}
+
+static void teste_renderizacao(void) {
+    oled_clear_global_buffer();
+    ssd1306_draw_utf8_string(buffer_oled, 0, 16, "192.168.0.50");
+    ssd1306_draw_line(buffer_oled, 0, 63, 127, 63, true);
+    host_i2c_zerar_estatisticas();
+    oled_render_global_buffer();
+    VERIFICAR(memcmp(host_ssd1306_gddram(), buffer_oled, ssd1306_buffer_length) == 0);
+    VERIFICAR(host_i2c_estatisticas()->quadros_dados >= 1);
+    VERIFICAR(host_i2c_estatisticas()->bytes_escritos >= ssd1306_buffer_length);
+
+    char caminho[] = "/tmp/teste_oled_XXXXXX";
+    int fd = mkstemp(caminho);
+    VERIFICAR(fd >= 0);
+    VERIFICAR_IGUAL(host_ssd1306_gravar_pbm(caminho), 0);
+    FILE *f = fopen(caminho, "rb");
+    static uint8_t pbm[64 + ssd1306_buffer_length];
+    size_t lidos = f ? fread(pbm, 1, sizeof(pbm), f) : 0;
+    if (f) fclose(f);
+    remove(caminho);
+    const char cabecalho[] = "P4\n128 64\n";
+    VERIFICAR_IGUAL(lidos, strlen(cabecalho) + ssd1306_buffer_length);
+    VERIFICAR(memcmp(pbm, cabecalho, strlen(cabecalho)) == 0);
+    // Linha 63 toda acesa: a última linha do PBM (16 bytes, bit mais significativo à esquerda)
+    const uint8_t *ultima = pbm + strlen(cabecalho) + 63 * (SSD1306_WIDTH / 8);
+    for (int i = 0; i < SSD1306_WIDTH / 8; i++) VERIFICAR_IGUAL(ultima[i], 0xFF);
+}
+
+// Quem agenda a limpeza de um aviso compara o contador para não apagar outra tela
+static void teste_contador_quadros(void) {
+    uint32_t quadros = oled_quadros_enviados();
+    oled_render_global_buffer();
+    VERIFICAR_IGUAL(oled_quadros_enviados(), quadros + 1);
+    oled_clear_global_buffer();
+    VERIFICAR_IGUAL(oled_quadros_enviados(), quadros + 2);
+}
+
+int main(void) {
+    oled_setup_interface();
+    teste_pixel();
+    teste_linhas();
+    teste_glifos();
+    teste_renderizacao();
+    teste_contador_quadros();
+    return verificacao_resultado("teste_oled");
+}
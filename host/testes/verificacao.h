@@ -0,0 +1,35 @@
+#ifndef HOST_TESTES_VERIFICACAO_H
+#define HOST_TESTES_VERIFICACAO_H
+
+// Verificações dos testes unitários do build nativo (ctest). Ao contrário de
+// assert, não somem com NDEBUG: cada falha é impressa e o teste termina com
+// código 1 em verificacao_resultado().
+
+#include <stdio.h>
+
+static int verificacao_falhas = 0;
+
+#define VERIFICAR(condicao)                                                          \
+    do {                                                                             \
+        if (!(condicao)) {                                                           \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #condicao);   \
+            verificacao_falhas++;                                                    \
+        }                                                                            \
+    } while (0)
+
+#define VERIFICAR_IGUAL(obtido, esperado)                                            \
+    do {                                                                             \
+        long long obtido_ = (long long)(obtido), esperado_ = (long long)(esperado);  \
+        if (obtido_ != esperado_) {                                                  \
+            fprintf(stderr, "%s:%d: %s = %lld, esperado %lld\n", __FILE__, __LINE__, \
+                    #obtido, obtido_, esperado_);                                    \
+            verificacao_falhas++;                                                    \
+        }                                                                            \
+    } while (0)
+
+static inline int verificacao_resultado(const char *nome) {
+    fprintf(stderr, "%s: %s (%d falhas)\n", nome, verificacao_falhas ? "FALHOU" : "OK", verificacao_falhas);
+    return verificacao_falhas ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,93 @@
+/**
+ * @file cbor_escrita.c
+ * @brief Codificador CBOR em fluxo (ver cbor_escrita.h).
+ *
+ * Todo item começa com um byte de cabeçalho: tipo maior nos 3 bits altos e, nos
+ * 5 baixos, o próprio argumento (< 24) ou o tamanho dele (24 a 27 = 1, 2, 4 ou
+ * 8 bytes em big-endian logo em seguida).
+ */
+
+#include "shared/cbor_escrita.h"
+#include "shared/secao_ram.h" // Para o cabeçalho fora da flash
+#include <string.h>
+
+#define CBOR_TIPO_UINT 0
+#define CBOR_TIPO_NEGATIVO 1
+#define CBOR_TIPO_TEXTO 3
+#define CBOR_TIPO_VETOR 4
+#define CBOR_TIPO_MAPA 5
+
+void cbor_iniciar(CodificadorCbor *c, uint8_t *destino, size_t capacidade) {
+    c->destino = destino;
+    c->capacidade = capacidade;
+    c->tamanho = 0;
+    c->estouro = false;
+}
+
+/**
+ * @brief Reserva `bytes` no destino; devolve NULL (e marca o estouro) se não couberem.
+ */
+static uint8_t *reservar(CodificadorCbor *c, size_t bytes) {
+    if (c->estouro || c->capacidade - c->tamanho < bytes) {
+        c->estouro = true;
+        return NULL;
+    }
+    uint8_t *p = c->destino + c->tamanho;
+    c->tamanho += bytes;
+    return p;
+}
+
+static void FUNC_RAM(escrever_cabecalho)(CodificadorCbor *c, uint8_t tipo, uint64_t argumento) {
+    uint8_t bytes_argumento, info;
+    if (argumento < 24) {
+        bytes_argumento = 0;
+        info = (uint8_t)argumento;
+    } else if (argumento <= 0xFF) {
+        bytes_argumento = 1;
+        info = 24;
+    } else if (argumento <= 0xFFFF) {
+        bytes_argumento = 2;
+        info = 25;
+    } else if (argumento <= 0xFFFFFFFFu) {
+        bytes_argumento = 4;
+        info = 26;
+    } else {
+        bytes_argumento = 8;
+        info = 27;
+    }
+
+    uint8_t *p = reservar(c, 1u + bytes_argumento);
+    if (!p) return;
+    *p++ = (uint8_t)(tipo << 5) | info;
+    for (int i = bytes_argumento - 1; i >= 0; i--) {
+        *p++ = (uint8_t)(argumento >> (8 * i));
+    }
+}
+
+void cbor_uint(CodificadorCbor *c, uint64_t valor) {
+    escrever_cabecalho(c, CBOR_TIPO_UINT, valor);
+}
+
+void cbor_int(CodificadorCbor *c, int64_t valor) {
+    // Negativos são codificados como -1 - n; ~valor calcula isso sem estourar em INT64_MIN
+    if (valor < 0) {
+        escrever_cabecalho(c, CBOR_TIPO_NEGATIVO, (uint64_t)~valor);
+    } else {
+        escrever_cabecalho(c, CBOR_TIPO_UINT, (uint64_t)valor);
+    }
+}
+
+void cbor_texto(CodificadorCbor *c, const char *texto) {
+    size_t n = strlen(texto);
+    escrever_cabecalho(c, CBOR_TIPO_TEXTO, n);
+    uint8_t *p = reservar(c, n);
+    if (p) memcpy(p, texto, n);
+}
+
+void cbor_vetor(CodificadorCbor *c, uint32_t elementos) {
+    escrever_cabecalho(c, CBOR_TIPO_VETOR, elementos);
+}
+
+void cbor_mapa(CodificadorCbor *c, uint32_t pares) {
+    escrever_cabecalho(c, CBOR_TIPO_MAPA, pares);
+}
\ No newline at end of file
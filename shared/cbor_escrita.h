@@ -0,0 +1,45 @@
+#ifndef CBOR_ESCRITA_H
+#define CBOR_ESCRITA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @file cbor_escrita.h
+ * @brief Codificador CBOR (RFC 8949) em fluxo, sem alocação e sem ponto flutuante.
+ *
+ * Os itens são escritos direto no buffer de destino (em geral o próprio buffer
+ * da publicação MQTT), na menor forma de cada inteiro. Vetores e mapas têm o
+ * número de elementos informado antes dos elementos. Se algum item não couber,
+ * `estouro` fica verdadeiro, nada mais é escrito e a saída deve ser descartada.
+ *
+ * Uso:
+ *   CodificadorCbor c;
+ *   cbor_iniciar(&c, buffer, sizeof(buffer));
+ *   cbor_mapa(&c, 2);
+ *   cbor_uint(&c, 0); cbor_int(&c, -12);
+ *   cbor_uint(&c, 1); cbor_texto(&c, "ok");
+ *   if (!c.estouro) publicar(buffer, c.tamanho);
+ */
+
+typedef struct {
+    uint8_t *destino;
+    size_t capacidade;
+    size_t tamanho;   // Bytes já escritos
+    bool estouro;
+} CodificadorCbor;
+
+void cbor_iniciar(CodificadorCbor *c, uint8_t *destino, size_t capacidade);
+
+void cbor_uint(CodificadorCbor *c, uint64_t valor);
+void cbor_int(CodificadorCbor *c, int64_t valor);
+void cbor_texto(CodificadorCbor *c, const char *texto);
+
+/**
+ * @brief Início de um vetor (tipo 4) ou mapa (tipo 5, `pares` pares chave/valor).
+ */
+void cbor_vetor(CodificadorCbor *c, uint32_t elementos);
+void cbor_mapa(CodificadorCbor *c, uint32_t pares);
+
+#endif
\ No newline at end of file
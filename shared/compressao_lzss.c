@@ -0,0 +1,106 @@
+/**
+ * @file compressao_lzss.c
+ * @brief Compressor LZSS (ver compressao_lzss.h).
+ *
+ * A tabela hash guarda a posição mais recente de cada trinca de bytes e
+ * `anterior` encadeia as posições antigas com o mesmo hash dentro da janela:
+ * 4 KB estáticos com a janela de 1 KB, reiniciados a cada chamada.
+ */
+
+#include "shared/compressao_lzss.h"
+#include <string.h>
+
+#define LZSS_BITS_HASH 10
+#define LZSS_SEM_POSICAO 0xFFFFu
+
+static uint16_t inicio_hash[1u << LZSS_BITS_HASH];
+static uint16_t anterior[LZSS_JANELA];
+
+static inline uint32_t hash_trinca(const uint8_t *p) {
+    uint32_t v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    return (v * 2654435761u) >> (32 - LZSS_BITS_HASH);
+}
+
+static inline void inserir_posicao(const uint8_t *origem, size_t tamanho, size_t pos) {
+    if (pos + LZSS_COMPRIMENTO_MIN > tamanho) return;
+    uint32_t h = hash_trinca(origem + pos);
+    anterior[pos & (LZSS_JANELA - 1)] = inicio_hash[h];
+    inicio_hash[h] = (uint16_t)pos;
+}
+
+size_t lzss_comprimir(const uint8_t *origem, size_t tamanho, uint8_t *destino, size_t capacidade) {
+    if (tamanho == 0 || tamanho >= LZSS_SEM_POSICAO) return 0;
+    memset(inicio_hash, 0xFF, sizeof(inicio_hash));
+
+    size_t pos = 0, n = 0, pos_flags = 0;
+    uint8_t bit = 8; // Força um novo byte de flags no primeiro símbolo
+    while (pos < tamanho) {
+        if (bit == 8) {
+            if (n >= capacidade) return 0;
+            pos_flags = n++;
+            destino[pos_flags] = 0;
+            bit = 0;
+        }
+
+        // Maior casamento entre os candidatos da cadeia, dentro da janela
+        size_t melhor_comprimento = 0, melhor_distancia = 0;
+        size_t limite = tamanho - pos < LZSS_COMPRIMENTO_MAX ? tamanho - pos : LZSS_COMPRIMENTO_MAX;
+        if (limite >= LZSS_COMPRIMENTO_MIN) {
+            uint16_t candidato = inicio_hash[hash_trinca(origem + pos)];
+            for (int profundidade = 0; profundidade < LZSS_PROFUNDIDADE_BUSCA && candidato != LZSS_SEM_POSICAO;
+                 profundidade++) {
+                size_t distancia = pos - candidato;
+                if (candidato >= pos || distancia > LZSS_JANELA) break;
+                size_t c = 0;
+                while (c < limite && origem[candidato + c] == origem[pos + c]) c++;
+                if (c > melhor_comprimento) {
+                    melhor_comprimento = c;
+                    melhor_distancia = distancia;
+                    if (c == limite) break;
+                }
+                candidato = anterior[candidato & (LZSS_JANELA - 1)];
+            }
+        }
+
+        if (melhor_comprimento >= LZSS_COMPRIMENTO_MIN) {
+            if (n + 2 > capacidade) return 0;
+            uint16_t ref = (uint16_t)(((melhor_distancia - 1) << (16 - LZSS_BITS_JANELA)) |
+                                      (melhor_comprimento - LZSS_COMPRIMENTO_MIN));
+            destino[n++] = (uint8_t)(ref >> 8);
+            destino[n++] = (uint8_t)ref;
+            for (size_t i = 0; i < melhor_comprimento; i++) inserir_posicao(origem, tamanho, pos + i);
+            pos += melhor_comprimento;
+        } else {
+            if (n >= capacidade) return 0;
+            destino[pos_flags] |= (uint8_t)(1u << bit);
+            destino[n++] = origem[pos];
+            inserir_posicao(origem, tamanho, pos);
+            pos++;
+        }
+        bit++;
+    }
+    return n < capacidade ? n : 0;
+}
+
+size_t lzss_descomprimir(const uint8_t *origem, size_t tamanho, uint8_t *destino, size_t capacidade) {
+    size_t i = 0, n = 0;
+    while (i < tamanho) {
+        uint8_t flags = origem[i++];
+        for (int bit = 0; bit < 8 && i < tamanho; bit++) {
+            if (flags & (1u << bit)) {
+                if (n >= capacidade) return 0;
+                destino[n++] = origem[i++];
+                continue;
+            }
+            if (i + 2 > tamanho) return 0;
+            uint16_t ref = (uint16_t)((origem[i] << 8) | origem[i + 1]);
+            i += 2;
+            size_t distancia = (ref >> (16 - LZSS_BITS_JANELA)) + 1;
+            size_t comprimento = (ref & ((1u << (16 - LZSS_BITS_JANELA)) - 1)) + LZSS_COMPRIMENTO_MIN;
+            if (distancia > n || n + comprimento > capacidade) return 0;
+            // Cópia byte a byte: a referência pode sobrepor o trecho que está sendo escrito
+            for (size_t k = 0; k < comprimento; k++, n++) destino[n] = destino[n - distancia];
+        }
+    }
+    return n;
+}
\ No newline at end of file
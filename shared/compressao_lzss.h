@@ -0,0 +1,41 @@
+#ifndef COMPRESSAO_LZSS_H
+#define COMPRESSAO_LZSS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config/config_geral.h" // Para LZSS_*
+
+/**
+ * @file compressao_lzss.h
+ * @brief Compressor LZSS de janela pequena, com memória de trabalho estática.
+ *
+ * Formato (tools/descomprimir_lzss.py): grupos de até 8 símbolos precedidos de
+ * um byte de flags, do bit menos significativo ao mais significativo. Bit 1 =
+ * literal (1 byte); bit 0 = referência de 2 bytes big-endian, com a distância
+ * - 1 nos LZSS_BITS_JANELA bits altos e o comprimento - 3 nos bits restantes.
+ * O fim dos dados encerra o fluxo (bits de flag excedentes são ignorados).
+ *
+ * As buscas usam uma tabela hash de 3 bytes com encadeamento limitado a
+ * LZSS_PROFUNDIDADE_BUSCA candidatos. Não é reentrante: só o Núcleo 0 comprime.
+ */
+
+#define LZSS_JANELA (1u << LZSS_BITS_JANELA)
+#define LZSS_COMPRIMENTO_MIN 3
+#define LZSS_COMPRIMENTO_MAX (LZSS_COMPRIMENTO_MIN + (1u << (16 - LZSS_BITS_JANELA)) - 1)
+
+/**
+ * @brief Comprime `tamanho` bytes (até 65535) em `destino`.
+ *
+ * @return Tamanho comprimido, ou 0 se ele não fosse menor que `capacidade` (o
+ *         chamador então envia os dados sem compressão).
+ */
+size_t lzss_comprimir(const uint8_t *origem, size_t tamanho, uint8_t *destino, size_t capacidade);
+
+/**
+ * @brief Descomprime um fluxo de lzss_comprimir.
+ *
+ * @return Tamanho descomprimido, ou 0 se o fluxo for inválido ou não couber.
+ */
+size_t lzss_descomprimir(const uint8_t *origem, size_t tamanho, uint8_t *destino, size_t capacidade);
+
+#endif
\ No newline at end of file
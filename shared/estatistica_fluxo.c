@@ -0,0 +1,140 @@
+/**
+ * @file estatistica_fluxo.c
+ * @brief Estatísticas de fluxo em aritmética inteira (ver estatistica_fluxo.h).
+ *
+ * O caminho comum de estatistica_adicionar() tem uma subtração, duas comparações,
+ * um produto de 32 bits (desvios de até 16 bits) e um deslocamento para achar a
+ * faixa; divisões de 64 bits só aparecem no resumo, uma vez por janela.
+ */
+
+#include "shared/estatistica_fluxo.h"
+#include "shared/secao_ram.h" // Para estatistica_adicionar fora da flash
+#include <string.h>
+
+void estatistica_reiniciar(EstatisticaFluxo *e) {
+    memset(e, 0, sizeof(*e));
+}
+
+/**
+ * @brief Dobra a largura das faixas até o valor caber no histograma.
+ *
+ * As faixas ocupadas são juntadas aos pares e recentralizadas, deixando um quarto
+ * do histograma livre de cada lado. A origem continua múltipla da nova largura.
+ */
+static void alargar_faixas(EstatisticaFluxo *e, int32_t valor) {
+    while (true) {
+        int64_t largura = (int64_t)1 << e->log2_largura;
+        int64_t indice = (valor - e->origem) >> e->log2_largura;
+        if (indice >= 0 && indice < ESTATISTICA_NUM_FAIXAS) return;
+
+        int64_t nova_largura = largura * 2;
+        int64_t origem = e->origem;
+        int64_t alinhada = origem - (((origem % nova_largura) + nova_largura) % nova_largura);
+        int64_t deslocamento = (origem - alinhada) / largura; // 0 ou 1 faixa antiga
+        uint32_t novas[ESTATISTICA_NUM_FAIXAS] = {0};
+        for (int i = 0; i < ESTATISTICA_NUM_FAIXAS; i++) {
+            novas[(i + deslocamento) / 2 + ESTATISTICA_NUM_FAIXAS / 4] += e->faixas[i];
+        }
+        memcpy(e->faixas, novas, sizeof(novas));
+        e->origem = alinhada - (int64_t)(ESTATISTICA_NUM_FAIXAS / 4) * nova_largura;
+        e->log2_largura++;
+    }
+}
+
+void FUNC_RAM(estatistica_adicionar)(EstatisticaFluxo *e, int32_t valor) {
+    if (e->n == 0) {
+        e->referencia = e->minimo = e->maximo = valor;
+        e->origem = (int64_t)valor - ESTATISTICA_NUM_FAIXAS / 2;
+    }
+    e->n++;
+    if (valor < e->minimo) e->minimo = valor;
+    if (valor > e->maximo) e->maximo = valor;
+
+    int64_t desvio = (int64_t)valor - e->referencia;
+    e->soma += desvio;
+    uint64_t modulo = (uint64_t)(desvio < 0 ? -desvio : desvio);
+    if (modulo <= 0xFFFFu) e->soma_quadrados += (uint32_t)modulo * (uint32_t)modulo; // Produto de 32 bits
+    else e->soma_quadrados += modulo * modulo;
+
+    int64_t distancia = valor - e->origem;
+    if (distancia < 0 || (distancia >> e->log2_largura) >= ESTATISTICA_NUM_FAIXAS) {
+        alargar_faixas(e, valor);
+        distancia = valor - e->origem;
+    }
+    uint32_t indice = (uint32_t)(distancia >> e->log2_largura);
+    e->faixas[indice]++;
+}
+
+int32_t estatistica_quantil(const EstatisticaFluxo *e, uint32_t permil) {
+    if (e->n == 0) return 0;
+    uint32_t posicao = (uint32_t)(((uint64_t)e->n * permil + 999) / 1000); // Posição 1..n
+    if (posicao == 0) posicao = 1;
+
+    uint32_t acumulado = 0;
+    int64_t largura = (int64_t)1 << e->log2_largura;
+    int64_t resultado = e->maximo;
+    for (int i = 0; i < ESTATISTICA_NUM_FAIXAS; i++) {
+        if (acumulado + e->faixas[i] >= posicao) {
+            // Interpolação linear dentro da faixa: resultado em [início, início + largura - 1]
+            int64_t dentro = ((int64_t)(posicao - acumulado) * largura - 1) / e->faixas[i];
+            resultado = e->origem + i * largura + dentro;
+            break;
+        }
+        acumulado += e->faixas[i];
+    }
+    if (resultado < e->minimo) resultado = e->minimo;
+    if (resultado > e->maximo) resultado = e->maximo;
+    return (int32_t)resultado;
+}
+
+/**
+ * @brief Raiz quadrada inteira (piso), bit a bit.
+ */
+static uint32_t raiz_inteira(uint64_t x) {
+    uint64_t resultado = 0, bit = (uint64_t)1 << 62;
+    while (bit > x) bit >>= 2;
+    while (bit) {
+        if (x >= resultado + bit) {
+            x -= resultado + bit;
+            resultado = (resultado >> 1) + bit;
+        } else {
+            resultado >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)resultado;
+}
+
+void estatistica_resumir(EstatisticaFluxo *e, ResumoEstatistica *resumo, bool reiniciar) {
+    memset(resumo, 0, sizeof(*resumo));
+    resumo->n = e->n;
+    if (e->n > 0) {
+        resumo->minimo = e->minimo;
+        resumo->maximo = e->maximo;
+        resumo->media_q8 = (int64_t)e->referencia * 256 + (e->soma * 256) / (int64_t)e->n;
+
+        if (e->n > 1) {
+            // Σd² - (Σd)²/n sem estourar: (Σd)²/n = q·Σd + r·Σd/n, com Σd = q·n + r
+            uint64_t modulo_soma = (uint64_t)(e->soma < 0 ? -e->soma : e->soma);
+            uint64_t q = modulo_soma / e->n, r = modulo_soma % e->n;
+            uint64_t correcao = q * modulo_soma + r * modulo_soma / e->n;
+            uint64_t dispersao = e->soma_quadrados > correcao ? e->soma_quadrados - correcao : 0;
+            uint64_t divisor = e->n - 1;
+            if (dispersao < ((uint64_t)1 << 55)) {
+                // A correção inteira despreza (r·Σd mod n)/n: descontada em Q8, senão a
+                // variância de janelas curtas sai até 1/(n-1) acima
+                uint64_t fracao_q8 = (((r * modulo_soma) % e->n) << 8) / e->n;
+                uint64_t dispersao_q8 = (dispersao << 8) > fracao_q8 ? (dispersao << 8) - fracao_q8 : 0;
+                resumo->variancia_q8 = dispersao_q8 / divisor;
+            } else {
+                resumo->variancia_q8 = (dispersao / divisor << 8) + ((dispersao % divisor) << 8) / divisor;
+            }
+            uint64_t v = resumo->variancia_q8;
+            resumo->desvio_q8 = raiz_inteira(v >= ((uint64_t)1 << 56) ? UINT64_MAX : v << 8);
+        }
+        resumo->p50 = estatistica_quantil(e, 500);
+        resumo->p90 = estatistica_quantil(e, 900);
+        resumo->p99 = estatistica_quantil(e, 990);
+    }
+    if (reiniciar) estatistica_reiniciar(e);
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef ESTATISTICA_FLUXO_H
+#define ESTATISTICA_FLUXO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config/config_geral.h" // Para ESTATISTICA_NUM_FAIXAS
+
+/**
+ * @file estatistica_fluxo.h
+ * @brief Agregação de um fluxo de inteiros em memória fixa, sem ponto flutuante.
+ *
+ * Contagem, mínimo, máximo, média e variância vêm de somas deslocadas pelo primeiro
+ * valor da janela (evita o cancelamento de Σx² - (Σx)²/n). Os quantis vêm de um
+ * histograma de ESTATISTICA_NUM_FAIXAS faixas de largura 2^k que dobra (juntando
+ * faixas vizinhas) quando chega um valor fora do alcance: o erro de um quantil é no
+ * máximo uma largura de faixa, cerca de 2 x (máx - mín) / ESTATISTICA_NUM_FAIXAS.
+ *
+ * Válido enquanto n x (x - primeiro)² couber em 64 bits. Cada janela começa com
+ * estatistica_reiniciar(); estatistica_resumir() pode reiniciar junto.
+ */
+
+typedef struct {
+    uint32_t n;
+    int32_t minimo;
+    int32_t maximo;
+    int32_t referencia;        // Primeiro valor da janela
+    int64_t soma;              // Σ(x - referencia)
+    uint64_t soma_quadrados;   // Σ(x - referencia)²
+    int64_t origem;            // Início da faixa 0 (múltiplo da largura)
+    uint8_t log2_largura;      // Largura das faixas = 2^log2_largura
+    uint32_t faixas[ESTATISTICA_NUM_FAIXAS];
+} EstatisticaFluxo;
+
+// Resumo de uma janela; média, variância e desvio em Q8 (valor x 256)
+typedef struct {
+    uint32_t n;
+    int32_t minimo;
+    int32_t maximo;
+    int64_t media_q8;
+    uint64_t variancia_q8;     // Variância amostral (divisor n - 1)
+    uint32_t desvio_q8;
+    int32_t p50, p90, p99;
+} ResumoEstatistica;
+
+void estatistica_reiniciar(EstatisticaFluxo *e);
+
+/**
+ * @brief Acrescenta um valor. Custo constante, exceto quando o histograma precisa
+ * dobrar a largura das faixas (raro: O(log(alcance)) vezes por janela).
+ */
+void estatistica_adicionar(EstatisticaFluxo *e, int32_t valor);
+
+/**
+ * @brief Quantil aproximado, interpolado dentro da faixa e limitado a [mín, máx].
+ *
+ * @param permil Posição do quantil em milésimos (500 = mediana).
+ */
+int32_t estatistica_quantil(const EstatisticaFluxo *e, uint32_t permil);
+
+/**
+ * @brief Calcula o resumo da janela e, com reiniciar, abre uma janela nova.
+ */
+void estatistica_resumir(EstatisticaFluxo *e, ResumoEstatistica *resumo, bool reiniciar);
+
+#endif
\ No newline at end of file
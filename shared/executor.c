@@ -0,0 +1,188 @@
+/**
+ * @file executor.c
+ * @brief Deques por núcleo com roubo de trabalho e conclusão no núcleo de origem
+ * (ver executor.h).
+ *
+ * `fundo - topo` é a ocupação do deque; os índices só crescem e o módulo por
+ * EXECUTOR_TAM_DEQUE dá a posição. Os contadores de cada núcleo só são escritos
+ * por ele, e lidos sem trava pelas métricas.
+ */
+
+#include "shared/executor.h"
+#include "config/config_geral.h" // Para EXECUTOR_TAM_DEQUE
+#include "core0/main_core0_utils.h" // Para FIFO_TIPO_TRABALHO
+#include "shared/metricas.h"
+#include "hardware/sync.h" // Para os spinlocks de hardware
+#include "pico/multicore.h"
+#include "pico/platform.h" // Para get_core_num, __sev e __wfe
+
+_Static_assert((EXECUTOR_TAM_DEQUE & (EXECUTOR_TAM_DEQUE - 1)) == 0, "EXECUTOR_TAM_DEQUE deve ser potência de 2");
+
+typedef struct {
+    Trabalho *itens[EXECUTOR_TAM_DEQUE];
+    uint32_t topo;              // Próximo a ser roubado
+    uint32_t fundo;             // Próxima posição livre
+    Trabalho *executados;       // Executados por outro núcleo, aguardando `concluir` neste
+    spin_lock_t *trava;         // Protege itens, topo, fundo e executados
+    uint32_t profundidade_max;  // Sob a trava, escrito só pelo dono
+    // Contadores do próprio núcleo
+    uint32_t contagem_executados;
+    uint32_t roubados;
+    uint32_t cheio;             // Executados na submissão, com o deque cheio
+} DequeNucleo;
+
+static DequeNucleo deques[2];
+static volatile bool campainha_pendente = false; // Há um FIFO_TIPO_TRABALHO na FIFO do Núcleo 0
+
+void executor_inicializar(void) {
+    for (int n = 0; n < 2; n++) deques[n].trava = spin_lock_init(spin_lock_claim_unused(true));
+}
+
+/**
+ * @brief Libera o trabalho e chama `concluir` (no núcleo de origem). LIVRE antes
+ * do `concluir`, para que ele possa submeter o trabalho de novo.
+ */
+static void finalizar(Trabalho *t) {
+    FuncaoTrabalho concluir = t->concluir;
+    t->estado = TRABALHO_LIVRE;
+    if (concluir) concluir(t);
+}
+
+/**
+ * @brief Executa o trabalho e o devolve ao núcleo de origem.
+ */
+static void executar(Trabalho *t) {
+    uint nucleo = get_core_num();
+    t->nucleo_execucao = (uint8_t)nucleo;
+    uint32_t inicio_us = time_us_32();
+    t->executar(t);
+    t->duracao_us = time_us_32() - inicio_us;
+    deques[nucleo].contagem_executados++;
+
+    if (t->nucleo_origem == nucleo) {
+        finalizar(t);
+        return;
+    }
+    DequeNucleo *origem = &deques[t->nucleo_origem];
+    uint32_t estado = spin_lock_blocking(origem->trava);
+    t->estado = TRABALHO_EXECUTADO;
+    t->proximo = origem->executados;
+    origem->executados = t;
+    spin_unlock(origem->trava, estado);
+
+    // Só o Núcleo 1 conclui trabalhos do Núcleo 0: só ele toca a campainha
+    if (t->nucleo_origem == 0 && !campainha_pendente) {
+        campainha_pendente = true;
+        multicore_fifo_push_blocking((uint32_t)FIFO_TIPO_TRABALHO << 16);
+    }
+    __sev(); // Acorda a origem se ela estiver em executor_aguardar
+}
+
+void executor_submeter(Trabalho *trabalho) {
+    uint nucleo = get_core_num();
+    DequeNucleo *d = &deques[nucleo];
+    trabalho->nucleo_origem = (uint8_t)nucleo;
+    trabalho->estado = TRABALHO_NA_FILA;
+
+    uint32_t estado = spin_lock_blocking(d->trava);
+    uint32_t ocupacao = d->fundo - d->topo;
+    bool cabe = ocupacao < EXECUTOR_TAM_DEQUE;
+    if (cabe) {
+        d->itens[d->fundo++ % EXECUTOR_TAM_DEQUE] = trabalho;
+        if (ocupacao + 1 > d->profundidade_max) d->profundidade_max = ocupacao + 1;
+    }
+    spin_unlock(d->trava, estado);
+
+    if (!cabe) {
+        d->cheio++;
+        trabalho->estado = TRABALHO_EXECUTANDO;
+        executar(trabalho);
+        return;
+    }
+    __sev(); // Acorda o outro núcleo se ele estiver ocioso em WFE
+}
+
+/**
+ * @brief Retira um trabalho do fundo (dono) ou do topo (roubo) de um deque.
+ */
+static Trabalho *retirar(DequeNucleo *d, bool do_fundo) {
+    Trabalho *t = NULL;
+    uint32_t estado = spin_lock_blocking(d->trava);
+    if (d->fundo != d->topo) {
+        t = do_fundo ? d->itens[--d->fundo % EXECUTOR_TAM_DEQUE] : d->itens[d->topo++ % EXECUTOR_TAM_DEQUE];
+        t->estado = TRABALHO_EXECUTANDO;
+    }
+    spin_unlock(d->trava, estado);
+    return t;
+}
+
+/**
+ * @brief Rouba e executa o trabalho do topo do deque do outro núcleo.
+ */
+static bool roubar_um(uint nucleo) {
+    Trabalho *t = retirar(&deques[nucleo ^ 1u], false);
+    if (!t) return false;
+    deques[nucleo].roubados++;
+    executar(t);
+    return true;
+}
+
+bool executor_executar_um(void) {
+    uint nucleo = get_core_num();
+    if (!deques[nucleo].trava) return false; // Sem executor_inicializar (ex.: benchmarks só do Núcleo 1)
+
+    Trabalho *t = retirar(&deques[nucleo], true);
+    if (!t) return roubar_um(nucleo);
+    executar(t);
+    return true;
+}
+
+void executor_processar_concluidos(void) {
+    DequeNucleo *d = &deques[get_core_num()];
+    if (!d->executados) return; // Leitura sem trava: um recém-chegado fica para a próxima chamada
+
+    uint32_t estado = spin_lock_blocking(d->trava);
+    Trabalho *lista = d->executados;
+    d->executados = NULL;
+    spin_unlock(d->trava, estado);
+
+    while (lista) {
+        Trabalho *t = lista;
+        lista = t->proximo;
+        finalizar(t);
+    }
+}
+
+void executor_campainha(void) {
+    // Libera antes de esvaziar a lista: o que chegar depois toca de novo
+    campainha_pendente = false;
+    __dmb();
+    executor_processar_concluidos();
+}
+
+void executor_aguardar(Trabalho *trabalho) {
+    while (trabalho->estado != TRABALHO_LIVRE) {
+        executor_processar_concluidos();
+        if (trabalho->estado == TRABALHO_LIVRE) break;
+        // Ajuda (inclusive fazendo o próprio trabalho, se ninguém o pegou) ou espera o SEV da conclusão
+        if (!executor_executar_um()) __wfe();
+    }
+}
+
+void executor_ocioso_ate(absolute_time_t limite, bool (*interromper)(void)) {
+    uint nucleo = get_core_num();
+    while (!time_reached(limite) && !(interromper && interromper())) {
+        executor_processar_concluidos();
+        if (!deques[nucleo].trava || !roubar_um(nucleo)) best_effort_wfe_or_timeout(limite);
+    }
+}
+
+void executor_atualizar_metricas(void) {
+    uint32_t profundidade = deques[0].profundidade_max > deques[1].profundidade_max ?
+                            deques[0].profundidade_max : deques[1].profundidade_max;
+    metricas_definir(METRICA_EXECUTOR_NUCLEO0, deques[0].contagem_executados);
+    metricas_definir(METRICA_EXECUTOR_NUCLEO1, deques[1].contagem_executados);
+    metricas_definir(METRICA_EXECUTOR_ROUBADOS, deques[0].roubados + deques[1].roubados);
+    metricas_definir(METRICA_EXECUTOR_FILA_MAX, profundidade);
+    metricas_definir(METRICA_EXECUTOR_CHEIO, deques[0].cheio + deques[1].cheio);
+}
\ No newline at end of file
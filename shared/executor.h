@@ -0,0 +1,102 @@
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/time.h" // Para absolute_time_t
+
+/**
+ * @file executor.h
+ * @brief Executor de trabalhos curtos nos dois núcleos, com roubo de trabalho.
+ *
+ * Cada núcleo tem um deque de EXECUTOR_TAM_DEQUE trabalhos: quem submete põe e
+ * tira do fundo, e o outro núcleo, ocioso, rouba do topo. O Núcleo 1 passa o
+ * tempo entre as verificações do Wi-Fi em executor_ocioso_ate, e o Núcleo 0 na
+ * pausa do seu loop, então um trabalho submetido por um núcleo ocupado é feito
+ * pelo outro. A ociosidade só ajuda o outro núcleo: um trabalho próprio volta a
+ * quem o submeteu apenas em executor_aguardar (ou com o deque cheio), por
+ * exemplo quando o Núcleo 1 está preso numa reconexão do Wi-Fi.
+ *
+ * O M0+ não tem instruções exclusivas (LDREX/STREX) para um deque sem trava:
+ * cada deque é protegido por um spinlock de hardware, segurado só por algumas
+ * instruções. A submissão acorda o outro núcleo com SEV. A conclusão volta ao
+ * núcleo que submeteu: o Núcleo 0 recebe a campainha FIFO_TIPO_TRABALHO pela
+ * FIFO (no máximo uma pendente), e o Núcleo 1, que não lê a própria FIFO
+ * (ela é do multicore_lockout), é acordado por SEV.
+ *
+ * `executar` roda em qualquer núcleo e só deve calcular sobre os dados do
+ * trabalho: nada de lwIP, OLED ou métricas, que têm um único escritor.
+ * `concluir` roda no núcleo que submeteu e pode usar tudo isso.
+ */
+
+typedef struct Trabalho Trabalho;
+typedef void (*FuncaoTrabalho)(Trabalho *trabalho);
+
+// Estado de um trabalho (Trabalho.estado)
+typedef enum {
+    TRABALHO_LIVRE = 0,     // Pode ser submetido (de novo)
+    TRABALHO_NA_FILA,       // Em um deque
+    TRABALHO_EXECUTANDO,
+    TRABALHO_EXECUTADO      // Aguarda `concluir` no núcleo de origem
+} EstadoTrabalho;
+
+// Descritor de um trabalho; a memória é de quem submete e só pode ser reusada depois de LIVRE
+struct Trabalho {
+    FuncaoTrabalho executar;    // Em qualquer núcleo
+    FuncaoTrabalho concluir;    // No núcleo que submeteu (NULL = nenhum)
+    void *arg;
+    uint32_t duracao_us;        // Tempo de `executar` (preenchido pelo executor)
+    uint8_t nucleo_origem;      // Preenchidos pelo executor
+    uint8_t nucleo_execucao;
+    volatile uint8_t estado;    // EstadoTrabalho
+    Trabalho *proximo;          // Lista de executados do núcleo de origem
+};
+
+/**
+ * @brief Reserva os spinlocks dos deques. Chamada pelo Núcleo 0 antes de lançar o Núcleo 1.
+ */
+void executor_inicializar(void);
+
+/**
+ * @brief Põe o trabalho no deque do núcleo atual e acorda o outro núcleo.
+ * Com o deque cheio o trabalho é executado e concluído aqui mesmo.
+ */
+void executor_submeter(Trabalho *trabalho);
+
+/**
+ * @brief Executa um trabalho: o do fundo do próprio deque ou, sem nenhum, o do
+ * topo do deque do outro núcleo (roubo).
+ * @return false se os dois deques estavam vazios.
+ */
+bool executor_executar_um(void);
+
+/**
+ * @brief Chama `concluir` dos trabalhos deste núcleo que já foram executados.
+ */
+void executor_processar_concluidos(void);
+
+/**
+ * @brief Campainha FIFO_TIPO_TRABALHO recebida pelo Núcleo 0: libera a próxima e
+ * processa os concluídos.
+ */
+void executor_campainha(void);
+
+/**
+ * @brief Espera o trabalho (submetido por este núcleo) ficar LIVRE, executando
+ * trabalhos enquanto isso; ao retornar `concluir` já foi chamado.
+ */
+void executor_aguardar(Trabalho *trabalho);
+
+/**
+ * @brief Até `limite`, processa as conclusões deste núcleo e rouba os trabalhos do
+ * outro, dormindo em WFE sem nada a fazer. Os trabalhos deste núcleo ficam para o outro.
+ * Volta antes se `interromper` (opcional), consultada a cada despertar, for verdadeira.
+ */
+void executor_ocioso_ate(absolute_time_t limite, bool (*interromper)(void));
+
+/**
+ * @brief Atualiza as métricas x0/x1/xr/xm/xc (registrada com metricas_registrar_atualizacao).
+ */
+void executor_atualizar_metricas(void);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,149 @@
+/**
+ * @file metricas.c
+ * @brief Registro de métricas de recursos em tempo de execução.
+ *
+ * Tudo é baseado em contadores atualizados no ponto de uso (somas e máximos de
+ * 32 bits, sem trava), de modo que a coleta fica sempre ligada. O trabalho mais
+ * caro (varrer as pilhas pintadas, ler as estatísticas do lwIP e do heap) só
+ * acontece em metricas_formatar(), chamada na publicação periódica.
+ */
+
+#include "shared/metricas.h"
+#include "pico/time.h"  // Para time_us_64
+#include "lwip/stats.h" // Para lwip_stats (MEM_STATS/MEMP_STATS)
+#include "shared/secao_ram.h" // Para FUNC_RAM nos pontos de coleta
+#include <stdio.h>
+
+#if PICO_ON_DEVICE
+#if !MEMORIA_ESTATICA
+#include <malloc.h> // Para mallinfo (ligaria o alocador no modo de memória estática)
+#endif
+
+// Limites das pilhas definidos pelo linker script do SDK (memmap_default.ld)
+extern uint32_t __StackBottom, __StackTop;       // Núcleo 0 (SCRATCH_Y)
+extern uint32_t __StackOneBottom, __StackOneTop; // Núcleo 1 (SCRATCH_X)
+
+#define PADRAO_PILHA 0xA5A5A5A5u
+#endif
+
+static uint32_t contadores[METRICA_NUM];
+
+// Limites superiores (us) das faixas do histograma do loop; a última faixa é aberta
+static const uint32_t limites_faixas_loop[METRICAS_NUM_FAIXAS_LOOP - 1] DADOS_RAM("faixas_loop") = {
+    100, 500, 1000, 5000, 10000, 50000, 100000
+};
+static uint32_t histograma_loop[METRICAS_NUM_FAIXAS_LOOP];
+static uint32_t iteracoes_loop = 0;
+static uint32_t pior_iteracao_us = 0;
+
+static const FilaCircularInterCore *fila_monitorada = NULL;
+static void (*atualizacoes[METRICAS_MAX_ATUALIZACOES])(void);
+static int num_atualizacoes = 0;
+
+// Chaves curtas na ordem de MetricaId
+static const char *const chaves_metricas[METRICA_NUM] = {
+    "of", "ou", "om", "fd", "po", "pf", "pr", "ps", "pa", "pd", "pb", "ze", "zs", "zu",
+    "rs", "rr", "rl", "r5", "r9", "er", "ed", "em",
+    "ct", "cu", "cx", "ca", "tc", "tr", "tf", "tk", "th",
+    "ra", "jd", "ja", "jx", "jf", "x0", "x1", "xr", "xm", "xc",
+    "gd", "gm", "gx", "qc", "qm", "qx",
+};
+
+#if PICO_ON_DEVICE
+/**
+ * @brief Preenche [inicio, fim) com o padrão de pilha.
+ */
+static void pintar_pilha(uint32_t *inicio, uint32_t *fim) {
+    for (volatile uint32_t *p = inicio; p < fim; p++) *p = PADRAO_PILHA;
+}
+
+/**
+ * @brief Bytes já usados de uma pilha: procura, a partir da base, a primeira palavra alterada.
+ */
+static uint32_t pilha_usada(const uint32_t *base, const uint32_t *topo) {
+    const volatile uint32_t *p = base;
+    while (p < topo && *p == PADRAO_PILHA) p++;
+    return (uint32_t)((const uint8_t *)topo - (const uint8_t *)p);
+}
+#endif
+
+void metricas_inicializar(void) {
+#if PICO_ON_DEVICE
+    // Núcleo 0: pinta até um pouco abaixo do quadro atual, que ainda está em uso
+    uint32_t marcador;
+    pintar_pilha(&__StackBottom, &marcador - 64);
+    // Núcleo 1 ainda não foi lançado: a pilha inteira está livre
+    pintar_pilha(&__StackOneBottom, &__StackOneTop);
+#endif
+}
+
+void metricas_registrar_fila(const FilaCircularInterCore *fila) {
+    fila_monitorada = fila;
+}
+
+void metricas_registrar_atualizacao(void (*atualizar)(void)) {
+    if (num_atualizacoes < METRICAS_MAX_ATUALIZACOES) atualizacoes[num_atualizacoes++] = atualizar;
+}
+
+void FUNC_RAM(metricas_somar)(MetricaId id, uint32_t valor) {
+    contadores[id] += valor;
+}
+
+void FUNC_RAM(metricas_maximo)(MetricaId id, uint32_t valor) {
+    if (valor > contadores[id]) contadores[id] = valor;
+}
+
+void metricas_definir(MetricaId id, uint32_t valor) {
+    contadores[id] = valor;
+}
+
+void FUNC_RAM_NUCLEO0(metricas_registrar_loop)(uint32_t duracao_us) {
+    int faixa = 0;
+    while (faixa < METRICAS_NUM_FAIXAS_LOOP - 1 && duracao_us >= limites_faixas_loop[faixa]) faixa++;
+    histograma_loop[faixa]++;
+    iteracoes_loop++;
+    if (duracao_us > pior_iteracao_us) pior_iteracao_us = duracao_us;
+}
+
+int metricas_formatar(char *destino, size_t tamanho) {
+    for (int i = 0; i < num_atualizacoes; i++) atualizacoes[i]();
+
+    size_t n = 0;
+#define ANEXAR(...) do { \
+        if (n < tamanho) n += snprintf(destino + n, tamanho - n, __VA_ARGS__); \
+    } while (0)
+
+    ANEXAR("t=%lu,li=%lu,lm=%lu,lh=", (unsigned long)(time_us_64() / 1000000u),
+           (unsigned long)iteracoes_loop, (unsigned long)pior_iteracao_us);
+    for (int i = 0; i < METRICAS_NUM_FAIXAS_LOOP; i++) {
+        ANEXAR(i ? "/%lu" : "%lu", (unsigned long)histograma_loop[i]);
+    }
+    for (int i = 0; i < METRICA_NUM; i++) {
+        ANEXAR(",%s=%lu", chaves_metricas[i], (unsigned long)contadores[i]);
+    }
+
+#if PICO_ON_DEVICE
+    ANEXAR(",p0=%lu,p1=%lu",
+           (unsigned long)pilha_usada(&__StackBottom, &__StackTop),
+           (unsigned long)pilha_usada(&__StackOneBottom, &__StackOneTop));
+#if !MEMORIA_ESTATICA
+    struct mallinfo heap = mallinfo(); // 'arena' só cresce: é a marca d'água do heap
+    ANEXAR(",hm=%lu,hu=%lu", (unsigned long)heap.arena, (unsigned long)heap.uordblks);
+#endif
+#endif
+
+    if (fila_monitorada) ANEXAR(",fm=%d", fila_monitorada->tamanho_max);
+
+    // Leituras de 16 bits do lwIP sem a trava: um retrato levemente defasado é aceitável
+#if MEM_STATS
+    ANEXAR(",mm=%lu,me=%lu", (unsigned long)lwip_stats.mem.max, (unsigned long)lwip_stats.mem.err);
+#endif
+#if MEMP_STATS
+    ANEXAR(",bm=%u,be=%u,sm=%u,se=%u",
+           (unsigned)lwip_stats.memp[MEMP_PBUF_POOL]->max, (unsigned)lwip_stats.memp[MEMP_PBUF_POOL]->err,
+           (unsigned)lwip_stats.memp[MEMP_TCP_SEG]->max, (unsigned)lwip_stats.memp[MEMP_TCP_SEG]->err);
+#endif
+
+#undef ANEXAR
+    return (int)(n < tamanho ? n : tamanho - 1);
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config/config_geral.h" // Para METRICAS_*
+#include "core0/fila_circular.h" // Para FilaCircularInterCore
+
+// Contadores do registro de métricas (os nomes curtos publicados ficam em metricas.c).
+// Cada contador tem um único escritor (núcleo 0 ou contexto lwIP), então não há trava.
+typedef enum {
+    METRICA_OLED_FLUSHES = 0,    // Renderizações completas enviadas ao SSD1306
+    METRICA_OLED_FLUSH_US,       // Tempo total gasto nessas renderizações (us)
+    METRICA_OLED_FLUSH_MAX_US,   // Renderização mais lenta (us)
+    METRICA_FILA_DESCARTES,      // Mensagens do Núcleo 1 descartadas com a fila cheia
+    METRICA_MQTT_PUB_OK,         // Publicações confirmadas pelo lwIP
+    METRICA_MQTT_PUB_FALHA,      // Publicações com erro no callback (timeout, conexão caída)
+    METRICA_MQTT_PUB_RECUSADA,   // Publicações recusadas antes de enfileirar (sem conexão, buffer cheio)
+    METRICA_MQTT_PUB_SUPRIMIDA,  // Valores não publicados por estarem dentro da zona morta
+    METRICA_MQTT_ACK_DESCARTADO, // Confirmações não entregues ao Núcleo 0 por FIFO cheia
+    METRICA_MQTT_PUB_DIRETA,     // Publicações entregues ao TCP sem o anel de saída (payload por referência)
+    METRICA_MQTT_BYTES_DIRETOS,  // Bytes de payload dessas publicações
+    METRICA_LZSS_BYTES_ENTRADA,  // Bytes dos lotes submetidos à compressão
+    METRICA_LZSS_BYTES_SAIDA,    // Bytes efetivamente publicados desses lotes
+    METRICA_LZSS_US,             // Tempo total gasto comprimindo (us)
+    METRICA_SONDA_ENVIADAS,      // Sondas de RTT publicadas
+    METRICA_SONDA_RESPOSTAS,     // Sondas respondidas pelo eco dentro do prazo
+    METRICA_SONDA_PERDIDAS,      // Sondas sem resposta em SONDA_TIMEOUT_MS
+    METRICA_SONDA_RTT_P50_US,    // Mediana do RTT na janela atual (valor, não contador)
+    METRICA_SONDA_RTT_P99_US,    // Percentil 99 do RTT na janela atual (valor, não contador)
+    METRICA_ENTRADA_RECEBIDAS,   // Mensagens assinadas remontadas e entregues ao Núcleo 0
+    METRICA_ENTRADA_DESCARTADAS, // Mensagens assinadas descartadas (pool cheio, grandes demais)
+    METRICA_ENTRADA_FILA_MAX,    // Maior número de mensagens aguardando o Núcleo 0
+    METRICA_BROKER_TROCAS,       // Conexões aceitas por um broker diferente do anterior
+    METRICA_BROKER_INTERRUPCAO_MS,     // Última interrupção: da falha ao próximo CONNACK (valor, não contador)
+    METRICA_BROKER_INTERRUPCAO_MAX_MS, // Pior interrupção
+    METRICA_BROKER_ATUAL,        // Índice em MQTT_BROKERS do broker conectado (valor, não contador)
+    METRICA_TLS_COMPLETOS,       // Conexões TLS com handshake completo
+    METRICA_TLS_RETOMADOS,       // Conexões TLS que retomaram a sessão guardada
+    METRICA_TLS_COMPLETO_MS,     // Último handshake completo: início da conexão até o CONNACK (valor, não contador)
+    METRICA_TLS_RETOMADO_MS,     // Idem, última retomada (valor, não contador)
+    METRICA_TLS_HEAP_MAX,        // Pico do heap estático do mbedTLS (bytes)
+    METRICA_RADIO_ATIVO_PERMIL,  // Fração estimada do tempo com o rádio acordado, em milésimos (valor, não contador)
+    METRICA_JANELA_ADIADAS,      // Publicações que esperaram a janela de transmissão
+    METRICA_JANELA_ATRASO_MS,    // Espera total dessas publicações (ms)
+    METRICA_JANELA_ATRASO_MAX_MS, // Maior espera
+    METRICA_JANELA_FORA,         // Lotes enviados fora da janela por falta de espaço
+    METRICA_EXECUTOR_NUCLEO0,    // Trabalhos do executor feitos pelo Núcleo 0
+    METRICA_EXECUTOR_NUCLEO1,    // Idem, pelo Núcleo 1
+    METRICA_EXECUTOR_ROUBADOS,   // Trabalhos feitos pelo núcleo que não os submeteu
+    METRICA_EXECUTOR_FILA_MAX,   // Maior ocupação de um deque do executor
+    METRICA_EXECUTOR_CHEIO,      // Trabalhos feitos na submissão por deque cheio
+    METRICA_AGENDADOR_DISPAROS,  // Temporizadores disparados no Núcleo 0
+    METRICA_AGENDADOR_ATRASO_MEDIO_US, // Atraso médio do disparo em relação ao prazo (valor, não contador)
+    METRICA_AGENDADOR_ATRASO_MAX_US,   // Maior atraso
+    METRICA_SAIDA_CHEIA,         // Publicações recusadas com a fila de saída cheia (REDE_POLL)
+    METRICA_SAIDA_FILA_MAX,      // Maior número de publicações aguardando o Núcleo 1
+    METRICA_SAIDA_ESPERA_MAX_US, // Maior espera de uma publicação na fila até o lwIP
+    METRICA_NUM
+} MetricaId;
+
+/**
+ * @brief Inicializa o registro e pinta as pilhas dos dois núcleos com um padrão
+ * conhecido, para a medição da marca d'água. Deve ser a primeira chamada de
+ * main(), antes de multicore_launch_core1().
+ */
+void metricas_inicializar(void);
+
+/**
+ * @brief Registra a fila inter-core cuja profundidade máxima será publicada.
+ */
+void metricas_registrar_fila(const FilaCircularInterCore *fila);
+
+/**
+ * @brief Registra uma função chamada no início de metricas_formatar para as métricas
+ * que só são calculadas sob demanda (ex.: a fração ativa do rádio). Cabem
+ * METRICAS_MAX_ATUALIZACOES; as excedentes são ignoradas.
+ */
+void metricas_registrar_atualizacao(void (*atualizar)(void));
+
+/**
+ * @brief Soma um valor a um contador.
+ */
+void metricas_somar(MetricaId id, uint32_t valor);
+
+/**
+ * @brief Atualiza um contador de máximo.
+ */
+void metricas_maximo(MetricaId id, uint32_t valor);
+
+/**
+ * @brief Substitui o valor de uma métrica que não é contador (ex.: um percentil).
+ */
+void metricas_definir(MetricaId id, uint32_t valor);
+
+static inline void metricas_incrementar(MetricaId id) { metricas_somar(id, 1); }
+
+/**
+ * @brief Registra a duração de uma iteração do superloop do Núcleo 0 (sem a pausa
+ * final) no histograma de METRICAS_NUM_FAIXAS_LOOP faixas.
+ *
+ * @param duracao_us Tempo de trabalho da iteração.
+ */
+void metricas_registrar_loop(uint32_t duracao_us);
+
+/**
+ * @brief Monta o retrato compacto das métricas no formato "chave=valor,...".
+ *
+ * Chaves: t (uptime s), li/lm/lh (iterações do loop, pior iteração em us,
+ * histograma por faixa separado por '/'), of/ou/om (flushes do OLED, tempo total
+ * e máximo em us), p0/p1 (bytes de pilha usados por núcleo), hm/hu (heap C:
+ * marca d'água e uso atual; ausentes com MEMORIA_ESTATICA), fm/fd (profundidade
+ * máxima da fila e descartes), po/pf/pr/ps (publicações MQTT ok, com falha, recusadas e
+ * suprimidas pela zona morta), pa (confirmações descartadas com a FIFO para o
+ * Núcleo 0 cheia), pd/pb (publicações diretas e seus bytes de
+ * payload, sem cópia), ze/zs/zu (compressão: bytes de entrada,
+ * de saída e tempo em us; economia = ze - zs), rs/rr/rl/r5/r9 (sondas de
+ * RTT enviadas, respondidas e perdidas; p50 e p99 do RTT em us), er/ed/em
+ * (mensagens recebidas, descartadas e maior fila de entrada), ct/cu/cx/ca (trocas
+ * de broker, última e pior interrupção em ms, broker atual), tc/tr/tf/tk/th
+ * (handshakes TLS completos e retomados, último tempo até o CONNACK de cada um
+ * em ms e pico do heap do mbedTLS em bytes; zeros sem MQTT_TLS), ra (fração do
+ * tempo com o rádio acordado, em milésimos), jd/ja/jx/jf (publicações adiadas
+ * até a janela de transmissão, espera total e máxima em ms, lotes que saíram fora
+ * dela; ver MODO_ENERGIA), x0/x1/xr/xm/xc (trabalhos do executor feitos por
+ * cada núcleo, roubados, maior ocupação de um deque e feitos na submissão por
+ * deque cheio), gd/gm/gx (temporizadores disparados no Núcleo 0, atraso
+ * médio e máximo do disparo em us: o jitter do agendador), qc/qm/qx (fila de
+ * saída para o Núcleo 1 com REDE_POLL: publicações recusadas com ela cheia, maior
+ * ocupação e maior espera até o lwIP em us), mm/me (heap do lwIP:
+ * pico e falhas), bm/be (pool de pbufs: pico e falhas), sm/se (segmentos TCP:
+ * pico e falhas).
+ *
+ * @return Número de caracteres escritos (sem o terminador).
+ */
+int metricas_formatar(char *destino, size_t tamanho);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+/**
+ * @file perfil_clock.c
+ * @brief Perfis de clock do sistema (baixo consumo, padrão e desempenho).
+ *
+ * A 200 MHz o regulador sobe para 1,15 V antes da troca do PLL. O divisor da
+ * flash do boot2 padrão (PICO_FLASH_SPI_CLKDIV = 2) resulta em 100 MHz no SCK,
+ * dentro dos 133 MHz da W25Q16 da Pico W, então o boot2 não precisa mudar.
+ * O divisor do PIO do barramento do CYW43 é ajustado pelo CMake por perfil
+ * (CYW43_PIO_CLOCK_DIV_INT) para manter o gSPI perto dos 31 MHz originais.
+ */
+
+#include "shared/perfil_clock.h"
+#include "hardware/clocks.h" // Para set_sys_clock_khz, set_sys_clock_48mhz
+#include "hardware/vreg.h"   // Para vreg_set_voltage
+#include "hardware/timer.h"  // Para busy_wait_us
+
+#define PERFIL_DESEMPENHO_KHZ 200000
+#define ESTABILIZACAO_VREG_US 1000 // Espera após subir a tensão, antes de acelerar o clock
+
+#if PERFIL_CLOCK != PERFIL_CLOCK_BAIXO_CONSUMO && PERFIL_CLOCK != PERFIL_CLOCK_PADRAO && \
+    PERFIL_CLOCK != PERFIL_CLOCK_DESEMPENHO
+#error "PERFIL_CLOCK inválido (use 1 = 48 MHz, 2 = 125 MHz, 3 = 200 MHz)"
+#endif
+
+void perfil_clock_aplicar(void) {
+#if PERFIL_CLOCK == PERFIL_CLOCK_BAIXO_CONSUMO
+    set_sys_clock_48mhz(); // clk_sys e clk_peri passam a vir do PLL_USB, que já alimenta o USB
+#elif PERFIL_CLOCK == PERFIL_CLOCK_DESEMPENHO
+    vreg_set_voltage(VREG_VOLTAGE_1_15);
+    busy_wait_us(ESTABILIZACAO_VREG_US);
+    set_sys_clock_khz(PERFIL_DESEMPENHO_KHZ, true);
+#endif
+    // PERFIL_CLOCK_PADRAO: mantém a configuração feita pelo runtime do SDK
+}
+
+const char *perfil_clock_nome(void) {
+#if PERFIL_CLOCK == PERFIL_CLOCK_BAIXO_CONSUMO
+    return "baixo_consumo";
+#elif PERFIL_CLOCK == PERFIL_CLOCK_DESEMPENHO
+    return "desempenho";
+#else
+    return "padrao";
+#endif
+}
\ No newline at end of file
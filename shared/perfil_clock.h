@@ -0,0 +1,26 @@
+#ifndef PERFIL_CLOCK_H
+#define PERFIL_CLOCK_H
+
+#include <stdint.h>
+#include "config/config_geral.h" // Para PERFIL_CLOCK
+
+// Perfis de clock do sistema (escolhidos por -DPERFIL_CLOCK=1|2|3 no CMake)
+#define PERFIL_CLOCK_BAIXO_CONSUMO 1 // 48 MHz a partir do PLL_USB; PLL_SYS desligado
+#define PERFIL_CLOCK_PADRAO        2 // 125 MHz, padrão do SDK
+#define PERFIL_CLOCK_DESEMPENHO    3 // 200 MHz com o regulador em 1,15 V
+
+/**
+ * @brief Aplica o perfil de clock escolhido no build.
+ * Deve ser a primeira configuração de hardware do Núcleo 0: os periféricos
+ * inicializados depois (stdio, I2C do OLED, PWM do LED) calculam seus divisores a
+ * partir do clk_sys já definitivo, mantendo as mesmas frequências em todos os perfis.
+ * O timer de 1 us não depende do clk_sys (é derivado do clk_ref).
+ */
+void perfil_clock_aplicar(void);
+
+/**
+ * @brief Nome curto do perfil compilado, para logs e benchmarks.
+ */
+const char *perfil_clock_nome(void);
+
+#endif
\ No newline at end of file
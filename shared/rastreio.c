@@ -0,0 +1,92 @@
+/**
+ * @file rastreio.c
+ * @brief Rastreio leve de trechos críticos (spans e eventos instantâneos) por núcleo.
+ *
+ * Os eventos são gravados em um buffer circular em RAM por núcleo, com o
+ * carimbo de tempo do timer de 1 MHz do RP2040. Como o timer é único para os
+ * dois núcleos, os eventos de core0 e core1 podem ser intercalados no host.
+ * Com HABILITAR_RASTREIO = 0 este arquivo não gera código.
+ */
+
+#include "shared/rastreio.h"
+
+#if HABILITAR_RASTREIO
+
+#include "hardware/sync.h"  // Para save_and_disable_interrupts
+#include "hardware/timer.h" // Para timer_hw
+#include "pico/platform.h"  // Para get_core_num
+#include "shared/secao_ram.h" // Para FUNC_RAM
+#include <stdio.h>
+
+#if (RASTREIO_TAM_BUFFER & (RASTREIO_TAM_BUFFER - 1)) != 0
+#error "RASTREIO_TAM_BUFFER deve ser potência de 2"
+#endif
+
+// Evento gravado no buffer (8 bytes)
+typedef struct {
+    uint32_t tempo_us;
+    uint8_t tipo;
+    uint8_t id;
+} EventoRastreio;
+
+// Buffer circular de um núcleo; 'escritos' conta o total e define a posição
+typedef struct {
+    EventoRastreio eventos[RASTREIO_TAM_BUFFER];
+    uint32_t escritos;
+} BufferRastreio;
+
+static BufferRastreio buffers_rastreio[2];
+static volatile bool rastreio_pausado = false;
+
+// Nomes exportados na ordem de RastreioId
+static const char *const nomes_rastreio[RASTREIO_NUM_IDS] = {
+    "ssd1306_render",
+    "verificar_fifo_do_core1",
+    "util_tratar_mensagem_intercore",
+    "publicar_mensagem_mqtt",
+    "mqtt_callback_conexao",
+    "mqtt_callback_publicacao",
+    "fifo_push_core1",
+    "loop_core0",
+};
+
+static const char tipos_rastreio[] = {'B', 'E', 'i'};
+
+void FUNC_RAM(rastreio_registrar)(uint8_t tipo, uint8_t id) {
+    if (rastreio_pausado) return;
+
+    BufferRastreio *b = &buffers_rastreio[get_core_num()];
+    uint32_t estado_irq = save_and_disable_interrupts();
+    EventoRastreio *e = &b->eventos[b->escritos & (RASTREIO_TAM_BUFFER - 1)];
+    e->tempo_us = timer_hw->timerawl;
+    e->tipo = tipo;
+    e->id = id;
+    b->escritos++;
+    restore_interrupts(estado_irq);
+}
+
+void rastreio_despejar(void) {
+    rastreio_pausado = true; // Evita que o buffer mude durante a exportação
+
+    printf("#RASTREIO v1\n");
+    for (int nucleo = 0; nucleo < 2; nucleo++) {
+        const BufferRastreio *b = &buffers_rastreio[nucleo];
+        uint32_t total = b->escritos;
+        // Se o buffer deu a volta, os mais antigos foram sobrescritos
+        uint32_t inicio = (total > RASTREIO_TAM_BUFFER) ? total - RASTREIO_TAM_BUFFER : 0;
+
+        for (uint32_t i = inicio; i < total; i++) {
+            const EventoRastreio *e = &b->eventos[i & (RASTREIO_TAM_BUFFER - 1)];
+            if (e->id >= RASTREIO_NUM_IDS || e->tipo > RASTREIO_TIPO_INSTANTE) continue;
+            printf("R,%d,%lu,%c,%s\n", nucleo, (unsigned long)e->tempo_us,
+                   tipos_rastreio[e->tipo], nomes_rastreio[e->id]);
+        }
+    }
+    printf("#FIM\n");
+
+    buffers_rastreio[0].escritos = 0;
+    buffers_rastreio[1].escritos = 0;
+    rastreio_pausado = false;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef RASTREIO_H
+#define RASTREIO_H
+
+#include <stdint.h>
+#include "config/config_geral.h" // Para HABILITAR_RASTREIO e RASTREIO_TAM_BUFFER
+
+// Tipos de evento, no mesmo sentido das fases "B", "E" e "i" do formato Chrome/Perfetto
+#define RASTREIO_TIPO_INICIO   0
+#define RASTREIO_TIPO_FIM      1
+#define RASTREIO_TIPO_INSTANTE 2
+
+// Identificadores dos pontos instrumentados (os nomes ficam em rastreio.c)
+typedef enum {
+    RASTREIO_ID_SSD1306_RENDER = 0,
+    RASTREIO_ID_VERIFICAR_FIFO,
+    RASTREIO_ID_TRATAR_MENSAGEM,
+    RASTREIO_ID_PUBLICAR_MQTT,
+    RASTREIO_ID_MQTT_CB_CONEXAO,
+    RASTREIO_ID_MQTT_CB_PUBLICACAO,
+    RASTREIO_ID_FIFO_PUSH_CORE1,
+    RASTREIO_ID_LOOP_CORE0,
+    RASTREIO_NUM_IDS
+} RastreioId;
+
+#if HABILITAR_RASTREIO
+
+/**
+ * @brief Registra um evento no buffer do núcleo que está executando.
+ * Cada núcleo escreve apenas no seu próprio buffer circular; as interrupções
+ * ficam desabilitadas só durante a escrita do evento (callbacks lwIP rodam em IRQ).
+ *
+ * @param tipo RASTREIO_TIPO_INICIO, RASTREIO_TIPO_FIM ou RASTREIO_TIPO_INSTANTE.
+ * @param id Ponto instrumentado (RastreioId).
+ */
+void rastreio_registrar(uint8_t tipo, uint8_t id);
+
+/**
+ * @brief Exporta pela serial o conteúdo dos buffers dos dois núcleos.
+ * Formato de cada linha: "R,<nucleo>,<tempo_us>,<B|E|i>,<nome>".
+ * O script tools/rastreio_para_perfetto.py converte a saída para JSON Chrome/Perfetto.
+ */
+void rastreio_despejar(void);
+
+#define RASTREIO_INICIO(id)   rastreio_registrar(RASTREIO_TIPO_INICIO, (id))
+#define RASTREIO_FIM(id)      rastreio_registrar(RASTREIO_TIPO_FIM, (id))
+#define RASTREIO_INSTANTE(id) rastreio_registrar(RASTREIO_TIPO_INSTANTE, (id))
+
+#else // Rastreio desabilitado: nenhuma chamada nem buffer é gerado
+
+#define RASTREIO_INICIO(id)   ((void)0)
+#define RASTREIO_FIM(id)      ((void)0)
+#define RASTREIO_INSTANTE(id) ((void)0)
+
+#endif
+
+#endif
\ No newline at end of file
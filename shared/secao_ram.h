@@ -0,0 +1,49 @@
+#ifndef SECAO_RAM_H
+#define SECAO_RAM_H
+
+/**
+ * @file secao_ram.h
+ * @brief Posicionamento opcional das funções e tabelas do caminho crítico em SRAM.
+ *
+ * Por padrão todo o código roda da flash QSPI via XIP, e uma falta no cache de
+ * 16 KB (disputado com o driver CYW43) custa dezenas de ciclos por linha. Com
+ * CODIGO_EM_RAM (opção do CMake) as funções marcadas são copiadas para a RAM no boot:
+ *   0 = nada muda (tudo em flash);
+ *   1 = SRAM principal (seções .time_critical do SDK);
+ *   2 = bancos scratch por núcleo: o caminho do Núcleo 0 no SCRATCH_Y e o do
+ *       Núcleo 1/contexto lwIP no SCRATCH_X, cada um junto da pilha do seu núcleo,
+ *       sem disputar os bancos da SRAM principal. Cada banco tem 4 KB, dos quais
+ *       2 KB são a pilha; o linker falha se o código não couber.
+ *
+ * Uso na definição (não no protótipo):
+ *   bool FUNC_RAM_NUCLEO0(fila_intercore_inserir)(FilaCircularInterCore *f, ...)
+ *   static const uint16_t tabela[256] DADOS_RAM("tabela") = {...};
+ *
+ * Funções do SDK chamadas a partir delas (i2c, mutex, printf) continuam na flash.
+ * `tools/relatorio_secoes.py` (alvo `relatorio_memoria`) mostra onde cada símbolo ficou.
+ */
+
+#include "pico/platform.h"      // Para __not_in_flash_func, __scratch_x/y
+#include "config/config_geral.h" // Para CODIGO_EM_RAM
+
+#if CODIGO_EM_RAM == 0
+#define FUNC_RAM(func) func
+#define FUNC_RAM_NUCLEO0(func) func
+#define FUNC_RAM_NUCLEO1(func) func
+#define DADOS_RAM(grupo)
+#elif CODIGO_EM_RAM == 1
+#define FUNC_RAM(func) __not_in_flash_func(func)
+#define FUNC_RAM_NUCLEO0(func) __not_in_flash_func(func)
+#define FUNC_RAM_NUCLEO1(func) __not_in_flash_func(func)
+#define DADOS_RAM(grupo) __not_in_flash(grupo)
+#elif CODIGO_EM_RAM == 2
+// Código chamado pelos dois núcleos fica na SRAM principal
+#define FUNC_RAM(func) __not_in_flash_func(func)
+#define FUNC_RAM_NUCLEO0(func) __scratch_y(__STRING(func)) func
+#define FUNC_RAM_NUCLEO1(func) __scratch_x(__STRING(func)) func
+#define DADOS_RAM(grupo) __not_in_flash(grupo)
+#else
+#error "CODIGO_EM_RAM inválido (use 0 = flash, 1 = SRAM, 2 = scratch por núcleo)"
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#!/usr/bin/env bash
+# Compara as duas arquiteturas de rede no build nativo (host/bench_rede.c):
+# lwIP em segundo plano (threadsafe_background) e em polling no núcleo 1
+# (-DREDE_POLL=ON). Configura e compila um build de cada, roda o benchmark nos
+# dois e imprime lado a lado vazão, latência até o ACK e duração do loop do núcleo 0.
+#
+# Uso:
+#   tools/bench_rede.sh [publicacoes]
+#
+# Variáveis de ambiente:
+#   BUILD_BASE            prefixo dos diretórios de build (padrão: build_bench_rede)
+#   HOST_LATENCIA_ACK_US  latência emulada do broker (padrão: 0, só o custo do firmware)
+#
+# Nos threads do host não há preempção por IRQ: o custo do modo em segundo plano
+# aparece como disputa da trava do lwIP entre o núcleo 0 e o contexto emulado.
+
+set -euo pipefail
+
+RAIZ=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_BASE=${BUILD_BASE:-build_bench_rede}
+PUBLICACOES=${1:-2000}
+export HOST_LATENCIA_ACK_US=${HOST_LATENCIA_ACK_US:-0}
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+for arquitetura in background poll; do
+    dir="$BUILD_BASE/$arquitetura"
+    poll=OFF
+    [ "$arquitetura" = poll ] && poll=ON
+    if ! { cmake -S "$RAIZ/host" -B "$dir" -DREDE_POLL=$poll -Wno-dev &&
+           cmake --build "$dir" --target MQTTPicoRF_bench_rede -j"$(nproc)"; } > "$TMP/build.log" 2>&1; then
+        cat "$TMP/build.log"
+        exit 1
+    fi
+    echo "== $arquitetura"
+    "$dir/MQTTPicoRF_bench_rede" "$PUBLICACOES" > "$TMP/$arquitetura.log" 2> "$TMP/$arquitetura.err"
+    grep -v '^Benchmark' "$TMP/$arquitetura.err" || true
+    grep '^RESULTADO' "$TMP/$arquitetura.log" > "$TMP/$arquitetura.res"
+done
+
+# Tabela: uma linha por métrica, as duas arquiteturas e a razão poll/background
+awk '
+    FNR == 1 { arquivo++ }
+    {
+        for (i = 2; i <= NF; i++) {
+            split($i, kv, "=")
+            if (arquivo == 1) { ordem[++n] = kv[1]; bg[kv[1]] = kv[2] } else poll[kv[1]] = kv[2]
+        }
+    }
+    END {
+        printf "\n%-16s %14s %14s %10s\n", "metrica", "background", "poll", "poll/bg"
+        for (i = 1; i <= n; i++) {
+            k = ordem[i]
+            if (k == "arquitetura") continue
+            razao = bg[k] + 0 != 0 ? sprintf("%.2f", poll[k] / bg[k]) : "-"
+            printf "%-16s %14s %14s %10s\n", k, bg[k], poll[k], razao
+        }
+    }
+' "$TMP/background.res" "$TMP/poll.res"
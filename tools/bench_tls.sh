@@ -0,0 +1,92 @@
+#!/usr/bin/env bash
+# Benchmark de handshakes TLS (completo x retomado) do alvo de rede nativo
+# (host/rede/bench_tls.c) contra um mosquitto local com TLS.
+#
+# Uso:
+#   tools/bench_tls.sh ca              # gera a CA de teste (uma vez, antes de configurar o build)
+#   sudo tools/bench_tls.sh [repeticoes]
+#
+# O build precisa de -DMQTT_TLS=ON -DMBEDTLS_DIR=... e, para que a cadeia do
+# broker seja verificada como no firmware, -DMQTT_TLS_CA=$DIR_CA/ca.pem
+# (ver host/rede/CMakeLists.txt). O certificado do broker é ECDSA P-256 com o
+# IP da TAP no CN e no subjectAltName, e o listener aceita só TLS 1.2.
+#
+# Variáveis de ambiente:
+#   BUILD_DIR   diretório do build com -DLWIP_DIR e -DMQTT_TLS=ON (padrão: build_rede)
+#   DIR_CA      onde ficam a CA e o certificado do broker (padrão: $BUILD_DIR/tls_bench)
+#   TAP         interface TAP (padrão: tap0)
+#   IP_BROKER   IP do host na TAP, igual a HOST_BROKER_IP do build (padrão: 192.168.50.1)
+#   IP_PICO     IP do "Pico" emulado (padrão: 192.168.50.2)
+#   PORTA_TLS   porta do listener TLS, igual a MQTT_BROKER_PORT (padrão: 8883)
+#
+# A última linha impressa é o "RESULTADO ..." do executor: percentis do tempo até
+# o CONNACK e pico do heap do mbedTLS de cada tipo de handshake.
+
+set -euo pipefail
+
+BUILD_DIR=${BUILD_DIR:-build_rede}
+DIR_CA=${DIR_CA:-$BUILD_DIR/tls_bench}
+TAP=${TAP:-tap0}
+IP_BROKER=${IP_BROKER:-192.168.50.1}
+IP_PICO=${IP_PICO:-192.168.50.2}
+PORTA_TLS=${PORTA_TLS:-8883}
+
+gerar_ca() {
+    command -v openssl >/dev/null || { echo "openssl não encontrado no PATH"; exit 1; }
+    mkdir -p "$DIR_CA"
+    openssl ecparam -name prime256v1 -genkey -noout -out "$DIR_CA/ca.key"
+    openssl req -x509 -new -key "$DIR_CA/ca.key" -sha256 -days 3650 -subj "/CN=MQTTPicoRF CA de teste" \
+        -out "$DIR_CA/ca.pem"
+    openssl ecparam -name prime256v1 -genkey -noout -out "$DIR_CA/broker.key"
+    openssl req -new -key "$DIR_CA/broker.key" -subj "/CN=$IP_BROKER" -out "$DIR_CA/broker.csr"
+    printf "subjectAltName=IP:%s\n" "$IP_BROKER" > "$DIR_CA/broker.ext"
+    openssl x509 -req -in "$DIR_CA/broker.csr" -CA "$DIR_CA/ca.pem" -CAkey "$DIR_CA/ca.key" \
+        -CAcreateserial -days 3650 -sha256 -extfile "$DIR_CA/broker.ext" -out "$DIR_CA/broker.pem"
+    echo "CA de teste em $DIR_CA/ca.pem (configure o build com -DMQTT_TLS_CA=$DIR_CA/ca.pem)"
+}
+
+if [ "${1:-}" = "ca" ]; then
+    gerar_ca
+    exit 0
+fi
+REPETICOES=${1:-20}
+
+EXECUTOR="$BUILD_DIR/host/rede/MQTTPicoRF_tls"
+[ -x "$EXECUTOR" ] || { echo "Executor não encontrado: $EXECUTOR (configure com -DLWIP_DIR=... -DMQTT_TLS=ON -DMBEDTLS_DIR=...)"; exit 1; }
+command -v mosquitto >/dev/null || { echo "mosquitto não encontrado no PATH"; exit 1; }
+[ -f "$DIR_CA/broker.pem" ] || gerar_ca
+
+TMP=$(mktemp -d)
+CONF="$TMP/mosquitto.conf"
+cat > "$CONF" <<CONF
+listener $PORTA_TLS $IP_BROKER
+cafile $DIR_CA/ca.pem
+certfile $DIR_CA/broker.pem
+keyfile $DIR_CA/broker.key
+tls_version tlsv1.2
+allow_anonymous true
+persistence false
+CONF
+
+PID_BROKER=""
+limpar() {
+    [ -n "$PID_BROKER" ] && kill "$PID_BROKER" 2>/dev/null || true
+    ip link del "$TAP" 2>/dev/null || true
+    rm -rf "$TMP"
+}
+trap limpar EXIT
+
+# Interface TAP com o IP do broker; o executor a abre via PRECONFIGURED_TAPIF
+ip tuntap add dev "$TAP" mode tap
+ip addr add "$IP_BROKER/24" dev "$TAP"
+ip link set "$TAP" up
+
+mosquitto -c "$CONF" > "$TMP/mosquitto.log" 2>&1 &
+PID_BROKER=$!
+sleep 0.5
+
+export PRECONFIGURED_TAPIF="$TAP" HOST_IP="$IP_PICO" HOST_MASCARA=255.255.255.0 HOST_GW="$IP_BROKER" HOST_PERDA_PCT=0
+echo "Benchmark TLS: $REPETICOES handshakes de cada tipo com $IP_BROKER:$PORTA_TLS"
+"$EXECUTOR" "$REPETICOES" > "$TMP/executor.log"
+grep -E '^\[TLS\]' "$TMP/executor.log" | tail -n 4 || true
+grep '^RESULTADO' "$TMP/executor.log"
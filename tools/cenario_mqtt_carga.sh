@@ -0,0 +1,119 @@
+#!/usr/bin/env bash
+# Cenários de carga MQTT no alvo de rede nativo (host/rede) contra um mosquitto local.
+#
+# Uso (requer root para criar a interface TAP):
+#   sudo tools/cenario_mqtt_carga.sh <sustentado|reinicio|perda|failover> [taxa_msgs_s] [duracao_s] [bytes_payload]
+#
+# Variáveis de ambiente:
+#   BUILD_DIR   diretório do build com -DLWIP_DIR (padrão: build_rede)
+#   TAP         interface TAP (padrão: tap0)
+#   IP_BROKER   IP do host na TAP, igual a HOST_BROKER_IP do build (padrão: 192.168.50.1)
+#   IP_PICO     IP do "Pico" emulado (padrão: 192.168.50.2)
+#   PERDA_PCT   perda por sentido no cenário "perda" (padrão: 5)
+#   PAUSA_BROKER_S  tempo com o broker parado nos cenários "reinicio" e "failover" (padrão: 3)
+#   PORTA_RESERVA   porta do broker reserva do cenário "failover", igual a
+#                   MQTT_BROKER_RESERVA_PORT do build (padrão: 1884)
+#
+# No cenário "failover" um segundo mosquitto escuta em PORTA_RESERVA; o principal
+# cai na metade e volta após a pausa. O tempo de recuperação mede a troca para o
+# reserva (core1/failover_broker.h); a volta ao preferido ocorre após BROKER_RETORNO_MS.
+#
+# A última linha impressa é o "RESULTADO ..." do executor, com msgs/s, percentis
+# de latência do ACK e tempos de recuperação.
+
+set -euo pipefail
+
+CENARIO=${1:-sustentado}
+TAXA=${2:-100}
+DURACAO=${3:-30}
+BYTES=${4:-64}
+
+BUILD_DIR=${BUILD_DIR:-build_rede}
+TAP=${TAP:-tap0}
+IP_BROKER=${IP_BROKER:-192.168.50.1}
+IP_PICO=${IP_PICO:-192.168.50.2}
+PERDA_PCT=${PERDA_PCT:-5}
+PAUSA_BROKER_S=${PAUSA_BROKER_S:-3}
+PORTA_RESERVA=${PORTA_RESERVA:-1884}
+
+EXECUTOR="$BUILD_DIR/host/rede/MQTTPicoRF_cenario"
+[ -x "$EXECUTOR" ] || { echo "Executor não encontrado: $EXECUTOR (configure com -DMQTTPICORF_HOST=ON -DLWIP_DIR=...)"; exit 1; }
+command -v mosquitto >/dev/null || { echo "mosquitto não encontrado no PATH"; exit 1; }
+
+TMP=$(mktemp -d)
+CONF="$TMP/mosquitto.conf"
+cat > "$CONF" <<CONF
+listener 1883 $IP_BROKER
+allow_anonymous true
+persistence false
+CONF
+
+CONF_RESERVA="$TMP/mosquitto_reserva.conf"
+cat > "$CONF_RESERVA" <<CONF
+listener $PORTA_RESERVA $IP_BROKER
+allow_anonymous true
+persistence false
+CONF
+
+# O PID do broker principal fica num arquivo: o reinício no meio do cenário roda
+# num subshell em segundo plano, e limpar precisa encerrar o broker que ele iniciou
+ARQ_PID_BROKER="$TMP/mosquitto.pid"
+PID_RESERVA=""
+PID_REINICIO=""
+iniciar_broker() {
+    mosquitto -c "$CONF" > "$TMP/mosquitto.log" 2>&1 &
+    echo $! > "$ARQ_PID_BROKER"
+    sleep 0.5
+}
+parar_broker() {
+    local pid
+    pid=$(cat "$ARQ_PID_BROKER" 2>/dev/null) || return 0
+    rm -f "$ARQ_PID_BROKER"
+    kill "$pid" 2>/dev/null || return 0
+    wait "$pid" 2>/dev/null || true # Filho deste shell: recolhe o processo
+    while kill -0 "$pid" 2>/dev/null; do sleep 0.1; done # Iniciado em outro shell: espera a porta ser liberada
+}
+# Derruba o broker principal na metade do cenário e o reinicia após a pausa
+reiniciar_broker_no_meio() {
+    ( sleep $((DURACAO / 2)); parar_broker; sleep "$PAUSA_BROKER_S"; iniciar_broker ) &
+    PID_REINICIO=$!
+}
+limpar() {
+    # Primeiro o temporizador do reinício, para que ele não inicie um broker depois daqui
+    [ -n "$PID_REINICIO" ] && kill "$PID_REINICIO" 2>/dev/null && wait "$PID_REINICIO" 2>/dev/null || true
+    parar_broker
+    [ -n "$PID_RESERVA" ] && kill "$PID_RESERVA" 2>/dev/null || true
+    ip link del "$TAP" 2>/dev/null || true
+    rm -rf "$TMP"
+}
+trap limpar EXIT
+
+# Interface TAP com o IP do broker; o executor a abre via PRECONFIGURED_TAPIF
+ip tuntap add dev "$TAP" mode tap
+ip addr add "$IP_BROKER/24" dev "$TAP"
+ip link set "$TAP" up
+
+iniciar_broker
+
+export PRECONFIGURED_TAPIF="$TAP" HOST_IP="$IP_PICO" HOST_MASCARA=255.255.255.0 HOST_GW="$IP_BROKER"
+case "$CENARIO" in
+    sustentado) export HOST_PERDA_PCT=0 ;;
+    perda)      export HOST_PERDA_PCT="$PERDA_PCT" ;;
+    reinicio)
+        export HOST_PERDA_PCT=0
+        reiniciar_broker_no_meio
+        ;;
+    failover)
+        export HOST_PERDA_PCT=0
+        mosquitto -c "$CONF_RESERVA" > "$TMP/mosquitto_reserva.log" 2>&1 &
+        PID_RESERVA=$!
+        sleep 0.5
+        reiniciar_broker_no_meio
+        ;;
+    *) echo "Cenário desconhecido: $CENARIO"; exit 2 ;;
+esac
+
+echo "Cenário '$CENARIO': $TAXA msgs/s, $DURACAO s, $BYTES bytes"
+"$EXECUTOR" "$TAXA" "$DURACAO" "$BYTES" > "$TMP/executor.log"
+grep -E '^\[(CENARIO|BROKER)\]' "$TMP/executor.log" || true
+grep '^RESULTADO' "$TMP/executor.log" | sed "s/^RESULTADO/RESULTADO cenario=$CENARIO/"
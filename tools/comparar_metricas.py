@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""
+Compara dois retratos de métricas do firmware (linhas "#METRICAS ..." do comando
+'m' na serial, ou o payload publicado em pico/metricas), por exemplo antes e
+depois de -DCODIGO_EM_RAM. Usa o último retrato de cada arquivo.
+
+Uso:
+    python3 tools/comparar_metricas.py antes.txt depois.txt
+
+Mostra a pior iteração do loop do Núcleo 0, os percentis aproximados pelo
+histograma (limite superior da faixa) e o tempo médio/máximo de renderização do OLED.
+"""
+
+import argparse
+
+# Limites superiores (us) das faixas do histograma, como em shared/metricas.c
+LIMITES_FAIXAS_LOOP = [100, 500, 1000, 5000, 10000, 50000, 100000]
+
+
+def ultimo_retrato(caminho):
+    retrato = None
+    with open(caminho, encoding="utf-8", errors="replace") as f:
+        for linha in f:
+            linha = linha.strip()
+            if linha.startswith("#METRICAS "):
+                linha = linha[len("#METRICAS "):]
+            if linha.startswith("t=") and ",lh=" in linha:
+                retrato = dict(par.split("=", 1) for par in linha.split(",") if "=" in par)
+    if retrato is None:
+        raise SystemExit(f"{caminho}: nenhum retrato de métricas encontrado")
+    return retrato
+
+
+def percentil_faixa(histograma, p):
+    total = sum(histograma)
+    if total == 0:
+        return "-"
+    acumulado = 0
+    for i, n in enumerate(histograma):
+        acumulado += n
+        if acumulado * 100 >= total * p:
+            return f"<{LIMITES_FAIXAS_LOOP[i]}" if i < len(LIMITES_FAIXAS_LOOP) else f">={LIMITES_FAIXAS_LOOP[-1]}"
+    return "-"
+
+
+def resumo(r):
+    histograma = [int(x) for x in r["lh"].split("/")]
+    flushes = int(r.get("of", 0))
+    return {
+        "iterações do loop": r["li"],
+        "pior iteração (us)": r["lm"],
+        "p50 do loop (us)": percentil_faixa(histograma, 50),
+        "p99 do loop (us)": percentil_faixa(histograma, 99),
+        "renderizações OLED": flushes,
+        "render médio (us)": f"{int(r.get('ou', 0)) / flushes:.0f}" if flushes else "-",
+        "render máximo (us)": r.get("om", "-"),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("antes")
+    parser.add_argument("depois")
+    args = parser.parse_args()
+
+    antes, depois = resumo(ultimo_retrato(args.antes)), resumo(ultimo_retrato(args.depois))
+    print(f"{'':<22} {'antes':>12} {'depois':>12}")
+    for chave in antes:
+        print(f"{chave:<22} {antes[chave]!s:>12} {depois[chave]!s:>12}")
+
+
+if __name__ == "__main__":
+    main()
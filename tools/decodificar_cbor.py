@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+Decodifica os resumos de sensores publicados em CBOR (SENSORES_FORMATO_CBOR=1)
+e os imprime em JSON, já convertidos para mV e °C. Sem dependências externas.
+
+Entrada (arquivo ou stdin), uma publicação por linha:
+    pico/sensores 1185...            (captura do host: HOST_MQTT_CAPTURA=arquivo)
+    1185...                          (só o payload em hexadecimal)
+Cada payload começa com o byte de cabeçalho dos lotes e pode estar comprimido
+(ver tools/descomprimir_lzss.py). Depois dele pode haver vários resumos
+seguidos (sequência CBOR, RFC 8742).
+
+Uso:
+    python3 tools/decodificar_cbor.py captura.txt [--topico pico/sensores] [--bruto]
+
+Esquema (versão 1, ver aquisicao_adc_codificar_resumo em drivers/adc/aquisicao_adc.h):
+    [versão, blocos, janela_ms, vref_mv, [entrada, ...]]
+    entrada = [número, n, mín, máx - mín, média - mín, dp, p50 - mín, p90 - mín, p99 - mín]
+    Entradas externas: mín em contagens do ADC, o resto em 1/16 de contagem.
+    Entrada 4 (temperatura): tudo em m°C.
+"""
+
+import argparse
+import json
+import sys
+
+from descomprimir_lzss import abrir_payload, ler_publicacoes
+
+VERSAO_ESQUEMA = 1
+ENTRADA_TEMPERATURA = 4
+CAMPOS_DESLOCADOS = ("max", "media", "p50", "p90", "p99")
+
+
+class ErroCbor(Exception):
+    pass
+
+
+def decodificar_item(dados, pos):
+    """Decodifica um item a partir de dados[pos]; devolve (valor, próxima posição)."""
+    if pos >= len(dados):
+        raise ErroCbor("payload truncado")
+    inicial = dados[pos]
+    tipo, info = inicial >> 5, inicial & 0x1F
+    pos += 1
+    if info < 24:
+        argumento = info
+    elif info <= 27:
+        n = 1 << (info - 24)
+        if pos + n > len(dados):
+            raise ErroCbor("argumento truncado")
+        argumento = int.from_bytes(dados[pos:pos + n], "big")
+        pos += n
+    else:
+        raise ErroCbor(f"informação adicional {info} não suportada")
+
+    if tipo == 0:
+        return argumento, pos
+    if tipo == 1:
+        return -1 - argumento, pos
+    if tipo in (2, 3):
+        fim = pos + argumento
+        if fim > len(dados):
+            raise ErroCbor("cadeia truncada")
+        bruto = bytes(dados[pos:fim])
+        return (bruto if tipo == 2 else bruto.decode("utf-8")), fim
+    if tipo == 4:
+        itens = []
+        for _ in range(argumento):
+            item, pos = decodificar_item(dados, pos)
+            itens.append(item)
+        return itens, pos
+    if tipo == 5:
+        mapa = {}
+        for _ in range(argumento):
+            chave, pos = decodificar_item(dados, pos)
+            valor, pos = decodificar_item(dados, pos)
+            mapa[chave] = valor
+        return mapa, pos
+    raise ErroCbor(f"tipo maior {tipo} não suportado")
+
+
+def decodificar_sequencia(dados):
+    itens, pos = [], 0
+    while pos < len(dados):
+        item, pos = decodificar_item(dados, pos)
+        itens.append(item)
+    return itens
+
+
+def converter_resumo(resumo):
+    """Converte um resumo do esquema para unidades físicas."""
+    if not isinstance(resumo, list) or not resumo or resumo[0] != VERSAO_ESQUEMA:
+        raise ErroCbor(f"versão de esquema desconhecida: {resumo[0] if resumo else resumo}")
+    _, blocos, janela_ms, vref, entradas = resumo
+    saida = {"blocos": blocos, "janela_ms": janela_ms, "vref_mv": vref, "entradas": []}
+    for numero, n, minimo, d_max, d_media, dp, d_p50, d_p90, d_p99 in entradas:
+        deslocados = dict(zip(CAMPOS_DESLOCADOS, (d_max, d_media, d_p50, d_p90, d_p99)))
+        if numero == ENTRADA_TEMPERATURA:
+            e = {"entrada": numero, "n": n, "unidade": "C", "min": minimo / 1000, "dp": dp / 1000}
+            e.update({k: (minimo + v) / 1000 for k, v in deslocados.items()})
+        else:
+            mv_por_passo = vref / 4096 / 16
+            e = {"entrada": numero, "n": n, "unidade": "mV",
+                 "min": round(minimo * 16 * mv_por_passo, 2), "dp": round(dp * mv_por_passo, 2)}
+            e.update({k: round((minimo * 16 + v) * mv_por_passo, 2) for k, v in deslocados.items()})
+        saida["entradas"].append(e)
+    return saida
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("arquivo", nargs="?", help="captura (padrão: stdin)")
+    parser.add_argument("--topico", default="pico/sensores", help="só as linhas deste tópico (na captura do host)")
+    parser.add_argument("--bruto", action="store_true", help="imprime os itens sem converter unidades")
+    args = parser.parse_args()
+
+    entrada = open(args.arquivo, encoding="utf-8") if args.arquivo else sys.stdin
+    publicacoes = bytes_total = resumos = 0
+    for payload in ler_publicacoes(entrada, args.topico):
+        publicacoes += 1
+        bytes_total += len(payload)
+        try:
+            for item in decodificar_sequencia(abrir_payload(payload)):
+                print(json.dumps(item if args.bruto else converter_resumo(item), ensure_ascii=False))
+                resumos += 1
+        except (ErroCbor, ValueError, TypeError) as e:
+            print(f"publicação {publicacoes}: payload inválido: {e}", file=sys.stderr)
+            return 1
+
+    media = bytes_total / resumos if resumos else 0
+    print(f"# {publicacoes} publicações, {resumos} resumos, {media:.1f} bytes publicados/resumo", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+Descomprime payloads de lotes publicados pelo firmware: um byte de cabeçalho
+(versão nos bits 7-4, bit 0 = LZSS) seguido dos dados, comprimidos ou não.
+Também é importado por tools/decodificar_cbor.py.
+
+Entrada (arquivo ou stdin), uma publicação por linha, como em decodificar_cbor.py:
+    pico/sensores 1185...            (captura do host: HOST_MQTT_CAPTURA=arquivo)
+    1185...                          (só o payload em hexadecimal)
+
+Uso:
+    python3 tools/descomprimir_lzss.py captura.txt [--topico pico/sensores]
+
+Imprime cada payload descomprimido em hexadecimal (texto, se for UTF-8
+imprimível) e, no fim, a taxa de compressão total.
+
+Formato LZSS (shared/compressao_lzss.h): grupos de até 8 símbolos precedidos de
+um byte de flags (LSB primeiro); bit 1 = literal, bit 0 = referência de 2 bytes
+big-endian com distância - 1 nos LZSS_BITS_JANELA bits altos e comprimento - 3
+no restante.
+"""
+
+import argparse
+import sys
+
+VERSAO_CABECALHO = 1
+CABECALHO_LZSS = 0x01
+LZSS_BITS_JANELA = 10  # Como em config/config_geral.h
+LZSS_COMPRIMENTO_MIN = 3
+
+
+def lzss_descomprimir(dados, bits_janela=LZSS_BITS_JANELA):
+    saida = bytearray()
+    bits_comprimento = 16 - bits_janela
+    i = 0
+    while i < len(dados):
+        flags = dados[i]
+        i += 1
+        for bit in range(8):
+            if i >= len(dados):
+                break
+            if flags & (1 << bit):
+                saida.append(dados[i])
+                i += 1
+                continue
+            if i + 2 > len(dados):
+                raise ValueError("referência truncada")
+            ref = (dados[i] << 8) | dados[i + 1]
+            i += 2
+            distancia = (ref >> bits_comprimento) + 1
+            comprimento = (ref & ((1 << bits_comprimento) - 1)) + LZSS_COMPRIMENTO_MIN
+            if distancia > len(saida):
+                raise ValueError("referência antes do início")
+            for _ in range(comprimento):  # Byte a byte: a cópia pode sobrepor a saída
+                saida.append(saida[-distancia])
+    return bytes(saida)
+
+
+def abrir_payload(payload):
+    """Remove o byte de cabeçalho e descomprime, se for o caso."""
+    if not payload:
+        raise ValueError("payload vazio")
+    cabecalho = payload[0]
+    if cabecalho >> 4 != VERSAO_CABECALHO:
+        raise ValueError(f"versão de cabeçalho desconhecida: {cabecalho >> 4}")
+    corpo = payload[1:]
+    return lzss_descomprimir(corpo) if cabecalho & CABECALHO_LZSS else corpo
+
+
+def ler_publicacoes(entrada, topico):
+    """Gera os payloads (bytes) das linhas da captura para o tópico pedido."""
+    for linha in entrada:
+        partes = linha.split()
+        if not partes:
+            continue
+        if len(partes) == 2:
+            if partes[0] != topico:
+                continue
+            yield bytes.fromhex(partes[1])
+        else:
+            yield bytes.fromhex(partes[0])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("arquivo", nargs="?", help="captura (padrão: stdin)")
+    parser.add_argument("--topico", default="pico/sensores", help="só as linhas deste tópico (na captura do host)")
+    args = parser.parse_args()
+
+    entrada = open(args.arquivo, encoding="utf-8") if args.arquivo else sys.stdin
+    publicacoes = bytes_publicados = bytes_originais = 0
+    for payload in ler_publicacoes(entrada, args.topico):
+        dados = abrir_payload(payload)
+        publicacoes += 1
+        bytes_publicados += len(payload)
+        bytes_originais += len(dados)
+        try:
+            texto = dados.decode("utf-8")
+            print(texto if texto.isprintable() or "\n" in texto else dados.hex())
+        except UnicodeDecodeError:
+            print(dados.hex())
+
+    taxa = bytes_originais / bytes_publicados if bytes_publicados else 0
+    print(f"# {publicacoes} publicações, {bytes_originais} bytes originais, {bytes_publicados} publicados "
+          f"({taxa:.2f}x)", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
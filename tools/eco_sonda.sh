@@ -0,0 +1,25 @@
+#!/usr/bin/env bash
+# Cliente de eco da sonda de RTT (core0/sonda_rtt.c): republica cada mensagem de
+# TOPICO_SONDA em TOPICO_SONDA_ECO por uma única conexão, sem processo por mensagem.
+#
+# Uso:
+#   tools/eco_sonda.sh [ip_broker] [porta]
+#
+# Variáveis de ambiente:
+#   TOPICO_SONDA      padrão: pico/sonda (igual a config/config_geral.h)
+#   TOPICO_SONDA_ECO  padrão: pico/sonda/eco
+#
+# Requer mosquitto_sub e mosquitto_pub (pacote mosquitto-clients). Rode na mesma
+# máquina do broker para que o RTT medido seja o do enlace do Pico.
+
+set -euo pipefail
+
+BROKER=${1:-127.0.0.1}
+PORTA=${2:-1883}
+TOPICO_SONDA=${TOPICO_SONDA:-pico/sonda}
+TOPICO_SONDA_ECO=${TOPICO_SONDA_ECO:-pico/sonda/eco}
+
+echo "Eco: ${TOPICO_SONDA} -> ${TOPICO_SONDA_ECO} em ${BROKER}:${PORTA}" >&2
+# -l no mosquitto_pub publica cada linha lida do stdin como uma mensagem
+mosquitto_sub -h "$BROKER" -p "$PORTA" -t "$TOPICO_SONDA" -q 0 |
+    mosquitto_pub -h "$BROKER" -p "$PORTA" -t "$TOPICO_SONDA_ECO" -q 0 -l
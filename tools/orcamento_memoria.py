@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+Relatório do orçamento de RAM do firmware a partir do ELF: dados estáticos,
+heap reservado, pilhas por núcleo, código copiado para a RAM e os maiores
+objetos estáticos. Com --exigir-sem-heap falha (código 1) se alguma função do
+alocador C (malloc/calloc/realloc) foi ligada; é assim que o build com
+-DMEMORIA_ESTATICA=ON garante que não há alocação dinâmica.
+
+Uso:
+    python3 tools/orcamento_memoria.py build/MQTTPicoRF.elf
+    python3 tools/orcamento_memoria.py --exigir-sem-heap build/MQTTPicoRF.elf
+
+Também disponível como alvo do CMake: cmake --build build --target orcamento_memoria
+"""
+
+import argparse
+import subprocess
+import sys
+
+from relatorio_secoes import LINHA_SIMBOLO, ler_simbolos, regiao
+
+RAM_TOTAL = 264 * 1024
+
+# Ponto de entrada do alocador da newlib e os invólucros do pico_malloc
+ALOCADORES = {
+    "malloc", "_malloc_r", "__wrap_malloc",
+    "calloc", "_calloc_r", "__wrap_calloc",
+    "realloc", "_realloc_r", "__wrap_realloc",
+}
+
+
+def enderecos_linker(objdump, elf):
+    """Símbolos sem tamanho definidos pelo linker script (limites de heap e pilhas)."""
+    saida = subprocess.run([objdump, "-t", elf], check=True, capture_output=True, text=True).stdout
+    enderecos = {}
+    for linha in saida.splitlines():
+        m = LINHA_SIMBOLO.match(linha)
+        if m:
+            enderecos[m.group(5).strip()] = int(m.group(1), 16)
+    return enderecos
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf")
+    parser.add_argument("--objdump", default="arm-none-eabi-objdump")
+    parser.add_argument("--maiores", type=int, default=20, help="Quantidade de objetos listados")
+    parser.add_argument("--exigir-sem-heap", action="store_true")
+    args = parser.parse_args()
+
+    simbolos = list(ler_simbolos(args.objdump, args.elf))
+    limites = enderecos_linker(args.objdump, args.elf)
+
+    def intervalo(inicio, fim):
+        if inicio in limites and fim in limites:
+            return limites[fim] - limites[inicio]
+        return 0
+
+    dados_sram = sum(s["tamanho"] for s in simbolos if s["tipo"] == "O" and regiao(s["endereco"]) == "SRAM")
+    codigo_ram = sum(s["tamanho"] for s in simbolos if s["tipo"] == "F" and regiao(s["endereco"]) not in (None, "FLASH"))
+    heap = intervalo("end", "__StackLimit")
+    pilha0 = intervalo("__StackBottom", "__StackTop")
+    pilha1 = intervalo("__StackOneBottom", "__StackOneTop")
+
+    print(f"Orçamento de RAM ({RAM_TOTAL // 1024} KB)")
+    linhas = [
+        ("Objetos estáticos na SRAM", dados_sram),
+        ("Código copiado para a RAM", codigo_ram),
+        ("Heap reservado (end .. __StackLimit)", heap),
+        ("Pilha do núcleo 0 (SCRATCH_Y)", pilha0),
+        ("Pilha do núcleo 1 (SCRATCH_X)", pilha1),
+    ]
+    for descricao, tamanho in linhas:
+        print(f"  {descricao:<40} {tamanho:>8} bytes ({100.0 * tamanho / RAM_TOTAL:5.1f}%)")
+
+    objetos = sorted((s for s in simbolos if s["tipo"] == "O" and regiao(s["endereco"]) not in (None, "FLASH")),
+                     key=lambda s: s["tamanho"], reverse=True)
+    print("\nMaiores objetos estáticos em RAM:")
+    for s in objetos[:args.maiores]:
+        print(f"  {s['tamanho']:>8} {regiao(s['endereco']):<10} {s['nome']}")
+
+    ligados = sorted(s["nome"] for s in simbolos if s["tipo"] == "F" and s["nome"] in ALOCADORES)
+    if ligados:
+        print(f"\nAlocador C ligado: {', '.join(ligados)}")
+        print("  (quem o referencia aparece em 'Archive member included' no arquivo .elf.map)")
+        if args.exigir_sem_heap:
+            print("ERRO: MEMORIA_ESTATICA exige um firmware sem malloc/calloc/realloc", file=sys.stderr)
+            return 1
+    else:
+        print("\nAlocador C: não ligado")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
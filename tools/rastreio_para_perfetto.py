@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""
+Converte o despejo de rastreio do firmware (comando 'd' na serial) para o
+formato JSON do Chrome Trace / Perfetto (https://ui.perfetto.dev).
+
+Uso:
+    python3 tools/rastreio_para_perfetto.py captura_serial.txt > rastreio.json
+    python3 tools/rastreio_para_perfetto.py --porta /dev/ttyACM0 > rastreio.json
+
+Cada linha "R,<nucleo>,<tempo_us>,<B|E|i>,<nome>" vira um evento; os núcleos
+aparecem como threads ("core0", "core1") do mesmo processo.
+"""
+
+import argparse
+import json
+import sys
+
+
+def ler_linhas_serial(porta, baud):
+    import serial  # pyserial, só necessário na captura direta
+
+    with serial.Serial(porta, baud, timeout=2) as s:
+        s.write(b"d")
+        em_despejo = False
+        while True:
+            linha = s.readline().decode("utf-8", errors="replace")
+            if not linha:
+                break
+            if linha.startswith("#RASTREIO"):
+                em_despejo = True
+            if em_despejo:
+                yield linha
+            if linha.startswith("#FIM"):
+                break
+
+
+def converter(linhas):
+    eventos = []
+    # Buffer circular pode ter perdido o início de spans: descarta "E" sem "B"
+    abertos = {}
+    for linha in linhas:
+        partes = linha.strip().split(",")
+        if len(partes) != 5 or partes[0] != "R":
+            continue
+        nucleo, tempo_us, fase, nome = int(partes[1]), int(partes[2]), partes[3], partes[4]
+        chave = (nucleo, nome)
+        if fase == "B":
+            abertos[chave] = abertos.get(chave, 0) + 1
+        elif fase == "E":
+            if abertos.get(chave, 0) == 0:
+                continue
+            abertos[chave] -= 1
+        evento = {"name": nome, "ph": fase, "ts": tempo_us, "pid": 0, "tid": nucleo}
+        if fase == "i":
+            evento["s"] = "t"
+        eventos.append(evento)
+
+    # Timer do RP2040 é de 32 bits em us: corrige a volta (~71 min) mantendo a ordem por núcleo
+    for nucleo in (0, 1):
+        deslocamento, anterior = 0, None
+        for e in (e for e in eventos if e["tid"] == nucleo):
+            if anterior is not None and e["ts"] + deslocamento < anterior:
+                deslocamento += 1 << 32
+            e["ts"] += deslocamento
+            anterior = e["ts"]
+
+    metadados = [
+        {"name": "thread_name", "ph": "M", "pid": 0, "tid": n, "args": {"name": f"core{n}"}}
+        for n in (0, 1)
+    ]
+    return {"traceEvents": metadados + eventos, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("arquivo", nargs="?", help="Captura da serial (padrão: stdin)")
+    parser.add_argument("--porta", help="Porta serial para solicitar o despejo diretamente")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    if args.porta:
+        linhas = ler_linhas_serial(args.porta, args.baud)
+    elif args.arquivo:
+        linhas = open(args.arquivo, encoding="utf-8", errors="replace")
+    else:
+        linhas = sys.stdin
+
+    json.dump(converter(linhas), sys.stdout)
+    sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()
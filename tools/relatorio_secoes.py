@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+Mostra onde o código e os dados do firmware ficaram na memória do RP2040
+(flash XIP, SRAM principal, SCRATCH_X, SCRATCH_Y), a partir da tabela de
+símbolos do ELF. Serve para conferir o efeito de -DCODIGO_EM_RAM.
+
+Uso:
+    python3 tools/relatorio_secoes.py build/MQTTPicoRF.elf
+    python3 tools/relatorio_secoes.py --simbolos fila_intercore_inserir,ssd1306_render build/MQTTPicoRF.elf
+
+Também disponível como alvo do CMake: cmake --build build --target relatorio_memoria
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+# Regiões do memmap_default.ld do SDK
+REGIOES = [
+    ("FLASH", 0x10000000, 0x11000000),
+    ("SRAM", 0x20000000, 0x20040000),
+    ("SCRATCH_X", 0x20040000, 0x20041000),
+    ("SCRATCH_Y", 0x20041000, 0x20042000),
+]
+
+LINHA_SIMBOLO = re.compile(r"^([0-9a-fA-F]+)\s(.{7})\s(\S+)\s+([0-9a-fA-F]+)\s+(.+)$")
+
+
+def regiao(endereco):
+    for nome, inicio, fim in REGIOES:
+        if inicio <= endereco < fim:
+            return nome
+    return None
+
+
+def ler_simbolos(objdump, elf):
+    saida = subprocess.run([objdump, "-t", elf], check=True, capture_output=True, text=True).stdout
+    for linha in saida.splitlines():
+        m = LINHA_SIMBOLO.match(linha)
+        if not m:
+            continue
+        endereco, flags, secao, tamanho, nome = m.groups()
+        tipo = "F" if "F" in flags else ("O" if "O" in flags else None)
+        if tipo is None or int(tamanho, 16) == 0:
+            continue
+        yield {
+            "endereco": int(endereco, 16),
+            "tipo": tipo,
+            "secao": secao,
+            "tamanho": int(tamanho, 16),
+            "nome": nome.strip(),
+        }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf")
+    parser.add_argument("--objdump", default="arm-none-eabi-objdump")
+    parser.add_argument("--simbolos", default="", help="Lista (vírgulas) de símbolos cuja região deve ser mostrada")
+    args = parser.parse_args()
+
+    simbolos = list(ler_simbolos(args.objdump, args.elf))
+
+    totais = {nome: {"F": 0, "O": 0} for nome, _, _ in REGIOES}
+    for s in simbolos:
+        r = regiao(s["endereco"])
+        if r:
+            totais[r][s["tipo"]] += s["tamanho"]
+
+    print(f"{'Região':<10} {'Código':>9} {'Dados':>9}")
+    for nome, _, _ in REGIOES:
+        print(f"{nome:<10} {totais[nome]['F']:>9} {totais[nome]['O']:>9}")
+
+    fora_da_flash = sorted(
+        (s for s in simbolos if s["tipo"] == "F" and regiao(s["endereco"]) not in (None, "FLASH")),
+        key=lambda s: s["endereco"],
+    )
+    print(f"\nFunções fora da flash ({len(fora_da_flash)}):")
+    for s in fora_da_flash:
+        print(f"  {s['endereco']:08x} {s['tamanho']:>6} {regiao(s['endereco']):<10} {s['nome']}")
+
+    if args.simbolos:
+        por_nome = {s["nome"]: s for s in simbolos}
+        print("\nSímbolos pedidos:")
+        for nome in filter(None, args.simbolos.split(",")):
+            s = por_nome.get(nome)
+            if s is None:
+                print(f"  {nome:<32} (não encontrado; pode ter sido embutido)")
+            else:
+                print(f"  {nome:<32} {regiao(s['endereco']) or '?':<10} {s['secao']} {s['tamanho']} bytes")
+
+
+if __name__ == "__main__":
+    sys.exit(main())
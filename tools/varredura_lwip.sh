@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+# Varredura dos parâmetros de memória do lwIP (config/lwipopts.h) no alvo de rede nativo.
+#
+# Para cada variante compila o MQTTPicoRF_cenario em um diretório próprio e roda o
+# cenário "sustentado" de tools/cenario_mqtt_carga.sh em cada taxa, juntando as
+# linhas RESULTADO em um CSV (vazão, latência do ACK e pico de uso dos pools).
+#
+# Uso (requer root para a interface TAP):
+#   sudo LWIP_DIR=$HOME/lwip tools/varredura_lwip.sh [saida.csv]
+#
+# Variáveis de ambiente:
+#   LWIP_DIR    fonte do lwIP com contrib/ (obrigatória)
+#   TAXAS       taxas em msgs/s (padrão: "50 200 1000")
+#   DURACAO     segundos por execução (padrão: 20)
+#   BYTES       tamanho do payload (padrão: 64)
+#   VARIANTES   lista "nome:perfil[:DEF=valor,DEF=valor]" separada por espaços.
+#               Padrão: os três perfis. Exemplo de varredura de um parâmetro:
+#               VARIANTES="pool8:2:PBUF_POOL_SIZE=8 pool16:2:PBUF_POOL_SIZE=16"
+
+set -euo pipefail
+
+SAIDA=${1:-varredura_lwip.csv}
+: "${LWIP_DIR:?defina LWIP_DIR com a raiz do lwIP (com contrib/)}"
+TAXAS=${TAXAS:-"50 200 1000"}
+DURACAO=${DURACAO:-20}
+BYTES=${BYTES:-64}
+VARIANTES=${VARIANTES:-"baixa_ram:1 equilibrado:2 alta_vazao:3"}
+
+RAIZ=$(cd "$(dirname "$0")/.." && pwd)
+IP_BROKER=${IP_BROKER:-192.168.50.1}
+
+# Chaves do RESULTADO exportadas para o CSV, na ordem das colunas
+CAMPOS="taxa_alvo msgs_s acks falhas recusadas lat_p50_us lat_p90_us lat_p99_us lat_max_us \
+perfil mem_size pbuf_pool tcp_wnd tcp_snd_buf mqtt_ringbuf mqtt_em_voo \
+mem_max mem_err pbuf_pool_max pbuf_pool_err tcp_seg_max tcp_seg_err"
+
+echo "variante,$(echo $CAMPOS | tr ' ' ',')" > "$SAIDA"
+
+for variante in $VARIANTES; do
+    IFS=: read -r nome perfil extras <<< "$variante"
+    dir="$RAIZ/build_varredura/$nome"
+    echo "== $nome (perfil $perfil${extras:+, $extras})"
+
+    cmake -S "$RAIZ" -B "$dir" -DMQTTPICORF_HOST=ON -DLWIP_DIR="$LWIP_DIR" \
+        -DHOST_BROKER_IP="$IP_BROKER" -DLWIP_PERFIL="$perfil" -DLWIP_MEDIR_POOLS=ON \
+        -DLWIP_OPCOES_EXTRA="${extras//,/;}" -DCMAKE_BUILD_TYPE=Release > /dev/null
+    cmake --build "$dir" --target MQTTPicoRF_cenario -j"$(nproc)" > /dev/null
+
+    for taxa in $TAXAS; do
+        linha=$(BUILD_DIR="$dir" IP_BROKER="$IP_BROKER" \
+            "$RAIZ/tools/cenario_mqtt_carga.sh" sustentado "$taxa" "$DURACAO" "$BYTES" | grep '^RESULTADO' || true)
+        echo "   $taxa msgs/s: ${linha:-sem RESULTADO}"
+        valores=""
+        for campo in $CAMPOS; do
+            valor=$(grep -o "\b$campo=[^ ]*" <<< "$linha" | head -1 | cut -d= -f2 || true)
+            valores="$valores,${valor}"
+        done
+        echo "$nome$valores" >> "$SAIDA"
+    done
+done
+
+echo "CSV gravado em $SAIDA"